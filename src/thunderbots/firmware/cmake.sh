@@ -11,7 +11,7 @@ if [[ $dir == "--help" ]]; then
     echo "    ./cmake.sh directory target"
     echo
     echo "The directory is one of:"
-    printf "    software firmware/main\n    firmware/dongle\n    firmware/test\n    tools/fwsim\n"
+    printf "    software firmware/main\n    firmware/dongle\n    firmware/test\n    tools/fwsim\n    tools/logdecode\n"
     echo
     echo "software targets are one of: "
     printf "    ai\n    mrftest\n    software_test\n    buildid\n    getcore\n    hall2phase\n    log\n    mrfcap\n    nulltest\n    sdutil\n"
@@ -24,6 +24,7 @@ if [[ $dir == "--help" ]]; then
     echo
     echo "For firmware/test the target is fw_test"
     echo "For tools/fwsim the target is sim"
+    echo "For tools/logdecode the target is logdecode"
     echo
     printf "Run\n    ./cmake.sh directory all\nto build all of the executables in that directory \n"
     echo
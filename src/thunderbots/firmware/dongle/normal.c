@@ -34,11 +34,43 @@
  */
 #define DRIVE_BYTES_PER_ROBOT 8
 
+/**
+ * \brief The number of bytes for each robot in a sequenced drive transfer,
+ * which are the robot index, the sequence number, and the drive data block.
+ */
+#define SEQUENCED_DRIVE_BYTES_PER_ROBOT (DRIVE_BYTES_PER_ROBOT + 2)
+
+/**
+ * \brief The mask of the bits of the drive serial number that are sent to the
+ * robots. The top bit of the byte holding it requests feedback.
+ */
+#define DRIVE_SERIAL_MASK 0x7FU
+
 /**
  * \brief The number of bytes in the camera data block for each robot.
  */
 #define CAMERA_BYTES_PER_ROBOT 6
 
+/**
+ * \brief The length of the USB transfer holding a camera packet.
+ */
+#define CAMERA_PACKET_LENGTH 55
+
+/**
+ * \brief The length of the USB transfer holding a compact camera packet.
+ */
+#define COMPACT_CAMERA_PACKET_LENGTH 64
+
+/**
+ * \brief The number of bytes in the compact camera packet keyframe data block for each robot.
+ */
+#define COMPACT_CAMERA_KEYFRAME_BYTES_PER_ROBOT 6
+
+/**
+ * \brief The number of bytes in the compact camera packet delta data block for each robot.
+ */
+#define COMPACT_CAMERA_DELTA_BYTES_PER_ROBOT 3
+
 /**
  * \brief The number of packet buffers to allocate at system startup.
  */
@@ -380,6 +412,73 @@ static void send_camera_packet(const void *packet)
 	mrf_write_short(MRF_REG_SHORT_TXNCON, 0b00000001U);
 }
 
+/**
+ * \brief Writes a compact camera packet into the radio transmit buffer and begins
+ * sending it.
+ *
+ * Only the bytes used by the packet are sent, which depends on whether it is a
+ * keyframe or a delta and on how many robots are in it.
+ *
+ * \param[in] packet the compact camera packet (max. 64 bytes)
+ *
+ * \pre The transmit mutex must be held by the caller.
+*/
+static void send_compact_camera_packet(const void *packet)
+{
+	unsigned int address = MRF_REG_LONG_TXNFIFO;
+
+	// Write out the MRF24J40 and 802.15.4 headers.
+	unsigned int header_length_address = address++;
+	unsigned int frame_length_address = address++;
+	unsigned int header_start_address = address;
+	mrf_write_long(address++, 0b01000001U); // Frame control LSB
+	mrf_write_long(address++, 0b10001000U); // Frame control MSB
+	mrf_write_long(address++, ++mrf_tx_seqnum); // Sequence number
+	mrf_write_long(address++, radio_config.pan_id); // Destination PAN ID LSB
+	mrf_write_long(address++, radio_config.pan_id >> 8U); // Destination PAN ID MSB
+	mrf_write_long(address++, 0xFFU); // Destination address LSB
+	mrf_write_long(address++, 0xFFU); // Destination address MSB
+	mrf_write_long(address++, 0x00U); // Source address LSB
+	mrf_write_long(address++, 0x01U); // Source address MSB
+
+	// Record the header length, now that the header is finished.
+	mrf_write_long(header_length_address, address - header_start_address);
+
+	// Compact camera packet. 0 = header, 1 = mask, 2-5 = Ball x and y, then the robots and timestamp
+	const uint8_t *rptr = packet;
+
+	// Message purpose
+	mrf_write_long(address++, 0x11U);
+
+	// The top bit of the header is set for keyframes
+	bool keyframe = (*rptr & 0x80U) != 0;
+	uint8_t mask = rptr[1];
+
+	uint8_t num_valid_robots = 0;
+	for (size_t i = 0; i < NUM_ROBOTS; ++i)
+	{
+		if ((mask >> i) & 1) num_valid_robots++;
+	}
+
+	// Keyframes have full positions and timestamps, deltas have small offsets from the keyframe
+	size_t length = 2 /* Header and mask */ + 4 /* Ball */;
+	if (keyframe) {
+		length += num_valid_robots * COMPACT_CAMERA_KEYFRAME_BYTES_PER_ROBOT + 8 /* Timestamp */;
+	} else {
+		length += num_valid_robots * COMPACT_CAMERA_DELTA_BYTES_PER_ROBOT + 2 /* Timestamp offset */;
+	}
+
+	for (size_t i = 0; i != length; ++i) {
+		mrf_write_long(address++, *rptr++);
+	}
+
+	// Record the frame length, now that the frame is finished.
+	mrf_write_long(frame_length_address, address - header_start_address);
+
+	// Initiate transmission with no acknowledgement.
+	mrf_write_short(MRF_REG_SHORT_TXNCON, 0b00000001U);
+}
+
 /**
  * \brief Writes a drive packet into the radio transmit buffer and begins
  * sending it.
@@ -387,8 +486,8 @@ static void send_camera_packet(const void *packet)
  * This function also blinks the transmit LED.
  *
  * \param[in] packet the 64-byte drive packet
- * \param[in] serials the 1-byte data serial number for each robot, incremented
- * when new data arrives
+ * \param[in] serials the data serial number for each robot, which is either the
+ * sequence number given by the host or incremented when new data arrives
  *
  * \pre The transmit mutex must be held by the caller.
  */
@@ -419,7 +518,7 @@ static void send_drive_packet(const void *packet, const uint8_t *serials) {
 	// byte for each robot.
 	const uint8_t *rptr = packet;
 	for (size_t i = 0; i != NUM_ROBOTS; ++i) {
-		mrf_write_long(address++, (serials[i] & 0x0F) | ((poll_index == i) ? 0x80 : 0x00));
+		mrf_write_long(address++, (serials[i] & DRIVE_SERIAL_MASK) | ((poll_index == i) ? 0x80 : 0x00));
 		for (size_t j = 0; j != DRIVE_BYTES_PER_ROBOT; ++j) {
 			mrf_write_long(address++, *rptr++);
 		}
@@ -449,6 +548,18 @@ static void send_drive_packet(const void *packet, const uint8_t *serials) {
  *
  * The drive packet is sent over the radio every time timer 6 expires, as long as the packet is valid.
  * On receiving a packet over USB, the new packet is used on the next scheduled transmission and thereafter.
+ *
+ * The host sends drive data in one of three formats, told apart by the transfer length:
+ * \li 64 bytes of data for every robot, in index order.
+ * \li A multiple of 9 bytes, where each robot’s data is prefixed by its index.
+ * \li A multiple of 10 bytes, where each robot’s data is prefixed by its index and a sequence number.
+ *
+ * In the first two formats, the serial number sent to a robot is incremented whenever it gets new data.
+ * In the sequenced format, the host’s sequence number is sent instead, so the host can match the
+ * sequence number the robot reports applying to the command it sent.
+ *
+ * Since the endpoint buffer holds a sequenced transfer for every robot, which is longer than one USB
+ * packet, a 64-byte transfer must be ended by a zero-length packet.
  */
 static void drive_task(void *UNUSED(param)) {
 	for (;;) {
@@ -457,7 +568,7 @@ static void drive_task(void *UNUSED(param)) {
 		// Allocate space to store packet serial numbers and packet buffers.
 		uint8_t serials[NUM_ROBOTS] = {};
 		static uint8_t packet_buffer[NUM_ROBOTS * DRIVE_BYTES_PER_ROBOT];
-		static uint8_t usb_buffer[NUM_ROBOTS * DRIVE_BYTES_PER_ROBOT];
+		static uint8_t usb_buffer[NUM_ROBOTS * SEQUENCED_DRIVE_BYTES_PER_ROBOT];
 
 		// Fill the packet buffer with a safe default.
 		memset(packet_buffer, 0, NUM_ROBOTS * DRIVE_BYTES_PER_ROBOT);
@@ -494,7 +605,7 @@ static void drive_task(void *UNUSED(param)) {
 		for (;;) {
 			// Start the endpoint if possible.
 			if (!ep_running) {
-				if (uep_async_read_start(0x01U, usb_buffer, NUM_ROBOTS * DRIVE_BYTES_PER_ROBOT, &handle_drive_endpoint_done)) {
+				if (uep_async_read_start(0x01U, usb_buffer, sizeof(usb_buffer), &handle_drive_endpoint_done)) {
 					ep_running = true;
 				} else {
 					if (errno == EPIPE) {
@@ -521,6 +632,25 @@ static void drive_task(void *UNUSED(param)) {
 						for (unsigned int i = 0; i != NUM_ROBOTS; ++i) {
 							++serials[i];
 						}
+					} else if (transfer_length && !(transfer_length % SEQUENCED_DRIVE_BYTES_PER_ROBOT)) {
+						// This transfer contains a list of new drive data blocks
+						// prefixed with robot indices and sequence numbers.
+						bool valid = true;
+						for (size_t i = 0; i != transfer_length; i += SEQUENCED_DRIVE_BYTES_PER_ROBOT) {
+							valid = valid && usb_buffer[i] < NUM_ROBOTS;
+						}
+						if (valid) {
+							const uint8_t *rptr = usb_buffer;
+							while (rptr != usb_buffer + transfer_length) {
+								unsigned int index = *rptr++;
+								serials[index] = *rptr++;
+								memcpy(packet_buffer + index * DRIVE_BYTES_PER_ROBOT, rptr, DRIVE_BYTES_PER_ROBOT);
+								rptr += DRIVE_BYTES_PER_ROBOT;
+							}
+						} else {
+							// Transfer has a bad robot index; reject.
+							uep_halt(0x01U);
+						}
 					} else if (transfer_length && !(transfer_length % (DRIVE_BYTES_PER_ROBOT + 1))) {
 						// This transfer contains a list of new drive data blocks
 						// prefixed with robot indices.
@@ -584,18 +714,19 @@ static void camera_task(void *UNUSED(param)) {
 		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
 
 		// Allocate space to store the camera packet
-		static uint8_t packet_buffer[55]; // The max bytes possible in a camera packet
-		static uint8_t usb_buffer[55];
+		static uint8_t packet_buffer[COMPACT_CAMERA_PACKET_LENGTH]; // The max bytes possible in a camera packet
+		static uint8_t usb_buffer[COMPACT_CAMERA_PACKET_LENGTH];
 
 		// Fill the packet buffer with a safe default.
-		memset(packet_buffer, 0, 55);
+		memset(packet_buffer, 0, sizeof(packet_buffer));
+		bool packet_compact = false;
 
 		// Run!
 		bool ep_running = false;
 		for (;;) {
 			// Start the endpoint if possible.
 			if (!ep_running) {
-				if (uep_async_read_start(0x02U, usb_buffer, 55, &handle_camera_endpoint_done)) {
+				if (uep_async_read_start(0x02U, usb_buffer, sizeof(usb_buffer), &handle_camera_endpoint_done)) {
 					ep_running = true;
 				} else {
 					if (errno == EPIPE) {
@@ -616,9 +747,11 @@ static void camera_task(void *UNUSED(param)) {
 				size_t transfer_length;
 				if (uep_async_read_finish(0x02U, &transfer_length)) {
 					ep_running = false;
-					if (transfer_length == 55) {
+					if (transfer_length == CAMERA_PACKET_LENGTH || transfer_length == COMPACT_CAMERA_PACKET_LENGTH) {
 						// This transfer contains new data for every robot.
-						memcpy(packet_buffer, usb_buffer, 55);
+						// The format of the packet is given by its length.
+						memcpy(packet_buffer, usb_buffer, transfer_length);
+						packet_compact = transfer_length == COMPACT_CAMERA_PACKET_LENGTH;
 					} else {
 						// Transfer is wrong length; reject.
 						uep_halt(0x02U);
@@ -637,7 +770,11 @@ static void camera_task(void *UNUSED(param)) {
 			}
 			// Send a packet.
 			xSemaphoreTake(transmit_mutex, portMAX_DELAY);
-			send_camera_packet(packet_buffer);
+			if (packet_compact) {
+				send_compact_camera_packet(packet_buffer);
+			} else {
+				send_camera_packet(packet_buffer);
+			}
 			xSemaphoreTake(transmit_complete_sem, portMAX_DELAY);
 			xSemaphoreGive(transmit_mutex);
 		}
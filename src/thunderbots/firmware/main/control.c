@@ -1,6 +1,7 @@
 #include "control.h"
 
 #include "physics.h"
+#include "util/matrix.h"
 
 
 #include "wheels.h"
@@ -47,7 +48,7 @@ const float SCALAR_VF[4] =
  * /param[out] new forces to apply to the wheels
  */
 void correct_wheel_force(const float force[4], float new_force[4]) {
-	matrix_mult(new_force,4,force,4,WHEEL_CORR_MAT);
+	mat4_mult_vec(WHEEL_CORR_MAT, force, new_force);
 }
 
 
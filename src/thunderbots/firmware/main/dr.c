@@ -5,6 +5,7 @@
 #include "sensors.h"
 #include "circbuff.h"
 #include "primitives/primitive.h"
+#include "shared_util/radio_units.h"
 
 #include <stdio.h>
 #include <stdint.h>
@@ -133,9 +134,9 @@ void dr_set_robot_frame(int16_t x, int16_t y, int16_t angle) {
   // before overwriting with new camera data.
   // Provides some thread safety
   if(robot_camera_data.new_data == false){  
-    robot_camera_data.x = (float)(x/1000.0);
-    robot_camera_data.y = (float)(y/1000.0);
-    robot_camera_data.angle = (float)(angle/1000.0);
+    robot_camera_data.x = radio_decode_camera_length(x);
+    robot_camera_data.y = radio_decode_camera_length(y);
+    robot_camera_data.angle = radio_decode_camera_angle(angle);
     robot_camera_data.new_data = true;
   }
 }
@@ -193,8 +194,8 @@ void dr_apply_cam() {
  * \brief Sets the ball's camera frame.
  */
 void dr_set_ball_frame(int16_t x, int16_t y) {
-  ball_camera_data.x = (float)(x/1000.0);
-  ball_camera_data.y = (float)(y/1000.0);
+  ball_camera_data.x = radio_decode_camera_length(x);
+  ball_camera_data.y = radio_decode_camera_length(y);
 }
 
 
@@ -202,8 +203,8 @@ void dr_set_ball_frame(int16_t x, int16_t y) {
  * \brief Sets the ball's camera frame and timestamp.
  */
 void dr_set_ball_frame_timestamp(int16_t x, int16_t y, uint64_t timestamp) {
-  float new_x = (float)(x/1000.0);
-  float new_y = (float)(y/1000.0);
+  float new_x = radio_decode_camera_length(x);
+  float new_y = radio_decode_camera_length(y);
   uint64_t new_t = timestamp;
 
   float delta_x = new_x - ball_camera_data.x;
@@ -21,6 +21,8 @@
 #include "mrf.h"
 #include "lps.h"
 #include "priority.h"
+#include "profile.h"
+#include "receive.h"
 #include "sdcard.h"
 #include "wheels.h"
 #include "upgrade/fpga.h"
@@ -47,6 +49,22 @@ static bool has_ball_after_antispam = false;
 static bool build_ids_pending = false;
 static TaskHandle_t feedback_task_handle;
 
+/**
+ * \brief Writes a time from the CPU profile to a feedback packet.
+ *
+ * \param[out] wptr where to write the time
+ * \param[in] counts the time, in profile counts
+ * \return the byte after the time
+ */
+static uint8_t *put_profile_time(uint8_t *wptr, uint32_t counts) {
+	// Tenths of a microsecond cover the whole normal tick period while still
+	// resolving the fast tick.
+	uint32_t tenths_us = (uint32_t) MIN(UINT16_MAX, (uint64_t) counts * 10U / PROFILE_COUNTS_PER_US);
+	*wptr++ = tenths_us; // LSB
+	*wptr++ = tenths_us >> 8U; // MSB
+	return wptr;
+}
+
 static void feedback_task(void *UNUSED(param)) {
 	static uint8_t nullary_frame[] = {
 		9U, // Header length
@@ -80,7 +98,7 @@ static void feedback_task(void *UNUSED(param)) {
 #define HEADER_LENGTH 9
 #define PURPOSE_LENGTH 1
 #define BASIC_LENGTH 12
-#define EXTENSIONS_MAX_LENGTH 32
+#define EXTENSIONS_MAX_LENGTH 36
 			static uint8_t frame[PREFIX_LENGTH + HEADER_LENGTH + PURPOSE_LENGTH + BASIC_LENGTH + EXTENSIONS_MAX_LENGTH] = {
 				HEADER_LENGTH, // [0] Header length
 				0, // [1] Total length
@@ -165,6 +183,35 @@ static void feedback_task(void *UNUSED(param)) {
 				wptr += sizeof(bid);
 			}
 
+			// Fill CPU profile extension.
+			log_profile_t profile;
+			if (profile_latest(&profile)) {
+				*wptr++ = 0x03; // CPU profile extension code.
+				wptr = put_profile_time(wptr, profile.mean[PROFILE_MODULE_NORMAL_TICK]);
+				wptr = put_profile_time(wptr, profile.max[PROFILE_MODULE_NORMAL_TICK]);
+				wptr = put_profile_time(wptr, profile.mean[PROFILE_MODULE_FAST_TICK]);
+				wptr = put_profile_time(wptr, profile.max[PROFILE_MODULE_FAST_TICK]);
+				unsigned int busiest = 0U;
+				for (unsigned int i = 0U; i != PROFILE_MODULE_NORMAL_TICK; ++i) {
+					if (profile.mean[i] > profile.mean[busiest]) {
+						busiest = i;
+					}
+				}
+				*wptr++ = busiest; // Busiest module
+				wptr = put_profile_time(wptr, profile.mean[busiest]);
+			}
+
+			// Fill drive acknowledgement extension.
+			uint8_t drive_serial;
+			uint32_t drive_age_ms;
+			if (receive_last_serial_age(&drive_serial, &drive_age_ms)) {
+				*wptr++ = 0x04; // Drive acknowledgement extension code.
+				*wptr++ = drive_serial; // Serial number of the applied drive data
+				u16 = (uint16_t) MIN(UINT16_MAX, drive_age_ms);
+				*wptr++ = u16; // Milliseconds since it was applied LSB
+				*wptr++ = u16 >> 8U; // Milliseconds since it was applied MSB
+			}
+
 			// Fill LPS data extension.
 			{
 				*wptr++ = 0x02; // LPS data extension code.
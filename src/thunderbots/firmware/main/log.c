@@ -134,7 +134,8 @@ bool log_init(void) {
 				state = LOG_STATE_SD_ERROR;
 				return false;
 			}
-			if (buffer->records[0U].magic == LOG_MAGIC_TICK) {
+			uint32_t magic = buffer->records[0U].magic;
+			if (magic == LOG_MAGIC_TICK || magic == LOG_MAGIC_PROFILE) {
 				low = probe + 1U;
 			} else {
 				high = probe;
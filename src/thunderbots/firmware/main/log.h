@@ -2,6 +2,7 @@
 #define LOG_H
 
 #include "error.h"
+#include "profile.h"
 #include "sdcard.h"
 #include <inttypes.h>
 #include <stdbool.h>
@@ -9,6 +10,7 @@
 
 #define LOG_RECORD_SIZE 256U //128U
 #define LOG_MAGIC_TICK UINT32_C(0xE2468845)
+#define LOG_MAGIC_PROFILE UINT32_C(0xE2468846)
 
 /**
  * \ingroup LOG
@@ -76,6 +78,7 @@ typedef struct {
 	uint64_t time;
 	union {
 		log_tick_t tick;
+		log_profile_t profile;
 		uint8_t padding[LOG_RECORD_SIZE - 4U - 4U - 8U];
 	};
 } log_record_t;
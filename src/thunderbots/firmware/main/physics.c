@@ -1,5 +1,7 @@
 #include "physics.h"
 #include "encoder.h"
+#include "util/fast_math.h"
+#include "util/matrix.h"
 #include <math.h>
 #include <stdint.h>
 
@@ -44,36 +46,15 @@ const float ROBOT_MASS[3] = {ROBOT_POINT_MASS, ROBOT_POINT_MASS, ROT_MASS};
 const float MAX_VEL[3] = {MAX_X_V, MAX_Y_V, MAX_T_V*ROBOT_RADIUS};
 const float MAX_ACC[3] = {MAX_X_A, MAX_Y_A, MAX_T_A*ROBOT_RADIUS};
 
-//contention vector, where in forces will simply consume power.
-static const float contention_vector[4] = {-0.4621, 0.5353, -0.5353, 0.4621};
-
 float norm2(float a1, float a2){
-	return(sqrtf(a1*a1 + a2*a2) );
+	return(fast_sqrtf(a1*a1 + a2*a2) );
 }
 
 
 
-// return the minimum angle from angle1 to angle2
-// test with angle2 increased or decreased by 2pi
+// return the minimum angle from angle1 to angle2, in [-pi, pi]
 float min_angle_delta(float angle1, float angle2){
-	angle1 = fmod(angle1, 2*P_PI);
-	angle2 = fmod(angle2, 2*P_PI);
-	if(angle2 >= angle1 ){                                                                                                        
-		float ang_sub = angle2 - 2*P_PI;                                                                                        
-		if((ang_sub - angle1)*(ang_sub - angle1) <= (angle2 - angle1)*(angle2 - angle1)){                             
-			return(ang_sub - angle1);                                                              
-		}else{                                                                                                                 
-			return(angle2 - angle1);                                                                                 
-		}                                                                                                                      
-	}else{                                                                                                                       
-		float ang_plus = angle2 + 2*P_PI;                                                                                       
-		if((ang_plus - angle1)*(ang_plus - angle1) <= (angle2 - angle1)*(angle2 - angle1)){                           
-			return(ang_plus - angle1);                                                              
-		}else{                                                                                                                 
-			return(angle2 - angle1);                                                                                 
-		}                                                                                                                      
-	}                                                                                                                       
-
+	return fast_wrap_angle(angle2 - angle1);
 }
 
 /**
@@ -227,44 +208,28 @@ void mm_sub(int nrows, int ncols, const float a[nrows][ncols], const float b[nro
 }
 
 /**
- * \brief Inverts a 2x2 or a 1x1 matrix. 
+ * \brief Inverts a 3x3, 2x2 or 1x1 matrix. Singular 2x2 and 3x3 matrices are left
+ * unchanged.
  *
  * \param[in, out] a the result 
  * \param[in] n number of rows and columns
  */
 
 void mm_inv(int n, float a[n][n]) {
-  float det, temp;
-  float temp_m[n][n];
   switch(n) {
     case (1):
       a[0][0] = 1 / a[0][0];
       break;
     case (2):
-      det = (a[0][0]*a[1][1] - a[0][1]*a[1][0]);
-      temp = a[0][0];
-      a[0][0] = a[1][1] / det;
-      a[1][1] = temp / det;
-      a[0][1] = -a[0][1] / det;
-      a[1][0] = -a[1][0] / det;
+      mat2_inv(a);
       break;
     case (3):
-		  for(int i=0;i<3;i++)
-		      det = det + (a[0][i]*(a[1][(i+1)%3]*a[2][(i+2)%3] - a[1][(i+2)%3]*a[2][(i+1)%3]));
-		   for(int i=0;i<3;i++){
-		      for(int j=0;j<3;j++)
-		           temp_m[i][j] = ((a[(i+1)%3][(j+1)%3] * a[(i+2)%3][(j+2)%3]) - (a[(i+1)%3][(j+2)%3]*a[(i+2)%3][(j+1)%3]))/ det;
-		   }
-		   for(int i=0;i<3;i++){
-		      for(int j=0;j<3;j++)
-		           a[i][j] = temp_m[i][j];
-		   }
-		   break;
+      mat3_inv(a);
+      break;
     default:
-	  break;
-	}
-
+      break;
   }
+}
 
 
 /**
@@ -276,12 +241,12 @@ void mm_inv(int n, float a[n][n]) {
  * \param[out] the 3 robot speeds in the same units
  */
 void speed4_to_speed3(const float speed4[4], float speed3[3]) {
-	matrix_mult(speed3,3,speed4,4, speed4_to_speed3_mat);
+	mat3x4_mult_vec(speed4_to_speed3_mat, speed4, speed3);
 }
 
 #ifdef FWSIM
 void force4_to_force3(const float force4[4], float force3[3]) {
-	matrix_mult(force3,3,force4,4, force4_to_force3_mat);
+	mat3x4_mult_vec(force4_to_force3_mat, force4, force3);
 }
 #endif
 
@@ -294,7 +259,7 @@ void force4_to_force3(const float force4[4], float force3[3]) {
  * \param[out] the robot wheel speeds in the same units as input
  */
 void speed3_to_speed4(const float speed3[3], float speed4[4]) {
-	matrix_mult_t(speed4, 4, speed3, 3, force4_to_force3_mat);
+	mat3x4_t_mult_vec(force4_to_force3_mat, speed3, speed4);
 }
 
 
@@ -356,8 +321,8 @@ void vectorCopy(float *a, const float *b, int len) {
  *
  */
 void Cart2Pol(float vec[2]) {
-	float temp = sqrtf(vec[0]*vec[0] + vec[1]*vec[1]);
-	vec[1] = atan2f(vec[1], vec[0]);
+	float temp = fast_sqrtf(vec[0]*vec[0] + vec[1]*vec[1]);
+	vec[1] = fast_atan2f(vec[1], vec[0]);
 	vec[0] = temp;
 }
 
@@ -370,8 +335,10 @@ void Cart2Pol(float vec[2]) {
  *
  */
 void Pol2Cart(float vec[2]) {
-	float temp = vec[0]*cosf(vec[1]);
-	vec[1] = vec[0]*sinf(vec[1]);
+	float sinT, cosT;
+	fast_sincosf(vec[1], &sinT, &cosT);
+	float temp = vec[0]*cosT;
+	vec[1] = vec[0]*sinT;
 	vec[0] = temp;
 }
 
@@ -384,8 +351,10 @@ void Pol2Cart(float vec[2]) {
  * \param[in,out] velocity in cartesian coordinates to replace with polar
  */
 void CartVel2Pol(float const loc[2], float vel[2]) {
-	float temp = cosf(loc[1])*vel[0] + sinf(loc[1])*vel[1];
-	vel[1] = -sinf(loc[1])/loc[0]*vel[0] + cosf(loc[1])/loc[0]*vel[1];
+	float sinT, cosT;
+	fast_sincosf(loc[1], &sinT, &cosT);
+	float temp = cosT*vel[0] + sinT*vel[1];
+	vel[1] = -sinT/loc[0]*vel[0] + cosT/loc[0]*vel[1];
 	vel[0] = temp;
 }
 
@@ -398,8 +367,10 @@ void CartVel2Pol(float const loc[2], float vel[2]) {
  * \param[in,out] velocity in polar coordinates to replace with cartesian
  */
 void PolVel2Cart(float const loc[2], float vel[2]) {
-	float temp = cosf(loc[1])*vel[0] - loc[0]*sinf(loc[1])*vel[1];
-	vel[1] = sinf(loc[1])*vel[0] + loc[0]*cosf(loc[1])*vel[1];
+	float sinT, cosT;
+	fast_sincosf(loc[1], &sinT, &cosT);
+	float temp = cosT*vel[0] - loc[0]*sinT*vel[1];
+	vel[1] = sinT*vel[0] + loc[0]*cosT*vel[1];
 	vel[0] = temp;
 }
 
@@ -414,8 +385,8 @@ void PolVel2Cart(float const loc[2], float vel[2]) {
  * \param[out] acceleration in cartesian coords
  */
 void PolAcc2Cart(float const loc[2], float const vel[2], float const Pacc[2], float Cacc[2]) {
-	float cosT = cosf(loc[1]);
-	float sinT = sinf(loc[1]);
+	float sinT, cosT;
+	fast_sincosf(loc[1], &sinT, &cosT);
 	Cacc[0] = cosT*Pacc[0] - loc[0]*sinT*Pacc[1] + vel[1] * (-2.0f*sinT*vel[0] - loc[0]*cosT*vel[1]);
 	Cacc[1] = sinT*Pacc[0] + loc[0]*cosT*Pacc[1] + vel[1] * ( 2.0f*cosT*vel[0] - loc[1]*sinT*vel[1]);
 }
@@ -431,8 +402,10 @@ void PolAcc2Cart(float const loc[2], float const vel[2], float const Pacc[2], fl
  * \param[in] amount in radian to rotate
  */
 void rotate(float speed[2], float angle) {
-	float temp = cosf(angle)*speed[0] - sinf(angle)*speed[1];
-	speed[1] = sinf(angle)*speed[0] + cosf(angle)*speed[1];
+	float sinT, cosT;
+	fast_sincosf(angle, &sinT, &cosT);
+	float temp = cosT*speed[0] - sinT*speed[1];
+	speed[1] = sinT*speed[0] + cosT*speed[1];
 	speed[0]=temp;
 }
 
@@ -451,7 +424,7 @@ void rotate(float speed[2], float angle) {
  * \param[out] force to exert per wheel 
  */
 void force3_to_force4(float force3[3], float force4[4]) {
-	matrix_mult_t(force4, 4, force3, 3, speed4_to_speed3_mat);
+	mat3x4_t_mult_vec(speed4_to_speed3_mat, force3, force4);
 }
 
 // need the ifndef here so that we can ignore this code when compiling
@@ -537,10 +510,12 @@ float get_maximal_accel_scaling(const float linear_accel[2], float angular_accel
 void decompose_radial(const float speed, float* vf, const float* init_pos,
 	const float* final_pos)
 {
-	float angle = atan2f(final_pos[1] - init_pos[1], final_pos[0] - init_pos[0]);
+	float angle = fast_atan2f(final_pos[1] - init_pos[1], final_pos[0] - init_pos[0]);
+	float sinT, cosT;
+	fast_sincosf(angle, &sinT, &cosT);
 
-	vf[0] = cosf(angle) * speed;
-	vf[1] = sinf(angle) * speed;
+	vf[0] = cosT * speed;
+	vf[1] = sinT * speed;
 }
 
 /**
@@ -145,11 +145,11 @@ void PolVel2Cart(float const loc[2], float vel[2]);
 void PolAcc2Cart(float const loc[2], float const vel[2], float const Pacc[2], float Cacc[2]);
 
 void matrix_mult(float* lhs, int lhs_len, const float* rhs, int rhs_len, const float matrix[lhs_len][rhs_len]);
-void matrix_mult_t(float* lhs, int lhs_len, const float* rhs, int rhs_len, const float matrix[lhs_len][rhs_len]);
+void matrix_mult_t(float* lhs, int lhs_len, const float* rhs, int rhs_len, const float matrix[rhs_len][lhs_len]);
 
 void mm_mult(int lm_rows, int rm_rows, int rm_cols, const float lmatrix[lm_rows][rm_rows], const float rmatrix[rm_rows][rm_cols], float matrix_out[lm_rows][rm_cols]);
 
-void mm_mult_t(int lm_rows, int rm_rows, int rm_cols, const float lmatrix[lm_rows][rm_rows], const float rmatrix[rm_rows][rm_cols], float matrix_out[lm_rows][rm_cols]);
+void mm_mult_t(int lm_rows, int rm_rows, int rm_cols, const float lmatrix[lm_rows][rm_cols], const float rmatrix[rm_rows][rm_cols], float matrix_out[lm_rows][rm_rows]);
 
 void mm_copy(int nrows, int ncols, float A[nrows][ncols], float B[nrows][ncols]);
 
@@ -6,6 +6,7 @@
 #include "../leds.h"
 #include "../physics.h"
 #include "../bangbang.h"
+#include "shared_util/radio_units.h"
 #include <math.h>
 #include <stdio.h>
 
@@ -68,9 +69,9 @@ static void accurate_shoot_start(const primitive_params_t *params) {
 
 	global_params = params;
 	// Convert into m/s and rad/s because physics is in m and s
-	destination[0] = ((float) (params->params[0]) / 1000.0f);
-	destination[1] = ((float) (params->params[1]) / 1000.0f);
-	destination[2] = ((float) (params->params[2]) / 100.0f);
+	destination[0] = radio_decode_primitive_length(params->params[0]);
+	destination[1] = radio_decode_primitive_length(params->params[1]);
+	destination[2] = radio_decode_primitive_angle(params->params[2]);
 
 	//get x and y components of major (shooting dir)
 	//and minor (pi/2 from shooting dir) axes
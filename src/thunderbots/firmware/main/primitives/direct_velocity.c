@@ -1,6 +1,7 @@
 #include "direct_velocity.h"
 #include "../control.h"
 #include "../dribbler.h"
+#include "shared_util/radio_units.h"
 
 #include <unused.h>
 
@@ -24,10 +25,10 @@ static void direct_velocity_init(void) {
  * function returns and must be copied into this module if needed
  */
 static void direct_velocity_start(const primitive_params_t *params) {
-	direct_target_velocity[0] = params->params[0] / 1000.0f;
-	direct_target_velocity[1] = params->params[1] / 1000.0f;
-	direct_target_velocity[2] = params->params[2] / 100.0f;
-	dribbler_set_speed((params->extra) * 300);
+	direct_target_velocity[0] = radio_decode_primitive_length(params->params[0]);
+	direct_target_velocity[1] = radio_decode_primitive_length(params->params[1]);
+	direct_target_velocity[2] = radio_decode_primitive_angle(params->params[2]);
+	dribbler_set_speed(radio_decode_dribbler_rpm(params->extra));
 }
 
 /**
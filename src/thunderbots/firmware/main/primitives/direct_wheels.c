@@ -10,6 +10,7 @@
 #include "../dribbler.h"
 #include "../log.h"
 #include "../wheels.h"
+#include "shared_util/radio_units.h"
 #include <unused.h>
 
 
@@ -35,7 +36,7 @@ static void direct_wheels_start(const primitive_params_t *params) {
 	for (unsigned int i = 0; i != WHEELS_NUM_WHEELS; ++i) {
 		wheels_drive(i, params->params[i]);
 	}
-	dribbler_set_speed((params->extra) * 300);
+	dribbler_set_speed(radio_decode_dribbler_rpm(params->extra));
 }
 
 /**
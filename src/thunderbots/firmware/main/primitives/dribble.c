@@ -4,6 +4,7 @@
 #include "../dribbler.h"
 #include "../physics.h"
 #include "../bangbang.h"
+#include "shared_util/radio_units.h"
 #include <stdio.h>
 
 #define DRIBBLE_TIME_HORIZON 0.05f //s
@@ -31,9 +32,9 @@ static void dribble_init(void) {
 	dribble_param.slow = params->slow;
 	dribble_param.extra = params->extra;
 
-	destination[0] = ((float)(params->params[0])/1000.0f);
-	destination[1] = ((float)(params->params[1])/1000.0f);
-	destination[2] = ((float)(params->params[2])/100.0f);
+	destination[0] = radio_decode_primitive_length(params->params[0]);
+	destination[1] = radio_decode_primitive_length(params->params[1]);
+	destination[2] = radio_decode_primitive_angle(params->params[2]);
 	dribbler_set_speed(((unsigned int)(params->params[3])));
 }
 
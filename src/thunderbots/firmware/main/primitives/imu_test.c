@@ -3,6 +3,7 @@
 #include "../control.h"
 #include "../dr.h"
 #include "../physics.h"
+#include "shared_util/radio_units.h"
 #include <math.h>
 #include <stdio.h>
 
@@ -37,9 +38,9 @@ static void imu_test_init(void) {
 // constant angular velocity
 
 static void imu_test_start(const primitive_params_t *params) {
-	x_dest = (float)(params->params[0]/1000.0f);
-	y_dest = (float)(params->params[1]/1000.0f);
-	avel_final = (float)(params->params[2]/100.0f);
+	x_dest = radio_decode_primitive_length(params->params[0]);
+	y_dest = radio_decode_primitive_length(params->params[1]);
+	avel_final = radio_decode_primitive_angle(params->params[2]);
 	slow = params->slow;	
 }
 
@@ -10,6 +10,7 @@
 #include "../bangbang.h"
 #include "../control.h"
 #include "../dr.h"
+#include "../dribbler.h"
 #include "../physics.h"
 #include "../primitives/move.h"
 #include "../breakbeam.h"
@@ -27,7 +28,7 @@
 
 #define X_SPACE_FACTOR (0.002f)
 
-#define TIME_HORIZON (0.01f)
+#define CATCH_TIME_HORIZON (0.01f)
 #define STATIONARY_VEL_MAX (0.05f)
 #define CURR_STATE_UNIT_CONV 1000000
 #define ROBOTRADIUS (0.06f)
@@ -167,7 +168,7 @@ static void catch_tick(log_record_t *log) {
 		float major_vel = major_vec[0]*vel[0] + major_vec[1]*vel[1];
 		PrepareBBTrajectoryMaxV(&major_profile, major_disp, major_vel, end_speed, max_major_a, max_major_v); //3.5, 3.0
 		PlanBBTrajectory(&major_profile);
-		major_accel = BBComputeAvgAccel(&major_profile, TIME_HORIZON);
+		major_accel = BBComputeAvgAccel(&major_profile, CATCH_TIME_HORIZON);
 		float time_major = GetBBTime(&major_profile);
 
 		float max_minor_a = 1;//(get_var(0x02)/4.0);
@@ -176,15 +177,14 @@ static void catch_tick(log_record_t *log) {
 		float minor_vel = minor_vec[0]*vel[0] + minor_vec[1]*vel[1];
 		PrepareBBTrajectoryMaxV(&minor_profile, minor_disp, minor_vel, 0, max_minor_a, max_minor_v); //1.5, 1.5
 		PlanBBTrajectory(&minor_profile);
-		minor_accel = BBComputeAvgAccel(&minor_profile, TIME_HORIZON);
-		float time_minor = GetBBTime(&minor_profile);
+		minor_accel = BBComputeAvgAccel(&minor_profile, CATCH_TIME_HORIZON);
 
 		//timetarget is used for the robot's rotation. It is alwways bigger than 0.1m/s
-		timeTarget = (time_major > TIME_HORIZON) ? time_major : TIME_HORIZON;
+		timeTarget = (time_major > CATCH_TIME_HORIZON) ? time_major : CATCH_TIME_HORIZON;
 
 		//accel[2] is used to find the rotational acceleration
 		float targetVel = 2*relative_destination[2]/timeTarget;
-		accel[2] = (targetVel - vel[2])/TIME_HORIZON;
+		accel[2] = (targetVel - vel[2])/CATCH_TIME_HORIZON;
        }
 	
 	//else statemnet will be executed when the ball is moving faster than 0.05m/s
@@ -206,14 +206,11 @@ static void catch_tick(log_record_t *log) {
 		PrepareBBTrajectoryMaxV(&minor_profile, minor_disp_cur, minor_vel_cur, 0, MAX_X_A, MAX_X_V);
 
 		PlanBBTrajectory(&minor_profile);
-		minor_accel = BBComputeAvgAccel(&minor_profile, TIME_HORIZON);
+		minor_accel = BBComputeAvgAccel(&minor_profile, CATCH_TIME_HORIZON);
 		float time_minor = GetBBTime(&minor_profile);
 
 		// how long it would take to get onto the velocity line with 0 minor vel
-		timeTarget = (time_minor > TIME_HORIZON) ? time_minor : TIME_HORIZON;
-
-		// now calculate where we would want to end up intercepting the ball
-		float ball_pos_proj[2] = {ballpos[0]+ballvel[0]*timeTarget, ballpos[1]+ballvel[1]*timeTarget};
+		timeTarget = (time_minor > CATCH_TIME_HORIZON) ? time_minor : CATCH_TIME_HORIZON;
 
 		// get our major axis distance from where the ball would be by the time we get to the velocity line
 		float major_disp_proj = major_vec[0]*(ballpos[0]-pos[0]) + major_vec[1]*(ballpos[1]-pos[1]);
@@ -230,8 +227,7 @@ static void catch_tick(log_record_t *log) {
 		BBProfile major_profile;
 		PrepareBBTrajectoryMaxV(&major_profile, major_disp_intercept, major_vel, major_vel_intercept, CATCH_MAX_X_V, CATCH_MAX_X_A);
 		PlanBBTrajectory(&major_profile);
-		major_accel = BBComputeAvgAccel(&major_profile, TIME_HORIZON);
-		float time_major = GetBBTime(&major_profile);
+		major_accel = BBComputeAvgAccel(&major_profile, CATCH_TIME_HORIZON);
 
 		major_angle = atan2f(major_vec[1], major_vec[0]);
 		float angle_disp = min_angle_delta(pos[2], major_angle + M_PI);
@@ -250,7 +246,6 @@ static void catch_tick(log_record_t *log) {
 	accel[1] += major_accel*(local_y_norm_vec[0]*major_vec[0] + local_y_norm_vec[1]*major_vec[1] );
 
 	//Apply acceleration to robot
-	accel[3] = 0;
 	limit(&accel[2], MAX_T_A);
     apply_accel(accel, accel[2]); // accel is already in local coords
 }
@@ -2,9 +2,11 @@
 #include "control.h"
 #include "physics.h"
 #include "bangbang.h"
+#include "util/fast_math.h"
 #include "util/physbot.h"
 #include "shared_util/robot_constants.h"
 #include "shared_util/constants.h"
+#include "shared_util/radio_units.h"
 #include "util/log.h"
 #include "util/util.h"
 #include <math.h>
@@ -58,7 +60,7 @@ static void build_wheel_axes(float angle) {
 unsigned choose_wheel_axis(float dx, float dy, float current_angle, float final_angle) {
 	build_wheel_axes(current_angle);
 	// the angle on the global axis corresponding to the bot's movement
-	float theta_norm = atan2f(dy, dx);
+	float theta_norm = fast_atan2f(dy, dx);
 	// initialize a variable to store the minimum rotation
 	float minimum_rotation = 2 * P_PI;
 	// the index that corresponds to the minimum rotation
@@ -69,7 +71,7 @@ unsigned choose_wheel_axis(float dx, float dy, float current_angle, float final_
 	for (i = 0; i < 2 * NUMBER_OF_WHEELS; i++) {
 		float relative_angle_to_movement = min_angle_delta(wheel_axes[i], theta_norm);
 		float initial_rotation = current_angle + relative_angle_to_movement;
-		float abs_final_rotation = fabs(min_angle_delta(initial_rotation, final_angle));
+		float abs_final_rotation = fabsf(min_angle_delta(initial_rotation, final_angle));
 		// if we have found a smaller angle, then update the minimum rotation
 		// and chosen index
 		if (abs_final_rotation < minimum_rotation) {
@@ -95,9 +97,9 @@ unsigned choose_wheel_axis(float dx, float dy, float current_angle, float final_
 void choose_rotation_destination(PhysBot *pb, float angle) {
 	// if we are close enough then we should just allow the bot to rotate
 	// onto its destination angle, so skip this if block
-	if ((float) fabs(pb->maj.disp) > APPROACH_LIMIT) {
+	if (fabsf(pb->maj.disp) > APPROACH_LIMIT) {
 		build_wheel_axes(angle);
-		float theta_norm = atan2f(pb->dr[1], pb->dr[0]);
+		float theta_norm = fast_atan2f(pb->dr[1], pb->dr[0]);
 		// use the pre-determined wheel axis 
 		pb->rot.disp = min_angle_delta(wheel_axes[wheel_index], theta_norm);
 	}
@@ -160,11 +162,10 @@ static void move_start(const primitive_params_t *params)
 	//				end_speed [millimeter/s]
   
 	// Convert into m/s and rad/s because physics is in m and s
-	printf("Move start called.\n");
-	destination[0] = (float) (params->params[0]) / 1000.0f;
-	destination[1] = (float) (params->params[1]) / 1000.0f;
-	destination[2] = (float) (params->params[2]) / 100.0f;
-	end_speed = (float) (params->params[3]) / 1000.0f;
+	destination[0] = radio_decode_primitive_length(params->params[0]);
+	destination[1] = radio_decode_primitive_length(params->params[1]);
+	destination[2] = radio_decode_primitive_angle(params->params[2]);
+	end_speed = radio_decode_primitive_length(params->params[3]);
 	slow = params->slow;
 
 	
@@ -173,7 +174,7 @@ static void move_start(const primitive_params_t *params)
 	
 	float dx = destination[0] - current_states.x;
 	float dy = destination[1] - current_states.y;
-	float total_disp = sqrtf(dx * dx + dy * dy);	
+	float total_disp = fast_sqrtf(dx * dx + dy * dy);	
 	major_vec[0] = dx / total_disp; 
 	major_vec[1] = dy / total_disp;
 	minor_vec[0] = major_vec[0];
@@ -183,9 +184,11 @@ static void move_start(const primitive_params_t *params)
 	// pick the wheel axis that will be used for faster movement
 	wheel_index = choose_wheel_axis(dx, dy, current_states.angle, destination[2]);
 
+#ifndef FWSIM
     if(params->extra & 0x01) chicker_auto_arm(CHICKER_KICK, BALL_MAX_SPEED_METERS_PER_SECOND-1);
 	if(params->extra & 0x02) dribbler_set_speed(16000);
     if(params->extra & 0x04) chicker_auto_arm(CHICKER_CHIP, 2);
+#endif
 }
 
 /**
@@ -198,8 +201,10 @@ static void move_start(const primitive_params_t *params)
  */
 static void move_end(void) 
 {
+#ifndef FWSIM
 	chicker_auto_disarm();
     dribbler_set_speed(0);
+#endif
 }
 
 
@@ -213,7 +218,6 @@ static void move_end(void)
  * @return void 
  */
 static void move_tick(log_record_t *log) {
-	printf("Move tick called.\n");
 	// get the state of the bot
 	dr_data_t current_states;
 	dr_get(&current_states);
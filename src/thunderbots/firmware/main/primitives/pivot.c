@@ -3,6 +3,7 @@
 #include "control.h"
 #include "dr.h"
 #include "physics.h"
+#include "shared_util/radio_units.h"
 
 #ifndef FWSIM
 #include "dr.h"
@@ -18,11 +19,9 @@
 #define STOPPED 0 
 #define TRUE 1
 #define FWSIM_CONST 1.0f
-#define THRESH 0.05f
 #define MAX_A 2.5f
 #define MAX_V 2.5f
 #define END_SPEED 1.5f
-#define WITHIN_THRESH(X) (X<=THRESH && X>=-THRESH)
 
 static float radius, speed, angle, center[2], final_dest[2]; 
 static int dir = 1;
@@ -60,35 +59,26 @@ float compute_magnitude(float a[2]){
  * optimal direction and final position needs to be recalculated
  */
 static void pivot_start(const primitive_params_t *params) {
-    center[0] = params->params[0] / 1000.0;
-    center[1] = params->params[1] / 1000.0;
-    angle = params->params[2] / 100.0;
-    speed = params->params[3] / 100.0;
+    center[0] = radio_decode_primitive_length(params->params[0]);
+    center[1] = radio_decode_primitive_length(params->params[1]);
+    angle = radio_decode_primitive_angle(params->params[2]);
+    speed = radio_decode_primitive_angle(params->params[3]);
 
+#ifndef FWSIM
     if(params->extra & 0x01) dribbler_set_speed(16000);
+#endif
 
     radius = 0.15; // ball radius + robot radius + buffer
 
     dr_data_t current_bot_state;
     dr_get(&current_bot_state);
 
-    float rel_dest[2] = {center[0]-current_bot_state.x, center[1]-current_bot_state.y};
-    float cur_radius = compute_magnitude(rel_dest);
-
-    rel_dest[0]/=cur_radius;
-    rel_dest[1]/=cur_radius;
-
     final_dest[0] = center[0] + radius * cosf(angle);
     final_dest[1] = center[1] + radius * sinf(angle);
 
-    //find the general direction to travel, project those onto the two possible directions and see which one is better
-    float general_dir[2] = {final_dest[0] - current_bot_state.x, final_dest[1] - current_bot_state.y};
-    float tangential_dir_1[2] = {rel_dest[1]/cur_radius,-rel_dest[0]/cur_radius};
-    float tangential_dir_2[2] = {-rel_dest[1]/cur_radius,rel_dest[0]/cur_radius};
-    float dir1 = dot_product(general_dir, tangential_dir_1,2);
-    float dir2 = dot_product(general_dir, tangential_dir_2,2);
-
-    dir = (dir1 >= dir2) ? -1 : 1;
+    //orbit whichever way round the centre is shorter; dir is -1 for counterclockwise
+    float start_angle = atan2f(current_bot_state.y - center[1], current_bot_state.x - center[0]);
+    dir = (min_angle_delta(start_angle, angle) >= 0) ? -1 : 1;
 }
 
 
@@ -136,19 +126,18 @@ static void pivot_tick(log_record_t *log) {
     //if correction is negative, bot is closer to ball so it needs to move away, so negative 
     float correction = cur_radius - radius;
 
-    float end_goal_vect[2] = {final_dest[0]-current_bot_state.x, final_dest[1]-current_bot_state.y};
-    float disp_to_final_dest = compute_magnitude(end_goal_vect);
-
-    if(WITHIN_THRESH(disp_to_final_dest)){
-        disp_to_final_dest = 0; 
-    }
+    //arc length left to the final position, measured along tangential_dir so it goes negative past the end
+    float cur_angle = atan2f(-rel_dest[1], -rel_dest[0]);
+    float disp_to_final_dest = -dir * min_angle_delta(cur_angle, angle) * radius;
 
     //figure out all velocities in prioritized directions
     float current_rot_vel = dot_product(tangential_dir,vel,2);
     float current_cor_vel = dot_product(radial_dir,vel,2);
 
     float mag_accel_orbital = speed*compute_acceleration(&rotation_profile, disp_to_final_dest, current_rot_vel, STOPPED, MAX_A, MAX_V);
-    float mag_accel_correction = compute_acceleration(&correction_profile, correction, current_cor_vel, STOPPED, MAX_A, MAX_V);
+    //staying on the circle takes the centripetal acceleration on top of the correction
+    float mag_accel_correction = compute_acceleration(&correction_profile, correction, current_cor_vel, STOPPED, MAX_A, MAX_V)
+        + current_rot_vel * current_rot_vel / cur_radius;
 
     //create the local vectors to the bot
     float local_x_norm_vec[2] = {cosf(current_bot_state.angle), sinf(current_bot_state.angle)}; 
@@ -157,13 +146,10 @@ static void pivot_tick(log_record_t *log) {
     //add the 3 directions together
     float accel[3] = {0};
 
-    //accel[0] = mag_accel_correction * dot_product(radial_dir, local_x_norm_vec, 2);
-    //accel[1] = mag_accel_correction * dot_product(radial_dir, local_y_norm_vec, 2);
-
-//    if(WITHIN_THRESH(correction)){
-         accel[0] = mag_accel_orbital * dot_product(tangential_dir, local_x_norm_vec, 2);
-         accel[1] = mag_accel_orbital * dot_product(tangential_dir, local_y_norm_vec, 2);
-  //  }
+    accel[0] = mag_accel_correction * dot_product(radial_dir, local_x_norm_vec, 2)
+        + mag_accel_orbital * dot_product(tangential_dir, local_x_norm_vec, 2);
+    accel[1] = mag_accel_correction * dot_product(radial_dir, local_y_norm_vec, 2)
+        + mag_accel_orbital * dot_product(tangential_dir, local_y_norm_vec, 2);
 
     //find the angle between what the bot currently is at, and the angle to face the destination
     float angle = min_angle_delta(current_bot_state.angle, atan2f(rel_dest[1], rel_dest[0]));
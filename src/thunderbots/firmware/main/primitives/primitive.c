@@ -17,6 +17,7 @@
 #include "chicker.h"
 #include "dr.h"
 #include "dribbler.h"
+#include "profile.h"
 #include "receive.h"
 #include <assert.h>
 #include <stdint.h>
@@ -127,11 +128,14 @@ void primitive_tick(log_record_t *log) {
 		log->tick.primitive = (uint8_t)primitive_current_index;
 	}
 #endif // FWSIM
+	uint32_t t = profile_now();
 	if (primitive_current) {
 		primitive_current->tick(log);
 	}
+	t = profile_end(PROFILE_MODULE_PRIMITIVE, t);
 #ifndef FWSIM
 	dr_tick(log);
+	profile_end(PROFILE_MODULE_DR, t);
 	xSemaphoreGive(primitive_mutex);
 #endif // FWSIM
 }
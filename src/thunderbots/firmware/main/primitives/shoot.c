@@ -8,6 +8,7 @@
 #include <util/physbot.h>
 #include "util/physbot.h"
 #include "util/log.h"
+#include "shared_util/radio_units.h"
 
 #ifndef FWSIM
 #include "chicker.h"
@@ -123,11 +124,10 @@ static void shoot_init(void) {
  */
 static void shoot_start(const primitive_params_t *params) {
 
-    printf("Shoot start called.\n");
     // Convert into m/s and rad/s because physics is in m and s
-    destination[0] = ((float) (params->params[0]) / 1000.0f);
-    destination[1] = ((float) (params->params[1]) / 1000.0f);
-    destination[2] = ((float) (params->params[2]) / 100.0f);
+    destination[0] = radio_decode_primitive_length(params->params[0]);
+    destination[1] = radio_decode_primitive_length(params->params[1]);
+    destination[2] = radio_decode_primitive_angle(params->params[2]);
 
 
     // cosine and sine of orientation angle to global x axis
@@ -140,18 +140,20 @@ static void shoot_start(const primitive_params_t *params) {
     dr_data_t states;
     dr_get(&states);
     total_rot = min_angle_delta(destination[2], states.angle);
-    float shoot_power = (float) params->params[3]/1000.0f;
 	chip = params->extra & 1;
+    shoot_power = radio_decode_primitive_length(params->params[3]);
+#ifndef FWSIM
     chicker_auto_arm( chip ? CHICKER_CHIP : CHICKER_KICK, shoot_power);
+#endif
 }
 
 /**
  * \brief Ends a movement of this type.
  *
 	// Convert into m/s and rad/s because physics is in m and s
-	destination[0] = ((float) (params->params[0]) / 1000.0f);
-	destination[1] = ((float) (params->params[1]) / 1000.0f);
-	destination[2] = ((float) (params->params[2]) / 100.0f);
+	destination[0] = radio_decode_primitive_length(params->params[0]);
+	destination[1] = radio_decode_primitive_length(params->params[1]);
+	destination[2] = radio_decode_primitive_angle(params->params[2]);
 
 
 	// cosine and sine of orientation angle to global x axis
@@ -178,7 +180,6 @@ static void shoot_end(void) {
  * \c NULL if no record is to be filled
  */
 static void shoot_tick(log_record_t *log) {
-    printf("Shoot tick called.\n");
     dr_data_t states;
     dr_get(&states);
     PhysBot pb = setup_bot(states, destination, major_vec, minor_vec);
@@ -195,7 +196,7 @@ static void shoot_tick(log_record_t *log) {
     scale(&pb);
     to_local_coords(accel, pb, states.angle, major_vec, minor_vec);
     apply_accel(accel, accel[2]);
-#ifndef FWSIm
+#ifndef FWSIM
     if (log) { to_log(log, pb.rot.time, accel); }
 #endif
 /*
@@ -2,6 +2,8 @@
 #include "bangbang.h"
 #include "control.h"
 #include "physics.h"
+#include "util/fast_math.h"
+#include "shared_util/radio_units.h"
 #include <math.h>
 #include <stdio.h>
 
@@ -50,10 +52,10 @@ static void spin_start(const primitive_params_t *p) {
     //              param[3]: g_end_speed       [millimeter/s]
 
     // Parse the parameters with the standard units
-    x_final = (float)p->params[0] / 1000.0f;
-    y_final = (float)p->params[1] / 1000.0f;
-    avel_final = (float)p->params[2] / 100.0f;
-    end_speed = (float)p->params[3] / 1000.0f;
+    x_final = radio_decode_primitive_length(p->params[0]);
+    y_final = radio_decode_primitive_length(p->params[1]);
+    avel_final = radio_decode_primitive_angle(p->params[2]);
+    end_speed = radio_decode_primitive_length(p->params[3]);
     slow = p->slow;
 
     // Get robot current data
@@ -73,7 +75,7 @@ static void spin_start(const primitive_params_t *p) {
     minor_vec[1] = major_vec[0];
 
     // major angle - angle relative to global x
-    major_angle = atan2f(major_vec[1], major_vec[0]);
+    major_angle = fast_atan2f(major_vec[1], major_vec[0]);
 }
 
 /**
@@ -136,13 +138,15 @@ dr_data_t now;
     }
 
     // Local cartesian represented as global cartesian
+    float sin_angle, cos_angle;
+    fast_sincosf(now.angle, &sin_angle, &cos_angle);
     float local_x_vec[2] = {
-        cosf(now.angle), 
-        sinf(now.angle)
+        cos_angle, 
+        sin_angle
     };
     float local_y_vec[2] = {
-        -sinf(now.angle),
-        cosf(now.angle)
+        -sin_angle,
+        cos_angle
     };
 
     // Get local x acceleration
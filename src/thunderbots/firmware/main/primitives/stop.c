@@ -6,11 +6,13 @@
  * @{
  */
 #include "stop.h"
+#ifndef FWSIM
 #include "dr.h"
 #include "dribbler.h"
 #include "wheels.h"
-#ifndef FWSIM
 #include <unused.h>
+#else
+#include "simulate.h"
 #endif // FWSIM
 /**
  * \brief Initializes the stop primitive.
@@ -31,6 +33,12 @@ static void stop_init(void) {
  * function returns and must be copied into this module if needed
  */
 static void stop_start(const primitive_params_t *params) {
+#ifdef FWSIM
+	// The simulated wheels have no back-EMF, so braking and coasting both just
+	// stop driving them.
+	const float no_force[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+	sim_apply_wheel_force(no_force);
+#else
 	for (unsigned int i = 0; i != 4; ++i) {
 		if (params->extra) {
 			wheels_brake(i);
@@ -41,6 +49,7 @@ static void stop_start(const primitive_params_t *params) {
 	if (!params->extra) {
 		dribbler_coast();
 	}
+#endif
 }
 
 /**
@@ -0,0 +1,215 @@
+/**
+ * \defgroup PROFILE CPU Profiling Functions
+ *
+ * \brief These functions measure how much of the tick budget each module uses.
+ *
+ * Each module’s tick is timed with the DWT cycle counter, which costs a single
+ * load per measurement. A tick consumer is timed by taking \ref profile_now
+ * before it and passing the result to \ref profile_end after it. Since
+ * \ref profile_end returns the time at which it was called, consecutive
+ * consumers can be timed with one counter read each:
+ *
+ * \code
+ * uint32_t t = profile_now();
+ * feedback_tick();
+ * t = profile_end(PROFILE_MODULE_FEEDBACK, t);
+ * receive_tick(record);
+ * t = profile_end(PROFILE_MODULE_RECEIVE, t);
+ * \endcode
+ *
+ * The minimum, mean, and maximum of each module are accumulated over a window
+ * of \ref PROFILE_WINDOW_TICKS normal ticks, which the normal tick then logs
+ * and hands to the feedback task with \ref profile_read_clear.
+ *
+ * Time spent in interrupts that preempt a module is counted against that
+ * module, so the fast tick shows up in every module’s maximum.
+ *
+ * On the host, the same calls read \c CLOCK_MONOTONIC instead, so the
+ * instrumentation works unchanged in the simulator and unit tests.
+ *
+ * \{
+ */
+
+#include "profile.h"
+#include <stddef.h>
+#if defined(FWSIM) || defined(FWTEST)
+#include <time.h>
+#else
+#include <FreeRTOS.h>
+#include <task.h>
+#include <registers/dwt.h>
+#include <registers/scb.h>
+#endif
+
+/**
+ * \brief The running totals for one module over the current window.
+ */
+typedef struct {
+	uint32_t min;
+	uint32_t max;
+	uint32_t count;
+	uint64_t sum;
+} accumulator_t;
+
+static accumulator_t accumulators[PROFILE_MODULE_COUNT];
+static log_profile_t latest;
+static bool latest_valid = false;
+
+static void clear_accumulator(accumulator_t *accumulator) {
+	accumulator->min = UINT32_MAX;
+	accumulator->max = 0U;
+	accumulator->count = 0U;
+	accumulator->sum = 0U;
+}
+
+#if defined(FWSIM) || defined(FWTEST)
+static uint32_t disable_interrupts(void) {
+	return 0U;
+}
+
+static void restore_interrupts(uint32_t primask) {
+	(void) primask;
+}
+#else
+/**
+ * \brief Masks all interrupts, including the fast tick, which runs above the
+ * priority that FreeRTOS critical sections mask.
+ *
+ * \return the previous interrupt mask, to pass to \ref restore_interrupts
+ */
+static uint32_t disable_interrupts(void) {
+	uint32_t primask;
+	asm volatile("mrs %0, primask\n\tcpsid i" : "=r"(primask) :: "memory");
+	return primask;
+}
+
+static void restore_interrupts(uint32_t primask) {
+	asm volatile("msr primask, %0" :: "r"(primask) : "memory");
+}
+#endif
+
+/**
+ * \brief Starts the cycle counter and clears the accumulated times.
+ */
+void profile_init(void) {
+#if !defined(FWSIM) && !defined(FWTEST)
+	DEBUG.DEMCR.TRCENA = 1;
+	DWT.CYCCNT = 0U;
+	DWT.CTRL.CYCCNTENA = 1;
+#endif
+	for (size_t i = 0U; i != PROFILE_MODULE_COUNT; ++i) {
+		clear_accumulator(&accumulators[i]);
+	}
+	latest_valid = false;
+}
+
+/**
+ * \brief Reads the profile counter.
+ *
+ * The counter wraps, so only the difference between two readings is
+ * meaningful.
+ *
+ * \return the current count
+ */
+uint32_t profile_now(void) {
+#if defined(FWSIM) || defined(FWTEST)
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint32_t) ((uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec);
+#else
+	return DWT.CYCCNT;
+#endif
+}
+
+/**
+ * \brief Records one tick of a module.
+ *
+ * A module must only be recorded from one context, either a single task or a
+ * single interrupt service routine.
+ *
+ * \param[in] module the module that ticked
+ * \param[in] start the count from \ref profile_now when the tick started
+ * \return the count when this function was called, which can be used as the
+ * start of the next module’s tick
+ */
+uint32_t profile_end(profile_module_t module, uint32_t start) {
+	uint32_t now = profile_now();
+	uint32_t elapsed = now - start;
+	accumulator_t *accumulator = &accumulators[module];
+	if (elapsed < accumulator->min) {
+		accumulator->min = elapsed;
+	}
+	if (elapsed > accumulator->max) {
+		accumulator->max = elapsed;
+	}
+	++accumulator->count;
+	accumulator->sum += elapsed;
+	return now;
+}
+
+/**
+ * \brief Reads the times accumulated since the last call and starts a new
+ * window.
+ *
+ * This must be called from the normal tick, which owns the accumulators of
+ * every module but the fast tick.
+ *
+ * \param[out] profile the times of each module over the window that just ended
+ */
+void profile_read_clear(log_profile_t *profile) {
+	for (size_t i = 0U; i != PROFILE_MODULE_COUNT; ++i) {
+		// The fast tick can preempt us, so take a consistent copy of its
+		// accumulator, as well as everything else, with it masked.
+		uint32_t primask = disable_interrupts();
+		accumulator_t accumulator = accumulators[i];
+		clear_accumulator(&accumulators[i]);
+		restore_interrupts(primask);
+
+		if (accumulator.count) {
+			profile->min[i] = accumulator.min;
+			profile->mean[i] = (uint32_t) (accumulator.sum / accumulator.count);
+			profile->max[i] = accumulator.max;
+		} else {
+			profile->min[i] = profile->mean[i] = profile->max[i] = 0U;
+		}
+		if (i == PROFILE_MODULE_NORMAL_TICK) {
+			profile->ticks = accumulator.count;
+		}
+	}
+
+#if !defined(FWSIM) && !defined(FWTEST)
+	taskENTER_CRITICAL();
+#endif
+	latest = *profile;
+	latest_valid = true;
+#if !defined(FWSIM) && !defined(FWTEST)
+	taskEXIT_CRITICAL();
+#endif
+}
+
+/**
+ * \brief Reads the times from the most recently completed window.
+ *
+ * This may be called from any task.
+ *
+ * \param[out] profile the times of each module over the window
+ * \retval true a window has completed and \p profile was filled
+ * \retval false no window has completed yet
+ */
+bool profile_latest(log_profile_t *profile) {
+#if !defined(FWSIM) && !defined(FWTEST)
+	taskENTER_CRITICAL();
+#endif
+	bool valid = latest_valid;
+	if (valid) {
+		*profile = latest;
+	}
+#if !defined(FWSIM) && !defined(FWTEST)
+	taskEXIT_CRITICAL();
+#endif
+	return valid;
+}
+
+/**
+ * \}
+ */
@@ -0,0 +1,108 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * \ingroup PROFILE
+ *
+ * \brief Applies a macro to every module whose tick is timed, in the order
+ * they are stored in a \ref log_profile_t.
+ *
+ * This lets the host-side tools name the modules without keeping their own
+ * copy of the list.
+ */
+#define PROFILE_MODULES(X) \
+	X(FEEDBACK, feedback) \
+	X(RECEIVE, receive) \
+	X(ADC, adc) \
+	X(LEDS, leds) \
+	X(BREAKBEAM, breakbeam) \
+	X(LPS, lps) \
+	X(HALL, hall) \
+	X(ENCODER, encoder) \
+	X(PRIMITIVE, primitive) \
+	X(DR, dr) \
+	X(WHEELS, wheels) \
+	X(DRIBBLER, dribbler) \
+	X(CHARGER, charger) \
+	X(CHICKER, chicker) \
+	X(MOTOR, motor) \
+	X(NORMAL_TICK, normal_tick) \
+	X(FAST_TICK, fast_tick)
+
+/**
+ * \ingroup PROFILE
+ *
+ * \brief The modules whose tick is timed.
+ *
+ * \ref PROFILE_MODULE_NORMAL_TICK and \ref PROFILE_MODULE_FAST_TICK time the
+ * whole of each tick, including the modules run in them and the profiling
+ * itself.
+ */
+typedef enum {
+#define PROFILE_MODULE_ENUM(name, lower) PROFILE_MODULE_##name,
+	PROFILE_MODULES(PROFILE_MODULE_ENUM)
+#undef PROFILE_MODULE_ENUM
+	PROFILE_MODULE_COUNT, ///< The number of modules.
+} profile_module_t;
+
+/**
+ * \ingroup PROFILE
+ *
+ * \brief The number of profile counts in one microsecond.
+ *
+ * On the robot the counts are CPU cycles. On the host, where there is no cycle
+ * counter to read, they are nanoseconds.
+ */
+#if defined(FWSIM) || defined(FWTEST)
+#define PROFILE_COUNTS_PER_US 1000U
+#else
+#define PROFILE_COUNTS_PER_US 168U
+#endif
+
+/**
+ * \ingroup PROFILE
+ *
+ * \brief The number of normal ticks in each profiling window.
+ */
+#define PROFILE_WINDOW_TICKS 200U
+
+/**
+ * \ingroup PROFILE
+ *
+ * \brief The time each module took to tick over one profiling window, in
+ * profile counts.
+ *
+ * A module that did not tick during the window has all its times set to zero.
+ */
+typedef struct __attribute__((packed)) {
+	/**
+	 * \brief The number of normal ticks in the window.
+	 */
+	uint32_t ticks;
+
+	/**
+	 * \brief The shortest tick of each module.
+	 */
+	uint32_t min[PROFILE_MODULE_COUNT];
+
+	/**
+	 * \brief The mean tick of each module.
+	 */
+	uint32_t mean[PROFILE_MODULE_COUNT];
+
+	/**
+	 * \brief The longest tick of each module.
+	 */
+	uint32_t max[PROFILE_MODULE_COUNT];
+} log_profile_t;
+
+void profile_init(void);
+uint32_t profile_now(void);
+uint32_t profile_end(profile_module_t module, uint32_t start);
+void profile_read_clear(log_profile_t *profile);
+bool profile_latest(log_profile_t *profile);
+
+#endif
@@ -4,19 +4,32 @@
  *
  * \brief These functions handle receiving radio packets and acting on them.
  *
- * For drive packets, each received packet is decoded, and the most recent data is made available for the tick functions elsewhere to act on.
- * Also, a drive packet that requests feedback immediately notifies the feedback module.
+ * The radio receives each frame straight into a free buffer in a ring (see \ref RX_RING), without copying it.
+ * The receive task checks the frame’s header where it lies and acts immediately only on what cannot wait for the tick:
+ * a drive packet that requests feedback immediately notifies the feedback module, and message packets take the action they require.
+ * Drive, camera, and capacitor packets are then handed through the ring to the normal tick, which reads them in place (see \ref RX_FRAME) and applies them just before the primitive runs.
+ * The handoff takes no locks, so neither task ever waits for the other, and everything a drive packet changes is only touched by the tick.
  *
- * For message packets, the action required by the packet is taken immediately.
+ * Under FWSIM, only drive packets are handled, and the host passes each frame
+ * to \ref receive_frame and calls \ref receive_tick from the one thread that
+ * runs the simulated robot.
  *
  * \{
  */
 
 #include "receive.h"
+#include "primitives/primitive.h"
+#include "physics.h"
+#include "rx_frame.h"
+#include "rx_ring.h"
+#include "tbuf.h"
+#include <assert.h>
+#include <stdio.h>
+#ifndef FWSIM
 #include "charger.h"
 #include "chicker.h"
 #include "dma.h"
-#include "dr.h"            
+#include "dr.h"
 #include "feedback.h"
 #include "leds.h"
 #include "main.h"
@@ -24,87 +37,221 @@
 #include "mrf.h"
 #include "priority.h"
 #include "rtc.h"
-#include "primitives/primitive.h"
-#include "physics.h"
 #include <FreeRTOS.h>
-#include <assert.h>
 #include <semphr.h>
 #include <stack.h>
 #include <task.h>
 #include <unused.h>
-#include <stdio.h>
+#else
+#include <string.h>
 
 /**
- * \brief The number of robots in the drive packet.
+ * \brief The type of a count of system ticks.
+ *
+ * The simulated robot has no scheduler, so the receiver counts the ticks
+ * itself in \ref receive_tick, which is called once per system tick.
  */
-#define NUM_ROBOTS 8
+typedef uint32_t TickType_t;
 
 /**
- * \brief The number of bytes of drive packet data per robot.
+ * \brief The length of a system tick, in milliseconds.
  */
-#define RECEIVE_DRIVE_BYTES_PER_ROBOT 9
+#define portTICK_PERIOD_MS (1000U / CONTROL_LOOP_HZ)
+
+static TickType_t sim_tick_count;
 
 /**
- * \brief The number of bytes of camera data per robot.
+ * \brief Returns the number of system ticks since the simulated robot started.
  */
-#define CAMERA_BYTES_PER_ROBOT 6
+#define xTaskGetTickCount() sim_tick_count
+#endif // FWSIM
 
 /**
- * \brief The minimum number of bytes in a camera frame.
+ * \brief The message purpose of a packet setting the capacitor bits.
  */
-#define CAMERA_MIN_BYTES 1 /*Mask*/ + 1 /*Flag*/ + 0 /*Ball Data*/ + 0 /*Robot Data*/ + 8 /*Timestamp*/ + 1 /*Status*/
+#define MESSAGE_PURPOSE_CAPACITOR 0x0EU
 
-static unsigned int robot_index;
-static uint8_t *dma_buffer;
-static SemaphoreHandle_t drive_mtx;
-static unsigned int timeout_ticks;
-static uint8_t last_serial = 0xFF;
+#ifndef FWSIM
+/**
+ * \brief The vision data from the most recent compact camera keyframe.
+ *
+ * Compact camera deltas are relative to this keyframe, and are only applied if they
+ * have the same keyframe id.
+ */
+static struct {
+	bool valid;
+	uint8_t id;
+	bool contains_robot;
+	int16_t robot_x;
+	int16_t robot_y;
+	int16_t robot_angle;
+	uint64_t timestamp;
+} compact_camera_keyframe;
+
+/**
+ * \brief The buffer the radio receives into when the ring is full, so message
+ * packets are still acted on while the tick has fallen behind.
+ */
+static uint8_t *overflow_buffer;
 static const size_t HEADER_LENGTH = 2U /* Frame control */ + 1U /* Seq# */ + 2U /* Dest PAN */ + 2U /* Dest */ + 2U /* Src */;
 static const size_t FOOTER_LENGTH = 2U /* FCS */ + 1U /* RSSI */ + 1U /* LQI */;
-static const size_t DRIVE_BODY_LENGTH = 1 /*msg purpose*/ + NUM_ROBOTS * RECEIVE_DRIVE_BYTES_PER_ROBOT + 1 /*estop */;
 static const int16_t MESSAGE_PURPOSE_ADDR = 2U /* Frame control */ + 1U /* Seq# */ + 2U /* Dest PAN */ + 2U /* Dest */ + 2U /* Src */;
 static const uint16_t MESSAGE_PAYLOAD_ADDR = 2U /* Frame control */ + 1U /* Seq# */ + 2U /* Dest PAN */ + 2U /* Dest */ + 2U /* Src */ + 1U /* Msg Purpose*/;
+#endif // FWSIM
 
-static void receive_task(void *UNUSED(param)) {
-	uint16_t last_sequence_number = 0xFFFFU;
-	size_t frame_length;
-
-	while ((frame_length = mrf_receive(dma_buffer))) {
-
-		uint16_t frame_control = dma_buffer[0U] | (dma_buffer[1U] << 8U);
-		// Sanity-check the frame control word
-		if (((frame_control >> 0U) & 7U) == 1U /* Data packet */ && ((frame_control >> 3U) & 1U) == 0U /* No security */ && ((frame_control >> 6U) & 1U) == 1U /* Intra-PAN */ && ((frame_control >> 10U) & 3U) == 2U /* 16-bit destination address */ && ((frame_control >> 14U) & 3U) == 2U /* 16-bit source address */) {
-			// Read out and check the source address and sequence number
-			uint16_t source_address = dma_buffer[7U] | (dma_buffer[8U] << 8U);
-			uint8_t sequence_number = dma_buffer[2U];
-			if (source_address == 0x0100U && sequence_number != last_sequence_number) {
-				// Update sequence number
-				last_sequence_number = sequence_number;
-
-				// Handle packet
-				uint16_t dest_address = dma_buffer[5U] | (dma_buffer[6U] << 8U);
-				if (dest_address == 0xFFFFU) {
-					// Broadcast frame must contain a camera packet or drive packet
-					// Note that camera packets have a variable length.          
-					if (dma_buffer[MESSAGE_PURPOSE_ADDR] == 0x0FU) {
-						handle_drive_packet(dma_buffer);
-					}else if(dma_buffer[MESSAGE_PURPOSE_ADDR] == 0x10U){
-						uint8_t buffer_position = MESSAGE_PAYLOAD_ADDR; 
-						handle_camera_packet(dma_buffer, buffer_position);
-					}
-				}
-				// Otherwise, it is a message packet specific to this robot.
-				else if (frame_length >= HEADER_LENGTH + 1U + FOOTER_LENGTH) {
-					handle_other_packet(dma_buffer, frame_length);
-				}
+/**
+ * \brief The frames passed from the receive task to the tick.
+ */
+static rx_ring_t rx_ring;
+static unsigned int robot_index;
+static unsigned int timeout_ticks;
+static uint8_t last_serial = 0xFF;
+static uint16_t last_sequence_number = 0xFFFFU;
+
+/**
+ * \brief The most recently applied drive data, as reported in feedback.
+ */
+typedef struct {
+	uint8_t serial;
+	TickType_t ticks;
+} applied_drive_t;
+
+/**
+ * \brief The applied drive data, passed from the tick to the feedback task
+ * through a triple buffer so neither waits for the other.
+ */
+static applied_drive_t applied_drives[3U] = {
+	{ .serial = 0xFF, .ticks = 0U },
+	{ .serial = 0xFF, .ticks = 0U },
+	{ .serial = 0xFF, .ticks = 0U },
+};
+static tbuf_t applied_drive_ctl = TBUF_INIT;
+
+static void handle_drive_packet(const rx_frame_drive_t *drive);
+#ifndef FWSIM
+static void handle_camera_packet(const uint8_t *frame, size_t frame_length);
+static void handle_compact_camera_packet(const uint8_t *frame, size_t frame_length);
+static void handle_other_packet(const uint8_t *dma_buffer, size_t frame_length);
+#endif // FWSIM
+
+/**
+ * \brief Checks a frame the radio has just received, in the receive task.
+ *
+ * Frames that are not data frames from the dongle, and frames repeating the
+ * sequence number of the frame before them, are dropped. Message packets for
+ * this robot are acted on immediately.
+ *
+ * \param[in] frame the frame, starting with the frame control word
+ * \param[in] frame_length the length of the frame, including the FCS, RSSI and
+ * LQI at the end
+ * \retval true the frame should be handed to the tick
+ * \retval false the frame has been dealt with
+ */
+static bool accept_frame(const uint8_t *frame, size_t frame_length) {
+	// Check the header, source address, and sequence number
+	const rx_frame_header_t *header = rx_frame_check(frame, frame_length);
+	if (!header || header->sequence_number == last_sequence_number) {
+		return false;
+	}
+	last_sequence_number = header->sequence_number;
+
+	if (header->destination_address == RX_FRAME_BROADCAST_ADDRESS) {
+		// Broadcast frame must contain a camera packet or drive packet, which
+		// the tick handles.
+#ifndef FWSIM
+		// The dongle waits for feedback right after the drive packet that
+		// asks for it, so don't wait for the tick to send it.
+		const rx_frame_drive_t *drive = rx_frame_drive(frame, frame_length);
+		if (drive && (drive->robots[robot_index].serial & RX_FRAME_DRIVE_FEEDBACK_REQUEST)) {
+			feedback_pend_normal();
+		}
+#endif // FWSIM
+		return true;
+	}
+#ifndef FWSIM
+	// Otherwise, it is a message packet specific to this robot.
+	if (header->purpose == MESSAGE_PURPOSE_CAPACITOR) {
+		return true;
+	}
+	handle_other_packet(frame, frame_length);
+#endif // FWSIM
+	return false;
+}
+
+/**
+ * \brief Acts on a frame handed over by the receive task, in the tick.
+ *
+ * \param[in] frame the frame, which has passed \ref accept_frame
+ * \param[in] frame_length the length of the frame, including the FCS, RSSI and
+ * LQI at the end
+ */
+static void handle_frame(const uint8_t *frame, size_t frame_length) {
+	const rx_frame_header_t *header = (const rx_frame_header_t *) frame;
+	if (header->destination_address == RX_FRAME_BROADCAST_ADDRESS) {
+		// Note that camera packets have a variable length.
+		if (header->purpose == RX_FRAME_PURPOSE_DRIVE) {
+			const rx_frame_drive_t *drive = rx_frame_drive(frame, frame_length);
+			if (drive) {
+				handle_drive_packet(drive);
 			}
 		}
+#ifndef FWSIM
+		// The simulated robot always knows exactly where it is, so
+		// it has no use for camera packets.
+		else if (header->purpose == RX_FRAME_PURPOSE_CAMERA) {
+			handle_camera_packet(frame, frame_length);
+		} else if (header->purpose == RX_FRAME_PURPOSE_COMPACT_CAMERA) {
+			handle_compact_camera_packet(frame, frame_length);
+		}
+	} else if (header->purpose == MESSAGE_PURPOSE_CAPACITOR && frame_length >= HEADER_LENGTH + 2U + FOOTER_LENGTH) {
+		uint8_t capacitor_flag = frame[MESSAGE_PAYLOAD_ADDR];
+		charger_enable(capacitor_flag & 0x02);
+		chicker_discharge(capacitor_flag & 0x01);
+#endif // FWSIM
+	}
+}
+
+#ifndef FWSIM
+static void receive_task(void *UNUSED(param)) {
+	for (;;) {
+		// Receive straight into the next free buffer in the ring, or into the
+		// overflow buffer if the tick has not released any.
+		rx_frame_t *slot = rx_ring_write_get(&rx_ring);
+		uint8_t *buffer = slot ? slot->buffer : overflow_buffer;
+		size_t frame_length = mrf_receive(buffer);
+		if (!frame_length) {
+			break;
+		}
+		if (accept_frame(buffer, frame_length) && slot) {
+			slot->length = frame_length;
+			rx_ring_write_put(&rx_ring);
+		}
 	}
 	// mrf_receive returned zero, which means a cancellation has been requested.
 	// This means we are shutting down.
 	xSemaphoreGive(main_shutdown_sem);
 	vTaskSuspend(0);
 }
+#else
+/**
+ * \brief Handles a frame received over radio, copying it into the ring as the
+ * radio would receive it.
+ *
+ * \param[in] frame the frame, starting with the frame control word
+ * \param[in] frame_length the length of the frame, including the FCS, RSSI and
+ * LQI at the end
+ */
+void receive_frame(const uint8_t *frame, size_t frame_length) {
+	rx_frame_t *slot = rx_ring_write_get(&rx_ring);
+	if (slot && frame_length <= RX_RING_BUFFER_LENGTH) {
+		memcpy(slot->buffer, frame, frame_length);
+		if (accept_frame(slot->buffer, frame_length)) {
+			slot->length = frame_length;
+			rx_ring_write_put(&rx_ring);
+		}
+	}
+}
+#endif // FWSIM
 
 /**
  * \brief Initializes the receive task.
@@ -112,20 +259,36 @@ static void receive_task(void *UNUSED(param)) {
  * \param[in] index the robot index
  */
 void receive_init(unsigned int index) {
-	static StaticSemaphore_t drive_mtx_storage;
-	drive_mtx = xSemaphoreCreateMutexStatic(&drive_mtx_storage);
-
 	robot_index = index;
 
-	dma_memory_handle_t dma_buffer_handle = dma_alloc(128U);
-	assert(dma_buffer_handle);
-	dma_buffer = dma_get_buffer(dma_buffer_handle);
+	uint8_t *buffers[RX_RING_SLOTS];
+#ifndef FWSIM
+	// The radio receives straight into the ring, so its buffers must be
+	// DMA-capable.
+	for (unsigned int i = 0U; i != RX_RING_SLOTS; ++i) {
+		dma_memory_handle_t buffer_handle = dma_alloc(RX_RING_BUFFER_LENGTH);
+		assert(buffer_handle);
+		buffers[i] = dma_get_buffer(buffer_handle);
+	}
+	dma_memory_handle_t overflow_buffer_handle = dma_alloc(RX_RING_BUFFER_LENGTH);
+	assert(overflow_buffer_handle);
+	overflow_buffer = dma_get_buffer(overflow_buffer_handle);
+#else
+	static uint8_t frame_buffers[RX_RING_SLOTS][RX_RING_BUFFER_LENGTH];
+	for (unsigned int i = 0U; i != RX_RING_SLOTS; ++i) {
+		buffers[i] = frame_buffers[i];
+	}
+#endif // FWSIM
+	rx_ring_init(&rx_ring, buffers);
 
+#ifndef FWSIM
 	static StaticTask_t receive_task_tcb;
 	STACK_ALLOCATE(receive_task_stack, 4096);
 	xTaskCreateStatic(&receive_task, "rx", sizeof(receive_task_stack) / sizeof(*receive_task_stack), 0, PRIO_TASK_RX, receive_task_stack, &receive_task_tcb);
+#endif // FWSIM
 }
 
+#ifndef FWSIM
 /**
  * \brief Stops the receive task.
  */
@@ -133,26 +296,41 @@ void receive_shutdown(void) {
 	mrf_receive_cancel();
 	xSemaphoreTake(main_shutdown_sem, portMAX_DELAY);
 }
+#endif // FWSIM
 
 /**
  * \brief Ticks the receiver.
+ *
+ * Every frame the receive task has handed over since the last tick is acted
+ * on, in the order it was received.
  */
 void receive_tick(log_record_t *record) {
-	// Decrement timeout tick counter if nonzero.      
+	const rx_frame_t *frame;
+	while ((frame = rx_ring_read_get(&rx_ring))) {
+		handle_frame(frame->buffer, frame->length);
+		rx_ring_read_put(&rx_ring);
+	}
+
+	// Decrement timeout tick counter if nonzero.
 	if (timeout_ticks == 1) {
 		timeout_ticks = 0;
+#ifndef FWSIM
 		charger_enable(false);
 		chicker_discharge(true);
+#endif // FWSIM
 
 		primitive_params_t stop_params;
-		xSemaphoreTake(drive_mtx, portMAX_DELAY);
 		primitive_start(0, &stop_params);
-		xSemaphoreGive(drive_mtx);
 	} else if (timeout_ticks > 1) {
 		--timeout_ticks;
 	}
-}
 
+#ifdef FWSIM
+	// Count the tick only once it is over, so drive data applied in it is
+	// stamped with the time the tick started, like on the robot.
+	++sim_tick_count;
+#endif // FWSIM
+}
 
 /**
  * \brief Returns the serial number of the most recent drive packet.
@@ -162,7 +340,29 @@ uint8_t receive_last_serial(void) {
 }
 
 /**
- * The previous primitive values to compare against to check if the 
+ * \brief Returns the serial number of the most recently applied drive data and
+ * how long ago it was applied.
+ *
+ * The dongle retransmits drive data until the host sends new data, so this is
+ * the time since the tick that applied the first drive packet with the serial
+ * number.
+ *
+ * \param[out] serial the serial number of the drive data
+ * \param[out] age_ms how long ago the drive data was applied, in milliseconds,
+ * with a resolution of one system tick
+ * \retval true drive data has been received and the outputs were filled
+ * \retval false no drive data has been received yet
+ */
+bool receive_last_serial_age(uint8_t *serial, uint32_t *age_ms) {
+	unsigned int index = tbuf_read_get(&applied_drive_ctl);
+	*serial = applied_drives[index].serial;
+	*age_ms = (xTaskGetTickCount() - applied_drives[index].ticks) * portTICK_PERIOD_MS;
+	tbuf_read_put(&applied_drive_ctl, index);
+	return *serial != 0xFF;
+}
+
+/**
+ * The previous primitive values to compare against to check if the
  * new primitive should be taken, or if it is a copy of the previous one.
  */
 static primitive_params_t pparams_previous = {.params = {0, 0, 0, 0},
@@ -170,47 +370,24 @@ static primitive_params_t pparams_previous = {.params = {0, 0, 0, 0},
 																							.extra = 0};
 static unsigned int primitive_previous = 0;
 
-void handle_drive_packet(uint8_t * dma_buffer){
-	// Grab emergency stop status from the end of the frame.
-	bool estop_run = !!dma_buffer[MESSAGE_PAYLOAD_ADDR + NUM_ROBOTS * RECEIVE_DRIVE_BYTES_PER_ROBOT];
-
-	// Grab a pointer to the robot’s own data block.
-	const uint8_t *robot_data = dma_buffer + MESSAGE_PAYLOAD_ADDR +  RECEIVE_DRIVE_BYTES_PER_ROBOT * robot_index;
-
-	// Check if feedback should be sent.
-	if (robot_data[0] & 0x80) {
-		feedback_pend_normal();
-	}
-
-	// Extract the serial number.
-	uint8_t serial = *robot_data++ & 0x0F;
-
-	// Construct the individual 16-bit words sent from the host.
-	uint16_t words[4U];
-	for (unsigned int i = 0U; i < 4U; ++i) {
-		words[i] = *robot_data++;
-		words[i] |= (uint16_t)*robot_data++ << 8;
-	}
-
-	// In case of emergency stop, treat everything as zero
-	// except the chicker discharge bit (that can keep its
-	// status).
-	if (!estop_run) {
-		static const uint16_t MASK[4] = { 0x0000, 0x4000, 0x0000, 0x0000 };
-		for (unsigned int i = 0; i != 4; ++i) {
-			words[i] &= MASK[i];
-		}
-	}
-
-	// Take the drive mutex.
-	xSemaphoreTake(drive_mtx, portMAX_DELAY);
+/**
+ * \brief Applies this robot’s data from a drive packet, in the tick.
+ *
+ * \param[in] drive the drive packet, read in place in the buffer it was
+ * received into
+ */
+static void handle_drive_packet(const rx_frame_drive_t *drive) {
+	rx_frame_drive_data_t data;
+	rx_frame_decode_drive(drive, robot_index, &data);
 
 	// Reset timeout.
 	timeout_ticks = 1000U / portTICK_PERIOD_MS;
 
+#ifndef FWSIM
 	// Apply the charge and discharge mode.
-	charger_enable(words[1] & 0x8000);
-	chicker_discharge(words[1] & 0x4000);
+	charger_enable(data.charge);
+	chicker_discharge(data.discharge);
+#endif // FWSIM
 
 	// If the serial number, the emergency stop has just
 	// been switched to stop, or the current primitive is
@@ -224,108 +401,111 @@ void handle_drive_packet(uint8_t * dma_buffer){
 	// is switched from stop to run, but this is
 	// unnecessary as direct primitives shouldn’t care
 	// about being started more often than necessary.
-	unsigned int primitive;
-	primitive_params_t pparams;
-	for (unsigned int i = 0; i != 4; ++i) {
-		int16_t value = words[i] & 0x3FF;
-		if (words[i] & 0x400) {
-			value = -value;
-		}
-		if (words[i] & 0x800) {
-			value *= 10;
-		}
-		pparams.params[i] = value;
-	}
-	primitive = words[0] >> 12;
-	pparams.extra = (words[2] >> 12) | ((words[3] >> 12) << 4);
-	pparams.slow = !!(pparams.extra & 0x80);
-	pparams.extra &= 0x7F;
-	if ((serial != last_serial /* Non-atomic because we are only writer */) || !estop_run || primitive_is_direct(primitive)) {
-		if (!primitive_params_are_equal(&pparams, &pparams_previous) || 
-				!(primitive == primitive_previous)) {
-			primitive_previous = primitive;
-			for (unsigned int i = 0; i < 4; i++) {
-				pparams_previous.params[i] = pparams.params[i];
-			}
-			pparams_previous.slow = pparams.slow; 
-			pparams_previous.extra = pparams.extra;
+	if ((data.serial != last_serial /* Non-atomic because we are only writer */) || !data.estop_run || primitive_is_direct(data.primitive)) {
+		if (!primitive_params_are_equal(&data.params, &pparams_previous) ||
+				!(data.primitive == primitive_previous)) {
+			primitive_previous = data.primitive;
+			pparams_previous = data.params;
 			// Apply the movement primitive.
-			primitive_start(primitive, &pparams);
+			primitive_start(data.primitive, &data.params);
 		}
 	}
 
-	// Release the drive mutex.
-	xSemaphoreGive(drive_mtx);
-
 	// Update the last values.
-	__atomic_store_n(&last_serial, serial, __ATOMIC_RELAXED);
+	if (data.serial != last_serial) {
+		unsigned int index = tbuf_write_get(&applied_drive_ctl);
+		applied_drives[index].serial = data.serial;
+		applied_drives[index].ticks = xTaskGetTickCount();
+		tbuf_write_put(&applied_drive_ctl, index);
+	}
+	__atomic_store_n(&last_serial, data.serial, __ATOMIC_RELAXED);
 }
 
-void handle_camera_packet(uint8_t * dma_buffer, uint8_t buffer_position){
-	// The first step is to get the mask vector, which contains
-	// which robots have valid camera data.
-	uint8_t mask_vector = dma_buffer[buffer_position++];
-	//printf("mask vector = %i", mask_vector);
+#ifndef FWSIM
+/**
+ * \brief Applies decoded camera data to this robot’s dead reckoning.
+ *
+ * \param[in] camera the camera data, with absolute positions and timestamp
+ */
+static void apply_camera_data(const rx_frame_camera_data_t *camera) {
+	if (camera->contains_robot) {
+		timeout_ticks = 1000U / portTICK_PERIOD_MS;
+		dr_set_robot_frame(camera->robot_x, camera->robot_y, camera->robot_angle);
+	}
 
-	// The next byte contains the flag information.
-	bool contains_robot = false;
+	rtc_set(camera->timestamp);
+	dr_set_ball_frame_timestamp(camera->ball_x, camera->ball_y, camera->timestamp);
 
-	// the next four bytes contain the ball position.
-	int16_t ball_x = 0;
-	int16_t ball_y = 0;
+	// If this packet contained robot information, update
+	// the timestamp for the camera data.
+	if (camera->contains_robot) {
+		dr_set_robot_timestamp(camera->timestamp);
+	}
+}
 
-	ball_x |= dma_buffer[buffer_position++];
-	ball_x |= (dma_buffer[buffer_position++] << 8);
-	ball_y |= dma_buffer[buffer_position++];
-	ball_y |= (dma_buffer[buffer_position++] << 8);
-	
- 
-	/* dr_set_ball_frame(ball_x, ball_y); */
-		 
-	// The next bytes contain the robot camera information, if any.
-	for (unsigned int i = 0; i < NUM_ROBOTS; i++) {
-		if ((0x01 << i) & mask_vector) {
-			// Valid camera data for robot i, if i matches this robot's 
-			// index, update camera data.
-			if (i == robot_index) {
-				timeout_ticks = 1000U / portTICK_PERIOD_MS;
-
-				int16_t robot_x = 0;
-				int16_t robot_y = 0;
-				int16_t robot_angle = 0;
-				contains_robot = true;
-				 
-				robot_x |= dma_buffer[buffer_position++];
-				robot_x |= (dma_buffer[buffer_position++] << 8);
-				robot_y |= dma_buffer[buffer_position++];
-				robot_y |= (dma_buffer[buffer_position++] << 8);
-				robot_angle |= dma_buffer[buffer_position++];
-				robot_angle |= (dma_buffer[buffer_position++] << 8);
-				dr_set_robot_frame(robot_x, robot_y, robot_angle);
-	
-			}else {
-				buffer_position += 6;
-			}
-		}
+/**
+ * \brief Handles a camera packet.
+ *
+ * \param[in] frame the received frame
+ * \param[in] frame_length the length of the frame, including the FCS, RSSI and
+ * LQI at the end
+ */
+static void handle_camera_packet(const uint8_t *frame, size_t frame_length) {
+	rx_frame_camera_data_t camera;
+	if (rx_frame_decode_camera(frame, frame_length, robot_index, &camera)) {
+		apply_camera_data(&camera);
 	}
+}
 
-	// timestamp will be in the next 8 bytes.
-	uint64_t timestamp = 0;
-	for (unsigned int i = 0; i < 8; i++) {
-		timestamp |= ((uint64_t)dma_buffer[buffer_position++] << 8*i);
+/**
+ * \brief Handles a compact camera packet.
+ *
+ * Keyframes contain the full position of every robot and the full timestamp, and are
+ * stored so later deltas can be applied to them. Deltas contain small offsets from the
+ * keyframe with the id in their header. If this robot missed that keyframe, the delta
+ * is ignored until the next keyframe arrives. The ball position is always absolute.
+ *
+ * \param[in] frame the received frame
+ * \param[in] frame_length the length of the frame, including the FCS, RSSI and
+ * LQI at the end
+ */
+static void handle_compact_camera_packet(const uint8_t *frame, size_t frame_length) {
+	rx_frame_camera_data_t camera;
+	if (!rx_frame_decode_compact_camera(frame, frame_length, robot_index, &camera)) {
+		return;
 	}
-	rtc_set(timestamp);
-	/* dr_set_ball_timestamp(timestamp); */
-	dr_set_ball_frame_timestamp(ball_x, ball_y, timestamp);
 
-	// If this packet contained robot information, update
-	// the timestamp for the camera data.
-	if (contains_robot) {
-		dr_set_robot_timestamp(timestamp);
+	if (camera.keyframe) {
+		compact_camera_keyframe.valid = true;
+		compact_camera_keyframe.id = camera.keyframe_id;
+		compact_camera_keyframe.contains_robot = camera.contains_robot;
+		compact_camera_keyframe.robot_x = camera.robot_x;
+		compact_camera_keyframe.robot_y = camera.robot_y;
+		compact_camera_keyframe.robot_angle = camera.robot_angle;
+		compact_camera_keyframe.timestamp = camera.timestamp;
+	} else {
+		if (!compact_camera_keyframe.valid || compact_camera_keyframe.id != camera.keyframe_id) {
+			// We missed the keyframe this delta is relative to.
+			return;
+		}
+		camera.contains_robot = camera.contains_robot && compact_camera_keyframe.contains_robot;
+		camera.robot_x = compact_camera_keyframe.robot_x + camera.robot_x;
+		camera.robot_y = compact_camera_keyframe.robot_y + camera.robot_y;
+		camera.robot_angle = compact_camera_keyframe.robot_angle + camera.robot_angle;
+		camera.timestamp = compact_camera_keyframe.timestamp + camera.timestamp;
 	}
+
+	apply_camera_data(&camera);
 }
 
-void handle_other_packet(uint8_t * dma_buffer, size_t frame_length){
+/**
+ * \brief Handles a message packet addressed to this robot, in the receive task.
+ *
+ * \param[in] dma_buffer the received frame
+ * \param[in] frame_length the length of the frame, including the FCS, RSSI and
+ * LQI at the end
+ */
+static void handle_other_packet(const uint8_t *dma_buffer, size_t frame_length){
 	//printf("got a message with purpose: %i", dma_buffer[MESSAGE_PURPOSE_ADDR]);
 	//printf("var index: %i", dma_buffer[MESSAGE_PURPOSE_ADDR + 1]);
 	//printf("value: %i", dma_buffer[MESSAGE_PURPOSE_ADDR + 2]);
@@ -388,17 +568,13 @@ void handle_other_packet(uint8_t * dma_buffer, size_t frame_length){
 			feedback_pend_build_ids();
 			break;
 	
-		case 0x0EU: // Set capacitor bits.
-			xSemaphoreTake(drive_mtx, portMAX_DELAY);
-			char capacitor_flag = dma_buffer[MESSAGE_PAYLOAD_ADDR];
-			charger_enable(capacitor_flag & 0x02);
-			chicker_discharge(capacitor_flag & 0x01);
-			xSemaphoreGive(drive_mtx);
-			break;
+		// Capacitor bits (0x0E) are set in the tick, by handle_frame, in
+		// order with the drive packets that also set them.
 		//case 0x20U: // Update tunable variable
 		//	update_var(dma_buffer[MESSAGE_PAYLOAD_ADDR], dma_buffer[MESSAGE_PAYLOAD_ADDR + 1]);
 		//	uint8_t i = get_var(dma_buffer[MESSAGE_PAYLOAD_ADDR]);
 		//	break;
 	}
 }
+#endif // FWSIM
 	
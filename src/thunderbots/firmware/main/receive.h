@@ -2,15 +2,17 @@
 #define RECEIVE_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include "log.h"
 
 void receive_init(unsigned int index);
 void receive_shutdown(void);
 void receive_tick(log_record_t *record);
+#ifdef FWSIM
+void receive_frame(const uint8_t *frame, size_t frame_length);
+#endif
 uint8_t receive_last_serial(void);
-void handle_camera_packet(uint8_t *, uint8_t);
-void handle_drive_packet(uint8_t *);
-void handle_other_packet(uint8_t *, size_t);
+bool receive_last_serial_age(uint8_t *serial, uint32_t *age_ms);
 #endif
 
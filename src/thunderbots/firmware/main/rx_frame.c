@@ -0,0 +1,286 @@
+/**
+ * \defgroup RX_FRAME Received Frame Parsing Functions
+ *
+ * \brief These functions read the frames the dongle sends, in place in the buffer the radio received them into.
+ *
+ * Each frame is read through packed structures laid over its bytes, so no field is copied out of the buffer until it is decoded.
+ * Every function checks that the frame is long enough for every byte it reads, so a truncated or corrupt frame is rejected rather than read past its end.
+ * The functions keep no state, so they can be called from any task.
+ *
+ * \{
+ */
+
+#include "rx_frame.h"
+
+_Static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "The frame views assume the radio protocol’s little-endian byte order.");
+_Static_assert(sizeof(rx_frame_header_t) == 10U, "The frame header view must match the radio protocol.");
+_Static_assert(sizeof(rx_frame_drive_t) == 10U + RX_FRAME_NUM_ROBOTS * 9U + 1U, "The drive packet view must match the radio protocol.");
+
+/**
+ * \brief The address the dongle sends from.
+ */
+#define DONGLE_ADDRESS 0x0100U
+
+/**
+ * \brief The mask of the serial number in a robot’s drive data.
+ */
+#define DRIVE_SERIAL_MASK 0x7FU
+
+/**
+ * \brief The bit in a compact camera header that marks a keyframe.
+ */
+#define COMPACT_CAMERA_KEYFRAME 0x80U
+
+/**
+ * \brief The start of a camera packet.
+ */
+typedef struct __attribute__((packed)) {
+	rx_frame_header_t header;
+
+	/**
+	 * \brief Which robots have camera data in the packet.
+	 */
+	uint8_t mask;
+	int16_t ball_x;
+	int16_t ball_y;
+} rx_frame_camera_t;
+
+/**
+ * \brief The start of a compact camera packet.
+ */
+typedef struct __attribute__((packed)) {
+	rx_frame_header_t header;
+
+	/**
+	 * \brief The keyframe id, with the keyframe flag in the top bit.
+	 */
+	uint8_t keyframe_id;
+
+	/**
+	 * \brief Which robots have camera data in the packet.
+	 */
+	uint8_t mask;
+	int16_t ball_x;
+	int16_t ball_y;
+} rx_frame_compact_camera_t;
+
+/**
+ * \brief One robot’s absolute position in a camera packet or compact camera keyframe.
+ */
+typedef struct __attribute__((packed)) {
+	int16_t x;
+	int16_t y;
+	int16_t angle;
+} rx_frame_camera_robot_t;
+
+/**
+ * \brief One robot’s offset from the keyframe in a compact camera delta.
+ */
+typedef struct __attribute__((packed)) {
+	int8_t x;
+	int8_t y;
+	int8_t angle;
+} rx_frame_camera_delta_t;
+
+/**
+ * \brief The timestamp at the end of a camera packet or compact camera keyframe.
+ */
+typedef struct __attribute__((packed)) {
+	uint64_t timestamp;
+} rx_frame_camera_timestamp_t;
+
+/**
+ * \brief The timestamp offset at the end of a compact camera delta.
+ */
+typedef struct __attribute__((packed)) {
+	uint16_t timestamp_offset;
+} rx_frame_camera_delta_timestamp_t;
+
+/**
+ * \brief Checks that a frame is a data frame from the dongle.
+ *
+ * \param[in] frame the frame, starting with the frame control word
+ * \param[in] length the length of the frame, including the FCS, RSSI, and LQI at the end
+ *
+ * \return the header of the frame, or null if the frame is too short for a header or did not come from the dongle
+ */
+const rx_frame_header_t *rx_frame_check(const uint8_t *frame, size_t length) {
+	if (length < sizeof(rx_frame_header_t) + RX_FRAME_FOOTER_LENGTH) {
+		return 0;
+	}
+	const rx_frame_header_t *header = (const rx_frame_header_t *) frame;
+	uint16_t frame_control = header->frame_control;
+	if (((frame_control >> 0U) & 7U) == 1U /* Data packet */ && ((frame_control >> 3U) & 1U) == 0U /* No security */ && ((frame_control >> 6U) & 1U) == 1U /* Intra-PAN */ && ((frame_control >> 10U) & 3U) == 2U /* 16-bit destination address */ && ((frame_control >> 14U) & 3U) == 2U /* 16-bit source address */ && header->source_address == DONGLE_ADDRESS) {
+		return header;
+	}
+	return 0;
+}
+
+/**
+ * \brief Finds the drive packet in a frame.
+ *
+ * \param[in] frame the frame, which has passed \ref rx_frame_check
+ * \param[in] length the length of the frame, including the FCS, RSSI, and LQI at the end
+ *
+ * \return the drive packet, or null if the frame is not a drive packet or is too short for one
+ */
+const rx_frame_drive_t *rx_frame_drive(const uint8_t *frame, size_t length) {
+	const rx_frame_drive_t *drive = (const rx_frame_drive_t *) frame;
+	if (length < sizeof(rx_frame_drive_t) + RX_FRAME_FOOTER_LENGTH || drive->header.purpose != RX_FRAME_PURPOSE_DRIVE) {
+		return 0;
+	}
+	return drive;
+}
+
+/**
+ * \brief Decodes one robot’s data from a drive packet.
+ *
+ * \param[in] drive the drive packet, from \ref rx_frame_drive
+ * \param[in] index the index of the robot, which must be less than \ref RX_FRAME_NUM_ROBOTS
+ * \param[out] data the decoded drive data
+ */
+void rx_frame_decode_drive(const rx_frame_drive_t *drive, unsigned int index, rx_frame_drive_data_t *data) {
+	const rx_frame_drive_robot_t *robot = &drive->robots[index];
+	data->serial = robot->serial & DRIVE_SERIAL_MASK;
+	data->estop_run = !!drive->estop;
+
+	uint16_t words[4U];
+	for (unsigned int i = 0U; i != 4U; ++i) {
+		words[i] = robot->words[i];
+	}
+
+	// In case of emergency stop, treat everything as zero
+	// except the chicker discharge bit (that can keep its
+	// status).
+	if (!data->estop_run) {
+		static const uint16_t MASK[4] = { 0x0000, 0x4000, 0x0000, 0x0000 };
+		for (unsigned int i = 0; i != 4; ++i) {
+			words[i] &= MASK[i];
+		}
+	}
+
+	data->charge = !!(words[1] & 0x8000);
+	data->discharge = !!(words[1] & 0x4000);
+
+	for (unsigned int i = 0; i != 4; ++i) {
+		int16_t value = words[i] & 0x3FF;
+		if (words[i] & 0x400) {
+			value = -value;
+		}
+		if (words[i] & 0x800) {
+			value *= 10;
+		}
+		data->params.params[i] = value;
+	}
+	data->primitive = words[0] >> 12;
+	data->params.extra = (words[2] >> 12) | ((words[3] >> 12) << 4);
+	data->params.slow = !!(data->params.extra & 0x80);
+	data->params.extra &= 0x7F;
+}
+
+/**
+ * \brief Decodes a camera packet.
+ *
+ * \param[in] frame the frame, which has passed \ref rx_frame_check and has the camera purpose
+ * \param[in] length the length of the frame, including the FCS, RSSI, and LQI at the end
+ * \param[in] index the index of the robot whose position to decode
+ * \param[out] data the decoded camera data, which is always a keyframe
+ *
+ * \retval true the packet was decoded
+ * \retval false the frame is too short for the robots its mask says it contains
+ */
+bool rx_frame_decode_camera(const uint8_t *frame, size_t length, unsigned int index, rx_frame_camera_data_t *data) {
+	if (length < sizeof(rx_frame_camera_t) + RX_FRAME_FOOTER_LENGTH) {
+		return false;
+	}
+	const rx_frame_camera_t *camera = (const rx_frame_camera_t *) frame;
+	unsigned int num_robots = __builtin_popcount(camera->mask);
+	if (length < sizeof(rx_frame_camera_t) + num_robots * sizeof(rx_frame_camera_robot_t) + sizeof(rx_frame_camera_timestamp_t) + RX_FRAME_FOOTER_LENGTH) {
+		return false;
+	}
+
+	data->keyframe = true;
+	data->keyframe_id = 0U;
+	data->ball_x = camera->ball_x;
+	data->ball_y = camera->ball_y;
+	data->contains_robot = false;
+	data->robot_x = 0;
+	data->robot_y = 0;
+	data->robot_angle = 0;
+
+	// The robots with camera data follow in order of index.
+	const rx_frame_camera_robot_t *robots = (const rx_frame_camera_robot_t *) (camera + 1);
+	if (index < RX_FRAME_NUM_ROBOTS && (camera->mask & (1U << index))) {
+		const rx_frame_camera_robot_t *robot = &robots[__builtin_popcount(camera->mask & ((1U << index) - 1U))];
+		data->contains_robot = true;
+		data->robot_x = robot->x;
+		data->robot_y = robot->y;
+		data->robot_angle = robot->angle;
+	}
+
+	data->timestamp = ((const rx_frame_camera_timestamp_t *) &robots[num_robots])->timestamp;
+	return true;
+}
+
+/**
+ * \brief Decodes a compact camera packet.
+ *
+ * \param[in] frame the frame, which has passed \ref rx_frame_check and has the compact camera purpose
+ * \param[in] length the length of the frame, including the FCS, RSSI, and LQI at the end
+ * \param[in] index the index of the robot whose position to decode
+ * \param[out] data the decoded camera data, with offsets from the keyframe if the packet is a delta
+ *
+ * \retval true the packet was decoded
+ * \retval false the frame is too short for the robots its mask says it contains
+ */
+bool rx_frame_decode_compact_camera(const uint8_t *frame, size_t length, unsigned int index, rx_frame_camera_data_t *data) {
+	if (length < sizeof(rx_frame_compact_camera_t) + RX_FRAME_FOOTER_LENGTH) {
+		return false;
+	}
+	const rx_frame_compact_camera_t *camera = (const rx_frame_compact_camera_t *) frame;
+	bool keyframe = !!(camera->keyframe_id & COMPACT_CAMERA_KEYFRAME);
+	unsigned int num_robots = __builtin_popcount(camera->mask);
+	size_t robots_length = num_robots * (keyframe ? sizeof(rx_frame_camera_robot_t) : sizeof(rx_frame_camera_delta_t));
+	size_t timestamp_length = keyframe ? sizeof(rx_frame_camera_timestamp_t) : sizeof(rx_frame_camera_delta_timestamp_t);
+	if (length < sizeof(rx_frame_compact_camera_t) + robots_length + timestamp_length + RX_FRAME_FOOTER_LENGTH) {
+		return false;
+	}
+
+	data->keyframe = keyframe;
+	data->keyframe_id = camera->keyframe_id & ~COMPACT_CAMERA_KEYFRAME;
+	data->ball_x = camera->ball_x;
+	data->ball_y = camera->ball_y;
+	data->contains_robot = false;
+	data->robot_x = 0;
+	data->robot_y = 0;
+	data->robot_angle = 0;
+
+	// The robots with camera data follow in order of index.
+	const uint8_t *robots = (const uint8_t *) (camera + 1);
+	bool contains_robot = index < RX_FRAME_NUM_ROBOTS && (camera->mask & (1U << index));
+	unsigned int position = contains_robot ? __builtin_popcount(camera->mask & ((1U << index) - 1U)) : 0U;
+	if (keyframe) {
+		if (contains_robot) {
+			const rx_frame_camera_robot_t *robot = &((const rx_frame_camera_robot_t *) robots)[position];
+			data->contains_robot = true;
+			data->robot_x = robot->x;
+			data->robot_y = robot->y;
+			data->robot_angle = robot->angle;
+		}
+		data->timestamp = ((const rx_frame_camera_timestamp_t *) (robots + robots_length))->timestamp;
+	} else {
+		if (contains_robot) {
+			const rx_frame_camera_delta_t *delta = &((const rx_frame_camera_delta_t *) robots)[position];
+			data->contains_robot = true;
+			data->robot_x = delta->x;
+			data->robot_y = delta->y;
+			data->robot_angle = delta->angle;
+		}
+		data->timestamp = ((const rx_frame_camera_delta_timestamp_t *) (robots + robots_length))->timestamp_offset;
+	}
+	return true;
+}
+
+/**
+ * \}
+ */
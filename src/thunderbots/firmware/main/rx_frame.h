@@ -0,0 +1,189 @@
+#ifndef RX_FRAME_H
+#define RX_FRAME_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "primitives/primitive.h"
+
+/**
+ * \ingroup RX_FRAME
+ *
+ * \brief The number of robots in drive and camera packets.
+ */
+#define RX_FRAME_NUM_ROBOTS 8U
+
+/**
+ * \ingroup RX_FRAME
+ *
+ * \brief The length of the FCS, RSSI, and LQI the radio appends to every received frame.
+ */
+#define RX_FRAME_FOOTER_LENGTH 4U
+
+/**
+ * \ingroup RX_FRAME
+ *
+ * \brief The destination address of frames broadcast to every robot.
+ */
+#define RX_FRAME_BROADCAST_ADDRESS 0xFFFFU
+
+/**
+ * \ingroup RX_FRAME
+ *
+ * \brief The bit in a robot’s drive data serial number that requests feedback.
+ */
+#define RX_FRAME_DRIVE_FEEDBACK_REQUEST 0x80U
+
+/**
+ * \ingroup RX_FRAME
+ *
+ * \brief The message purpose of a drive packet.
+ */
+#define RX_FRAME_PURPOSE_DRIVE 0x0FU
+
+/**
+ * \ingroup RX_FRAME
+ *
+ * \brief The message purpose of a camera packet.
+ */
+#define RX_FRAME_PURPOSE_CAMERA 0x10U
+
+/**
+ * \ingroup RX_FRAME
+ *
+ * \brief The message purpose of a compact camera packet.
+ */
+#define RX_FRAME_PURPOSE_COMPACT_CAMERA 0x11U
+
+/**
+ * \ingroup RX_FRAME
+ *
+ * \brief The 802.15.4 header of a frame from the dongle, followed by the message purpose.
+ *
+ * This and the other views below are laid over the received bytes in place.
+ * They are packed, so they may lie at any alignment, and their multi-byte fields are little-endian like the radio protocol.
+ */
+typedef struct __attribute__((packed)) {
+	uint16_t frame_control;
+	uint8_t sequence_number;
+	uint16_t destination_pan;
+	uint16_t destination_address;
+	uint16_t source_address;
+	uint8_t purpose;
+} rx_frame_header_t;
+
+/**
+ * \ingroup RX_FRAME
+ *
+ * \brief One robot’s data in a drive packet.
+ */
+typedef struct __attribute__((packed)) {
+	/**
+	 * \brief The serial number, with the feedback request in the top bit.
+	 */
+	uint8_t serial;
+
+	/**
+	 * \brief The four words holding the primitive, its parameters, and the capacitor bits.
+	 */
+	uint16_t words[4U];
+} rx_frame_drive_robot_t;
+
+/**
+ * \ingroup RX_FRAME
+ *
+ * \brief A drive packet.
+ */
+typedef struct __attribute__((packed)) {
+	rx_frame_header_t header;
+	rx_frame_drive_robot_t robots[RX_FRAME_NUM_ROBOTS];
+
+	/**
+	 * \brief Nonzero if the emergency stop switch is in the run position.
+	 */
+	uint8_t estop;
+} rx_frame_drive_t;
+
+/**
+ * \ingroup RX_FRAME
+ *
+ * \brief The drive data for one robot, decoded from a drive packet.
+ */
+typedef struct {
+	/**
+	 * \brief The serial number of the drive data.
+	 */
+	uint8_t serial;
+
+	/**
+	 * \brief Whether the emergency stop switch is in the run position.
+	 *
+	 * In the stop position, everything except the discharge bit is decoded as zero.
+	 */
+	bool estop_run;
+
+	/**
+	 * \brief Whether the capacitors should be charged.
+	 */
+	bool charge;
+
+	/**
+	 * \brief Whether the capacitors should be discharged.
+	 */
+	bool discharge;
+
+	/**
+	 * \brief The index of the movement primitive.
+	 */
+	unsigned int primitive;
+
+	/**
+	 * \brief The parameters of the movement primitive.
+	 */
+	primitive_params_t params;
+} rx_frame_drive_data_t;
+
+/**
+ * \ingroup RX_FRAME
+ *
+ * \brief The camera data for one robot, decoded from a camera or compact camera packet.
+ */
+typedef struct {
+	/**
+	 * \brief Whether the packet is a keyframe, which camera packets always are.
+	 */
+	bool keyframe;
+
+	/**
+	 * \brief The id of the compact camera keyframe the packet is, or is relative to.
+	 */
+	uint8_t keyframe_id;
+
+	/**
+	 * \brief The position of the ball, which is always absolute.
+	 */
+	int16_t ball_x, ball_y;
+
+	/**
+	 * \brief Whether the packet contains this robot’s position.
+	 */
+	bool contains_robot;
+
+	/**
+	 * \brief This robot’s position, or its offset from the keyframe in compact camera deltas.
+	 */
+	int16_t robot_x, robot_y, robot_angle;
+
+	/**
+	 * \brief The timestamp, or its offset from the keyframe in compact camera deltas.
+	 */
+	uint64_t timestamp;
+} rx_frame_camera_data_t;
+
+const rx_frame_header_t *rx_frame_check(const uint8_t *frame, size_t length);
+const rx_frame_drive_t *rx_frame_drive(const uint8_t *frame, size_t length);
+void rx_frame_decode_drive(const rx_frame_drive_t *drive, unsigned int index, rx_frame_drive_data_t *data);
+bool rx_frame_decode_camera(const uint8_t *frame, size_t length, unsigned int index, rx_frame_camera_data_t *data);
+bool rx_frame_decode_compact_camera(const uint8_t *frame, size_t length, unsigned int index, rx_frame_camera_data_t *data);
+
+#endif
@@ -0,0 +1,89 @@
+/**
+ * \defgroup RX_RING Received Frame Ring Functions
+ *
+ * These functions pass received radio frames from the task that receives them to the task that acts on them, without locks or copies.
+ * A ring provides the following semantics:
+ * \li The ring holds a fixed set of buffers, given to it at initialization, each described by a \ref rx_frame_t.
+ * \li Given exactly one producer, the producer can, without blocking, find the descriptor of a free buffer for the radio to write a frame into, unless the ring is full.
+ * \li Given exactly one consumer, the consumer can, without blocking, find the descriptor of the oldest frame submitted by the producer, unless the ring is empty.
+ * \li Frames are consumed in the order they were submitted, and a buffer is never written while the consumer still owns it.
+ *
+ * A descriptor belongs to the producer from \ref rx_ring_write_get until \ref rx_ring_write_put, and to the consumer from \ref rx_ring_read_get until \ref rx_ring_read_put.
+ * The producer and consumer each only write their own counter, and publish it with release ordering, so the ring is safe even when they run on different cores, as in the host tests.
+ *
+ * @{
+ */
+#include "rx_ring.h"
+
+_Static_assert((RX_RING_SLOTS & (RX_RING_SLOTS - 1U)) == 0U, "RX_RING_SLOTS must be a power of two so the counters can wrap.");
+
+/**
+ * \brief Initializes a ring, with no frames in it.
+ *
+ * \param[out] ring the ring to initialize
+ * \param[in] buffers the buffers the frames are received into, each \ref RX_RING_BUFFER_LENGTH bytes long
+ */
+void rx_ring_init(rx_ring_t *ring, uint8_t *const buffers[RX_RING_SLOTS]) {
+	for (unsigned int i = 0U; i != RX_RING_SLOTS; ++i) {
+		ring->frames[i].buffer = buffers[i];
+		ring->frames[i].length = 0U;
+	}
+	ring->head = 0U;
+	ring->tail = 0U;
+}
+
+/**
+ * \brief Finds a free buffer for the producer to receive a frame into.
+ *
+ * Calling this again without calling \ref rx_ring_write_put returns the same descriptor, so a frame that should not be passed on can be dropped by simply not submitting it.
+ *
+ * \param[in] ring the ring
+ *
+ * \return the descriptor of the free buffer, or null if the ring is full
+ */
+rx_frame_t *rx_ring_write_get(rx_ring_t *ring) {
+	unsigned int head = ring->head;
+	if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == RX_RING_SLOTS) {
+		return 0;
+	}
+	return &ring->frames[head & (RX_RING_SLOTS - 1U)];
+}
+
+/**
+ * \brief Submits the frame in the descriptor returned by \ref rx_ring_write_get to the consumer.
+ *
+ * \param[in] ring the ring
+ *
+ * \pre The descriptor’s length has been set to the length of the received frame.
+ */
+void rx_ring_write_put(rx_ring_t *ring) {
+	__atomic_store_n(&ring->head, ring->head + 1U, __ATOMIC_RELEASE);
+}
+
+/**
+ * \brief Finds the oldest frame submitted to the consumer.
+ *
+ * \param[in] ring the ring
+ *
+ * \return the descriptor of the frame, or null if the ring is empty
+ */
+const rx_frame_t *rx_ring_read_get(rx_ring_t *ring) {
+	unsigned int tail = ring->tail;
+	if (__atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == tail) {
+		return 0;
+	}
+	return &ring->frames[tail & (RX_RING_SLOTS - 1U)];
+}
+
+/**
+ * \brief Releases the frame returned by \ref rx_ring_read_get, so its buffer can be received into again.
+ *
+ * \param[in] ring the ring
+ */
+void rx_ring_read_put(rx_ring_t *ring) {
+	__atomic_store_n(&ring->tail, ring->tail + 1U, __ATOMIC_RELEASE);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,66 @@
+#ifndef RX_RING_H
+#define RX_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * \ingroup RX_RING
+ *
+ * \brief The number of frames the ring can hold, which must be a power of two.
+ */
+#define RX_RING_SLOTS 4U
+
+/**
+ * \ingroup RX_RING
+ *
+ * \brief The length of each frame buffer, which is the largest frame the radio can receive.
+ */
+#define RX_RING_BUFFER_LENGTH 128U
+
+/**
+ * \ingroup RX_RING
+ *
+ * \brief A descriptor of one received frame.
+ */
+typedef struct {
+	/**
+	 * \brief The buffer the radio writes the frame into.
+	 */
+	uint8_t *buffer;
+
+	/**
+	 * \brief The length of the frame in the buffer.
+	 */
+	size_t length;
+} rx_frame_t;
+
+/**
+ * \ingroup RX_RING
+ *
+ * \brief A ring of frame descriptors passed from one producer to one consumer.
+ */
+typedef struct {
+	/**
+	 * \brief The descriptors, each owned by the producer or the consumer.
+	 */
+	rx_frame_t frames[RX_RING_SLOTS];
+
+	/**
+	 * \brief The number of frames ever submitted, which only the producer writes.
+	 */
+	unsigned int head;
+
+	/**
+	 * \brief The number of frames ever released, which only the consumer writes.
+	 */
+	unsigned int tail;
+} rx_ring_t;
+
+void rx_ring_init(rx_ring_t *ring, uint8_t *const buffers[RX_RING_SLOTS]);
+rx_frame_t *rx_ring_write_get(rx_ring_t *ring);
+void rx_ring_write_put(rx_ring_t *ring);
+const rx_frame_t *rx_ring_read_get(rx_ring_t *ring);
+void rx_ring_read_put(rx_ring_t *ring);
+
+#endif
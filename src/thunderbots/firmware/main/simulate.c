@@ -1,9 +1,11 @@
 #ifdef FWSIM
 #include "simulate.h"
+#include "dribbler.h"
 #include "physics.h"
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include <unused.h>
 
 
 const float MU = 0.6;
@@ -14,6 +16,9 @@ static float accel[3];
 static float force3[3];
 static float force4[4];
 static bool slip[4];
+static float slip_force = SLIP_FORCE;
+static float drag = 1.0;
+static dr_ball_data_t ball;
 
 static FILE* logFile;
 
@@ -27,24 +32,43 @@ void dr_get(dr_data_t * ret){
 	ret->avel = vel[2];
 }
 
+/**
+ * \brief Returns the state of the simulated ball.
+ *
+ * \param[out] ret the position and velocity of the ball
+ */
+void dr_get_ball(dr_ball_data_t *ret)
+{
+    *ret = ball;
+}
+
+/**
+ * \brief Stands in for the dribbler, which is not simulated.
+ *
+ * \param[in] desired_rpm the speed the primitive asked the dribbler to spin at
+ */
+void dribbler_set_speed(uint32_t UNUSED(desired_rpm))
+{
+}
+
 void sim_apply_wheel_force(const float new_wheel_force[4]){
     // printf("\nWF0:%f, WF2:%f, WF2:%f,
     // WF3:%f",new_wheel_force[0],new_wheel_force[1],new_wheel_force[2],new_wheel_force[3]);
     unsigned int i;
     for (i = 0; i < 4; i++)
     {
-        if (new_wheel_force[i] > SLIP_FORCE)
+        if (new_wheel_force[i] > slip_force)
         {
             // printf("\nSLIPPING, limit = %f, force = %f\n",SLIP_FORCE,
             // new_wheel_force[i]);
-            force4[i] = SLIP_FORCE;  //* 0.2; TODO: uncomment this
+            force4[i] = slip_force;  //* 0.2; TODO: uncomment this
             slip[i]   = true;
         }
-        else if (new_wheel_force[i] < -SLIP_FORCE)
+        else if (new_wheel_force[i] < -slip_force)
         {
             // printf("\nSLIPPING, limit = %f, force = %f\n",SLIP_FORCE,
             // new_wheel_force[i]);
-            force4[i] = -SLIP_FORCE;  //* 0.2; TODO: uncomment this
+            force4[i] = -slip_force;  //* 0.2; TODO: uncomment this
             slip[i]   = true;
         }
         else
@@ -77,9 +101,9 @@ void sim_tick(float delta_t){
     pos[1] += vel[1] * delta_t;
     pos[2] += vel[2] * delta_t;
 
-    vel[0] += accel[0] * delta_t - 1.0 * vel[0] * delta_t;  // complete guess
-    vel[1] += accel[1] * delta_t - 1.0 * vel[1] * delta_t;  // complete guess
-    vel[2] += accel[2] * delta_t - 1.0 * vel[2] * delta_t;  // complete guess
+    vel[0] += accel[0] * delta_t - drag * vel[0] * delta_t;  // complete guess
+    vel[1] += accel[1] * delta_t - drag * vel[1] * delta_t;  // complete guess
+    vel[2] += accel[2] * delta_t - drag * vel[2] * delta_t;  // complete guess
 }
 
 void sim_log_tick(float time){
@@ -129,6 +153,51 @@ void sim_reset(){
     }
     force4[3] = 0.0;
     slip[3]   = 0.0;
+    slip_force = SLIP_FORCE;
+    drag       = 1.0;
+    ball       = (dr_ball_data_t){0};
+}
+
+/**
+ * \brief Changes the properties of the simulated robot.
+ *
+ * \param[in] plant the grip and drag of the robot to simulate
+ */
+void sim_set_plant(const sim_plant_t *plant)
+{
+    slip_force = SLIP_FORCE * plant->grip;
+    drag       = plant->drag;
+}
+
+/**
+ * \brief Moves the simulated robot.
+ *
+ * \param[in] new_pos the new position and orientation of the robot
+ * \param[in] new_vel the new linear and angular velocity of the robot
+ */
+void sim_set_state(const float new_pos[3], const float new_vel[3])
+{
+    for (unsigned i = 0; i < 3; i++)
+    {
+        pos[i] = new_pos[i];
+        vel[i] = new_vel[i];
+    }
+}
+
+/**
+ * \brief Moves the simulated ball.
+ *
+ * The ball is not simulated, so it keeps this state until it is moved again.
+ *
+ * \param[in] new_pos the new position of the ball
+ * \param[in] new_vel the new velocity of the ball
+ */
+void sim_set_ball(const float new_pos[2], const float new_vel[2])
+{
+    ball.x  = new_pos[0];
+    ball.y  = new_pos[1];
+    ball.vx = new_vel[0];
+    ball.vy = new_vel[1];
 }
 
 float get_pos_x() {
@@ -60,14 +60,46 @@ typedef struct {
 
 } dr_data_t;
 
+/**
+ * \brief The type of data returned by \ref dr_get_ball, as in dr.h.
+ *
+ * Positions are in metres and velocities in metres per second, in the same
+ * coordinate system as \ref dr_data_t.
+ */
+typedef struct {
+	float x;
+	float y;
+	float vx;
+	float vy;
+} dr_ball_data_t;
+
+/**
+ * \brief The properties of the simulated robot that vary from robot to robot.
+ */
+typedef struct {
+	/**
+	 * \brief The fraction of the nominal slip force each wheel can apply before
+	 * it slips.
+	 */
+	float grip;
+
+	/**
+	 * \brief The fraction of the robot’s velocity lost to friction each second.
+	 */
+	float drag;
+} sim_plant_t;
 
 void dr_get(dr_data_t*);
+void dr_get_ball(dr_ball_data_t *ret);
 void sim_apply_wheel_force(const float wheel_force[4]);
 void sim_tick(float delta_t);
 void sim_log_tick(float time);
 void sim_log_start();
 void sim_log_end();
 void sim_reset();
+void sim_set_plant(const sim_plant_t *plant);
+void sim_set_state(const float new_pos[3], const float new_vel[3]);
+void sim_set_ball(const float new_pos[2], const float new_vel[2]);
 float get_pos_x();
 
 #endif//
@@ -44,6 +44,7 @@
 #include "main.h"
 #include "motor.h"
 #include "priority.h"
+#include "profile.h"
 #include "receive.h"
 #include "wheels.h"
 #include "primitives/primitive.h"
@@ -67,10 +68,12 @@ static bool shutdown = false;
 
 static void normal_task(void *UNUSED(param)) {
 	TickType_t last_wake = xTaskGetTickCount();
+	unsigned int window_ticks = 0U;
 
 	while (!__atomic_load_n(&shutdown, __ATOMIC_RELAXED)) {
 		// Wait one system tick.
 		vTaskDelayUntil(&last_wake, 1U);
+		uint32_t tick_start = profile_now();
 
 		// Sanity check: the FPGA must not have experienced a post-configuration CRC failure.
 		assert(gpio_get_input(PIN_FPGA_INIT_B));
@@ -83,26 +86,44 @@ static void normal_task(void *UNUSED(param)) {
 			error_post_report(ERROR_CONSUMER_LOG, true);
 		}
 
-		// Run the stuff.
+		// Run the stuff, timing each module.
+		uint32_t t = profile_now();
 		feedback_tick();
+		t = profile_end(PROFILE_MODULE_FEEDBACK, t);
 		receive_tick(record);
+		t = profile_end(PROFILE_MODULE_RECEIVE, t);
 		adc_tick(record);
+		t = profile_end(PROFILE_MODULE_ADC, t);
 		leds_tick();
+		t = profile_end(PROFILE_MODULE_LEDS, t);
 		breakbeam_tick(record);
+		t = profile_end(PROFILE_MODULE_BREAKBEAM, t);
 		lps_tick();
+		t = profile_end(PROFILE_MODULE_LPS, t);
 		
 		if (chicker_auto_fired_test_clear()) {
 			feedback_pend_autokick();
 		}
+		t = profile_now();
 		hall_tick();
+		t = profile_end(PROFILE_MODULE_HALL, t);
 		encoder_tick();
+		t = profile_end(PROFILE_MODULE_ENCODER, t);
 
+		// The primitive times dead reckoning separately and leaves it out of
+		// its own time.
 		primitive_tick(record);
+		t = profile_now();
 		wheels_tick(record);
+		t = profile_end(PROFILE_MODULE_WHEELS, t);
 		dribbler_tick(record);
+		t = profile_end(PROFILE_MODULE_DRIBBLER, t);
 		charger_tick();
+		t = profile_end(PROFILE_MODULE_CHARGER, t);
 		chicker_tick();
+		t = profile_end(PROFILE_MODULE_CHICKER, t);
 		motor_tick();
+		profile_end(PROFILE_MODULE_MOTOR, t);
 
 		// Submit the log record, if we filled one.
 		if (record) {
@@ -110,6 +131,21 @@ static void normal_task(void *UNUSED(param)) {
 			log_queue(record);
 		}
 
+		// Close the profiling window once a second, logging the times and
+		// making them available to the feedback packet.
+		profile_end(PROFILE_MODULE_NORMAL_TICK, tick_start);
+		if (++window_ticks == PROFILE_WINDOW_TICKS) {
+			window_ticks = 0U;
+			log_profile_t profile;
+			profile_read_clear(&profile);
+			log_record_t *profile_record = log_alloc();
+			if (profile_record) {
+				profile_record->magic = LOG_MAGIC_PROFILE;
+				profile_record->profile = profile;
+				log_queue(profile_record);
+			}
+		}
+
 		// Report progress.
 		main_kick_wdt(MAIN_WDT_SOURCE_TICK);
 	}
@@ -123,6 +159,9 @@ static void normal_task(void *UNUSED(param)) {
  * \brief Initializes the tick generators.
  */
 void tick_init(void) {
+	// Start timing the ticks before they start running.
+	profile_init();
+
 	// Configure timer 6 to run the fast ticks.
 	rcc_enable_reset(APB1, TIM6);
 	TIM6.PSC = 84000000U / 1000000U; // One microsecond per timer tick
@@ -174,6 +213,7 @@ void timer6_isr(void) {
 	// Clear pending interrupt.
 	TIM_basic_SR_t sr = { .UIF = 0 };
 	TIM6.SR = sr;
+	uint32_t tick_start = profile_now();
 
 	// Run the devices that need to run fast.
 	breakbeam_tick_fast();
@@ -181,6 +221,7 @@ void timer6_isr(void) {
 
 	// Run lps fast tick
 	lps_incr();	
+	profile_end(PROFILE_MODULE_FAST_TICK, tick_start);
 
 	// Report progress.
 	main_kick_wdt(MAIN_WDT_SOURCE_HSTICK);
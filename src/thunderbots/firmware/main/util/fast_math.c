@@ -0,0 +1,208 @@
+#include "fast_math.h"
+#include <math.h>
+
+#ifdef FAST_MATH_USE_LIBM
+
+float fast_sinf(float x) {
+    return sinf(x);
+}
+
+float fast_cosf(float x) {
+    return cosf(x);
+}
+
+void fast_sincosf(float x, float *sin, float *cos) {
+    *sin = sinf(x);
+    *cos = cosf(x);
+}
+
+float fast_atan2f(float y, float x) {
+    return atan2f(y, x);
+}
+
+float fast_sqrtf(float x) {
+    return sqrtf(x);
+}
+
+float fast_wrap_angle(float x) {
+    return remainderf(x, 6.28318531f);
+}
+
+#else
+
+#define TWO_OVER_PI 0.636619772f
+#define ONE_OVER_TWO_PI 0.159154943f
+#define PI_4 0.785398163f
+#define PI_2 1.57079633f
+#define PI 3.14159265f
+
+// pi / 2 split into three parts so that multiples of it can be subtracted from an angle
+// without losing precision. The first two parts have enough trailing zero bits that
+// multiplying them by any quadrant up to FAST_MATH_MAX_ANGLE is exact
+#define PI_2_HI 1.5703125f
+#define PI_2_MID 4.837512969970703125e-4f
+#define PI_2_LO 7.54978995489188216e-8f
+
+/**
+ * Rounds a number to the nearest integer. The Cortex-M4 has no instruction for this,
+ * but its conversion to integer truncates
+ */
+static inline int round_to_int(float x) {
+    return (int) (x + (x >= 0.0f ? 0.5f : -0.5f));
+}
+
+/**
+ * Reduces an angle to [-pi/4, pi/4] by subtracting a multiple of pi/2
+ *
+ * @param x the angle
+ * @param quadrant the multiple of pi/2 that was subtracted
+ * @return the reduced angle
+ */
+static inline float reduce_angle(float x, int *quadrant) {
+    int q = round_to_int(x * TWO_OVER_PI);
+    float k = (float) q;
+    *quadrant = q;
+    return ((x - k * PI_2_HI) - k * PI_2_MID) - k * PI_2_LO;
+}
+
+/**
+ * Subtracts a whole number of turns from an angle
+ *
+ * @param x the angle
+ * @param turns the number of turns to subtract
+ * @return the reduced angle
+ */
+static inline float reduce_turns(float x, int turns) {
+    float k = (float) turns;
+    return ((x - k * (4.0f * PI_2_HI)) - k * (4.0f * PI_2_MID)) - k * (4.0f * PI_2_LO);
+}
+
+/**
+ * Minimax polynomials for sine and cosine on [-pi/4, pi/4], from the Cephes library
+ */
+static inline float sin_poly(float r) {
+    float z = r * r;
+    return r + r * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f));
+}
+
+static inline float cos_poly(float r) {
+    float z = r * r;
+    return 1.0f - 0.5f * z
+        + z * z * (4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f));
+}
+
+float fast_sinf(float x) {
+    int quadrant;
+    float r = reduce_angle(x, &quadrant);
+    switch (quadrant & 3) {
+        case 0:
+            return sin_poly(r);
+        case 1:
+            return cos_poly(r);
+        case 2:
+            return -sin_poly(r);
+        default:
+            return -cos_poly(r);
+    }
+}
+
+float fast_cosf(float x) {
+    int quadrant;
+    float r = reduce_angle(x, &quadrant);
+    switch (quadrant & 3) {
+        case 0:
+            return cos_poly(r);
+        case 1:
+            return -sin_poly(r);
+        case 2:
+            return -cos_poly(r);
+        default:
+            return sin_poly(r);
+    }
+}
+
+void fast_sincosf(float x, float *sin, float *cos) {
+    int quadrant;
+    float r = reduce_angle(x, &quadrant);
+    float s = sin_poly(r);
+    float c = cos_poly(r);
+    switch (quadrant & 3) {
+        case 0:
+            *sin = s;
+            *cos = c;
+            break;
+        case 1:
+            *sin = c;
+            *cos = -s;
+            break;
+        case 2:
+            *sin = -s;
+            *cos = -c;
+            break;
+        default:
+            *sin = -c;
+            *cos = s;
+            break;
+    }
+}
+
+float fast_atan2f(float y, float x) {
+    float ax = fabsf(x);
+    float ay = fabsf(y);
+    float big = ax > ay ? ax : ay;
+    float small = ax > ay ? ay : ax;
+    if (big == 0.0f) {
+        return 0.0f;
+    }
+
+    // Reduce to the angle of a vector in the first octant, and then to [0, tan(pi/8)]
+    // for the polynomial, which costs a single division either way
+    float a, offset;
+    if (small > 0.414213562f * big) {
+        a = (small - big) / (small + big);
+        offset = PI_4;
+    } else {
+        a = small / big;
+        offset = 0.0f;
+    }
+    // Minimax polynomial for arctangent on [-tan(pi/8), tan(pi/8)], from the Cephes
+    // library
+    float z = a * a;
+    float angle = offset + a + a * z * (-3.33329491539e-1f + z * (1.99777106478e-1f
+        + z * (-1.38776856032e-1f + z * 8.05374449538e-2f)));
+
+    // Unfold the octant
+    if (ay > ax) {
+        angle = PI_2 - angle;
+    }
+    if (x < 0.0f) {
+        angle = PI - angle;
+    }
+    return y < 0.0f ? -angle : angle;
+}
+
+float fast_sqrtf(float x) {
+#if defined(__ARM_FP)
+    float result;
+    asm("vsqrt.f32 %0, %1" : "=t"(result) : "t"(x));
+    return result;
+#else
+    return __builtin_sqrtf(x);
+#endif
+}
+
+float fast_wrap_angle(float x) {
+    // The same reduction as for sine and cosine, by multiples of 2 pi. Near odd
+    // multiples of pi the multiple can be rounded the wrong way, which is corrected by
+    // reducing again by one more or less
+    int k = round_to_int(x * ONE_OVER_TWO_PI);
+    float r = reduce_turns(x, k);
+    if (r > PI) {
+        r = reduce_turns(x, k + 1);
+    } else if (r < -PI) {
+        r = reduce_turns(x, k - 1);
+    }
+    return r;
+}
+
+#endif
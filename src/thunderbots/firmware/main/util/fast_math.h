@@ -0,0 +1,80 @@
+#ifndef UTIL_FAST_MATH_H
+#define UTIL_FAST_MATH_H
+
+/**
+ * Fast single precision replacements for the libm functions the primitives call every
+ * tick. The libm versions either work in double precision, which the Cortex-M4 FPU
+ * doesn't support, or handle cases that never come up in the control loop, such as
+ * setting errno.
+ *
+ * The errors below are the largest found against double precision libm by
+ * fast_math_test over the ranges given.
+ *
+ * Build with FAST_MATH_USE_LIBM defined to make every function call libm instead, to
+ * check whether a change in behaviour comes from the approximations.
+ */
+
+/**
+ * The largest angle, in magnitude, that fast_sinf, fast_cosf, and fast_sincosf keep
+ * their stated accuracy for. Larger angles lose accuracy in the range reduction
+ */
+#define FAST_MATH_MAX_ANGLE 8192.0f
+
+/**
+ * Calculates the sine of an angle, with a maximum absolute error of 1e-7 for angles no
+ * larger than FAST_MATH_MAX_ANGLE
+ *
+ * @param x the angle, in radians
+ * @return the sine of the angle
+ */
+float fast_sinf(float x);
+
+/**
+ * Calculates the cosine of an angle, with a maximum absolute error of 1e-7 for angles no
+ * larger than FAST_MATH_MAX_ANGLE
+ *
+ * @param x the angle, in radians
+ * @return the cosine of the angle
+ */
+float fast_cosf(float x);
+
+/**
+ * Calculates the sine and cosine of an angle together, which costs little more than
+ * calculating one of them. The errors are the same as fast_sinf and fast_cosf
+ *
+ * @param x the angle, in radians
+ * @param sin the sine of the angle
+ * @param cos the cosine of the angle
+ * @return void
+ */
+void fast_sincosf(float x, float *sin, float *cos);
+
+/**
+ * Calculates the angle of a vector, with a maximum absolute error of 3e-7 radians. The
+ * result for a zero vector is 0
+ *
+ * @param y the y component of the vector
+ * @param x the x component of the vector
+ * @return the angle of the vector from the x axis, in radians, in [-pi, pi]
+ */
+float fast_atan2f(float y, float x);
+
+/**
+ * Calculates the square root of a number using the FPU's square root instruction, which
+ * is correctly rounded, without the libm check for negative numbers
+ *
+ * @param x the number, which must not be negative
+ * @return the square root of the number
+ */
+float fast_sqrtf(float x);
+
+/**
+ * Wraps an angle into the range [-pi, pi], without the double precision fmod, with a
+ * maximum absolute error of 2e-7
+ *
+ * @param x the angle, in radians, no larger in magnitude than FAST_MATH_MAX_ANGLE
+ * @return the equivalent angle in [-pi, pi]
+ */
+float fast_wrap_angle(float x);
+
+#endif
@@ -15,7 +15,7 @@ Matrix create_matrix(int n_rows, int n_cols) {
 }
 
 void free_matrix(Matrix matrix) {
-    int i, j;
+    int i;
     for (i = 0; i < matrix.n_rows; i++) {
         free(matrix.rows[i]);
     }
@@ -87,3 +87,128 @@ Matrix transpose(Matrix in_matrix) {
     }
     return out_matrix;
 }
+
+/*
+ * Multiply-accumulate, acc + a * b. The Cortex-M4F's FPU has a fused multiply-add
+ * (VFMA.F32) that does this in one instruction and one rounding, so it is used when the
+ * compiler says the target has one, and the host falls back to a plain multiply and add.
+ */
+#if defined(__ARM_FEATURE_FMA)
+#define MAC(acc, a, b) __builtin_fmaf((a), (b), (acc))
+#else
+#define MAC(acc, a, b) ((acc) + (a) * (b))
+#endif
+
+// Dot products of rows and columns written out in full
+#define DOT2(a0, a1, b0, b1) MAC((a0) * (b0), (a1), (b1))
+#define DOT3(a0, a1, a2, b0, b1, b2) MAC(DOT2(a0, a1, b0, b1), (a2), (b2))
+#define DOT4(a0, a1, a2, a3, b0, b1, b2, b3) MAC(DOT3(a0, a1, a2, b0, b1, b2), (a3), (b3))
+
+void mat2_mult_vec(const float m[2][2], const float v[2], float out[2]) {
+    const float v0 = v[0], v1 = v[1];
+    out[0] = DOT2(m[0][0], m[0][1], v0, v1);
+    out[1] = DOT2(m[1][0], m[1][1], v0, v1);
+}
+
+void mat3_mult_vec(const float m[3][3], const float v[3], float out[3]) {
+    const float v0 = v[0], v1 = v[1], v2 = v[2];
+    out[0] = DOT3(m[0][0], m[0][1], m[0][2], v0, v1, v2);
+    out[1] = DOT3(m[1][0], m[1][1], m[1][2], v0, v1, v2);
+    out[2] = DOT3(m[2][0], m[2][1], m[2][2], v0, v1, v2);
+}
+
+void mat4_mult_vec(const float m[4][4], const float v[4], float out[4]) {
+    const float v0 = v[0], v1 = v[1], v2 = v[2], v3 = v[3];
+    out[0] = DOT4(m[0][0], m[0][1], m[0][2], m[0][3], v0, v1, v2, v3);
+    out[1] = DOT4(m[1][0], m[1][1], m[1][2], m[1][3], v0, v1, v2, v3);
+    out[2] = DOT4(m[2][0], m[2][1], m[2][2], m[2][3], v0, v1, v2, v3);
+    out[3] = DOT4(m[3][0], m[3][1], m[3][2], m[3][3], v0, v1, v2, v3);
+}
+
+void mat3x4_mult_vec(const float m[3][4], const float v[4], float out[3]) {
+    const float v0 = v[0], v1 = v[1], v2 = v[2], v3 = v[3];
+    out[0] = DOT4(m[0][0], m[0][1], m[0][2], m[0][3], v0, v1, v2, v3);
+    out[1] = DOT4(m[1][0], m[1][1], m[1][2], m[1][3], v0, v1, v2, v3);
+    out[2] = DOT4(m[2][0], m[2][1], m[2][2], m[2][3], v0, v1, v2, v3);
+}
+
+void mat3x4_t_mult_vec(const float m[3][4], const float v[3], float out[4]) {
+    const float v0 = v[0], v1 = v[1], v2 = v[2];
+    out[0] = DOT3(m[0][0], m[1][0], m[2][0], v0, v1, v2);
+    out[1] = DOT3(m[0][1], m[1][1], m[2][1], v0, v1, v2);
+    out[2] = DOT3(m[0][2], m[1][2], m[2][2], v0, v1, v2);
+    out[3] = DOT3(m[0][3], m[1][3], m[2][3], v0, v1, v2);
+}
+
+void mat2_mult(const float a[2][2], const float b[2][2], float out[2][2]) {
+    // only the rows are looped over, which the compiler unrolls since the bound is fixed
+    for (int i = 0; i < 2; i++) {
+        out[i][0] = DOT2(a[i][0], a[i][1], b[0][0], b[1][0]);
+        out[i][1] = DOT2(a[i][0], a[i][1], b[0][1], b[1][1]);
+    }
+}
+
+void mat3_mult(const float a[3][3], const float b[3][3], float out[3][3]) {
+    for (int i = 0; i < 3; i++) {
+        const float a0 = a[i][0], a1 = a[i][1], a2 = a[i][2];
+        out[i][0] = DOT3(a0, a1, a2, b[0][0], b[1][0], b[2][0]);
+        out[i][1] = DOT3(a0, a1, a2, b[0][1], b[1][1], b[2][1]);
+        out[i][2] = DOT3(a0, a1, a2, b[0][2], b[1][2], b[2][2]);
+    }
+}
+
+void mat4_mult(const float a[4][4], const float b[4][4], float out[4][4]) {
+    for (int i = 0; i < 4; i++) {
+        const float a0 = a[i][0], a1 = a[i][1], a2 = a[i][2], a3 = a[i][3];
+        out[i][0] = DOT4(a0, a1, a2, a3, b[0][0], b[1][0], b[2][0], b[3][0]);
+        out[i][1] = DOT4(a0, a1, a2, a3, b[0][1], b[1][1], b[2][1], b[3][1]);
+        out[i][2] = DOT4(a0, a1, a2, a3, b[0][2], b[1][2], b[2][2], b[3][2]);
+        out[i][3] = DOT4(a0, a1, a2, a3, b[0][3], b[1][3], b[2][3], b[3][3]);
+    }
+}
+
+bool mat2_inv(float m[2][2]) {
+    const float det = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+    if (det == 0.0f) {
+        return false;
+    }
+    // one division, since the FPU takes several times longer to divide than to multiply
+    const float inv_det = 1.0f / det;
+    const float m00 = m[0][0];
+    m[0][0] = m[1][1] * inv_det;
+    m[1][1] = m00 * inv_det;
+    m[0][1] = -m[0][1] * inv_det;
+    m[1][0] = -m[1][0] * inv_det;
+    return true;
+}
+
+bool mat3_inv(float m[3][3]) {
+    // the cofactors of the first row are reused for the determinant
+    const float c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    const float c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    const float c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    const float det = DOT3(m[0][0], m[0][1], m[0][2], c00, c01, c02);
+    if (det == 0.0f) {
+        return false;
+    }
+    const float inv_det = 1.0f / det;
+
+    // the inverse is the transpose of the cofactor matrix divided by the determinant
+    const float c10 = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+    const float c11 = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+    const float c12 = m[0][1] * m[2][0] - m[0][0] * m[2][1];
+    const float c20 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+    const float c21 = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+    const float c22 = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+
+    m[0][0] = c00 * inv_det;
+    m[0][1] = c10 * inv_det;
+    m[0][2] = c20 * inv_det;
+    m[1][0] = c01 * inv_det;
+    m[1][1] = c11 * inv_det;
+    m[1][2] = c21 * inv_det;
+    m[2][0] = c02 * inv_det;
+    m[2][1] = c12 * inv_det;
+    m[2][2] = c22 * inv_det;
+    return true;
+}
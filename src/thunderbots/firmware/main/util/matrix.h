@@ -1,4 +1,7 @@
+#ifndef UTIL_MATRIX_H
+#define UTIL_MATRIX_H
 
+#include <stdbool.h>
 
 /**
  * A representation of a matrix that has an arbitrary number of rows and columns specified by n_cols and n_rows.
@@ -70,3 +73,111 @@ void rotate_vector_2D(float vector[2], const float unit_vector[2]);
  */
 Matrix transpose(Matrix in_matrix);
 
+/*
+ * Fixed-size kernels for the small matrices used in the control loop. These are unrolled
+ * by hand so that they compile to straight-line floating point code with no loop or
+ * variable-length array indexing overhead, and use fused multiply-adds where the FPU has
+ * them. Unless stated otherwise, the output must not be the same array as any input.
+ */
+
+/**
+ * Multiplies a 2x2 matrix by a 2D vector.
+ *
+ * @param m the matrix
+ * @param v the vector
+ * @param out the result, m * v
+ * @return void
+ */
+void mat2_mult_vec(const float m[2][2], const float v[2], float out[2]);
+
+/**
+ * Multiplies a 3x3 matrix by a 3D vector.
+ *
+ * @param m the matrix
+ * @param v the vector
+ * @param out the result, m * v
+ * @return void
+ */
+void mat3_mult_vec(const float m[3][3], const float v[3], float out[3]);
+
+/**
+ * Multiplies a 4x4 matrix by a 4D vector.
+ *
+ * @param m the matrix
+ * @param v the vector
+ * @param out the result, m * v
+ * @return void
+ */
+void mat4_mult_vec(const float m[4][4], const float v[4], float out[4]);
+
+/**
+ * Multiplies a 3x4 matrix by a 4D vector, such as when converting wheel speeds or forces
+ * into robot speeds or forces.
+ *
+ * @param m the matrix
+ * @param v the vector
+ * @param out the result, m * v
+ * @return void
+ */
+void mat3x4_mult_vec(const float m[3][4], const float v[4], float out[3]);
+
+/**
+ * Multiplies the transpose of a 3x4 matrix by a 3D vector, such as when converting robot
+ * speeds or forces into wheel speeds or forces.
+ *
+ * @param m the matrix, which is transposed
+ * @param v the vector
+ * @param out the result, transpose(m) * v
+ * @return void
+ */
+void mat3x4_t_mult_vec(const float m[3][4], const float v[3], float out[4]);
+
+/**
+ * Multiplies two 2x2 matrices.
+ *
+ * @param a the left matrix
+ * @param b the right matrix
+ * @param out the result, a * b
+ * @return void
+ */
+void mat2_mult(const float a[2][2], const float b[2][2], float out[2][2]);
+
+/**
+ * Multiplies two 3x3 matrices.
+ *
+ * @param a the left matrix
+ * @param b the right matrix
+ * @param out the result, a * b
+ * @return void
+ */
+void mat3_mult(const float a[3][3], const float b[3][3], float out[3][3]);
+
+/**
+ * Multiplies two 4x4 matrices.
+ *
+ * @param a the left matrix
+ * @param b the right matrix
+ * @param out the result, a * b
+ * @return void
+ */
+void mat4_mult(const float a[4][4], const float b[4][4], float out[4][4]);
+
+/**
+ * Inverts a 2x2 matrix in place.
+ *
+ * @param m the matrix to invert
+ * @return true if the matrix was inverted, or false if it is singular, in which case it
+ * is left unchanged
+ */
+bool mat2_inv(float m[2][2]);
+
+/**
+ * Inverts a 3x3 matrix in place.
+ *
+ * @param m the matrix to invert
+ * @return true if the matrix was inverted, or false if it is singular, in which case it
+ * is left unchanged
+ */
+bool mat3_inv(float m[3][3]);
+
+#endif
@@ -1,4 +1,5 @@
 #include "physbot.h"
+#include "fast_math.h"
 #include "../dr.h"
 #include "../bangbang.h"
 #include "../physics.h"
@@ -47,9 +48,12 @@ void plan_move(Component *c, float p[3]) {
 
 void to_local_coords(float accel[3], PhysBot pb, float angle, float major_vec[2], 
     float minor_vec[2]) {
+    // The local y axis is the x axis rotated by pi / 2
+    float sin_angle, cos_angle;
+    fast_sincosf(angle, &sin_angle, &cos_angle);
     float local_norm_vec[2][2] = {
-        {cosf(angle), sinf(angle)}, 
-        {cosf(angle + P_PI / 2), sinf(angle + P_PI / 2)}
+        {cos_angle, sin_angle}, 
+        {-sin_angle, cos_angle}
     };
     for (int i = 0; i < 2; i++) {
         accel[i] =  pb.min.accel * dot2D(local_norm_vec[i], minor_vec);
@@ -106,9 +106,62 @@ void quad_optimize(PhysBot pb, dr_data_t state, float a_req[3]) {
     setup_indexing();
     to_1d_matrix(Q);
     solve();
-    double x = *vars.x;
-    // TODO: remove this print statement once we figure out what 
-    // parameters we need from the solver
-    printf("%f\n", x);
+}
+
+void quad_reset(QuadProblem *qp) {
+    for (int i = 0; i < 4; i++) {
+        qp->x[i] = 0.0f;
+    }
+}
+
+void quad_setup(QuadProblem *qp, PhysBot pb, dr_data_t state, float a_req[3]) {
+    float M[3][4];
+    float M_T[4][3];
+    build_M_matrix(pb, state, M);
+    transpose_qp(M, M_T);
+    build_Q_matrix(M, M_T, qp->Q);
+    build_c_matrix(a_req, M, qp->c);
+    // every wheel contributes to the rotation row of M, so the diagonal of Q is at
+    // least 1 and never needs to be checked for zero
+    for (int i = 0; i < 4; i++) {
+        qp->Q_diag_inv[i] = 0.5f / qp->Q[i][i];
+    }
+}
 
+unsigned int quad_solve(QuadProblem *qp, unsigned int max_iters, float tolerance) {
+    unsigned int iter = 0;
+    while (iter < max_iters) {
+        float max_step = 0.0f;
+        for (int i = 0; i < 4; i++) {
+            // the derivative of the objective along this wheel
+            float gradient = qp->c[i] + 2.0f * (qp->Q[i][0] * qp->x[0]
+                + qp->Q[i][1] * qp->x[1] + qp->Q[i][2] * qp->x[2]
+                + qp->Q[i][3] * qp->x[3]);
+            float new_x = qp->x[i] - gradient * qp->Q_diag_inv[i];
+            if (new_x > 1.0f) {
+                new_x = 1.0f;
+            } else if (new_x < -1.0f) {
+                new_x = -1.0f;
+            }
+            float step = fabsf(new_x - qp->x[i]);
+            if (step > max_step) {
+                max_step = step;
+            }
+            qp->x[i] = new_x;
+        }
+        iter++;
+        if (max_step <= tolerance) {
+            break;
+        }
+    }
+    return iter;
+}
+
+void quad_optimize_warm(QuadProblem *qp, PhysBot pb, dr_data_t state, float a_req[3],
+    float wheel_forces[4]) {
+    quad_setup(qp, pb, state, a_req);
+    quad_solve(qp, QUAD_MAX_ITERS, QUAD_TOLERANCE);
+    for (int i = 0; i < 4; i++) {
+        wheel_forces[i] = qp->x[i];
+    }
 }
\ No newline at end of file
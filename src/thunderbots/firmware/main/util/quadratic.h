@@ -4,6 +4,29 @@
 #include "physbot.h"
 #include "../dr.h"
 
+// The most coordinate descent sweeps quad_optimize_warm runs in one tick, which bounds
+// how long it takes no matter how badly the warm start guessed
+#define QUAD_MAX_ITERS 12
+
+// quad_optimize_warm stops once no wheel force changes by more than this in a sweep
+#define QUAD_TOLERANCE 1e-4f
+
+/**
+ * The wheel force optimization, minimize x.T * Q * x + c.T * x subject to
+ * -1 <= x <= 1, set up for the allocation-free solver.
+ *
+ * Q and c are the same as those given to the CVXGEN solver. Q_diag_inv holds the
+ * reciprocal of twice each diagonal entry of Q, the only factorization coordinate
+ * descent needs, so that a sweep has no divisions. x is the last solution, which the
+ * next solve starts from.
+ */
+typedef struct {
+    float Q[4][4];
+    float c[4];
+    float Q_diag_inv[4];
+    float x[4];
+} QuadProblem;
+
 /**
  * Builds the M matrix for the optimization. This matrix has one 
  * row for each acceleration (major, minor, rotational) and one 
@@ -75,4 +98,57 @@ void build_Q_matrix(float M[3][4], float M_T[4][3], float Q[4][4]);
  */
 void quad_optimize(PhysBot pb, dr_data_t state, float a_req[3]);
 
-#endif
\ No newline at end of file
+/**
+ * Clears the last solution of a QuadProblem, so the next solve starts from zero
+ * wheel forces. Call this when a primitive starts.
+ *
+ * @param qp the problem to reset
+ * @return void
+ */
+void quad_reset(QuadProblem *qp);
+
+/**
+ * Builds Q, c and the factorization of Q for this tick, keeping the last solution
+ * to start the next solve from.
+ *
+ * @param qp the problem to set up
+ * @param pb a PhysBot that was set up by that setup_bot function
+ * in physbot.c
+ * @param state a dr_data_t that contains the bot's current angle
+ * @param a_req a 3 length array with requested accelerations for major, minor,
+ * and rotational accelerations
+ * @return void
+ */
+void quad_setup(QuadProblem *qp, PhysBot pb, dr_data_t state, float a_req[3]);
+
+/**
+ * Solves a QuadProblem by projected coordinate descent, starting from its last
+ * solution. Each sweep minimizes the objective exactly along each wheel in turn and
+ * clamps the result to the constraints. This uses no memory other than the
+ * QuadProblem and the stack, and takes at most max_iters sweeps.
+ *
+ * @param qp the problem to solve, whose x is updated with the solution
+ * @param max_iters the most sweeps to run
+ * @param tolerance stop once no wheel force changes by more than this in a sweep
+ * @return the number of sweeps that were run
+ */
+unsigned int quad_solve(QuadProblem *qp, unsigned int max_iters, float tolerance);
+
+/**
+ * The production path for the wheel force optimization. Sets up the problem for this
+ * tick and solves it, warm started from the last tick's solution, with at most
+ * QUAD_MAX_ITERS sweeps.
+ *
+ * @param qp the problem, which keeps the solution between ticks
+ * @param pb a PhysBot that was set up by that setup_bot function
+ * in physbot.c
+ * @param state a dr_data_t that contains the bot's current angle
+ * @param a_req a 3 length array with requested accelerations for major, minor,
+ * and rotational accelerations
+ * @param wheel_forces the optimal force for each wheel, between -1 and 1
+ * @return void
+ */
+void quad_optimize_warm(QuadProblem *qp, PhysBot pb, dr_data_t state, float a_req[3],
+    float wheel_forces[4]);
+
+#endif
@@ -3,7 +3,7 @@
 
 float fmax_of_array(float array[], unsigned size) {
     unsigned i;
-    float max_value;
+    float max_value = 0.0f;
     for (i = 0; i < size; i++) {
         if (i == 0) {
             max_value = array[i];
@@ -17,7 +17,7 @@ float fmax_of_array(float array[], unsigned size) {
 
 float fmin_of_array(float array[], unsigned size) { 
     unsigned i;
-    float min_value;
+    float min_value = 0.0f;
     for (i = 0; i < size; i++) {
         if (i == 0) {
             min_value = array[i];
@@ -30,7 +30,7 @@ float fmin_of_array(float array[], unsigned size) {
 
 unsigned argmax(float array[], unsigned size) {
     unsigned i;
-    float max_value;
+    float max_value = 0.0f;
     unsigned max_index = 0;
     for (i = 0; i < size; i++) {
         if (i == 0) {
@@ -45,7 +45,7 @@ unsigned argmax(float array[], unsigned size) {
 
 unsigned argmin(float array[], unsigned size) { 
     unsigned i;
-    float min_value;
+    float min_value = 0.0f;
     unsigned min_index = 0;
     for (i = 0; i < size; i++) {
         if (i == 0) {
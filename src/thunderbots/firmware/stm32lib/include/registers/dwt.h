@@ -0,0 +1,53 @@
+/**
+ * \ingroup REG
+ * \defgroup REGDWT Data watchpoint and trace unit
+ * @{
+ */
+#ifndef STM32LIB_REGISTERS_DWT_H
+#define STM32LIB_REGISTERS_DWT_H
+
+#include <stdint.h>
+
+typedef struct {
+	unsigned CYCCNTENA : 1;
+	unsigned POSTPRESET : 4;
+	unsigned POSTINIT : 4;
+	unsigned CYCTAP : 1;
+	unsigned SYNCTAP : 2;
+	unsigned PCSAMPLENA : 1;
+	unsigned : 3;
+	unsigned EXCTRCENA : 1;
+	unsigned CPIEVTENA : 1;
+	unsigned EXCEVTENA : 1;
+	unsigned SLEEPEVTENA : 1;
+	unsigned LSUEVTENA : 1;
+	unsigned FOLDEVTENA : 1;
+	unsigned CYCEVTENA : 1;
+	unsigned : 1;
+	unsigned NOPRFCNT : 1;
+	unsigned NOCYCCNT : 1;
+	unsigned NOEXTTRIG : 1;
+	unsigned NOTRCPKT : 1;
+	unsigned NUMCOMP : 4;
+} DWT_CTRL_t;
+_Static_assert(sizeof(DWT_CTRL_t) == 4U, "DWT_CTRL_t is wrong size");
+
+typedef struct {
+	DWT_CTRL_t CTRL;
+	uint32_t CYCCNT;
+	uint32_t CPICNT;
+	uint32_t EXCCNT;
+	uint32_t SLEEPCNT;
+	uint32_t LSUCNT;
+	uint32_t FOLDCNT;
+	uint32_t PCSR;
+} DWT_t;
+_Static_assert(sizeof(DWT_t) == 0x1CU + 4U, "DWT_t is wrong size");
+
+extern volatile DWT_t DWT;
+
+#endif
+
+/**
+ * @}
+ */
@@ -1,7 +1,11 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <time.h>
 #include "check.h"
 #include "test.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 static int number_failed = 0;
 
@@ -14,6 +18,16 @@ void run_test(TCase *tc, Suite *s) {
     printf("\n");
 }
 
+uint64_t benchmark_timestamp(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+#endif
+}
+
 /**
  * Main entry point for the test cases. Each test to run should 
  * be wrapped inside a function that should be added here so that
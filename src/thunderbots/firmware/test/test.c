@@ -1,16 +1,24 @@
 
+#include "fast_math_test.h"
 #include "math_test.h"
 #include "matrix_test.h"
 #include "move_test.h"
 #include "physbot_test.h"
 #include "physics_test.h"
+#include "profile_test.h"
 #include "quadratic_test.h"
+#include "rx_frame_test.h"
+#include "rx_ring_test.h"
 #include "shoot_test.h"
 #include "util_test.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <time.h>
 #include "check.h"
 #include "test.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 static int number_failed = 0;
 
@@ -23,6 +31,16 @@ void run_test(TCase *tc, Suite *s) {
     printf("\n");
 }
 
+uint64_t benchmark_timestamp(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+#endif
+}
+
 /**
  * Main entry point for the test cases. Each test to run should 
  * be wrapped inside a function that should be added here so that
@@ -31,12 +49,16 @@ void run_test(TCase *tc, Suite *s) {
 int main(void)
 {
     printf("\nStart Tests\n");
+    run_fast_math_test();
     run_math_test();
     run_matrix_test();
     run_move_test();
     run_physbot_test();
     run_physics_test();
+    run_profile_test();
     run_quadratic_test();
+    run_rx_frame_test();
+    run_rx_ring_test();
     run_shoot_test();
     run_util_test();
     (number_failed == 0) ? printf("All tests passed.\n") : printf("%d Tests failed.\n\n", number_failed);
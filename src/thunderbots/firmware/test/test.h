@@ -1,4 +1,5 @@
 #include <check.h>
+#include <stdint.h>
 
 // Tolerance to pass to ck_assert_float_eq
 #define TOL 0.00001f
@@ -15,3 +16,17 @@
  * @return void
  */
 void run_test(TCase *tc, Suite *s);
+
+/**
+ * Returns a timestamp to measure short runs of code with in benchmarks. This is the
+ * cycle counter on x86 hosts, and nanoseconds of CPU time elsewhere.
+ *
+ * @return the timestamp
+ */
+uint64_t benchmark_timestamp(void);
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BENCHMARK_UNITS "cycles"
+#else
+#define BENCHMARK_UNITS "ns"
+#endif
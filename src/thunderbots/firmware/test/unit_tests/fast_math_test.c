@@ -0,0 +1,151 @@
+#include "check.h"
+#include "test.h"
+#include "main/util/fast_math.h"
+#include <math.h>
+#include <stdio.h>
+
+// The errors documented in fast_math.h
+#define SIN_COS_MAX_ERROR 1e-7
+#define ATAN2_MAX_ERROR 3e-7
+#define WRAP_ANGLE_MAX_ERROR 2e-7
+
+/**
+ * Finds the difference between two angles, ignoring whole turns
+ */
+static double angle_error(double a, double b) {
+    return fabs(remainder(a - b, 2.0 * M_PI));
+}
+
+START_TEST(test_sin_cos_error)
+{
+    double max_sin_error = 0.0, max_cos_error = 0.0;
+    for (float x = -FAST_MATH_MAX_ANGLE; x <= FAST_MATH_MAX_ANGLE; x += 0.0137f) {
+        max_sin_error = fmax(max_sin_error, fabs(fast_sinf(x) - sin((double) x)));
+        max_cos_error = fmax(max_cos_error, fabs(fast_cosf(x) - cos((double) x)));
+    }
+    printf("fast_sinf max error %.3g, fast_cosf max error %.3g\n", max_sin_error, max_cos_error);
+    ck_assert(max_sin_error <= SIN_COS_MAX_ERROR);
+    ck_assert(max_cos_error <= SIN_COS_MAX_ERROR);
+}
+END_TEST
+
+START_TEST(test_sin_cos_quadrant_boundaries)
+{
+    for (int i = -8; i <= 8; i++) {
+        float x = i * (float) M_PI_2;
+        ck_assert(fabs(fast_sinf(x) - sin((double) x)) <= SIN_COS_MAX_ERROR);
+        ck_assert(fabs(fast_cosf(x) - cos((double) x)) <= SIN_COS_MAX_ERROR);
+    }
+}
+END_TEST
+
+START_TEST(test_sincos_matches_sin_and_cos)
+{
+    for (float x = -20.0f; x <= 20.0f; x += 0.01f) {
+        float s, c;
+        fast_sincosf(x, &s, &c);
+        ck_assert_float_eq(fast_sinf(x), s);
+        ck_assert_float_eq(fast_cosf(x), c);
+    }
+}
+END_TEST
+
+START_TEST(test_atan2_error)
+{
+    double max_error = 0.0;
+    for (float radius = 1e-3f; radius < 1e3f; radius *= 3.7f) {
+        for (float angle = -3.14159f; angle <= 3.14159f; angle += 0.00123f) {
+            float y = radius * sinf(angle), x = radius * cosf(angle);
+            max_error = fmax(max_error, angle_error(fast_atan2f(y, x), atan2((double) y, (double) x)));
+        }
+    }
+    printf("fast_atan2f max error %.3g\n", max_error);
+    ck_assert(max_error <= ATAN2_MAX_ERROR);
+}
+END_TEST
+
+START_TEST(test_atan2_axes)
+{
+    ck_assert_float_eq(0.0f, fast_atan2f(0.0f, 0.0f));
+    ck_assert_float_eq_tol(0.0f, fast_atan2f(0.0f, 2.0f), TOL);
+    ck_assert_float_eq_tol((float) M_PI_2, fast_atan2f(2.0f, 0.0f), TOL);
+    ck_assert_float_eq_tol((float) M_PI, fast_atan2f(0.0f, -2.0f), TOL);
+    ck_assert_float_eq_tol((float) -M_PI_2, fast_atan2f(-2.0f, 0.0f), TOL);
+    ck_assert_float_eq_tol((float) M_PI_4, fast_atan2f(1.0f, 1.0f), TOL);
+    ck_assert_float_eq_tol((float) (-3.0 * M_PI_4), fast_atan2f(-1.0f, -1.0f), TOL);
+}
+END_TEST
+
+START_TEST(test_sqrt_is_exact)
+{
+    for (float x = 0.0f; x < 1000.0f; x += 0.37f) {
+        ck_assert_float_eq(sqrtf(x), fast_sqrtf(x));
+    }
+}
+END_TEST
+
+START_TEST(test_wrap_angle)
+{
+    double max_error = 0.0;
+    for (float x = -FAST_MATH_MAX_ANGLE; x <= FAST_MATH_MAX_ANGLE; x += 0.0137f) {
+        float wrapped = fast_wrap_angle(x);
+        ck_assert(fabsf(wrapped) <= (float) M_PI + 1e-6f);
+        max_error = fmax(max_error, angle_error(wrapped, x));
+    }
+    printf("fast_wrap_angle max error %.3g\n", max_error);
+    ck_assert(max_error <= WRAP_ANGLE_MAX_ERROR);
+}
+END_TEST
+
+START_TEST(test_fast_math_benchmark)
+{
+    // What a tick of move does: a rotation of the wheel forces and an atan2 for each of
+    // the eight wheel axes
+    const int num_ticks = 100000;
+    volatile float sink = 0.0f;
+    int i, j;
+
+    uint64_t start = benchmark_timestamp();
+    for (i = 0; i < num_ticks; i++) {
+        float angle = i * 1e-4f;
+        sink += sinf(angle) + cosf(angle);
+        for (j = 0; j < 8; j++) {
+            sink += atan2f(angle - j, 1.0f + j);
+        }
+    }
+    uint64_t libm = benchmark_timestamp() - start;
+    const float libm_result = sink;
+
+    sink = 0.0f;
+    start = benchmark_timestamp();
+    for (i = 0; i < num_ticks; i++) {
+        float angle = i * 1e-4f;
+        float s, c;
+        fast_sincosf(angle, &s, &c);
+        sink += s + c;
+        for (j = 0; j < 8; j++) {
+            sink += fast_atan2f(angle - j, 1.0f + j);
+        }
+    }
+    uint64_t fast = benchmark_timestamp() - start;
+
+    printf("Trig per move tick: libm %.1f, fast_math %.1f " BENCHMARK_UNITS "\n",
+           (double) libm / num_ticks, (double) fast / num_ticks);
+    // The timings depend on the host, so only the results are checked
+    ck_assert_float_eq_tol(libm_result, sink, fabsf(libm_result) * 0.0001f);
+}
+END_TEST
+
+void run_fast_math_test() {
+    Suite *s = suite_create("Fast Math Test");
+    TCase *tc = tcase_create("Core");
+    tcase_add_test(tc, test_sin_cos_error);
+    tcase_add_test(tc, test_sin_cos_quadrant_boundaries);
+    tcase_add_test(tc, test_sincos_matches_sin_and_cos);
+    tcase_add_test(tc, test_atan2_error);
+    tcase_add_test(tc, test_atan2_axes);
+    tcase_add_test(tc, test_sqrt_is_exact);
+    tcase_add_test(tc, test_wrap_angle);
+    tcase_add_test(tc, test_fast_math_benchmark);
+    run_test(tc, s);
+}
@@ -0,0 +1 @@
+void run_fast_math_test();
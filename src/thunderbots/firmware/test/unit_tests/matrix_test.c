@@ -2,10 +2,31 @@
 #include "check.h"
 #include "test.h"
 #include "main/util/matrix.h"
+#include "main/physics.h"
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+// Arbitrary matrices with no special structure to check the fixed-size kernels against
+// the generic ones
+static const float A3x4[3][4] = {
+    {-0.8192f, -0.7071f, 0.7071f, 0.8192f},
+    {0.5736f, -0.7071f, -0.7071f, 0.5736f},
+    {1.0f, 2.0f, -3.0f, 0.5f}
+};
+static const float A4x4[4][4] = {
+    {0.9995f, 0.0841f, 0.0153f, -0.0802f},
+    {-0.0895f, 0.9694f, 0.0855f, 0.0450f},
+    {-0.0153f, -0.0908f, 0.9995f, 0.0893f},
+    {0.0855f, 0.0144f, -0.0843f, 0.9712f}
+};
+static const float B4x4[4][4] = {
+    {1.0f, 2.0f, 3.0f, 4.0f},
+    {-5.0f, 6.0f, 7.0f, 8.0f},
+    {9.0f, -1.0f, 2.0f, 3.0f},
+    {4.0f, 5.0f, -6.0f, 7.0f}
+};
+
 START_TEST(test_matmul_vectors)
 {
     Matrix A = create_matrix(1, 2);
@@ -179,6 +200,201 @@ START_TEST(test_matrix_struct)
 }
 END_TEST
 
+START_TEST(test_mat3x4_mult_vec)
+{
+    int i;
+    const float v[4] = {1.0f, -2.0f, 3.5f, 0.25f};
+    float expected[3], result[3];
+    matrix_mult(expected, 3, v, 4, A3x4);
+    mat3x4_mult_vec(A3x4, v, result);
+    for (i = 0; i < 3; i++) {
+        ck_assert_float_eq_tol(expected[i], result[i], TOL);
+    }
+}
+END_TEST
+
+START_TEST(test_mat3x4_t_mult_vec)
+{
+    int i;
+    const float v[3] = {1.0f, -2.0f, 3.5f};
+    float expected[4], result[4];
+    matrix_mult_t(expected, 4, v, 3, (const float (*)[4]) A3x4);
+    mat3x4_t_mult_vec(A3x4, v, result);
+    for (i = 0; i < 4; i++) {
+        ck_assert_float_eq_tol(expected[i], result[i], TOL);
+    }
+}
+END_TEST
+
+START_TEST(test_matn_mult_vec)
+{
+    int i;
+    const float v[4] = {1.0f, -2.0f, 3.5f, 0.25f};
+    float expected[4], result[4];
+
+    matrix_mult(expected, 4, v, 4, A4x4);
+    mat4_mult_vec(A4x4, v, result);
+    for (i = 0; i < 4; i++) {
+        ck_assert_float_eq_tol(expected[i], result[i], TOL);
+    }
+
+    const float m3[3][3] = {{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}, {7.0f, 8.0f, 10.0f}};
+    matrix_mult(expected, 3, v, 3, m3);
+    mat3_mult_vec(m3, v, result);
+    for (i = 0; i < 3; i++) {
+        ck_assert_float_eq_tol(expected[i], result[i], TOL);
+    }
+
+    const float m2[2][2] = {{1.0f, 2.0f}, {3.0f, 4.0f}};
+    matrix_mult(expected, 2, v, 2, m2);
+    mat2_mult_vec(m2, v, result);
+    for (i = 0; i < 2; i++) {
+        ck_assert_float_eq_tol(expected[i], result[i], TOL);
+    }
+}
+END_TEST
+
+START_TEST(test_matn_mult)
+{
+    int i, j;
+    float expected4[4][4], result4[4][4];
+    mm_mult(4, 4, 4, A4x4, B4x4, expected4);
+    mat4_mult(A4x4, B4x4, result4);
+    for (i = 0; i < 4; i++) {
+        for (j = 0; j < 4; j++) {
+            ck_assert_float_eq_tol(expected4[i][j], result4[i][j], TOL);
+        }
+    }
+
+    const float a3[3][3] = {{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}, {7.0f, 8.0f, 10.0f}};
+    const float b3[3][3] = {{-1.0f, 0.5f, 2.0f}, {3.0f, -4.0f, 1.0f}, {0.0f, 2.0f, -2.0f}};
+    float expected3[3][3], result3[3][3];
+    mm_mult(3, 3, 3, a3, b3, expected3);
+    mat3_mult(a3, b3, result3);
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            ck_assert_float_eq_tol(expected3[i][j], result3[i][j], TOL);
+        }
+    }
+
+    const float a2[2][2] = {{1.0f, 2.0f}, {3.0f, 4.0f}};
+    const float b2[2][2] = {{-1.0f, 0.5f}, {2.0f, 3.0f}};
+    float expected2[2][2], result2[2][2];
+    mm_mult(2, 2, 2, a2, b2, expected2);
+    mat2_mult(a2, b2, result2);
+    for (i = 0; i < 2; i++) {
+        for (j = 0; j < 2; j++) {
+            ck_assert_float_eq_tol(expected2[i][j], result2[i][j], TOL);
+        }
+    }
+}
+END_TEST
+
+START_TEST(test_mat2_inv)
+{
+    int i, j;
+    const float m[2][2] = {{4.0f, 7.0f}, {2.0f, 6.0f}};
+    float inverse[2][2] = {{4.0f, 7.0f}, {2.0f, 6.0f}};
+    float identity[2][2];
+    ck_assert(mat2_inv(inverse));
+    mat2_mult(m, inverse, identity);
+    for (i = 0; i < 2; i++) {
+        for (j = 0; j < 2; j++) {
+            ck_assert_float_eq_tol(i == j ? 1.0f : 0.0f, identity[i][j], TOL);
+        }
+    }
+
+    float singular[2][2] = {{1.0f, 2.0f}, {2.0f, 4.0f}};
+    ck_assert(!mat2_inv(singular));
+    ck_assert_float_eq_tol(1.0f, singular[0][0], TOL);
+    ck_assert_float_eq_tol(4.0f, singular[1][1], TOL);
+}
+END_TEST
+
+START_TEST(test_mat3_inv)
+{
+    int i, j;
+    const float m[3][3] = {{2.0f, -1.0f, 0.0f}, {-1.0f, 2.0f, -1.0f}, {0.0f, -1.0f, 3.0f}};
+    float inverse[3][3], identity[3][3];
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            inverse[i][j] = m[i][j];
+        }
+    }
+    ck_assert(mat3_inv(inverse));
+    mat3_mult(m, inverse, identity);
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            ck_assert_float_eq_tol(i == j ? 1.0f : 0.0f, identity[i][j], TOL);
+        }
+    }
+
+    float singular[3][3] = {{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}, {7.0f, 8.0f, 9.0f}};
+    ck_assert(!mat3_inv(singular));
+    ck_assert_float_eq_tol(5.0f, singular[1][1], TOL);
+}
+END_TEST
+
+START_TEST(test_mm_inv_3x3)
+{
+    int i, j;
+    const float m[3][3] = {{1.0f, 2.0f, 3.0f}, {0.0f, 1.0f, 4.0f}, {5.0f, 6.0f, 0.0f}};
+    const float expected[3][3] = {{-24.0f, 18.0f, 5.0f}, {20.0f, -15.0f, -4.0f}, {-5.0f, 4.0f, 1.0f}};
+    float inverse[3][3];
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            inverse[i][j] = m[i][j];
+        }
+    }
+    mm_inv(3, inverse);
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            ck_assert_float_eq_tol(expected[i][j], inverse[i][j], 0.0001f);
+        }
+    }
+}
+END_TEST
+
+START_TEST(test_fixed_size_kernels_benchmark)
+{
+    // The matrix work done in each control tick: robot forces to wheel forces, the high
+    // centre of gravity correction, and wheel speeds to robot speeds
+    const int num_ticks = 100000;
+    float robot[3] = {0.0f, 0.2f, 0.3f};
+    float wheels[4], corrected[4], speeds[3];
+    // Keeps the compiler from removing the loops
+    volatile float sink = 0.0f;
+    int i;
+
+    uint64_t start = benchmark_timestamp();
+    for (i = 0; i < num_ticks; i++) {
+        robot[0] = i * 1e-6f;
+        matrix_mult_t(wheels, 4, robot, 3, (const float (*)[4]) A3x4);
+        matrix_mult(corrected, 4, wheels, 4, A4x4);
+        matrix_mult(speeds, 3, corrected, 4, A3x4);
+        sink += speeds[2];
+    }
+    uint64_t generic = benchmark_timestamp() - start;
+    const float generic_result = sink;
+
+    sink = 0.0f;
+    start = benchmark_timestamp();
+    for (i = 0; i < num_ticks; i++) {
+        robot[0] = i * 1e-6f;
+        mat3x4_t_mult_vec(A3x4, robot, wheels);
+        mat4_mult_vec(A4x4, wheels, corrected);
+        mat3x4_mult_vec(A3x4, corrected, speeds);
+        sink += speeds[2];
+    }
+    uint64_t fixed = benchmark_timestamp() - start;
+
+    printf("Matrix kernels per control tick: generic %.1f, fixed-size %.1f " BENCHMARK_UNITS "\n",
+           (double) generic / num_ticks, (double) fixed / num_ticks);
+    // The timings depend on the host, so only the results are checked
+    ck_assert_float_eq_tol(generic_result, sink, fabsf(generic_result) * 0.0001f);
+}
+END_TEST
+
 void run_matrix_test() {
     // Put the name of the suite of tests in here
     Suite *s = suite_create("Matrix Test");
@@ -192,6 +408,14 @@ void run_matrix_test() {
     tcase_add_test(tc, test_rotate_vector_2D);
     tcase_add_test(tc, test_transpose);
     tcase_add_test(tc, test_matrix_struct);
+    tcase_add_test(tc, test_mat3x4_mult_vec);
+    tcase_add_test(tc, test_mat3x4_t_mult_vec);
+    tcase_add_test(tc, test_matn_mult_vec);
+    tcase_add_test(tc, test_matn_mult);
+    tcase_add_test(tc, test_mat2_inv);
+    tcase_add_test(tc, test_mat3_inv);
+    tcase_add_test(tc, test_mm_inv_3x3);
+    tcase_add_test(tc, test_fixed_size_kernels_benchmark);
     // run the tests
     run_test(tc, s);
 }
\ No newline at end of file
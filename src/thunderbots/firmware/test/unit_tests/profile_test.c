@@ -0,0 +1,109 @@
+#include "check.h"
+#include "test.h"
+#include "main/profile.h"
+#include <string.h>
+
+// How much longer than we asked a tick may be measured as taking, in profile
+// counts, to allow for the time spent in the test itself
+#define SLACK (5000U * PROFILE_COUNTS_PER_US)
+
+START_TEST(test_read_clear_min_mean_max)
+{
+    profile_init();
+    // Pretend the module started its ticks 10, 20, and 30 ms ago
+    profile_end(PROFILE_MODULE_DR, profile_now() - 10000U * PROFILE_COUNTS_PER_US);
+    profile_end(PROFILE_MODULE_DR, profile_now() - 30000U * PROFILE_COUNTS_PER_US);
+    profile_end(PROFILE_MODULE_DR, profile_now() - 20000U * PROFILE_COUNTS_PER_US);
+
+    log_profile_t profile;
+    profile_read_clear(&profile);
+    ck_assert_uint_ge(profile.min[PROFILE_MODULE_DR], 10000U * PROFILE_COUNTS_PER_US);
+    ck_assert_uint_le(profile.min[PROFILE_MODULE_DR], 10000U * PROFILE_COUNTS_PER_US + SLACK);
+    ck_assert_uint_ge(profile.mean[PROFILE_MODULE_DR], 20000U * PROFILE_COUNTS_PER_US);
+    ck_assert_uint_le(profile.mean[PROFILE_MODULE_DR], 20000U * PROFILE_COUNTS_PER_US + SLACK);
+    ck_assert_uint_ge(profile.max[PROFILE_MODULE_DR], 30000U * PROFILE_COUNTS_PER_US);
+    ck_assert_uint_le(profile.max[PROFILE_MODULE_DR], 30000U * PROFILE_COUNTS_PER_US + SLACK);
+}
+END_TEST
+
+START_TEST(test_read_clear_idle_module_is_zero)
+{
+    profile_init();
+    profile_end(PROFILE_MODULE_DR, profile_now());
+
+    log_profile_t profile;
+    profile_read_clear(&profile);
+    ck_assert_uint_eq(0U, profile.min[PROFILE_MODULE_WHEELS]);
+    ck_assert_uint_eq(0U, profile.mean[PROFILE_MODULE_WHEELS]);
+    ck_assert_uint_eq(0U, profile.max[PROFILE_MODULE_WHEELS]);
+}
+END_TEST
+
+START_TEST(test_read_clear_counts_normal_ticks)
+{
+    profile_init();
+    for (unsigned int i = 0U; i != 7U; ++i) {
+        profile_end(PROFILE_MODULE_NORMAL_TICK, profile_now());
+    }
+    // Other modules don't count as ticks
+    profile_end(PROFILE_MODULE_FAST_TICK, profile_now());
+
+    log_profile_t profile;
+    profile_read_clear(&profile);
+    ck_assert_uint_eq(7U, profile.ticks);
+}
+END_TEST
+
+START_TEST(test_read_clear_starts_new_window)
+{
+    profile_init();
+    profile_end(PROFILE_MODULE_DR, profile_now() - 10000U * PROFILE_COUNTS_PER_US);
+
+    log_profile_t profile;
+    profile_read_clear(&profile);
+    profile_end(PROFILE_MODULE_DR, profile_now());
+    profile_read_clear(&profile);
+    ck_assert_uint_lt(profile.max[PROFILE_MODULE_DR], SLACK);
+}
+END_TEST
+
+START_TEST(test_end_returns_start_of_next_tick)
+{
+    profile_init();
+    uint32_t start = profile_now() - 10000U * PROFILE_COUNTS_PER_US;
+    uint32_t t = profile_end(PROFILE_MODULE_FEEDBACK, start);
+    profile_end(PROFILE_MODULE_RECEIVE, t);
+
+    log_profile_t profile;
+    profile_read_clear(&profile);
+    // The second module only counts the time since the first one ended
+    ck_assert_uint_ge(profile.max[PROFILE_MODULE_FEEDBACK], 10000U * PROFILE_COUNTS_PER_US);
+    ck_assert_uint_lt(profile.max[PROFILE_MODULE_RECEIVE], SLACK);
+}
+END_TEST
+
+START_TEST(test_latest_follows_read_clear)
+{
+    profile_init();
+    log_profile_t latest;
+    ck_assert(!profile_latest(&latest));
+
+    profile_end(PROFILE_MODULE_NORMAL_TICK, profile_now());
+    log_profile_t profile;
+    profile_read_clear(&profile);
+    ck_assert(profile_latest(&latest));
+    ck_assert_int_eq(0, memcmp(&profile, &latest, sizeof(profile)));
+}
+END_TEST
+
+void run_profile_test() {
+    Suite *s = suite_create("Profile Test");
+    TCase *tc = tcase_create("Core");
+    tcase_add_test(tc, test_read_clear_min_mean_max);
+    tcase_add_test(tc, test_read_clear_idle_module_is_zero);
+    tcase_add_test(tc, test_read_clear_counts_normal_ticks);
+    tcase_add_test(tc, test_read_clear_starts_new_window);
+    tcase_add_test(tc, test_end_returns_start_of_next_tick);
+    tcase_add_test(tc, test_latest_follows_read_clear);
+    run_test(tc, s);
+}
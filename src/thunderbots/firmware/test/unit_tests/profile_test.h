@@ -0,0 +1 @@
+void run_profile_test();
@@ -1,7 +1,9 @@
 #include "test.h"
 #include "check.h"
 #include "main/util/quadratic.h"
+#include "main/cvxgen/solver.h"
 #include <math.h>
+#include <stdio.h>
 
 // This is an M matrix that is used for multiple tests
 // It is primarily related to the Q matrix from the optimization
@@ -112,6 +114,160 @@ START_TEST(quadratic_test)
 }
 END_TEST
 
+/**
+ * Sets up the PhysBot, state and requested accelerations used by quadratic_test, with
+ * the robot turned to the given angle.
+ */
+static void setup_fixture(float angle, PhysBot *pb, dr_data_t *state, float a_req[3]) {
+    PhysBot fixture = {
+        .rot = {
+            .disp = 30.0f * M_PI / 180.0f
+        },
+        .major_vec = {1, 1},
+        .minor_vec = {1, 0}
+    };
+    *pb = fixture;
+    state->angle = angle;
+    a_req[0] = 0.1f;
+    a_req[1] = 0.5f;
+    a_req[2] = 0.4f;
+}
+
+/**
+ * Returns x.T * Q * x + c.T * x for the given problem.
+ */
+static float objective(const QuadProblem *qp, const float x[4]) {
+    float value = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        value += qp->c[i] * x[i];
+        for (int j = 0; j < 4; j++) {
+            value += x[i] * qp->Q[i][j] * x[j];
+        }
+    }
+    return value;
+}
+
+START_TEST(test_quad_solve_matches_cvxgen)
+{
+    PhysBot pb;
+    dr_data_t state;
+    float a_req[3];
+    setup_fixture(0.0f, &pb, &state, a_req);
+
+    quad_optimize(pb, state, a_req);
+    float cvxgen_x[4];
+    for (int i = 0; i < 4; i++) {
+        cvxgen_x[i] = (float) vars.x[i];
+    }
+
+    QuadProblem qp;
+    quad_reset(&qp);
+    quad_setup(&qp, pb, state, a_req);
+    unsigned int iters = quad_solve(&qp, 1000, 1e-6f);
+    ck_assert_uint_lt(iters, 1000);
+
+    // Q is singular, so the two solvers can find different optimal forces, but they
+    // must have the same cost
+    ck_assert_float_eq_tol(objective(&qp, cvxgen_x), objective(&qp, qp.x), 0.0001f);
+    for (int i = 0; i < 4; i++) {
+        ck_assert(qp.x[i] >= -1.0f && qp.x[i] <= 1.0f);
+    }
+}
+END_TEST
+
+START_TEST(test_quad_solve_is_bounded)
+{
+    PhysBot pb;
+    dr_data_t state;
+    float a_req[3];
+    setup_fixture(0.0f, &pb, &state, a_req);
+
+    QuadProblem qp;
+    quad_reset(&qp);
+    quad_setup(&qp, pb, state, a_req);
+    ck_assert_uint_eq(2, quad_solve(&qp, 2, 0.0f));
+    for (int i = 0; i < 4; i++) {
+        ck_assert(qp.x[i] >= -1.0f && qp.x[i] <= 1.0f);
+    }
+}
+END_TEST
+
+START_TEST(test_quad_solve_warm_start)
+{
+    PhysBot pb;
+    dr_data_t state;
+    float a_req[3];
+    setup_fixture(0.0f, &pb, &state, a_req);
+
+    QuadProblem qp;
+    quad_reset(&qp);
+    quad_setup(&qp, pb, state, a_req);
+    quad_solve(&qp, 1000, QUAD_TOLERANCE);
+
+    // the next tick, the robot has turned a little
+    setup_fixture(0.01f, &pb, &state, a_req);
+    quad_setup(&qp, pb, state, a_req);
+    unsigned int warm_iters = quad_solve(&qp, 1000, QUAD_TOLERANCE);
+    float warm_objective = objective(&qp, qp.x);
+
+    quad_reset(&qp);
+    unsigned int cold_iters = quad_solve(&qp, 1000, QUAD_TOLERANCE);
+
+    ck_assert_uint_lt(warm_iters, cold_iters);
+    ck_assert_float_eq_tol(objective(&qp, qp.x), warm_objective, 0.001f);
+}
+END_TEST
+
+START_TEST(test_quad_optimize_warm_benchmark)
+{
+    // A second of ticks with the robot turning at 1 rad/s, so each tick's problem is a
+    // little different from the last
+    const int num_ticks = 200;
+    PhysBot pb;
+    dr_data_t state;
+    float a_req[3];
+    float wheel_forces[4];
+    uint64_t total = 0, max = 0;
+    unsigned int max_iters = 0;
+
+    QuadProblem qp;
+    quad_reset(&qp);
+    for (int i = 0; i < num_ticks; i++) {
+        setup_fixture(i * 0.005f, &pb, &state, a_req);
+        uint64_t start = benchmark_timestamp();
+        quad_setup(&qp, pb, state, a_req);
+        unsigned int iters = quad_solve(&qp, QUAD_MAX_ITERS, QUAD_TOLERANCE);
+        uint64_t elapsed = benchmark_timestamp() - start;
+        total += elapsed;
+        max = elapsed > max ? elapsed : max;
+        max_iters = iters > max_iters ? iters : max_iters;
+        ck_assert_uint_le(iters, QUAD_MAX_ITERS);
+
+        // even when the sweeps run out, the cost is close to optimal
+        QuadProblem converged = qp;
+        quad_solve(&converged, 1000, 1e-6f);
+        ck_assert_float_eq_tol(objective(&converged, converged.x), objective(&qp, qp.x),
+                               0.001f);
+    }
+    setup_fixture(0.0f, &pb, &state, a_req);
+    quad_optimize_warm(&qp, pb, state, a_req, wheel_forces);
+    for (int i = 0; i < 4; i++) {
+        ck_assert_float_eq(qp.x[i], wheel_forces[i]);
+    }
+
+    // the CVXGEN solver, with its output turned off, on the same first problem
+    quad_optimize(pb, state, a_req);
+    settings.verbose = 0;
+    uint64_t start = benchmark_timestamp();
+    solve();
+    uint64_t cvxgen = benchmark_timestamp() - start;
+
+    printf("Wheel force QP per tick: warm started mean %.1f, max %lu (%u sweeps), "
+           "CVXGEN %lu " BENCHMARK_UNITS "\n", (double) total / num_ticks,
+           (unsigned long) max, max_iters, (unsigned long) cvxgen);
+}
+END_TEST
+
 /**
  * Test function manager for quadratic.c
  */ 
@@ -126,6 +282,10 @@ void run_quadratic_test() {
     tcase_add_test(tc, test_transpose);
     tcase_add_test(tc, test_build_Q_matrix);
     tcase_add_test(tc, test_build_c_matrix);
+    tcase_add_test(tc, test_quad_solve_matches_cvxgen);
+    tcase_add_test(tc, test_quad_solve_is_bounded);
+    tcase_add_test(tc, test_quad_solve_warm_start);
+    tcase_add_test(tc, test_quad_optimize_warm_benchmark);
     // run the tests
     run_test(tc, s);
 }
\ No newline at end of file
@@ -0,0 +1,369 @@
+#include "check.h"
+#include "test.h"
+#include "main/rx_frame.h"
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// How many random frames each fuzz test tries
+#define FUZZ_ITERATIONS 200000U
+
+// The length of the header, including the message purpose, and of the footer
+#define HEADER_LENGTH 10U
+#define FOOTER_LENGTH 4U
+
+#define DRIVE_FRAME_LENGTH (HEADER_LENGTH + 8U * 9U + 1U + FOOTER_LENGTH)
+
+/**
+ * A small, fast, deterministic random number generator, so fuzz failures reproduce
+ */
+static uint32_t fuzz_state;
+static uint32_t fuzz_random(void) {
+    fuzz_state ^= fuzz_state << 13;
+    fuzz_state ^= fuzz_state >> 17;
+    fuzz_state ^= fuzz_state << 5;
+    return fuzz_state;
+}
+
+static void put_u16(uint8_t *p, uint16_t value) {
+    p[0] = (uint8_t) value;
+    p[1] = (uint8_t) (value >> 8);
+}
+
+/**
+ * Writes the header the dongle puts on every frame, with the given destination and
+ * message purpose
+ */
+static void put_header(uint8_t *frame, uint8_t sequence_number, uint16_t destination, uint8_t purpose) {
+    put_u16(&frame[0], 0x8841U);
+    frame[2] = sequence_number;
+    put_u16(&frame[3], 0x1846U);
+    put_u16(&frame[5], destination);
+    put_u16(&frame[7], 0x0100U);
+    frame[9] = purpose;
+}
+
+/**
+ * Writes one robot's camera position
+ */
+static uint8_t *put_robot(uint8_t *p, int16_t x, int16_t y, int16_t angle) {
+    put_u16(&p[0], (uint16_t) x);
+    put_u16(&p[2], (uint16_t) y);
+    put_u16(&p[4], (uint16_t) angle);
+    return p + 6;
+}
+
+static uint8_t *put_timestamp(uint8_t *p, uint64_t timestamp) {
+    for (unsigned int i = 0; i < 8; i++) {
+        p[i] = (uint8_t) (timestamp >> (8 * i));
+    }
+    return p + 8;
+}
+
+/**
+ * Decodes a robot's drive data byte by byte, as receive.c did before the frame views,
+ * to check the views against
+ */
+static void reference_decode_drive(const uint8_t *frame, unsigned int index, rx_frame_drive_data_t *data) {
+    bool estop_run = !!frame[HEADER_LENGTH + 8 * 9];
+    const uint8_t *robot_data = frame + HEADER_LENGTH + 9 * index;
+    uint8_t serial = *robot_data++ & 0x7F;
+    uint16_t words[4];
+    for (unsigned int i = 0; i < 4; ++i) {
+        words[i] = *robot_data++;
+        words[i] |= (uint16_t) *robot_data++ << 8;
+    }
+    if (!estop_run) {
+        static const uint16_t MASK[4] = { 0x0000, 0x4000, 0x0000, 0x0000 };
+        for (unsigned int i = 0; i != 4; ++i) {
+            words[i] &= MASK[i];
+        }
+    }
+    memset(data, 0, sizeof(*data));
+    data->serial = serial;
+    data->estop_run = estop_run;
+    data->charge = !!(words[1] & 0x8000);
+    data->discharge = !!(words[1] & 0x4000);
+    for (unsigned int i = 0; i != 4; ++i) {
+        int16_t value = words[i] & 0x3FF;
+        if (words[i] & 0x400) {
+            value = -value;
+        }
+        if (words[i] & 0x800) {
+            value *= 10;
+        }
+        data->params.params[i] = value;
+    }
+    data->primitive = words[0] >> 12;
+    data->params.extra = (words[2] >> 12) | ((words[3] >> 12) << 4);
+    data->params.slow = !!(data->params.extra & 0x80);
+    data->params.extra &= 0x7F;
+}
+
+static bool drive_data_equal(const rx_frame_drive_data_t *a, const rx_frame_drive_data_t *b) {
+    return a->serial == b->serial && a->estop_run == b->estop_run && a->charge == b->charge && a->discharge == b->discharge && a->primitive == b->primitive && memcmp(a->params.params, b->params.params, sizeof(a->params.params)) == 0 && a->params.slow == b->params.slow && a->params.extra == b->params.extra;
+}
+
+START_TEST(test_check_accepts_frames_from_dongle)
+{
+    uint8_t frame[HEADER_LENGTH + FOOTER_LENGTH] = {0};
+    put_header(frame, 7, 0xFFFFU, RX_FRAME_PURPOSE_DRIVE);
+    const rx_frame_header_t *header = rx_frame_check(frame, sizeof(frame));
+    ck_assert_ptr_eq(frame, header);
+    ck_assert_uint_eq(7, header->sequence_number);
+    ck_assert_uint_eq(RX_FRAME_BROADCAST_ADDRESS, header->destination_address);
+    ck_assert_uint_eq(RX_FRAME_PURPOSE_DRIVE, header->purpose);
+}
+END_TEST
+
+START_TEST(test_check_rejects_other_frames)
+{
+    uint8_t frame[HEADER_LENGTH + FOOTER_LENGTH] = {0};
+    put_header(frame, 0, 0xFFFFU, RX_FRAME_PURPOSE_DRIVE);
+    ck_assert_ptr_null(rx_frame_check(frame, sizeof(frame) - 1));
+
+    // From another address
+    put_u16(&frame[7], 0x0101U);
+    ck_assert_ptr_null(rx_frame_check(frame, sizeof(frame)));
+
+    // Not a data frame
+    put_header(frame, 0, 0xFFFFU, RX_FRAME_PURPOSE_DRIVE);
+    frame[0] = 0x42U;
+    ck_assert_ptr_null(rx_frame_check(frame, sizeof(frame)));
+}
+END_TEST
+
+START_TEST(test_drive_decodes_robot_data)
+{
+    uint8_t frame[DRIVE_FRAME_LENGTH] = {0};
+    put_header(frame, 0, 0xFFFFU, RX_FRAME_PURPOSE_DRIVE);
+    uint8_t *robot = &frame[HEADER_LENGTH + 3 * 9];
+    robot[0] = 0x80U | 42U;
+    put_u16(&robot[1], (3U << 12) | 0x800U | 100U); // Primitive 3, 1000
+    put_u16(&robot[3], 0x8000U | 0x400U | 5U); // Charge, -5
+    put_u16(&robot[5], (0xAU << 12) | 7U); // Extra low nibble
+    put_u16(&robot[7], (0x9U << 12)); // Extra high nibble, with the slow bit
+    frame[HEADER_LENGTH + 8 * 9] = 1U;
+
+    const rx_frame_drive_t *drive = rx_frame_drive(frame, sizeof(frame));
+    ck_assert_ptr_nonnull(drive);
+    ck_assert(drive->robots[3].serial & RX_FRAME_DRIVE_FEEDBACK_REQUEST);
+
+    rx_frame_drive_data_t data;
+    rx_frame_decode_drive(drive, 3, &data);
+    ck_assert_uint_eq(42, data.serial);
+    ck_assert(data.estop_run);
+    ck_assert(data.charge);
+    ck_assert(!data.discharge);
+    ck_assert_uint_eq(3, data.primitive);
+    ck_assert_int_eq(1000, data.params.params[0]);
+    ck_assert_int_eq(-5, data.params.params[1]);
+    ck_assert_int_eq(7, data.params.params[2]);
+    ck_assert_int_eq(0, data.params.params[3]);
+    ck_assert(data.params.slow);
+    ck_assert_uint_eq(0x1A, data.params.extra);
+}
+END_TEST
+
+START_TEST(test_drive_estop_keeps_only_discharge)
+{
+    uint8_t frame[DRIVE_FRAME_LENGTH] = {0};
+    put_header(frame, 0, 0xFFFFU, RX_FRAME_PURPOSE_DRIVE);
+    uint8_t *robot = &frame[HEADER_LENGTH];
+    robot[0] = 5U;
+    put_u16(&robot[1], (3U << 12) | 100U);
+    put_u16(&robot[3], 0xC000U | 5U); // Charge and discharge
+    frame[HEADER_LENGTH + 8 * 9] = 0U;
+
+    rx_frame_drive_data_t data;
+    rx_frame_decode_drive(rx_frame_drive(frame, sizeof(frame)), 0, &data);
+    ck_assert_uint_eq(5, data.serial);
+    ck_assert(!data.estop_run);
+    ck_assert(!data.charge);
+    ck_assert(data.discharge);
+    ck_assert_uint_eq(0, data.primitive);
+    ck_assert_int_eq(0, data.params.params[0]);
+    ck_assert_int_eq(0, data.params.params[1]);
+}
+END_TEST
+
+START_TEST(test_drive_rejects_short_or_other_frames)
+{
+    uint8_t frame[DRIVE_FRAME_LENGTH] = {0};
+    put_header(frame, 0, 0xFFFFU, RX_FRAME_PURPOSE_DRIVE);
+    ck_assert_ptr_null(rx_frame_drive(frame, sizeof(frame) - 1));
+    frame[9] = RX_FRAME_PURPOSE_CAMERA;
+    ck_assert_ptr_null(rx_frame_drive(frame, sizeof(frame)));
+}
+END_TEST
+
+START_TEST(test_camera_finds_robot_among_others)
+{
+    uint8_t frame[128] = {0};
+    put_header(frame, 0, 0xFFFFU, RX_FRAME_PURPOSE_CAMERA);
+    uint8_t *p = &frame[HEADER_LENGTH];
+    *p++ = 0x2DU; // Robots 0, 2, 3, and 5
+    put_u16(p, (uint16_t) -1234);
+    put_u16(p + 2, 567U);
+    p += 4;
+    p = put_robot(p, 1, 2, 3);
+    p = put_robot(p, 20, 21, 22);
+    p = put_robot(p, -300, 301, -302);
+    p = put_robot(p, 50, 51, 52);
+    p = put_timestamp(p, 0x0123456789ABCDEFULL);
+    size_t length = (size_t) (p - frame) + FOOTER_LENGTH;
+
+    rx_frame_camera_data_t data;
+    ck_assert(rx_frame_decode_camera(frame, length, 3, &data));
+    ck_assert(data.keyframe);
+    ck_assert_int_eq(-1234, data.ball_x);
+    ck_assert_int_eq(567, data.ball_y);
+    ck_assert(data.contains_robot);
+    ck_assert_int_eq(-300, data.robot_x);
+    ck_assert_int_eq(301, data.robot_y);
+    ck_assert_int_eq(-302, data.robot_angle);
+    ck_assert_uint_eq(0x0123456789ABCDEFULL, data.timestamp);
+
+    ck_assert(rx_frame_decode_camera(frame, length, 1, &data));
+    ck_assert(!data.contains_robot);
+    ck_assert_uint_eq(0x0123456789ABCDEFULL, data.timestamp);
+
+    // The mask claims more robots than the frame holds
+    ck_assert(!rx_frame_decode_camera(frame, length - 1, 3, &data));
+}
+END_TEST
+
+START_TEST(test_compact_camera_keyframe_and_delta)
+{
+    uint8_t frame[128] = {0};
+    put_header(frame, 0, 0xFFFFU, RX_FRAME_PURPOSE_COMPACT_CAMERA);
+    uint8_t *p = &frame[HEADER_LENGTH];
+    *p++ = 0x80U | 9U;
+    *p++ = 0x06U; // Robots 1 and 2
+    put_u16(p, 10U);
+    put_u16(p + 2, 20U);
+    p += 4;
+    p = put_robot(p, 100, 101, 102);
+    p = put_robot(p, 200, 201, 202);
+    p = put_timestamp(p, 1000000U);
+    size_t length = (size_t) (p - frame) + FOOTER_LENGTH;
+
+    rx_frame_camera_data_t data;
+    ck_assert(rx_frame_decode_compact_camera(frame, length, 2, &data));
+    ck_assert(data.keyframe);
+    ck_assert_uint_eq(9, data.keyframe_id);
+    ck_assert(data.contains_robot);
+    ck_assert_int_eq(200, data.robot_x);
+    ck_assert_int_eq(202, data.robot_angle);
+    ck_assert_uint_eq(1000000U, data.timestamp);
+    ck_assert(!rx_frame_decode_compact_camera(frame, length - 1, 2, &data));
+
+    p = &frame[HEADER_LENGTH];
+    *p++ = 9U;
+    *p++ = 0x06U;
+    p += 4;
+    *p++ = 1; *p++ = 2; *p++ = 3;
+    *p++ = (uint8_t) -4; *p++ = 5; *p++ = (uint8_t) -6;
+    put_u16(p, 345U);
+    p += 2;
+    length = (size_t) (p - frame) + FOOTER_LENGTH;
+
+    ck_assert(rx_frame_decode_compact_camera(frame, length, 2, &data));
+    ck_assert(!data.keyframe);
+    ck_assert_uint_eq(9, data.keyframe_id);
+    ck_assert(data.contains_robot);
+    ck_assert_int_eq(-4, data.robot_x);
+    ck_assert_int_eq(5, data.robot_y);
+    ck_assert_int_eq(-6, data.robot_angle);
+    ck_assert_uint_eq(345U, data.timestamp);
+    ck_assert(!rx_frame_decode_compact_camera(frame, length - 1, 2, &data));
+}
+END_TEST
+
+START_TEST(test_fuzz_drive_matches_byte_decoding)
+{
+    fuzz_state = 0x12345678U;
+    uint8_t frame[DRIVE_FRAME_LENGTH];
+    unsigned int mismatches = 0;
+    for (unsigned int i = 0; i < FUZZ_ITERATIONS; i++) {
+        for (size_t j = 0; j < sizeof(frame); j++) {
+            frame[j] = (uint8_t) fuzz_random();
+        }
+        frame[9] = RX_FRAME_PURPOSE_DRIVE;
+        const rx_frame_drive_t *drive = rx_frame_drive(frame, sizeof(frame));
+        unsigned int index = fuzz_random() % RX_FRAME_NUM_ROBOTS;
+        rx_frame_drive_data_t data, expected;
+        rx_frame_decode_drive(drive, index, &data);
+        reference_decode_drive(frame, index, &expected);
+        if (!drive_data_equal(&expected, &data)) {
+            mismatches++;
+        }
+    }
+    ck_assert_uint_eq(0, mismatches);
+}
+END_TEST
+
+START_TEST(test_fuzz_never_reads_past_frame)
+{
+    // Put each frame at the very end of a page followed by an inaccessible page, so
+    // reading one byte past its end crashes the test
+    long page_size = sysconf(_SC_PAGESIZE);
+    uint8_t *pages = mmap(0, 2 * page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ck_assert_ptr_ne(MAP_FAILED, pages);
+    ck_assert_int_eq(0, mprotect(pages + page_size, page_size, PROT_NONE));
+    uint8_t *page_end = pages + page_size;
+
+    fuzz_state = 0x9E3779B9U;
+    unsigned int decoded = 0;
+    for (unsigned int i = 0; i < FUZZ_ITERATIONS; i++) {
+        size_t length = fuzz_random() % (RX_FRAME_FOOTER_LENGTH + 100U);
+        uint8_t *frame = page_end - length;
+        for (size_t j = 0; j < length; j++) {
+            frame[j] = (uint8_t) fuzz_random();
+        }
+        // Make most frames look like they came from the dongle, so the decoders past
+        // the header are exercised
+        if (length >= HEADER_LENGTH && fuzz_random() % 8U != 0U) {
+            static const uint8_t PURPOSES[] = { RX_FRAME_PURPOSE_DRIVE, RX_FRAME_PURPOSE_CAMERA, RX_FRAME_PURPOSE_COMPACT_CAMERA };
+            put_header(frame, frame[2], 0xFFFFU, PURPOSES[fuzz_random() % 3U]);
+        }
+
+        unsigned int index = fuzz_random() % (RX_FRAME_NUM_ROBOTS + 1U);
+        if (!rx_frame_check(frame, length)) {
+            continue;
+        }
+        const rx_frame_drive_t *drive = rx_frame_drive(frame, length);
+        if (drive && index < RX_FRAME_NUM_ROBOTS) {
+            rx_frame_drive_data_t data;
+            rx_frame_decode_drive(drive, index, &data);
+            decoded++;
+        }
+        rx_frame_camera_data_t camera;
+        if (rx_frame_decode_camera(frame, length, index, &camera)) {
+            decoded++;
+        }
+        if (rx_frame_decode_compact_camera(frame, length, index, &camera)) {
+            decoded++;
+        }
+    }
+
+    munmap(pages, 2 * page_size);
+    // Make sure the fuzzing got past the length checks often enough to mean something
+    ck_assert_uint_gt(decoded, FUZZ_ITERATIONS / 10U);
+}
+END_TEST
+
+void run_rx_frame_test() {
+    Suite *s = suite_create("Received Frame Test");
+    TCase *tc = tcase_create("Core");
+    tcase_add_test(tc, test_check_accepts_frames_from_dongle);
+    tcase_add_test(tc, test_check_rejects_other_frames);
+    tcase_add_test(tc, test_drive_decodes_robot_data);
+    tcase_add_test(tc, test_drive_estop_keeps_only_discharge);
+    tcase_add_test(tc, test_drive_rejects_short_or_other_frames);
+    tcase_add_test(tc, test_camera_finds_robot_among_others);
+    tcase_add_test(tc, test_compact_camera_keyframe_and_delta);
+    tcase_add_test(tc, test_fuzz_drive_matches_byte_decoding);
+    tcase_add_test(tc, test_fuzz_never_reads_past_frame);
+    run_test(tc, s);
+}
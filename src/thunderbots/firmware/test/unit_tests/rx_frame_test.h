@@ -0,0 +1 @@
+void run_rx_frame_test();
@@ -0,0 +1,180 @@
+#include "check.h"
+#include "test.h"
+#include "main/rx_ring.h"
+#include <limits.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+// How many frames the producer thread sends through the ring in the threaded test
+#define THREADED_FRAMES 50000U
+
+static uint8_t buffers[RX_RING_SLOTS][RX_RING_BUFFER_LENGTH];
+static rx_ring_t ring;
+
+static void setup(void) {
+    uint8_t *buffer_pointers[RX_RING_SLOTS];
+    for (unsigned int i = 0; i < RX_RING_SLOTS; i++) {
+        buffer_pointers[i] = buffers[i];
+    }
+    rx_ring_init(&ring, buffer_pointers);
+}
+
+/**
+ * Receives a frame of the given length, filled with the given byte, into the ring
+ */
+static void write_frame(uint8_t fill, size_t length) {
+    rx_frame_t *frame = rx_ring_write_get(&ring);
+    ck_assert_ptr_nonnull(frame);
+    memset(frame->buffer, fill, length);
+    frame->length = length;
+    rx_ring_write_put(&ring);
+}
+
+START_TEST(test_new_ring_is_empty)
+{
+    setup();
+    ck_assert_ptr_null(rx_ring_read_get(&ring));
+    ck_assert_ptr_nonnull(rx_ring_write_get(&ring));
+}
+END_TEST
+
+START_TEST(test_frames_are_read_in_order)
+{
+    setup();
+    write_frame(1, 10);
+    write_frame(2, 20);
+    write_frame(3, 30);
+    for (uint8_t fill = 1; fill <= 3; fill++) {
+        const rx_frame_t *frame = rx_ring_read_get(&ring);
+        ck_assert_ptr_nonnull(frame);
+        ck_assert_uint_eq(fill * 10U, frame->length);
+        ck_assert_uint_eq(fill, frame->buffer[0]);
+        ck_assert_uint_eq(fill, frame->buffer[frame->length - 1]);
+        rx_ring_read_put(&ring);
+    }
+    ck_assert_ptr_null(rx_ring_read_get(&ring));
+}
+END_TEST
+
+START_TEST(test_frames_are_received_in_place)
+{
+    setup();
+    // Every buffer is handed out in turn, and never copied
+    for (unsigned int i = 0; i < 2 * RX_RING_SLOTS; i++) {
+        rx_frame_t *written = rx_ring_write_get(&ring);
+        ck_assert_ptr_eq(buffers[i % RX_RING_SLOTS], written->buffer);
+        written->length = 1;
+        rx_ring_write_put(&ring);
+        ck_assert_ptr_eq(buffers[i % RX_RING_SLOTS], rx_ring_read_get(&ring)->buffer);
+        rx_ring_read_put(&ring);
+    }
+}
+END_TEST
+
+START_TEST(test_full_ring_refuses_writes_until_read)
+{
+    setup();
+    for (unsigned int i = 0; i < RX_RING_SLOTS; i++) {
+        write_frame(i, 1);
+    }
+    ck_assert_ptr_null(rx_ring_write_get(&ring));
+
+    // The buffer the consumer releases is the one the producer gets next
+    const uint8_t *released = rx_ring_read_get(&ring)->buffer;
+    rx_ring_read_put(&ring);
+    rx_frame_t *frame = rx_ring_write_get(&ring);
+    ck_assert_ptr_nonnull(frame);
+    ck_assert_ptr_eq(released, frame->buffer);
+}
+END_TEST
+
+START_TEST(test_unsubmitted_frame_is_dropped)
+{
+    setup();
+    rx_frame_t *first = rx_ring_write_get(&ring);
+    rx_frame_t *second = rx_ring_write_get(&ring);
+    ck_assert_ptr_eq(first, second);
+    ck_assert_ptr_null(rx_ring_read_get(&ring));
+}
+END_TEST
+
+START_TEST(test_counters_wrap)
+{
+    setup();
+    ring.head = UINT_MAX - 1U;
+    ring.tail = UINT_MAX - 1U;
+    for (uint8_t fill = 0; fill < 8; fill++) {
+        write_frame(fill, 1);
+        write_frame(fill + 100, 2);
+        ck_assert_uint_eq(fill, rx_ring_read_get(&ring)->buffer[0]);
+        rx_ring_read_put(&ring);
+        ck_assert_uint_eq(fill + 100, rx_ring_read_get(&ring)->buffer[0]);
+        rx_ring_read_put(&ring);
+    }
+    ck_assert_ptr_null(rx_ring_read_get(&ring));
+}
+END_TEST
+
+/**
+ * Sends THREADED_FRAMES frames through the ring, each holding its own number in every
+ * byte and a length that depends on it
+ */
+static void *produce(void *arg) {
+    (void) arg;
+    for (unsigned int i = 0; i < THREADED_FRAMES; i++) {
+        rx_frame_t *frame;
+        while (!(frame = rx_ring_write_get(&ring))) {
+            sched_yield();
+        }
+        size_t length = 1U + i % RX_RING_BUFFER_LENGTH;
+        memset(frame->buffer, (uint8_t) i, length);
+        frame->length = length;
+        rx_ring_write_put(&ring);
+    }
+    return 0;
+}
+
+START_TEST(test_threads_pass_every_frame_intact)
+{
+    setup();
+    pthread_t producer;
+    ck_assert_int_eq(0, pthread_create(&producer, 0, &produce, 0));
+
+    // Count the mismatches rather than asserting on each byte, which would be slow
+    unsigned int bad_frames = 0;
+    for (unsigned int i = 0; i < THREADED_FRAMES; i++) {
+        const rx_frame_t *frame;
+        while (!(frame = rx_ring_read_get(&ring))) {
+            // Let the producer run even on a single core
+            sched_yield();
+        }
+        bool intact = frame->length == 1U + i % RX_RING_BUFFER_LENGTH;
+        for (size_t j = 0; j < frame->length; j++) {
+            intact = intact && frame->buffer[j] == (uint8_t) i;
+        }
+        if (!intact) {
+            bad_frames++;
+        }
+        rx_ring_read_put(&ring);
+    }
+
+    ck_assert_int_eq(0, pthread_join(producer, 0));
+    ck_assert_uint_eq(0, bad_frames);
+    ck_assert_ptr_null(rx_ring_read_get(&ring));
+}
+END_TEST
+
+void run_rx_ring_test() {
+    Suite *s = suite_create("Received Frame Ring Test");
+    TCase *tc = tcase_create("Core");
+    tcase_add_test(tc, test_new_ring_is_empty);
+    tcase_add_test(tc, test_frames_are_read_in_order);
+    tcase_add_test(tc, test_frames_are_received_in_place);
+    tcase_add_test(tc, test_full_ring_refuses_writes_until_read);
+    tcase_add_test(tc, test_unsubmitted_frame_is_dropped);
+    tcase_add_test(tc, test_counters_wrap);
+    tcase_add_test(tc, test_threads_pass_every_frame_intact);
+    run_test(tc, s);
+}
@@ -0,0 +1 @@
+void run_rx_ring_test();
@@ -0,0 +1,151 @@
+/**
+ * \defgroup FWSIM_BRIDGE Firmware-in-the-Loop Bridge
+ *
+ * \brief Runs a whole simulated robot for the AI's firmware-in-the-loop
+ * backend.
+ *
+ * Radio frames from the host go through the real \ref receive_frame and
+ * \ref handle_drive_packet into \ref primitive_start, and every tick runs
+ * \ref receive_tick and \ref primitive_tick against the simulated robot, timed
+ * by the profiler in the same way as the normal tick.
+ *
+ * The firmware keeps its state in static variables, so this is built as a
+ * shared library, and the host loads a private copy of the library for each
+ * robot.
+ *
+ * @{
+ */
+#include "bridge.h"
+#include "physics.h"
+#include "primitives/primitive.h"
+#include "profile.h"
+#include "receive.h"
+#include "simulate.h"
+
+/**
+ * \brief The number of ticks since the last profiling window was closed.
+ */
+static unsigned int window_ticks;
+
+/**
+ * \brief Starts the robot, stopped at the given position.
+ *
+ * \param[in] index the robot index, which picks the robot's data out of drive
+ * packets
+ * \param[in] pos the position and orientation of the robot
+ */
+void fwsim_bridge_init(unsigned int index, const float pos[3]) {
+	static const float STOPPED[3] = { 0.0f, 0.0f, 0.0f };
+	sim_reset();
+	sim_set_state(pos, STOPPED);
+	profile_init();
+	primitive_init();
+	receive_init(index);
+	window_ticks = 0U;
+}
+
+/**
+ * \brief Moves the ball the primitives see.
+ *
+ * \param[in] pos the position of the ball
+ * \param[in] vel the velocity of the ball
+ */
+void fwsim_bridge_set_ball(const float pos[2], const float vel[2]) {
+	sim_set_ball(pos, vel);
+}
+
+/**
+ * \brief Hands the robot a frame received over radio.
+ *
+ * \param[in] frame the frame, starting with the frame control word
+ * \param[in] frame_length the length of the frame, including the FCS, RSSI and
+ * LQI at the end
+ */
+void fwsim_bridge_receive(uint8_t *frame, size_t frame_length) {
+	receive_frame(frame, frame_length);
+}
+
+/**
+ * \brief Runs one normal tick, and then advances the simulated robot by one
+ * control period.
+ *
+ * Only the firmware is timed, not the simulation of the robot.
+ */
+void fwsim_bridge_tick(void) {
+	uint32_t tick_start = profile_now();
+	uint32_t t = profile_now();
+	receive_tick(NULL);
+	profile_end(PROFILE_MODULE_RECEIVE, t);
+	primitive_tick(NULL);
+
+	// Close the profiling window once a second, as the normal tick does.
+	profile_end(PROFILE_MODULE_NORMAL_TICK, tick_start);
+	if (++window_ticks == PROFILE_WINDOW_TICKS) {
+		window_ticks = 0U;
+		log_profile_t profile;
+		profile_read_clear(&profile);
+	}
+
+	sim_tick(TICK_TIME);
+}
+
+/**
+ * \brief Returns the position and velocity of the robot.
+ *
+ * \param[out] state the state of the robot
+ */
+void fwsim_bridge_get_state(fwsim_bridge_state_t *state) {
+	dr_data_t data;
+	dr_get(&data);
+	state->x = data.x;
+	state->y = data.y;
+	state->angle = data.angle;
+	state->vx = data.vx;
+	state->vy = data.vy;
+	state->avel = data.avel;
+}
+
+/**
+ * \brief Returns the serial number of the most recently applied drive data and
+ * how long ago it was applied.
+ *
+ * \param[out] serial the serial number of the drive data
+ * \param[out] age_ms how long ago the drive data was applied, in milliseconds
+ * \retval true drive data has been received and the outputs were filled
+ * \retval false no drive data has been received yet
+ */
+bool fwsim_bridge_last_serial_age(uint8_t *serial, uint32_t *age_ms) {
+	return receive_last_serial_age(serial, age_ms);
+}
+
+/**
+ * \brief Returns the CPU time of the normal tick over the last profiling
+ * window.
+ *
+ * The busiest module is picked in the same way as in the feedback packet.
+ *
+ * \param[out] profile the CPU time of the normal tick
+ * \retval true a window has completed and \p profile was filled
+ * \retval false no window has completed yet
+ */
+bool fwsim_bridge_profile(fwsim_bridge_profile_t *profile) {
+	log_profile_t latest;
+	if (!profile_latest(&latest)) {
+		return false;
+	}
+	unsigned int busiest = 0U;
+	for (unsigned int i = 0U; i != PROFILE_MODULE_NORMAL_TICK; ++i) {
+		if (latest.mean[i] > latest.mean[busiest]) {
+			busiest = i;
+		}
+	}
+	profile->normal_tick_mean_us = (float) latest.mean[PROFILE_MODULE_NORMAL_TICK] / PROFILE_COUNTS_PER_US;
+	profile->normal_tick_max_us = (float) latest.max[PROFILE_MODULE_NORMAL_TICK] / PROFILE_COUNTS_PER_US;
+	profile->busiest_module = busiest;
+	profile->busiest_module_mean_us = (float) latest.mean[busiest] / PROFILE_COUNTS_PER_US;
+	return true;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,75 @@
+#ifndef FWSIM_BRIDGE_H
+#define FWSIM_BRIDGE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// This header is included by the AI's firmware-in-the-loop backend, so it must
+// only use types that both C and C++ understand, and must not include any
+// other firmware headers
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \ingroup FWSIM_BRIDGE
+ *
+ * \brief Marks the functions the host looks up in the bridge library.
+ *
+ * Everything else is hidden, so each copy of the library only ever calls its
+ * own copy of the firmware.
+ */
+#define FWSIM_BRIDGE_EXPORT __attribute__((visibility("default")))
+
+/**
+ * \ingroup FWSIM_BRIDGE
+ *
+ * \brief The position and velocity of the simulated robot.
+ *
+ * Positions are in metres, orientations in radians, and velocities in metres
+ * or radians per second, in the coordinates of the field.
+ */
+typedef struct {
+	float x;
+	float y;
+	float angle;
+	float vx;
+	float vy;
+	float avel;
+} fwsim_bridge_state_t;
+
+/**
+ * \ingroup FWSIM_BRIDGE
+ *
+ * \brief The CPU time of the simulated robot's normal tick over the last
+ * profiling window, as the robot reports it in its feedback.
+ */
+typedef struct {
+	/**
+	 * \brief The mean and longest normal tick, in microseconds.
+	 */
+	float normal_tick_mean_us;
+	float normal_tick_max_us;
+
+	/**
+	 * \brief The module that took the longest on average, in the order of
+	 * \c PROFILE_MODULES, and its mean time in microseconds.
+	 */
+	unsigned int busiest_module;
+	float busiest_module_mean_us;
+} fwsim_bridge_profile_t;
+
+FWSIM_BRIDGE_EXPORT void fwsim_bridge_init(unsigned int index, const float pos[3]);
+FWSIM_BRIDGE_EXPORT void fwsim_bridge_set_ball(const float pos[2], const float vel[2]);
+FWSIM_BRIDGE_EXPORT void fwsim_bridge_receive(uint8_t *frame, size_t frame_length);
+FWSIM_BRIDGE_EXPORT void fwsim_bridge_tick(void);
+FWSIM_BRIDGE_EXPORT void fwsim_bridge_get_state(fwsim_bridge_state_t *state);
+FWSIM_BRIDGE_EXPORT bool fwsim_bridge_last_serial_age(uint8_t *serial, uint32_t *age_ms);
+FWSIM_BRIDGE_EXPORT bool fwsim_bridge_profile(fwsim_bridge_profile_t *profile);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
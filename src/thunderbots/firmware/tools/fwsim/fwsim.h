@@ -0,0 +1,136 @@
+#ifndef FWSIM_H
+#define FWSIM_H
+
+#include "primitives/primitive.h"
+#include "simulate.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * \brief A robot to run the scenarios on.
+ */
+typedef struct {
+	/**
+	 * \brief The name printed in the results.
+	 */
+	const char *name;
+
+	/**
+	 * \brief How the simulated robot differs from the nominal robot.
+	 */
+	sim_plant_t plant;
+} fwsim_robot_t;
+
+/**
+ * \brief A single primitive to run from a known starting state.
+ *
+ * Positions are in metres, orientations in radians, and velocities in metres
+ * or radians per second, matching \ref dr_data_t.
+ */
+typedef struct {
+	/**
+	 * \brief The name printed in the results.
+	 */
+	const char *name;
+
+	/**
+	 * \brief The primitive to run.
+	 */
+	const primitive_t *primitive;
+
+	/**
+	 * \brief The parameters given to the primitive, in the units the host sends.
+	 */
+	primitive_params_t params;
+
+	/**
+	 * \brief The position, orientation and velocity the robot starts with.
+	 */
+	float start_pos[3];
+	float start_vel[3];
+
+	/**
+	 * \brief Where the primitive should leave the robot.
+	 */
+	float target_pos[2];
+	float target_angle;
+	float target_avel;
+
+	/**
+	 * \brief Which parts of the target the robot must reach to have settled.
+	 * The position is always checked.
+	 */
+	bool check_angle;
+	bool check_avel;
+
+	/**
+	 * \brief How long the primitive is run for, in seconds.
+	 */
+	float duration;
+} fwsim_scenario_t;
+
+/**
+ * \brief How a robot did in a scenario.
+ */
+typedef struct {
+	/**
+	 * \brief Whether the robot was within tolerance of the target from some
+	 * tick until the end of the scenario.
+	 */
+	bool settled;
+
+	/**
+	 * \brief The time at which the robot settled, in seconds.
+	 */
+	float settling_time;
+
+	/**
+	 * \brief How far the robot went past the target along the line it started
+	 * on, in metres, and past the target orientation, in radians.
+	 */
+	float overshoot;
+	float angle_overshoot;
+
+	/**
+	 * \brief The distance from the target at the end of the scenario, in
+	 * metres.
+	 */
+	float final_error;
+
+	/**
+	 * \brief The number of control ticks run.
+	 */
+	unsigned int ticks;
+
+	/**
+	 * \brief The CPU time and cycles spent in the primitive’s tick function.
+	 *
+	 * Cycles are only counted on x86, and are 0 elsewhere.
+	 */
+	uint64_t total_tick_ns;
+	uint64_t max_tick_ns;
+	uint64_t total_tick_cycles;
+	uint64_t max_tick_cycles;
+} fwsim_result_t;
+
+/**
+ * \brief The largest distance from the target position, in metres, at which
+ * the robot counts as being there.
+ */
+#define FWSIM_POSITION_TOLERANCE 0.03f
+
+/**
+ * \brief The largest error in orientation, in radians, and in angular
+ * velocity, in radians per second, at which the robot counts as being there.
+ */
+#define FWSIM_ANGLE_TOLERANCE 0.05f
+#define FWSIM_AVEL_TOLERANCE 0.2f
+
+extern const fwsim_robot_t FWSIM_ROBOTS[];
+extern const unsigned int FWSIM_NUM_ROBOTS;
+extern const fwsim_scenario_t FWSIM_SCENARIOS[];
+extern const unsigned int FWSIM_NUM_SCENARIOS;
+
+void fwsim_run(const fwsim_robot_t *robot, const fwsim_scenario_t *scenario, fwsim_result_t *result);
+
+#endif
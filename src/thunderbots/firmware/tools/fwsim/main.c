@@ -0,0 +1,213 @@
+/**
+ * \defgroup FWSIM Firmware Simulator
+ *
+ * \brief Runs the real primitive code against the simulated robot on the
+ * host.
+ *
+ * Every scenario is run on every robot, each in its own process since the
+ * primitives and the simulated robot keep their state in static variables.
+ * Up to one process per processor runs at once, and the results are sent
+ * back to the parent through a pipe and printed as a table.
+ *
+ * Usage: <tt>sim [-j jobs] [-c max_mean_cycles] [-s]</tt>
+ * \li \c -j sets how many processes run at once
+ * \li \c -c fails the run if any primitive takes more cycles per tick, on
+ * average, than given
+ * \li \c -s fails the run if the robot does not settle in any scenario
+ *
+ * @{
+ */
+#include "fwsim.h"
+#include "physics.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * \brief A run that has been started but not collected.
+ */
+typedef struct {
+	pid_t pid;
+	int result_fd;
+	unsigned int index;
+} job_t;
+
+/**
+ * \brief Runs a scenario in a new process.
+ *
+ * \param[in] index the index of the run, which selects the robot and scenario
+ * \param[out] job the process that was started
+ * \return \c true if the process was started
+ */
+static bool start_job(unsigned int index, job_t *job) {
+	int fds[2];
+	if (pipe(fds) < 0) {
+		perror("pipe");
+		return false;
+	}
+
+	pid_t pid = fork();
+	if (pid < 0) {
+		perror("fork");
+		close(fds[0]);
+		close(fds[1]);
+		return false;
+	}
+
+	if (pid == 0) {
+		close(fds[0]);
+		// The primitives print their own debugging output, which would
+		// otherwise be interleaved with the table
+		int null_fd = open("/dev/null", O_WRONLY);
+		if (null_fd >= 0) {
+			dup2(null_fd, STDOUT_FILENO);
+		}
+
+		fwsim_result_t result;
+		fwsim_run(&FWSIM_ROBOTS[index % FWSIM_NUM_ROBOTS], &FWSIM_SCENARIOS[index / FWSIM_NUM_ROBOTS], &result);
+		// The result is smaller than PIPE_BUF, so it is written all at once
+		_exit(write(fds[1], &result, sizeof(result)) == (ssize_t) sizeof(result) ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	close(fds[1]);
+	job->pid = pid;
+	job->result_fd = fds[0];
+	job->index = index;
+	return true;
+}
+
+/**
+ * \brief Waits for a run to finish and reads its result.
+ *
+ * \param[in] job the process to wait for
+ * \param[out] result how the robot did
+ * \return \c true if the process finished and sent its result
+ */
+static bool finish_job(const job_t *job, fwsim_result_t *result) {
+	ssize_t length;
+	do {
+		length = read(job->result_fd, result, sizeof(*result));
+	} while (length < 0 && errno == EINTR);
+	close(job->result_fd);
+
+	int status;
+	while (waitpid(job->pid, &status, 0) < 0 && errno == EINTR);
+	return length == (ssize_t) sizeof(*result) && WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+}
+
+/**
+ * \brief Prints how a robot did in a scenario.
+ *
+ * \param[in] index the index of the run, which selects the robot and scenario
+ * \param[in] result how the robot did
+ */
+static void print_result(unsigned int index, const fwsim_result_t *result) {
+	printf("%-26s %-16s ", FWSIM_SCENARIOS[index / FWSIM_NUM_ROBOTS].name, FWSIM_ROBOTS[index % FWSIM_NUM_ROBOTS].name);
+	if (result->settled) {
+		printf("%8.3f ", result->settling_time);
+	} else {
+		printf("%8s ", "-");
+	}
+	printf("%9.3f %9.3f %9.3f %9" PRIu64 " %9" PRIu64 " %10" PRIu64 " %10" PRIu64 "\n",
+			result->overshoot, result->angle_overshoot, result->final_error,
+			result->total_tick_ns / result->ticks, result->max_tick_ns,
+			result->total_tick_cycles / result->ticks, result->max_tick_cycles);
+}
+
+int main(int argc, char **argv) {
+	long num_jobs = sysconf(_SC_NPROCESSORS_ONLN);
+	uint64_t max_mean_cycles = 0;
+	bool require_settled = false;
+	int opt;
+	while ((opt = getopt(argc, argv, "j:c:s")) != -1) {
+		switch (opt) {
+			case 'j':
+				num_jobs = strtol(optarg, NULL, 10);
+				break;
+			case 'c':
+				max_mean_cycles = strtoull(optarg, NULL, 10);
+				break;
+			case 's':
+				require_settled = true;
+				break;
+			default:
+				fprintf(stderr, "Usage: %s [-j jobs] [-c max_mean_cycles] [-s]\n", argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+	if (num_jobs < 1) {
+		num_jobs = 1;
+	}
+
+	const unsigned int num_runs = FWSIM_NUM_ROBOTS * FWSIM_NUM_SCENARIOS;
+	fwsim_result_t *results = calloc(num_runs, sizeof(*results));
+	bool *finished = calloc(num_runs, sizeof(*finished));
+	job_t *jobs = calloc((size_t) num_jobs, sizeof(*jobs));
+	if (!results || !finished || !jobs) {
+		perror("calloc");
+		return EXIT_FAILURE;
+	}
+
+	// Output is flushed before forking so the children don't print it again
+	fflush(stdout);
+	struct timespec start_time, end_time;
+	clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+	// Runs are started in order, and the oldest is collected once every slot
+	// is in use, so the slots are a ring of the most recently started runs
+	unsigned int num_started = 0, num_collected = 0;
+	while (num_collected != num_runs) {
+		if (num_started != num_runs && num_started - num_collected < (unsigned int) num_jobs) {
+			if (start_job(num_started, &jobs[num_started % num_jobs])) {
+				++num_started;
+				continue;
+			}
+			if (num_started == num_collected) {
+				return EXIT_FAILURE;
+			}
+		}
+		const job_t *job = &jobs[num_collected % num_jobs];
+		finished[job->index] = finish_job(job, &results[job->index]);
+		++num_collected;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end_time);
+	double wall_time = (double) (end_time.tv_sec - start_time.tv_sec) + (double) (end_time.tv_nsec - start_time.tv_nsec) / 1.0e9;
+
+	printf("%-26s %-16s %8s %9s %9s %9s %9s %9s %10s %10s\n",
+			"scenario", "robot", "settle_s", "over_m", "over_rad", "error_m",
+			"mean_ns", "max_ns", "mean_cyc", "max_cyc");
+	bool passed = true;
+	double simulated_time = 0.0;
+	for (unsigned int i = 0; i != num_runs; ++i) {
+		if (!finished[i]) {
+			printf("%-26s %-16s crashed\n", FWSIM_SCENARIOS[i / FWSIM_NUM_ROBOTS].name, FWSIM_ROBOTS[i % FWSIM_NUM_ROBOTS].name);
+			passed = false;
+			continue;
+		}
+		print_result(i, &results[i]);
+		simulated_time += results[i].ticks * TICK_TIME;
+		if (require_settled && !results[i].settled) {
+			passed = false;
+		}
+		if (max_mean_cycles && results[i].total_tick_cycles / results[i].ticks > max_mean_cycles) {
+			passed = false;
+		}
+	}
+	printf("Simulated %.1f s of control in %.2f s (%.0fx real time)\n",
+			simulated_time, wall_time, wall_time > 0.0 ? simulated_time / wall_time : 0.0);
+
+	free(results);
+	free(finished);
+	free(jobs);
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,140 @@
+/**
+ * \defgroup FWSIM_RUN Closed-Loop Runs
+ *
+ * \brief Runs a primitive against the simulated robot at the control loop
+ * rate and measures how well and how cheaply it gets there.
+ *
+ * Each tick, the primitive reads the simulated robot’s state through
+ * \ref dr_get and drives its wheels through \ref apply_accel, exactly as it
+ * does on the robot, and the simulation then advances by one control period.
+ * The simulation advances as fast as the host can run it, so the results do
+ * not depend on how fast the host is, except for the time spent in each tick.
+ *
+ * @{
+ */
+#include "fwsim.h"
+#include "physics.h"
+#include <math.h>
+#include <stddef.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * \brief Returns the CPU time used by the calling thread.
+ *
+ * \return the CPU time, in nanoseconds
+ */
+static uint64_t thread_cpu_ns(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+	return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+/**
+ * \brief Returns the processor’s cycle counter.
+ *
+ * \return the cycle count, or 0 if the host has no counter we can read
+ */
+static uint64_t cycle_count(void) {
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+/**
+ * \brief Runs a scenario on a robot.
+ *
+ * The primitive keeps its state in static variables, as does the simulated
+ * robot, so only one scenario can be run in each process.
+ *
+ * \param[in] robot the robot to simulate
+ * \param[in] scenario the scenario to run
+ * \param[out] result how the robot did
+ */
+void fwsim_run(const fwsim_robot_t *robot, const fwsim_scenario_t *scenario, fwsim_result_t *result) {
+	*result = (fwsim_result_t) { .settling_time = -1.0f };
+
+	sim_reset();
+	sim_set_plant(&robot->plant);
+	sim_set_state(scenario->start_pos, scenario->start_vel);
+
+	// The overshoot is measured along the line from the start to the target,
+	// and past the target orientation in the direction the robot has to turn
+	float approach[2] = {
+		scenario->target_pos[0] - scenario->start_pos[0],
+		scenario->target_pos[1] - scenario->start_pos[1],
+	};
+	float approach_length = norm2(approach[0], approach[1]);
+	if (approach_length > 0.0f) {
+		approach[0] /= approach_length;
+		approach[1] /= approach_length;
+	}
+	float turn_direction = min_angle_delta(scenario->start_pos[2], scenario->target_angle) >= 0.0f ? 1.0f : -1.0f;
+
+	scenario->primitive->init();
+	scenario->primitive->start(&scenario->params);
+
+	// The tick at which the robot last came within tolerance, or -1 if it is
+	// outside tolerance now
+	int settled_tick = -1;
+	const unsigned int num_ticks = (unsigned int) lroundf(scenario->duration * CONTROL_LOOP_HZ);
+	dr_data_t state;
+	for (unsigned int tick = 0; tick != num_ticks; ++tick) {
+		uint64_t start_ns = thread_cpu_ns();
+		uint64_t start_cycles = cycle_count();
+		scenario->primitive->tick(NULL);
+		uint64_t tick_cycles = cycle_count() - start_cycles;
+		uint64_t tick_ns = thread_cpu_ns() - start_ns;
+
+		result->total_tick_ns += tick_ns;
+		result->total_tick_cycles += tick_cycles;
+		if (tick_ns > result->max_tick_ns) {
+			result->max_tick_ns = tick_ns;
+		}
+		if (tick_cycles > result->max_tick_cycles) {
+			result->max_tick_cycles = tick_cycles;
+		}
+		++result->ticks;
+
+		sim_tick(TICK_TIME);
+		dr_get(&state);
+
+		float error[2] = {
+			state.x - scenario->target_pos[0],
+			state.y - scenario->target_pos[1],
+		};
+		float overshoot = error[0] * approach[0] + error[1] * approach[1];
+		if (overshoot > result->overshoot) {
+			result->overshoot = overshoot;
+		}
+		float angle_error = min_angle_delta(state.angle, scenario->target_angle);
+		if (scenario->check_angle && -turn_direction * angle_error > result->angle_overshoot) {
+			result->angle_overshoot = -turn_direction * angle_error;
+		}
+
+		result->final_error = norm2(error[0], error[1]);
+		bool within_tolerance = result->final_error <= FWSIM_POSITION_TOLERANCE
+			&& (!scenario->check_angle || fabsf(angle_error) <= FWSIM_ANGLE_TOLERANCE)
+			&& (!scenario->check_avel || fabsf(state.avel - scenario->target_avel) <= FWSIM_AVEL_TOLERANCE);
+		if (!within_tolerance) {
+			settled_tick = -1;
+		} else if (settled_tick < 0) {
+			settled_tick = (int) tick + 1;
+		}
+	}
+
+	scenario->primitive->end();
+
+	result->settled = settled_tick >= 0;
+	if (result->settled) {
+		result->settling_time = settled_tick * TICK_TIME;
+	}
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,94 @@
+/**
+ * \defgroup FWSIM_SCENARIOS Simulation Scenarios
+ *
+ * \brief The robots and scenarios that every primitive is checked against.
+ *
+ * Every scenario is run on every robot. The primitive parameters are in the
+ * same units the host sends over the radio, so a scenario can be copied from a
+ * log of a real game.
+ *
+ * The shoot primitive is left out on purpose: it drives through its target at
+ * 1 m/s to kick the ball and only stops once something is in the way, so it
+ * never settles on a target in the way these scenarios measure.
+ *
+ * @{
+ */
+#include "fwsim.h"
+#include "primitives/move.h"
+#include "primitives/pivot.h"
+#include "primitives/spin.h"
+
+const fwsim_robot_t FWSIM_ROBOTS[] = {
+	{ .name = "nominal", .plant = { .grip = 1.0f, .drag = 1.0f } },
+	// Wheels with worn rollers slip at a lower force
+	{ .name = "worn_wheels", .plant = { .grip = 0.6f, .drag = 1.0f } },
+	// Long carpet slows the robot down more than the lab floor
+	{ .name = "carpet", .plant = { .grip = 1.0f, .drag = 2.0f } },
+	{ .name = "worn_on_carpet", .plant = { .grip = 0.6f, .drag = 2.0f } },
+};
+
+const unsigned int FWSIM_NUM_ROBOTS = sizeof(FWSIM_ROBOTS) / sizeof(*FWSIM_ROBOTS);
+
+const fwsim_scenario_t FWSIM_SCENARIOS[] = {
+	{
+		.name = "move_short",
+		.primitive = &MOVE_PRIMITIVE,
+		.params = { .params = { 500, 0, 0, 0 } },
+		.target_pos = { 0.5f, 0.0f },
+		.target_angle = 0.0f,
+		.check_angle = true,
+		.duration = 3.0f,
+	},
+	{
+		.name = "move_long_turn",
+		.primitive = &MOVE_PRIMITIVE,
+		.params = { .params = { 3000, 1000, 157, 0 } },
+		.target_pos = { 3.0f, 1.0f },
+		.target_angle = 1.57f,
+		.check_angle = true,
+		.duration = 5.0f,
+	},
+	{
+		.name = "move_backwards_half_turn",
+		.primitive = &MOVE_PRIMITIVE,
+		.params = { .params = { -1500, 1500, 314, 0 } },
+		.target_pos = { -1.5f, 1.5f },
+		.target_angle = 3.14f,
+		.check_angle = true,
+		.duration = 5.0f,
+	},
+	{
+		// The robot is already moving away from where it is sent
+		.name = "move_while_moving",
+		.primitive = &MOVE_PRIMITIVE,
+		.params = { .params = { 0, 1000, 0, 0 } },
+		.start_vel = { 1.5f, 0.0f, 0.0f },
+		.target_pos = { 0.0f, 1.0f },
+		.target_angle = 0.0f,
+		.check_angle = true,
+		.duration = 5.0f,
+	},
+	{
+		// A pivot ends 0.15 m from its centre, at the given angle
+		.name = "pivot_quarter_turn",
+		.primitive = &PIVOT_PRIMITIVE,
+		.params = { .params = { 150, 0, 157, 100 } },
+		.target_pos = { 0.15f, 0.15f },
+		.duration = 5.0f,
+	},
+	{
+		.name = "spin",
+		.primitive = &SPIN_PRIMITIVE,
+		.params = { .params = { 1000, 0, 300, 0 } },
+		.target_pos = { 1.0f, 0.0f },
+		.target_avel = 3.0f,
+		.check_avel = true,
+		.duration = 4.0f,
+	},
+};
+
+const unsigned int FWSIM_NUM_SCENARIOS = sizeof(FWSIM_SCENARIOS) / sizeof(*FWSIM_SCENARIOS);
+
+/**
+ * @}
+ */
@@ -0,0 +1,533 @@
+#include "log_decoder.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+extern "C"
+{
+#include "main/log.h"
+#include "main/upgrade/constants.h"
+}
+
+static_assert(sizeof(log_record_t) == LOG_RECORD_SIZE,
+              "log_record_t is not LOG_RECORD_SIZE bytes long");
+
+const std::size_t LOG_FIRST_SECTOR_ON_CARD =
+    UPGRADE_SD_AREA_SECTORS * UPGRADE_SD_AREA_COUNT;
+
+namespace
+{
+    const std::size_t RECORDS_PER_SECTOR = SD_SECTOR_SIZE / LOG_RECORD_SIZE;
+
+    // The magic of the records that pad out the last sector of an epoch
+    const std::uint32_t LOG_MAGIC_PADDING = 0;
+
+    /**
+     * Describes where a field is in a log_record_t, without any data
+     */
+    struct ColumnDescription
+    {
+        const char* name;
+        LogColumnType type;
+        std::size_t size;
+        std::size_t record_offset;
+    };
+
+#define RECORD_COLUMN(member, type)                                                      \
+    ColumnDescription                                                                    \
+    {                                                                                    \
+        #member, type, sizeof(log_record_t::member), offsetof(log_record_t, member)      \
+    }
+#define TICK_COLUMN(member, type)                                                        \
+    ColumnDescription                                                                    \
+    {                                                                                    \
+        #member, type, sizeof(log_tick_t::member), offsetof(log_record_t, tick.member)   \
+    }
+#define PROFILE_COLUMN(member, type)                                                     \
+    ColumnDescription                                                                    \
+    {                                                                                    \
+        #member, type, sizeof(log_profile_t::member),                                    \
+            offsetof(log_record_t, profile.member)                                       \
+    }
+
+    // Every field of a tick record, in the order they are in log_tick_t
+    const ColumnDescription COLUMN_DESCRIPTIONS[] = {
+        RECORD_COLUMN(epoch, LogColumnType::UINT32),
+        RECORD_COLUMN(time, LogColumnType::UINT64),
+        TICK_COLUMN(breakbeam_diff, LogColumnType::FLOAT32),
+        TICK_COLUMN(battery_voltage, LogColumnType::FLOAT32),
+        TICK_COLUMN(capacitor_voltage, LogColumnType::FLOAT32),
+        TICK_COLUMN(dr_x, LogColumnType::FLOAT32),
+        TICK_COLUMN(dr_y, LogColumnType::FLOAT32),
+        TICK_COLUMN(dr_angle, LogColumnType::FLOAT32),
+        TICK_COLUMN(dr_vx, LogColumnType::FLOAT32),
+        TICK_COLUMN(dr_vy, LogColumnType::FLOAT32),
+        TICK_COLUMN(dr_avel, LogColumnType::FLOAT32),
+        TICK_COLUMN(enc_vx, LogColumnType::FLOAT32),
+        TICK_COLUMN(enc_vy, LogColumnType::FLOAT32),
+        TICK_COLUMN(enc_avel, LogColumnType::FLOAT32),
+        TICK_COLUMN(accelerometer_x, LogColumnType::FLOAT32),
+        TICK_COLUMN(accelerometer_y, LogColumnType::FLOAT32),
+        TICK_COLUMN(accelerometer_z, LogColumnType::FLOAT32),
+        TICK_COLUMN(gyro_avel, LogColumnType::FLOAT32),
+        TICK_COLUMN(cam_x, LogColumnType::FLOAT32),
+        TICK_COLUMN(cam_y, LogColumnType::FLOAT32),
+        TICK_COLUMN(cam_angle, LogColumnType::FLOAT32),
+        TICK_COLUMN(cam_ball_x, LogColumnType::FLOAT32),
+        TICK_COLUMN(cam_ball_y, LogColumnType::FLOAT32),
+        TICK_COLUMN(cam_delay, LogColumnType::UINT16),
+        TICK_COLUMN(new_cam_data, LogColumnType::UINT8),
+        TICK_COLUMN(drive_serial, LogColumnType::UINT8),
+        TICK_COLUMN(primitive, LogColumnType::UINT8),
+        TICK_COLUMN(primitive_data, LogColumnType::FLOAT32),
+        TICK_COLUMN(wheels_encoder_counts, LogColumnType::INT16),
+        TICK_COLUMN(wheels_drives, LogColumnType::INT16),
+        TICK_COLUMN(wheels_temperatures, LogColumnType::UINT8),
+        TICK_COLUMN(dribbler_ticked, LogColumnType::UINT8),
+        TICK_COLUMN(dribbler_pwm, LogColumnType::UINT8),
+        TICK_COLUMN(dribbler_speed, LogColumnType::UINT8),
+        TICK_COLUMN(dribbler_temperature, LogColumnType::UINT8),
+        TICK_COLUMN(idle_cpu_cycles, LogColumnType::UINT32),
+        TICK_COLUMN(errors, LogColumnType::UINT8),
+    };
+
+    // Every field of a profile record, in the order they are in log_profile_t
+    const ColumnDescription PROFILE_COLUMN_DESCRIPTIONS[] = {
+        RECORD_COLUMN(epoch, LogColumnType::UINT32),
+        RECORD_COLUMN(time, LogColumnType::UINT64),
+        PROFILE_COLUMN(ticks, LogColumnType::UINT32),
+        PROFILE_COLUMN(min, LogColumnType::UINT32),
+        PROFILE_COLUMN(mean, LogColumnType::UINT32),
+        PROFILE_COLUMN(max, LogColumnType::UINT32),
+    };
+
+#undef RECORD_COLUMN
+#undef TICK_COLUMN
+#undef PROFILE_COLUMN
+
+    /**
+     * What one thread found in its chunk of the log
+     */
+    struct ChunkSummary
+    {
+        std::size_t first_sector;
+        std::size_t end_sector;
+        std::size_t num_tick_records;
+        std::size_t num_profile_records;
+        std::size_t num_padding_records;
+        std::size_t num_invalid_records;
+        std::size_t num_epoch_regressions;
+        std::size_t num_time_regressions;
+        // Each run of consecutive tick and profile records with the same epoch
+        std::vector<LogEpochSummary> epochs;
+    };
+
+    /**
+     * Reads the magic, epoch and time of a record, which may not be aligned in the image
+     */
+    std::uint32_t readMagic(const std::uint8_t* record)
+    {
+        std::uint32_t magic;
+        std::memcpy(&magic, record + offsetof(log_record_t, magic), sizeof(magic));
+        return magic;
+    }
+
+    std::uint32_t readEpoch(const std::uint8_t* record)
+    {
+        std::uint32_t epoch;
+        std::memcpy(&epoch, record + offsetof(log_record_t, epoch), sizeof(epoch));
+        return epoch;
+    }
+
+    std::uint64_t readTime(const std::uint8_t* record)
+    {
+        std::uint64_t time;
+        std::memcpy(&time, record + offsetof(log_record_t, time), sizeof(time));
+        return time;
+    }
+
+    /**
+     * Checks whether a magic is one the robot writes while it is logging, as opposed to
+     * padding, an erased sector, or a corrupt record
+     */
+    bool isDataMagic(std::uint32_t magic)
+    {
+        return magic == LOG_MAGIC_TICK || magic == LOG_MAGIC_PROFILE;
+    }
+
+    /**
+     * Creates empty columns for the fields in a table of descriptions
+     *
+     * @param descriptions The fields
+     * @param num_records The number of records the columns must hold
+     *
+     * @return the columns, big enough to hold the given number of records
+     */
+    template <std::size_t N>
+    std::vector<LogColumn> createColumns(const ColumnDescription (&descriptions)[N],
+                                         std::size_t num_records)
+    {
+        std::vector<LogColumn> columns;
+        for (const ColumnDescription& description : descriptions)
+        {
+            LogColumn column;
+            column.name          = description.name;
+            column.type          = description.type;
+            column.width         = description.size / getLogColumnTypeSize(description.type);
+            column.record_offset = description.record_offset;
+            column.data.resize(num_records * description.size);
+            columns.push_back(std::move(column));
+        }
+        return columns;
+    }
+
+    /**
+     * Copies one record into a row of a set of columns
+     */
+    void copyRecord(const std::uint8_t* record, std::size_t row,
+                    std::vector<LogColumn>& columns)
+    {
+        for (LogColumn& column : columns)
+        {
+            const std::size_t size = column.width * getLogColumnTypeSize(column.type);
+            std::memcpy(column.data.data() + row * size, record + column.record_offset,
+                        size);
+        }
+    }
+
+    /**
+     * Adds a tick record to a list of epoch runs, counting any epoch or time that goes
+     * backwards
+     *
+     * @param epoch The epoch of the record
+     * @param time The timestamp of the record
+     * @param epochs The runs of records with the same epoch so far
+     * @param num_epoch_regressions Incremented if the epoch is lower than the last one
+     * @param num_time_regressions Incremented if the time is earlier than the last one
+     * in the same epoch
+     */
+    void addToEpochs(std::uint32_t epoch, std::uint64_t time,
+                     std::vector<LogEpochSummary>& epochs,
+                     std::size_t& num_epoch_regressions, std::size_t& num_time_regressions)
+    {
+        if (!epochs.empty() && epochs.back().epoch == epoch)
+        {
+            LogEpochSummary& current = epochs.back();
+            if (time < current.last_time)
+            {
+                num_time_regressions++;
+            }
+            current.num_records++;
+            current.last_time = time;
+            return;
+        }
+
+        if (!epochs.empty() && epoch < epochs.back().epoch)
+        {
+            num_epoch_regressions++;
+        }
+        epochs.push_back({epoch, 1, time, time});
+    }
+
+    /**
+     * Counts and checks the records in a chunk of the log
+     *
+     * @param image The image of the SD card
+     * @param chunk The chunk to scan, with its first and end sectors set
+     */
+    void scanChunk(const std::uint8_t* image, ChunkSummary& chunk)
+    {
+        for (std::size_t sector = chunk.first_sector; sector < chunk.end_sector; sector++)
+        {
+            for (std::size_t i = 0; i < RECORDS_PER_SECTOR; i++)
+            {
+                const std::uint8_t* record =
+                    image + sector * SD_SECTOR_SIZE + i * LOG_RECORD_SIZE;
+                const std::uint32_t magic = readMagic(record);
+                if (isDataMagic(magic))
+                {
+                    if (magic == LOG_MAGIC_TICK)
+                    {
+                        chunk.num_tick_records++;
+                    }
+                    else
+                    {
+                        chunk.num_profile_records++;
+                    }
+                    addToEpochs(readEpoch(record), readTime(record), chunk.epochs,
+                                chunk.num_epoch_regressions, chunk.num_time_regressions);
+                }
+                else if (magic == LOG_MAGIC_PADDING)
+                {
+                    chunk.num_padding_records++;
+                }
+                else
+                {
+                    chunk.num_invalid_records++;
+                }
+            }
+        }
+    }
+
+    /**
+     * Copies the records in a chunk of the log into the columns
+     *
+     * @param image The image of the SD card
+     * @param chunk The chunk to copy, which has already been scanned
+     * @param first_row The row of the tick columns to copy the first tick record in the
+     * chunk to
+     * @param first_profile_row The row of the profile columns to copy the first profile
+     * record in the chunk to
+     * @param log The decoded log, whose columns are already big enough to hold every
+     * record
+     */
+    void decodeChunk(const std::uint8_t* image, const ChunkSummary& chunk,
+                     std::size_t first_row, std::size_t first_profile_row,
+                     DecodedLog& log)
+    {
+        std::size_t row = first_row, profile_row = first_profile_row;
+        for (std::size_t sector = chunk.first_sector; sector < chunk.end_sector; sector++)
+        {
+            for (std::size_t i = 0; i < RECORDS_PER_SECTOR; i++)
+            {
+                const std::uint8_t* record =
+                    image + sector * SD_SECTOR_SIZE + i * LOG_RECORD_SIZE;
+                const std::uint32_t magic = readMagic(record);
+                if (magic == LOG_MAGIC_TICK)
+                {
+                    copyRecord(record, row++, log.columns);
+                }
+                else if (magic == LOG_MAGIC_PROFILE)
+                {
+                    copyRecord(record, profile_row++, log.profile_columns);
+                }
+            }
+        }
+    }
+}  // namespace
+
+std::size_t getLogColumnTypeSize(LogColumnType type)
+{
+    switch (type)
+    {
+        case LogColumnType::UINT8:
+            return 1;
+        case LogColumnType::INT16:
+        case LogColumnType::UINT16:
+            return 2;
+        case LogColumnType::UINT32:
+        case LogColumnType::FLOAT32:
+            return 4;
+        case LogColumnType::UINT64:
+            return 8;
+    }
+    throw std::invalid_argument("Unknown log column type");
+}
+
+std::string getLogColumnTypeName(LogColumnType type)
+{
+    switch (type)
+    {
+        case LogColumnType::UINT8:
+            return "uint8";
+        case LogColumnType::INT16:
+            return "int16";
+        case LogColumnType::UINT16:
+            return "uint16";
+        case LogColumnType::UINT32:
+            return "uint32";
+        case LogColumnType::UINT64:
+            return "uint64";
+        case LogColumnType::FLOAT32:
+            return "float32";
+    }
+    throw std::invalid_argument("Unknown log column type");
+}
+
+double LogColumn::getValue(std::size_t index) const
+{
+    const std::uint8_t* value = data.data() + index * getLogColumnTypeSize(type);
+    switch (type)
+    {
+        case LogColumnType::UINT8:
+            return *value;
+        case LogColumnType::INT16:
+        {
+            std::int16_t result;
+            std::memcpy(&result, value, sizeof(result));
+            return result;
+        }
+        case LogColumnType::UINT16:
+        {
+            std::uint16_t result;
+            std::memcpy(&result, value, sizeof(result));
+            return result;
+        }
+        case LogColumnType::UINT32:
+        {
+            std::uint32_t result;
+            std::memcpy(&result, value, sizeof(result));
+            return result;
+        }
+        case LogColumnType::UINT64:
+        {
+            std::uint64_t result;
+            std::memcpy(&result, value, sizeof(result));
+            return static_cast<double>(result);
+        }
+        case LogColumnType::FLOAT32:
+        {
+            float result;
+            std::memcpy(&result, value, sizeof(result));
+            return result;
+        }
+    }
+    throw std::invalid_argument("Unknown log column type");
+}
+
+std::size_t findLogEnd(const std::uint8_t* image, std::size_t num_sectors,
+                       std::size_t first_sector)
+{
+    // The robot erases the card from the end of the log when it starts logging, so every
+    // sector before the end starts with a tick or profile record and every sector after
+    // it doesn't
+    std::size_t low = first_sector, high = num_sectors;
+    while (low < high)
+    {
+        const std::size_t probe = low + (high - low) / 2;
+        if (isDataMagic(readMagic(image + probe * SD_SECTOR_SIZE)))
+        {
+            low = probe + 1;
+        }
+        else
+        {
+            high = probe;
+        }
+    }
+    return low;
+}
+
+DecodedLog decodeLog(const std::uint8_t* image, std::size_t image_size,
+                     std::size_t first_sector, unsigned int num_threads)
+{
+    const std::size_t num_sectors = image_size / SD_SECTOR_SIZE;
+    if (first_sector > num_sectors)
+    {
+        throw std::invalid_argument("The first log sector is past the end of the image");
+    }
+    const std::size_t end_sector = findLogEnd(image, num_sectors, first_sector);
+
+    // Split the log into one chunk of whole sectors per thread
+    const std::size_t num_log_sectors = end_sector - first_sector;
+    const std::size_t num_chunks =
+        std::max<std::size_t>(1, std::min<std::size_t>(num_threads, num_log_sectors));
+    std::vector<ChunkSummary> chunks(num_chunks);
+    for (std::size_t i = 0; i < num_chunks; i++)
+    {
+        chunks[i].first_sector = first_sector + num_log_sectors * i / num_chunks;
+        chunks[i].end_sector   = first_sector + num_log_sectors * (i + 1) / num_chunks;
+    }
+
+    auto run_on_chunks = [&chunks](auto function) {
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < chunks.size(); i++)
+        {
+            threads.emplace_back(function, i);
+        }
+        function(0);
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    };
+
+    run_on_chunks([image, &chunks](std::size_t i) { scanChunk(image, chunks[i]); });
+
+    // Combine the chunks, checking the epochs and times across the chunk boundaries
+    DecodedLog log     = {};
+    LogSummary& summary = log.summary;
+    summary.num_sectors = num_log_sectors;
+    std::vector<std::size_t> first_rows, first_profile_rows;
+    for (const ChunkSummary& chunk : chunks)
+    {
+        first_rows.push_back(summary.num_tick_records);
+        first_profile_rows.push_back(summary.num_profile_records);
+        summary.num_tick_records += chunk.num_tick_records;
+        summary.num_profile_records += chunk.num_profile_records;
+        summary.num_padding_records += chunk.num_padding_records;
+        summary.num_invalid_records += chunk.num_invalid_records;
+        summary.num_epoch_regressions += chunk.num_epoch_regressions;
+        summary.num_time_regressions += chunk.num_time_regressions;
+        if (chunk.epochs.empty())
+        {
+            continue;
+        }
+
+        // Only the first run of a chunk can continue the last run of the chunk before
+        // it. The rest were already checked against each other when the chunk was
+        // scanned
+        const LogEpochSummary& first = chunk.epochs.front();
+        addToEpochs(first.epoch, first.first_time, summary.epochs,
+                    summary.num_epoch_regressions, summary.num_time_regressions);
+        summary.epochs.back().num_records += first.num_records - 1;
+        summary.epochs.back().last_time = first.last_time;
+        summary.epochs.insert(summary.epochs.end(), chunk.epochs.begin() + 1,
+                              chunk.epochs.end());
+    }
+    log.num_records         = summary.num_tick_records;
+    log.num_profile_records = summary.num_profile_records;
+    log.columns             = createColumns(COLUMN_DESCRIPTIONS, log.num_records);
+    log.profile_columns =
+        createColumns(PROFILE_COLUMN_DESCRIPTIONS, log.num_profile_records);
+
+    run_on_chunks([image, &chunks, &first_rows, &first_profile_rows, &log](std::size_t i) {
+        decodeChunk(image, chunks[i], first_rows[i], first_profile_rows[i], log);
+    });
+
+    return log;
+}
+
+namespace
+{
+    /**
+     * Writes a set of columns to files in a directory and adds them to the manifest
+     *
+     * @param columns The columns
+     * @param prefix The prefix to add to the name of each column
+     * @param directory The directory to write to
+     * @param manifest The manifest to list the columns in
+     */
+    void writeColumns(const std::vector<LogColumn>& columns, const std::string& prefix,
+                      const std::string& directory, std::ostream& manifest)
+    {
+        for (const LogColumn& column : columns)
+        {
+            const std::string name = prefix + column.name;
+            const std::string path = directory + "/" + name + ".bin";
+            std::ofstream file(path, std::ios::binary);
+            file.write(reinterpret_cast<const char*>(column.data.data()),
+                       static_cast<std::streamsize>(column.data.size()));
+            if (!file)
+            {
+                throw std::runtime_error("Could not write " + path);
+            }
+            manifest << name << " " << getLogColumnTypeName(column.type) << " "
+                     << column.width << "\n";
+        }
+    }
+}  // namespace
+
+void writeLogColumns(const DecodedLog& log, const std::string& directory)
+{
+    std::ofstream manifest(directory + "/columns.txt");
+    writeColumns(log.columns, "", directory, manifest);
+    writeColumns(log.profile_columns, "profile_", directory, manifest);
+    if (!manifest)
+    {
+        throw std::runtime_error("Could not write " + directory + "/columns.txt");
+    }
+}
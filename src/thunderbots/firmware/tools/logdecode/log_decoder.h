@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * The type of each value in a LogColumn
+ */
+enum class LogColumnType
+{
+    UINT8,
+    INT16,
+    UINT16,
+    UINT32,
+    UINT64,
+    FLOAT32
+};
+
+/**
+ * Returns the size of a single value of the given type
+ *
+ * @param type The type
+ *
+ * @return the size of a value of the given type, in bytes
+ */
+std::size_t getLogColumnTypeSize(LogColumnType type);
+
+/**
+ * Returns the name numpy uses for the given type, so columns can be loaded with
+ * numpy.fromfile
+ *
+ * @param type The type
+ *
+ * @return the numpy dtype name of the given type
+ */
+std::string getLogColumnTypeName(LogColumnType type);
+
+/**
+ * One field of every record of one type in a log, stored contiguously. Fields that are arrays
+ * in the record, such as the wheel encoder counts, have one value per element of the
+ * array for each record, stored record by record
+ */
+struct LogColumn
+{
+    // The name of the field in log_record_t or log_tick_t
+    std::string name;
+    LogColumnType type;
+    // The number of values each record has in this column
+    std::size_t width;
+    // Where the field is in a log_record_t
+    std::size_t record_offset;
+    // The little-endian values for every record, width values per record
+    std::vector<std::uint8_t> data;
+
+    /**
+     * Returns a value from this column, converted to a double
+     *
+     * @param index The index of the value, which is the record index times the width
+     * plus the index into the field
+     *
+     * @return the value at the given index
+     */
+    double getValue(std::size_t index) const;
+};
+
+/**
+ * The records written during a single epoch. The robot starts a new epoch every time
+ * logging starts, so each epoch is one power cycle of the robot
+ */
+struct LogEpochSummary
+{
+    std::uint32_t epoch;
+    std::size_t num_records;
+    // The RTC timestamps of the first and last records in the epoch, in microseconds
+    std::uint64_t first_time;
+    std::uint64_t last_time;
+};
+
+/**
+ * What was found while decoding a log, and any problems with it
+ */
+struct LogSummary
+{
+    // The sectors between the first log sector and the end of the log
+    std::size_t num_sectors;
+    // The records with LOG_MAGIC_TICK, which are decoded into the columns
+    std::size_t num_tick_records;
+    // The records with LOG_MAGIC_PROFILE, which are decoded into the profile columns
+    std::size_t num_profile_records;
+    // The records with a magic of 0, which pad out the last sector of an epoch
+    std::size_t num_padding_records;
+    // The records with any other magic, which are corrupt
+    std::size_t num_invalid_records;
+    // The number of times a record's epoch is lower than the one before it
+    std::size_t num_epoch_regressions;
+    // The number of times a record's timestamp is earlier than the one before it in
+    // the same epoch
+    std::size_t num_time_regressions;
+    std::vector<LogEpochSummary> epochs;
+};
+
+/**
+ * A log decoded into one contiguous column per field of each type of record, along with
+ * a summary of what was in it
+ */
+struct DecodedLog
+{
+    // The tick records, one per normal tick
+    std::size_t num_records;
+    std::vector<LogColumn> columns;
+    // The CPU profile records, one per profiling window
+    std::size_t num_profile_records;
+    std::vector<LogColumn> profile_columns;
+    LogSummary summary;
+};
+
+/**
+ * The first sector of the log on a raw SD card image. The sectors before it hold the
+ * firmware upgrade areas
+ */
+extern const std::size_t LOG_FIRST_SECTOR_ON_CARD;
+
+/**
+ * Finds the end of the log in an image the same way the robot does when it starts a new
+ * epoch, by binary searching for the first sector that does not start with a tick or
+ * profile record
+ *
+ * @param image The image of the SD card
+ * @param num_sectors The number of sectors in the image
+ * @param first_sector The first sector of the log in the image
+ *
+ * @return the index of the first sector after the log
+ */
+std::size_t findLogEnd(const std::uint8_t* image, std::size_t num_sectors,
+                       std::size_t first_sector);
+
+/**
+ * Decodes every tick and profile record in an image of an SD card into columns.
+ *
+ * The log is split into one chunk of sectors per thread. Each thread first counts and
+ * checks the records in its chunk, which gives every chunk the index of its first row
+ * in the columns, and then copies its records into the columns.
+ *
+ * @param image The image of the SD card, or of just the part of it holding the log
+ * @param image_size The size of the image, in bytes
+ * @param first_sector The first sector of the log in the image
+ * @param num_threads The number of threads to decode on, which must be at least 1
+ *
+ * @throws std::invalid_argument if the first sector is past the end of the image
+ * @return the decoded log
+ */
+DecodedLog decodeLog(const std::uint8_t* image, std::size_t image_size,
+                     std::size_t first_sector, unsigned int num_threads);
+
+/**
+ * Writes each column of a decoded log to its own file, <name>.bin, in the given
+ * directory, along with a columns.txt manifest. Each line of the manifest has the name,
+ * numpy dtype, and width of a column, so a column can be loaded with
+ * numpy.fromfile(name + ".bin", dtype).reshape(-1, width). The profile columns are
+ * named profile_<name>
+ *
+ * @param log The decoded log
+ * @param directory The directory to write to, which must already exist
+ *
+ * @throws std::runtime_error if a file could not be written
+ */
+void writeLogColumns(const DecodedLog& log, const std::string& directory);
@@ -0,0 +1,250 @@
+/**
+ * Decodes the log the robot writes to its SD card into one file per field, and prints a
+ * summary of the log, including how long each module took to tick.
+ *
+ * Usage: logdecode image output_directory [--first-sector N] [--threads N]
+ *
+ * The image is a raw image of the whole SD card, or the card itself, in which case the
+ * log starts after the firmware upgrade areas. For an image of just the log, such as one
+ * copied off the card with dd, pass --first-sector 0.
+ */
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "log_decoder.h"
+#include "mapped_file.h"
+
+extern "C"
+{
+#include "main/profile.h"
+}
+
+namespace
+{
+    /**
+     * The minimum, mean, and maximum of one element of a column
+     */
+    struct ColumnStatistics
+    {
+        double min;
+        double mean;
+        double max;
+    };
+
+    /**
+     * Computes the statistics of every element of a column
+     *
+     * @param column The column
+     * @param num_records The number of records in the column
+     *
+     * @return the statistics of each element of the column, in order
+     */
+    std::vector<ColumnStatistics> computeStatistics(const LogColumn& column,
+                                                    std::size_t num_records)
+    {
+        std::vector<ColumnStatistics> statistics;
+        for (std::size_t element = 0; element < column.width; element++)
+        {
+            double min = std::numeric_limits<double>::infinity();
+            double max = -std::numeric_limits<double>::infinity();
+            double sum = 0.0;
+            for (std::size_t row = 0; row < num_records; row++)
+            {
+                const double value = column.getValue(row * column.width + element);
+                min                = std::min(min, value);
+                max                = std::max(max, value);
+                sum += value;
+            }
+            statistics.push_back({min, sum / static_cast<double>(num_records), max});
+        }
+        return statistics;
+    }
+
+    /**
+     * Finds a column by name
+     *
+     * @param columns The columns to search
+     * @param name The name of the column
+     *
+     * @throws std::invalid_argument if there is no column with the given name
+     * @return the column
+     */
+    const LogColumn& findColumn(const std::vector<LogColumn>& columns,
+                                const std::string& name)
+    {
+        for (const LogColumn& column : columns)
+        {
+            if (column.name == name)
+            {
+                return column;
+            }
+        }
+        throw std::invalid_argument("No column named " + name);
+    }
+
+    /**
+     * Prints how long each module took to tick over the whole log, from the CPU profile
+     * records
+     *
+     * @param log The decoded log, which must have at least one profile record
+     */
+    void printProfile(const DecodedLog& log)
+    {
+        static const char* const MODULE_NAMES[] = {
+#define PROFILE_MODULE_NAME(name, lower) #lower,
+            PROFILE_MODULES(PROFILE_MODULE_NAME)
+#undef PROFILE_MODULE_NAME
+        };
+        const LogColumn& means = findColumn(log.profile_columns, "mean");
+        const LogColumn& maxes = findColumn(log.profile_columns, "max");
+
+        std::printf("\n%-28s %14s %14s\n", "module", "mean_us", "max_us");
+        for (std::size_t module = 0; module < PROFILE_MODULE_COUNT; module++)
+        {
+            // Each window is weighted equally, since they all cover the same number of
+            // normal ticks
+            double sum = 0.0, max = 0.0;
+            for (std::size_t row = 0; row < log.num_profile_records; row++)
+            {
+                sum += means.getValue(row * PROFILE_MODULE_COUNT + module);
+                max = std::max(max, maxes.getValue(row * PROFILE_MODULE_COUNT + module));
+            }
+            std::printf("%-28s %14.1f %14.1f\n", MODULE_NAMES[module],
+                        sum / static_cast<double>(log.num_profile_records) /
+                            PROFILE_COUNTS_PER_US,
+                        max / PROFILE_COUNTS_PER_US);
+        }
+    }
+
+    /**
+     * Prints the epochs in a log, any problems found with it, and the statistics of
+     * every field
+     *
+     * @param log The decoded log
+     * @param num_threads The number of threads to compute the statistics on
+     */
+    void printSummary(const DecodedLog& log, unsigned int num_threads)
+    {
+        const LogSummary& summary = log.summary;
+        std::printf("%zu sectors, %zu tick records, %zu profile records, %zu padding "
+                    "records, %zu invalid records\n",
+                    summary.num_sectors, summary.num_tick_records,
+                    summary.num_profile_records, summary.num_padding_records,
+                    summary.num_invalid_records);
+        std::printf("%zu epoch regressions, %zu time regressions\n",
+                    summary.num_epoch_regressions, summary.num_time_regressions);
+
+        std::printf("\n%10s %10s %14s %14s %10s\n", "epoch", "records", "first_us",
+                    "last_us", "span_s");
+        for (const LogEpochSummary& epoch : summary.epochs)
+        {
+            std::printf("%10" PRIu32 " %10zu %14" PRIu64 " %14" PRIu64 " %10.3f\n",
+                        epoch.epoch, epoch.num_records, epoch.first_time,
+                        epoch.last_time,
+                        static_cast<double>(epoch.last_time - epoch.first_time) / 1.0e6);
+        }
+
+        if (log.num_profile_records != 0)
+        {
+            printProfile(log);
+        }
+        if (log.num_records == 0)
+        {
+            return;
+        }
+
+        // Each column is independent, so they are spread across the threads
+        std::vector<std::vector<ColumnStatistics>> statistics(log.columns.size());
+        std::vector<std::thread> threads;
+        for (unsigned int i = 0; i < num_threads; i++)
+        {
+            threads.emplace_back([&log, &statistics, i, num_threads]() {
+                for (std::size_t column = i; column < log.columns.size();
+                     column += num_threads)
+                {
+                    statistics[column] =
+                        computeStatistics(log.columns[column], log.num_records);
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        std::printf("\n%-28s %14s %14s %14s\n", "field", "min", "mean", "max");
+        for (std::size_t column = 0; column < log.columns.size(); column++)
+        {
+            for (std::size_t element = 0; element < log.columns[column].width; element++)
+            {
+                std::string name = log.columns[column].name;
+                if (log.columns[column].width > 1)
+                {
+                    name += "[" + std::to_string(element) + "]";
+                }
+                const ColumnStatistics& element_statistics = statistics[column][element];
+                std::printf("%-28s %14.6g %14.6g %14.6g\n", name.c_str(),
+                            element_statistics.min, element_statistics.mean,
+                            element_statistics.max);
+            }
+        }
+    }
+
+    void printUsage(const char* program)
+    {
+        std::fprintf(stderr,
+                     "Usage: %s image output_directory [--first-sector N] [--threads N]\n",
+                     program);
+    }
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::size_t first_sector = LOG_FIRST_SECTOR_ON_CARD;
+    unsigned int num_threads = std::max(1U, std::thread::hardware_concurrency());
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--first-sector" && i + 1 < argc)
+        {
+            first_sector = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--threads" && i + 1 < argc)
+        {
+            num_threads = std::max(1UL, std::strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.size() != 2)
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        const MappedFile image(paths[0]);
+        const DecodedLog log =
+            decodeLog(image.data(), image.size(), first_sector, num_threads);
+        writeLogColumns(log, paths[1]);
+        printSummary(log, num_threads);
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
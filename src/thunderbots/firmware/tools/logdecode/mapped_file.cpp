@@ -0,0 +1,67 @@
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+MappedFile::MappedFile(const std::string& path) : data_(nullptr), size_(0)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Could not open " + path + ": " + std::strerror(errno));
+    }
+
+    // Block devices report a size of 0 from fstat, so the size is found by seeking to
+    // the end instead
+    const off_t size = lseek(fd, 0, SEEK_END);
+    if (size < 0)
+    {
+        const int error = errno;
+        close(fd);
+        throw std::runtime_error("Could not find the size of " + path + ": " +
+                                 std::strerror(error));
+    }
+    size_ = static_cast<std::size_t>(size);
+
+    if (size_ > 0)
+    {
+        void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            const int error = errno;
+            close(fd);
+            throw std::runtime_error("Could not map " + path + ": " +
+                                     std::strerror(error));
+        }
+        // Every page is read once, so ask the kernel to start reading them all now
+        madvise(mapping, size_, MADV_WILLNEED);
+        data_ = static_cast<const std::uint8_t*>(mapping);
+    }
+
+    // The mapping stays valid after the file is closed
+    close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_)
+    {
+        munmap(const_cast<std::uint8_t*>(data_), size_);
+    }
+}
+
+const std::uint8_t* MappedFile::data() const
+{
+    return data_;
+}
+
+std::size_t MappedFile::size() const
+{
+    return size_;
+}
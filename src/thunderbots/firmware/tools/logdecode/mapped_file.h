@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * A file mapped read-only into memory, so a whole SD card image can be read without
+ * copying it. The file is unmapped when this is destroyed
+ */
+class MappedFile
+{
+   public:
+    /**
+     * Maps a file into memory
+     *
+     * @param path The path of the file, which may also be a block device such as an SD
+     * card in a card reader
+     *
+     * @throws std::runtime_error if the file could not be opened or mapped
+     */
+    explicit MappedFile(const std::string& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Returns the contents of the file
+     *
+     * @return the first byte of the file, or nullptr if the file is empty
+     */
+    const std::uint8_t* data() const;
+
+    /**
+     * Returns the size of the file
+     *
+     * @return the size of the file, in bytes
+     */
+    std::size_t size() const;
+
+   private:
+    const std::uint8_t* data_;
+    std::size_t size_;
+};
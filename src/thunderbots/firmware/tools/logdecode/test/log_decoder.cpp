@@ -0,0 +1,264 @@
+#include "tools/logdecode/log_decoder.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+extern "C"
+{
+#include "main/log.h"
+}
+
+namespace
+{
+    /**
+     * Builds an image of an SD card holding a log, record by record, the same way the
+     * robot lays one out
+     */
+    class LogImageBuilder
+    {
+       public:
+        /**
+         * Starts an image with the given number of sectors before the log, which are
+         * filled like an erased card
+         */
+        explicit LogImageBuilder(std::size_t first_sector)
+            : image(first_sector * SD_SECTOR_SIZE, 0xFF)
+        {
+        }
+
+        /**
+         * Adds a tick record whose fields are all derived from the given index, so
+         * every record in the log is different
+         */
+        void addTick(std::uint32_t epoch, std::uint64_t time, std::uint32_t index)
+        {
+            log_record_t record = createRecord(LOG_MAGIC_TICK, epoch, time);
+            record.tick.dr_x            = static_cast<float>(index);
+            record.tick.dr_y            = -static_cast<float>(index) / 2.0f;
+            record.tick.cam_delay       = static_cast<std::uint16_t>(index * 3);
+            record.tick.primitive       = static_cast<std::uint8_t>(index % 7);
+            record.tick.idle_cpu_cycles = index * 1000;
+            for (std::size_t wheel = 0; wheel < 4; wheel++)
+            {
+                record.tick.wheels_encoder_counts[wheel] =
+                    static_cast<std::int16_t>(-static_cast<int>(index * 4 + wheel));
+            }
+            addRecord(record);
+            ticks.push_back(record);
+        }
+
+        void addProfile(std::uint32_t epoch, std::uint64_t time, std::uint32_t index)
+        {
+            log_record_t record  = createRecord(LOG_MAGIC_PROFILE, epoch, time);
+            record.profile.ticks = index;
+            for (std::size_t module = 0; module < PROFILE_MODULE_COUNT; module++)
+            {
+                record.profile.min[module]  = index + module;
+                record.profile.mean[module] = index + module * 2;
+                record.profile.max[module]  = index + module * 3;
+            }
+            addRecord(record);
+            num_profiles++;
+        }
+
+        /**
+         * Fills the rest of the current sector with padding records, as the robot does
+         * when it stops logging
+         */
+        void endEpoch()
+        {
+            while (image.size() % SD_SECTOR_SIZE != 0)
+            {
+                addRecord(createRecord(0, 0, 0));
+                num_padding++;
+            }
+        }
+
+        /**
+         * Ends the log with the given number of erased sectors
+         */
+        std::vector<std::uint8_t> finish(std::size_t num_erased_sectors)
+        {
+            image.resize(image.size() + num_erased_sectors * SD_SECTOR_SIZE, 0xFF);
+            return image;
+        }
+
+        std::vector<std::uint8_t> image;
+        std::vector<log_record_t> ticks;
+        std::size_t num_profiles = 0;
+        std::size_t num_padding  = 0;
+
+       private:
+        static log_record_t createRecord(std::uint32_t magic, std::uint32_t epoch,
+                                         std::uint64_t time)
+        {
+            log_record_t record;
+            std::memset(&record, 0, sizeof(record));
+            record.magic = magic;
+            record.epoch = epoch;
+            record.time  = time;
+            return record;
+        }
+
+        void addRecord(const log_record_t& record)
+        {
+            const auto bytes = reinterpret_cast<const std::uint8_t*>(&record);
+            image.insert(image.end(), bytes, bytes + sizeof(record));
+        }
+    };
+
+    const std::size_t FIRST_SECTOR = 3;
+
+    /**
+     * Builds a log of several epochs of different lengths, with a profile record every
+     * few ticks, so the runs of each epoch and the padding at the end of them fall
+     * across the chunk boundaries of any number of threads
+     */
+    LogImageBuilder createLog()
+    {
+        LogImageBuilder builder(FIRST_SECTOR);
+        // The last epoch is lower than the one before it, as if the robot's epoch
+        // counter had been reset
+        const std::uint32_t epochs[]    = {7, 8, 9, 2};
+        const std::uint32_t num_ticks[] = {41, 1, 96, 17};
+        std::uint32_t index             = 0;
+        for (std::size_t i = 0; i < 4; i++)
+        {
+            std::uint64_t time = 5000000 * (i + 1);
+            for (std::uint32_t tick = 0; tick < num_ticks[i]; tick++)
+            {
+                builder.addTick(epochs[i], time, index++);
+                if (tick % 16 == 15)
+                {
+                    builder.addProfile(epochs[i], time, index);
+                }
+                time += 5000;
+            }
+            builder.endEpoch();
+        }
+        return builder;
+    }
+
+    const LogColumn& findColumn(const std::vector<LogColumn>& columns,
+                                const std::string& name)
+    {
+        for (const LogColumn& column : columns)
+        {
+            if (column.name == name)
+            {
+                return column;
+            }
+        }
+        throw std::invalid_argument("No column named " + name);
+    }
+
+    void expectSameColumns(const std::vector<LogColumn>& expected,
+                           const std::vector<LogColumn>& actual)
+    {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (std::size_t i = 0; i < expected.size(); i++)
+        {
+            EXPECT_EQ(expected[i].name, actual[i].name);
+            EXPECT_EQ(expected[i].type, actual[i].type);
+            EXPECT_EQ(expected[i].width, actual[i].width);
+            EXPECT_EQ(expected[i].record_offset, actual[i].record_offset);
+            EXPECT_EQ(expected[i].data, actual[i].data) << expected[i].name;
+        }
+    }
+}  // namespace
+
+TEST(LogDecoderTest, decodes_every_record_in_order)
+{
+    LogImageBuilder builder               = createLog();
+    const std::vector<std::uint8_t> image = builder.finish(5);
+
+    DecodedLog log = decodeLog(image.data(), image.size(), FIRST_SECTOR, 1);
+
+    ASSERT_EQ(builder.ticks.size(), log.num_records);
+    EXPECT_EQ(builder.num_profiles, log.num_profile_records);
+    EXPECT_EQ(builder.num_padding, log.summary.num_padding_records);
+    EXPECT_EQ(0u, log.summary.num_invalid_records);
+    EXPECT_EQ(1u, log.summary.num_epoch_regressions);
+    EXPECT_EQ(0u, log.summary.num_time_regressions);
+    EXPECT_EQ(image.size() / SD_SECTOR_SIZE - FIRST_SECTOR - 5, log.summary.num_sectors);
+
+    const LogColumn& epoch  = findColumn(log.columns, "epoch");
+    const LogColumn& time   = findColumn(log.columns, "time");
+    const LogColumn& dr_x   = findColumn(log.columns, "dr_x");
+    const LogColumn& counts = findColumn(log.columns, "wheels_encoder_counts");
+    ASSERT_EQ(4u, counts.width);
+    for (std::size_t i = 0; i < builder.ticks.size(); i++)
+    {
+        // The tick fields are packed, so they are copied out before being compared
+        const log_record_t& expected = builder.ticks[i];
+        const double expected_dr_x   = expected.tick.dr_x;
+        EXPECT_EQ(expected.epoch, epoch.getValue(i));
+        EXPECT_EQ(expected.time, time.getValue(i));
+        EXPECT_EQ(expected_dr_x, dr_x.getValue(i));
+        for (std::size_t wheel = 0; wheel < 4; wheel++)
+        {
+            const double expected_count = expected.tick.wheels_encoder_counts[wheel];
+            EXPECT_EQ(expected_count, counts.getValue(i * 4 + wheel));
+        }
+    }
+
+    // Each epoch's records include its profile records
+    const std::uint32_t epochs[]    = {7, 8, 9, 2};
+    const std::size_t num_records[] = {43, 1, 102, 18};
+    ASSERT_EQ(4u, log.summary.epochs.size());
+    for (std::size_t i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(epochs[i], log.summary.epochs[i].epoch);
+        EXPECT_EQ(num_records[i], log.summary.epochs[i].num_records);
+        EXPECT_EQ(5000000 * (i + 1), log.summary.epochs[i].first_time);
+    }
+}
+
+TEST(LogDecoderTest, decoding_on_many_threads_matches_one_thread)
+{
+    const std::vector<std::uint8_t> image = createLog().finish(5);
+    const std::size_t num_log_sectors = image.size() / SD_SECTOR_SIZE - FIRST_SECTOR - 5;
+
+    DecodedLog expected = decodeLog(image.data(), image.size(), FIRST_SECTOR, 1);
+
+    // Include more threads than there are sectors, which leaves some with nothing to do
+    for (unsigned int num_threads : {2u, 3u, 4u, 7u, 16u,
+                                     static_cast<unsigned int>(num_log_sectors + 4)})
+    {
+        SCOPED_TRACE(num_threads);
+        DecodedLog actual =
+            decodeLog(image.data(), image.size(), FIRST_SECTOR, num_threads);
+
+        EXPECT_EQ(expected.num_records, actual.num_records);
+        EXPECT_EQ(expected.num_profile_records, actual.num_profile_records);
+        expectSameColumns(expected.columns, actual.columns);
+        expectSameColumns(expected.profile_columns, actual.profile_columns);
+
+        const LogSummary& expected_summary = expected.summary;
+        const LogSummary& actual_summary   = actual.summary;
+        EXPECT_EQ(expected_summary.num_sectors, actual_summary.num_sectors);
+        EXPECT_EQ(expected_summary.num_tick_records, actual_summary.num_tick_records);
+        EXPECT_EQ(expected_summary.num_profile_records,
+                  actual_summary.num_profile_records);
+        EXPECT_EQ(expected_summary.num_padding_records,
+                  actual_summary.num_padding_records);
+        EXPECT_EQ(expected_summary.num_invalid_records,
+                  actual_summary.num_invalid_records);
+        EXPECT_EQ(expected_summary.num_epoch_regressions,
+                  actual_summary.num_epoch_regressions);
+        EXPECT_EQ(expected_summary.num_time_regressions,
+                  actual_summary.num_time_regressions);
+        ASSERT_EQ(expected_summary.epochs.size(), actual_summary.epochs.size());
+        for (std::size_t i = 0; i < expected_summary.epochs.size(); i++)
+        {
+            EXPECT_EQ(expected_summary.epochs[i].epoch, actual_summary.epochs[i].epoch);
+            EXPECT_EQ(expected_summary.epochs[i].num_records,
+                      actual_summary.epochs[i].num_records);
+            EXPECT_EQ(expected_summary.epochs[i].first_time,
+                      actual_summary.epochs[i].first_time);
+            EXPECT_EQ(expected_summary.epochs[i].last_time,
+                      actual_summary.epochs[i].last_time);
+        }
+    }
+}
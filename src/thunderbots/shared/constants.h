@@ -36,12 +36,8 @@ const double ENEMY_ROBOT_MAX_SPEED_METERS_PER_SECOND = 3.0;
 const double ENEMY_ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED = 4.0;
 
 /* Unit Conversion */
-const double MILLIMETERS_PER_METER = 1000.0;
-const double METERS_PER_MILLIMETER = 1.0 / 1000.0;
-
-const double CENTIRADIANS_PER_RADIAN = 100.0;
-const double RADIANS_PER_CENTIRADIAN = 1.0 / 100.0;
-
+// Lengths and angles are converted with the strongly typed units in
+// software/util/units.h, and to and from the radio format with shared/radio_units.h
 const double MICROSECONDS_PER_MILLISECOND = 1000.0;
 const double MICROSECONDS_PER_SECOND      = 1000000.0;
 const double MILLISECONDS_PER_SECOND      = 1000.0;
@@ -49,8 +45,5 @@ const double SECONDS_PER_MICROSECOND      = 1.0 / 1000000.0;
 const double SECONDS_PER_MILLISECOND      = 1.0 / 1000.0;
 const double MILLISECONDS_PER_MICROSECOND = 1.0 / 1000.0;
 
-// Converts dribbler RPM to a smaller number firmware uses
-const double DRIBBLER_RPM_TO_RADIO_CONVERSION_FACTOR = 1.0 / 300.0;
-
 const double POSSESSION_BUFFER_TIME_IN_SECONDS              = 1.5;
 const double POSSESSION_TIMESTAMP_TOLERANCE_IN_MILLISECONDS = 10;
@@ -0,0 +1,81 @@
+#pragma once
+#include <stdint.h>
+
+// This file contains the fixed point units of the values sent to the robots over
+// radio, and the functions firmware uses to decode them. Since this needs to be
+// compiled by both C and C++, everything should be defined in a way that's compatible
+// with C. The software encoders that use these units are in
+// software/backend/output/radio/radio_units.h
+//
+// The units are integer macros rather than const globals so that both languages can
+// use them in constant expressions, which lets every conversion compile to a single
+// multiply by a constant
+
+/* Primitive parameters */
+// Lengths and speeds are sent in millimetres and millimetres per second
+#define RADIO_PRIMITIVE_LENGTH_UNITS_PER_METER 1000
+// Angles and angular velocities are sent in centiradians and centiradians per second
+#define RADIO_PRIMITIVE_ANGLE_UNITS_PER_RADIAN 100
+// Dribbler speeds are sent in the extra bits in units of 300 RPM, to fit in 7 bits
+#define RADIO_DRIBBLER_RPM_PER_UNIT 300
+
+/* Camera packets */
+// Positions are sent in millimetres
+#define RADIO_CAMERA_LENGTH_UNITS_PER_METER 1000
+// Orientations are sent in milliradians
+#define RADIO_CAMERA_ANGLE_UNITS_PER_RADIAN 1000
+
+/**
+ * Decodes a length or speed primitive parameter
+ *
+ * @param value the parameter, in millimetres or millimetres per second
+ * @return the length in metres, or the speed in metres per second
+ */
+static inline float radio_decode_primitive_length(int16_t value)
+{
+    return (float)value * (1.0f / RADIO_PRIMITIVE_LENGTH_UNITS_PER_METER);
+}
+
+/**
+ * Decodes an angle or angular velocity primitive parameter
+ *
+ * @param value the parameter, in centiradians or centiradians per second
+ * @return the angle in radians, or the angular velocity in radians per second
+ */
+static inline float radio_decode_primitive_angle(int16_t value)
+{
+    return (float)value * (1.0f / RADIO_PRIMITIVE_ANGLE_UNITS_PER_RADIAN);
+}
+
+/**
+ * Decodes a dribbler speed sent in the extra bits of a primitive
+ *
+ * @param value the extra bits
+ * @return the dribbler speed, in RPM
+ */
+static inline uint32_t radio_decode_dribbler_rpm(uint8_t value)
+{
+    return (uint32_t)value * RADIO_DRIBBLER_RPM_PER_UNIT;
+}
+
+/**
+ * Decodes a position coordinate from a camera packet
+ *
+ * @param value the coordinate, in millimetres
+ * @return the coordinate, in metres
+ */
+static inline float radio_decode_camera_length(int16_t value)
+{
+    return (float)value * (1.0f / RADIO_CAMERA_LENGTH_UNITS_PER_METER);
+}
+
+/**
+ * Decodes an orientation from a camera packet
+ *
+ * @param value the orientation, in milliradians
+ * @return the orientation, in radians
+ */
+static inline float radio_decode_camera_angle(int16_t value)
+{
+    return (float)value * (1.0f / RADIO_CAMERA_ANGLE_UNITS_PER_RADIAN);
+}
@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+
+extern "C"
+{
+#include "../trajectory.h"
+}
+
+constexpr double EPS = 1e-9;
+
+// Limits that are easy to work out trajectories for by hand
+constexpr double MAX_VELOCITY     = 2.0;
+constexpr double MAX_ACCELERATION = 4.0;
+
+TEST(SharedTrajectoryTest, test_1d_already_at_rest_at_destination)
+{
+    Trajectory1D trajectory = planTrajectory1D(0, 0, MAX_VELOCITY, MAX_ACCELERATION);
+    EXPECT_DOUBLE_EQ(0, getTrajectory1DDuration(&trajectory));
+
+    double displacement, velocity;
+    sampleTrajectory1D(&trajectory, 1.0, &displacement, &velocity);
+    EXPECT_DOUBLE_EQ(0, displacement);
+    EXPECT_DOUBLE_EQ(0, velocity);
+}
+
+TEST(SharedTrajectoryTest, test_1d_from_rest_without_reaching_max_velocity)
+{
+    // Accelerate for 0.5s to 2m/s covering 0.5m, then decelerate for 0.5s
+    Trajectory1D trajectory = planTrajectory1D(1.0, 0, 10.0, MAX_ACCELERATION);
+    EXPECT_NEAR(1.0, getTrajectory1DDuration(&trajectory), EPS);
+    EXPECT_NEAR(0, trajectory.cruise_phase_time, EPS);
+
+    double displacement, velocity;
+    sampleTrajectory1D(&trajectory, 0.5, &displacement, &velocity);
+    EXPECT_NEAR(0.5, displacement, EPS);
+    EXPECT_NEAR(2.0, velocity, EPS);
+
+    sampleTrajectory1D(&trajectory, 0.75, &displacement, &velocity);
+    EXPECT_NEAR(0.875, displacement, EPS);
+    EXPECT_NEAR(1.0, velocity, EPS);
+}
+
+TEST(SharedTrajectoryTest, test_1d_from_rest_reaching_max_velocity)
+{
+    // Accelerate for 0.5s covering 0.5m, cruise for 1.5s covering 3m, then decelerate
+    // for 0.5s covering 0.5m
+    Trajectory1D trajectory = planTrajectory1D(-4.0, 0, MAX_VELOCITY, MAX_ACCELERATION);
+    EXPECT_NEAR(2.5, getTrajectory1DDuration(&trajectory), EPS);
+    EXPECT_NEAR(1.5, trajectory.cruise_phase_time, EPS);
+
+    double displacement, velocity;
+    sampleTrajectory1D(&trajectory, 1.0, &displacement, &velocity);
+    EXPECT_NEAR(-1.5, displacement, EPS);
+    EXPECT_NEAR(-2.0, velocity, EPS);
+
+    sampleTrajectory1D(&trajectory, 2.5, &displacement, &velocity);
+    EXPECT_DOUBLE_EQ(-4.0, displacement);
+    EXPECT_DOUBLE_EQ(0, velocity);
+}
+
+TEST(SharedTrajectoryTest, test_1d_moving_away_from_destination)
+{
+    // Brake for 0.5s covering 0.5m, then come back 1.5m to the destination
+    Trajectory1D trajectory = planTrajectory1D(-1.0, 2.0, 10.0, MAX_ACCELERATION);
+
+    double displacement, velocity;
+    sampleTrajectory1D(&trajectory, 0.5, &displacement, &velocity);
+    EXPECT_NEAR(0.5, displacement, EPS);
+    EXPECT_NEAR(0, velocity, EPS);
+
+    // Coming back 1.5m takes sqrt(1.5)s, half accelerating and half decelerating
+    EXPECT_NEAR(0.5 + std::sqrt(1.5), getTrajectory1DDuration(&trajectory), EPS);
+}
+
+TEST(SharedTrajectoryTest, test_1d_overshoots_destination_when_too_fast_to_stop)
+{
+    // Braking from 4m/s takes 2m, so the destination 1m away is overshot
+    Trajectory1D trajectory = planTrajectory1D(1.0, 4.0, 10.0, MAX_ACCELERATION);
+
+    double displacement, velocity;
+    sampleTrajectory1D(&trajectory, 1.0, &displacement, &velocity);
+    EXPECT_NEAR(2.0, displacement, EPS);
+    EXPECT_NEAR(0, velocity, EPS);
+
+    sampleTrajectory1D(&trajectory, getTrajectory1DDuration(&trajectory), &displacement,
+                       &velocity);
+    EXPECT_DOUBLE_EQ(1.0, displacement);
+}
+
+TEST(SharedTrajectoryTest, test_1d_brakes_to_max_velocity)
+{
+    // Brake from 3m/s to 2m/s for 0.25s covering 0.625m, then cruise
+    Trajectory1D trajectory = planTrajectory1D(10.0, 3.0, MAX_VELOCITY, MAX_ACCELERATION);
+
+    double displacement, velocity;
+    sampleTrajectory1D(&trajectory, 0.25, &displacement, &velocity);
+    EXPECT_NEAR(0.625, displacement, EPS);
+    EXPECT_NEAR(2.0, velocity, EPS);
+
+    // Cruise the remaining 10 - 0.625 - 0.5 meters before decelerating
+    EXPECT_NEAR(0.25 + 8.875 / 2.0 + 0.5, getTrajectory1DDuration(&trajectory), EPS);
+}
+
+TEST(SharedTrajectoryTest, test_max_1d_distance_is_inverse_of_duration)
+{
+    for (double distance : {0.1, 0.5, 1.0, 3.0, 10.0})
+    {
+        Trajectory1D trajectory =
+            planTrajectory1D(distance, 0, MAX_VELOCITY, MAX_ACCELERATION);
+        double duration = getTrajectory1DDuration(&trajectory);
+        EXPECT_NEAR(distance,
+                    getMaxTrajectory1DDistance(duration, MAX_VELOCITY, MAX_ACCELERATION),
+                    EPS);
+    }
+}
+
+TEST(SharedTrajectoryTest, test_2d_from_rest_moves_in_straight_line)
+{
+    Vector2D displacement     = {.x = 3.0, .y = -4.0};
+    Vector2D initial_velocity = {.x = 0.0, .y = 0.0};
+    Trajectory2D trajectory =
+        planTrajectory2D(displacement, initial_velocity, MAX_VELOCITY, MAX_ACCELERATION);
+
+    // The same as a 1D trajectory along the line to the destination
+    Trajectory1D straight_line = planTrajectory1D(5.0, 0, MAX_VELOCITY, MAX_ACCELERATION);
+    EXPECT_NEAR(getTrajectory1DDuration(&straight_line),
+                getTrajectory2DDuration(&trajectory), EPS);
+    EXPECT_NEAR(getTrajectory1DDuration(&trajectory.x),
+                getTrajectory1DDuration(&trajectory.y), EPS);
+
+    Vector2D sampled_displacement, sampled_velocity;
+    sampleTrajectory2D(&trajectory, 1.0, &sampled_displacement, &sampled_velocity);
+    EXPECT_NEAR(0.6 * MAX_VELOCITY, sampled_velocity.x, EPS);
+    EXPECT_NEAR(-0.8 * MAX_VELOCITY, sampled_velocity.y, EPS);
+    EXPECT_NEAR(sampled_displacement.x * -4.0, sampled_displacement.y * 3.0, EPS);
+}
+
+TEST(SharedTrajectoryTest, test_2d_with_sideways_velocity_arrives_on_both_axes_together)
+{
+    Vector2D displacement     = {.x = 2.0, .y = 0.5};
+    Vector2D initial_velocity = {.x = -0.5, .y = 1.5};
+    Trajectory2D trajectory =
+        planTrajectory2D(displacement, initial_velocity, MAX_VELOCITY, MAX_ACCELERATION);
+
+    EXPECT_NEAR(getTrajectory1DDuration(&trajectory.x),
+                getTrajectory1DDuration(&trajectory.y), 1e-6);
+
+    // The limits are never exceeded
+    for (double t = 0; t < getTrajectory2DDuration(&trajectory); t += 0.01)
+    {
+        Vector2D sampled_displacement, sampled_velocity;
+        sampleTrajectory2D(&trajectory, t, &sampled_displacement, &sampled_velocity);
+        EXPECT_LE(std::hypot(sampled_velocity.x, sampled_velocity.y),
+                  std::max(MAX_VELOCITY,
+                           std::hypot(initial_velocity.x, initial_velocity.y)) +
+                      EPS);
+    }
+
+    Vector2D sampled_displacement, sampled_velocity;
+    sampleTrajectory2D(&trajectory, getTrajectory2DDuration(&trajectory),
+                       &sampled_displacement, &sampled_velocity);
+    EXPECT_DOUBLE_EQ(displacement.x, sampled_displacement.x);
+    EXPECT_DOUBLE_EQ(displacement.y, sampled_displacement.y);
+    EXPECT_DOUBLE_EQ(0, sampled_velocity.x);
+    EXPECT_DOUBLE_EQ(0, sampled_velocity.y);
+}
+
+TEST(SharedTrajectoryTest, test_2d_along_axis_from_rest_leaves_other_axis_at_rest)
+{
+    Vector2D displacement     = {.x = 0.0, .y = 4.0};
+    Vector2D initial_velocity = {.x = 0.0, .y = 0.0};
+    Trajectory2D trajectory =
+        planTrajectory2D(displacement, initial_velocity, MAX_VELOCITY, MAX_ACCELERATION);
+
+    EXPECT_NEAR(2.5, getTrajectory2DDuration(&trajectory), EPS);
+    EXPECT_DOUBLE_EQ(0, getTrajectory1DDuration(&trajectory.x));
+}
+
+TEST(SharedTrajectoryTest, test_2d_along_axis_with_cross_axis_velocity_stops_both_axes)
+{
+    // Moves along each axis, with a velocity along the other axis that is large, small,
+    // or so small the move counts as a straight line
+    for (bool along_x : {true, false})
+    {
+        for (double cross_axis_velocity : {1.5, -0.5, 1e-3, 1e-14})
+        {
+            Vector2D displacement     = {.x = 0.0, .y = 0.0};
+            Vector2D initial_velocity = {.x = 0.0, .y = 0.0};
+            if (along_x)
+            {
+                displacement.x     = 4.0;
+                initial_velocity.y = cross_axis_velocity;
+            }
+            else
+            {
+                displacement.y     = 4.0;
+                initial_velocity.x = cross_axis_velocity;
+            }
+            Trajectory2D trajectory   = planTrajectory2D(displacement, initial_velocity,
+                                                       MAX_VELOCITY, MAX_ACCELERATION);
+
+            double duration = getTrajectory2DDuration(&trajectory);
+            ASSERT_TRUE(std::isfinite(duration)) << cross_axis_velocity;
+            // Stopping sideways can only make the move slower than starting from rest
+            EXPECT_GE(duration, 2.5 - EPS) << cross_axis_velocity;
+
+            Vector2D sampled_displacement, sampled_velocity;
+            sampleTrajectory2D(&trajectory, duration / 2, &sampled_displacement,
+                               &sampled_velocity);
+            EXPECT_TRUE(std::isfinite(sampled_displacement.x)) << cross_axis_velocity;
+            EXPECT_TRUE(std::isfinite(sampled_displacement.y)) << cross_axis_velocity;
+
+            sampleTrajectory2D(&trajectory, duration, &sampled_displacement,
+                               &sampled_velocity);
+            EXPECT_DOUBLE_EQ(displacement.x, sampled_displacement.x)
+                << cross_axis_velocity;
+            EXPECT_DOUBLE_EQ(displacement.y, sampled_displacement.y)
+                << cross_axis_velocity;
+            EXPECT_DOUBLE_EQ(0, sampled_velocity.x) << cross_axis_velocity;
+            EXPECT_DOUBLE_EQ(0, sampled_velocity.y) << cross_axis_velocity;
+        }
+    }
+}
@@ -0,0 +1,337 @@
+#pragma once
+#include <math.h>
+
+#include "util.h"
+
+// This file contains a time-optimal trajectory planner for a robot with limited velocity
+// and acceleration. It is shared between our software (AI) and firmware code, and is
+// header-only so it can be included from both C and C++ without linking anything.
+//
+// A 1D trajectory moves along a single axis from where it starts (with some initial
+// velocity) to a target displacement, where it comes to rest. It has three phases of
+// constant acceleration: accelerating (or braking, if the initial velocity is above the
+// max velocity), cruising, and decelerating to rest. This is the same plan as
+// PlanBBTrajectory in firmware/main/bangbang.c, computed in closed form.
+//
+// A 2D trajectory is a 1D trajectory for each axis. The velocity and acceleration
+// limits are split between the axes so that both axes arrive at the same time, which
+// gives a time-optimal trajectory that moves in a nearly straight line. The split is
+// found by bisection, as described in "Trajectory Generation and Control for Four
+// Wheeled Omnidirectional Vehicles" by Purwin and D'Andrea.
+//
+// Trajectories can be sampled at any time after they start, so they can be used both to
+// control a robot and to predict where it will be.
+
+// The number of bisection steps used to split the limits between the axes of a 2D
+// trajectory. Each step halves the difference between the arrival times of the axes
+#define TRAJECTORY_2D_NUM_BISECTION_STEPS 30
+
+// The smallest share of the limits either axis of a 2D trajectory is given. An axis that
+// is given none of the limits could never stop any velocity it starts with
+#define TRAJECTORY_2D_MIN_LIMIT_SHARE 1e-6
+
+typedef struct
+{
+    // The displacement from the start of the trajectory to where it ends at rest
+    double displacement;
+    // The velocity at the start of the trajectory
+    double initial_velocity;
+    // The acceleration during the first phase, which is negative if the trajectory
+    // accelerates in the negative direction or brakes while moving in the positive
+    // direction
+    double first_acceleration;
+    // The velocity held during the cruise phase
+    double cruise_velocity;
+    // The acceleration during the last phase, which brings the trajectory to rest
+    double last_acceleration;
+    // How long each phase lasts, in seconds
+    double first_phase_time;
+    double cruise_phase_time;
+    double last_phase_time;
+} Trajectory1D;
+
+typedef struct
+{
+    Trajectory1D x;
+    Trajectory1D y;
+} Trajectory2D;
+
+/**
+ * Plans the fastest 1D trajectory from rest or motion to rest at the given displacement
+ *
+ * @param displacement the displacement to travel
+ * @param initial_velocity the velocity at the start of the trajectory
+ * @param max_velocity the max velocity during the trajectory, which must be positive.
+ * If the initial velocity is faster, the trajectory first brakes down to it
+ * @param max_acceleration the max acceleration during the trajectory, which must be
+ * positive
+ *
+ * @return the planned trajectory
+ */
+static inline Trajectory1D planTrajectory1D(double displacement, double initial_velocity,
+                                            double max_velocity, double max_acceleration)
+{
+    Trajectory1D trajectory;
+    trajectory.displacement     = displacement;
+    trajectory.initial_velocity = initial_velocity;
+
+    if (displacement == 0 && initial_velocity == 0)
+    {
+        // Already at rest at the destination. This is checked first since an axis of a
+        // 2D trajectory that does not need to move may be given a tiny share of the
+        // limits
+        trajectory.first_acceleration = 0;
+        trajectory.cruise_velocity    = 0;
+        trajectory.last_acceleration  = 0;
+        trajectory.first_phase_time   = 0;
+        trajectory.cruise_phase_time  = 0;
+        trajectory.last_phase_time    = 0;
+        return trajectory;
+    }
+
+    // The trajectory always ends by decelerating towards the destination, so if we
+    // would overshoot the destination when braking as hard as possible, the trajectory
+    // must go in the negative direction. We plan in a mirrored frame where the
+    // trajectory always ends moving in the positive direction
+    double stopping_displacement =
+        initial_velocity * fabs(initial_velocity) / (2 * max_acceleration);
+    double direction = displacement >= stopping_displacement ? 1.0 : -1.0;
+    double d         = direction * displacement;
+    double v         = direction * initial_velocity;
+
+    // The velocity we would reach if we accelerated until we had to decelerate, found by
+    // solving (peak^2 - v^2) / 2a + peak^2 / 2a = d
+    double peak_velocity = sqrt(fmax(0.0, max_acceleration * d + v * v / 2));
+
+    double first_acceleration;
+    double cruise_velocity;
+    if (peak_velocity <= max_velocity)
+    {
+        // We never reach the max velocity, so there is no cruise phase
+        first_acceleration           = max_acceleration;
+        cruise_velocity              = peak_velocity;
+        trajectory.first_phase_time  = (peak_velocity - v) / max_acceleration;
+        trajectory.cruise_phase_time = 0;
+        trajectory.last_phase_time   = peak_velocity / max_acceleration;
+    }
+    else
+    {
+        // Accelerate or brake to the max velocity, cruise, then decelerate
+        first_acceleration = v <= max_velocity ? max_acceleration : -max_acceleration;
+        cruise_velocity    = max_velocity;
+        double first_phase_displacement =
+            (max_velocity * max_velocity - v * v) / (2 * first_acceleration);
+        double last_phase_displacement =
+            max_velocity * max_velocity / (2 * max_acceleration);
+
+        trajectory.first_phase_time = fabs(max_velocity - v) / max_acceleration;
+        trajectory.cruise_phase_time =
+            fmax(0.0, d - first_phase_displacement - last_phase_displacement) /
+            max_velocity;
+        trajectory.last_phase_time = max_velocity / max_acceleration;
+    }
+
+    trajectory.first_acceleration = direction * first_acceleration;
+    trajectory.cruise_velocity    = direction * cruise_velocity;
+    trajectory.last_acceleration  = -direction * max_acceleration;
+
+    return trajectory;
+}
+
+/**
+ * Returns how long the given 1D trajectory takes, in seconds
+ *
+ * @param trajectory the trajectory
+ *
+ * @return how long the trajectory takes until it comes to rest
+ */
+static inline double getTrajectory1DDuration(const Trajectory1D *trajectory)
+{
+    return trajectory->first_phase_time + trajectory->cruise_phase_time +
+           trajectory->last_phase_time;
+}
+
+/**
+ * Finds the displacement and velocity along the given 1D trajectory at the given time.
+ * After the trajectory ends, it stays at rest at its displacement
+ *
+ * @param trajectory the trajectory to sample
+ * @param time the time since the start of the trajectory, in seconds
+ * @param displacement[out] the displacement from the start of the trajectory
+ * @param velocity[out] the velocity
+ */
+static inline void sampleTrajectory1D(const Trajectory1D *trajectory, double time,
+                                      double *displacement, double *velocity)
+{
+    if (time >= getTrajectory1DDuration(trajectory))
+    {
+        // Avoid accumulating rounding error when the trajectory has finished
+        *displacement = trajectory->displacement;
+        *velocity     = 0;
+        return;
+    }
+
+    const double accelerations[3] = {trajectory->first_acceleration, 0,
+                                     trajectory->last_acceleration};
+    const double phase_times[3]   = {trajectory->first_phase_time,
+                                     trajectory->cruise_phase_time,
+                                     trajectory->last_phase_time};
+
+    double d = 0;
+    double v = trajectory->initial_velocity;
+    for (int i = 0; i < 3 && time > 0; i++)
+    {
+        double t = fmin(time, phase_times[i]);
+        d += v * t + accelerations[i] * t * t / 2;
+        v += accelerations[i] * t;
+        time -= t;
+    }
+
+    *displacement = d;
+    *velocity     = v;
+}
+
+/**
+ * Returns the furthest distance that can be travelled in the given time, starting and
+ * ending at rest. This is the inverse of the duration of a 1D trajectory from rest
+ *
+ * @param time the time to travel for, in seconds
+ * @param max_velocity the max velocity, which must be positive
+ * @param max_acceleration the max acceleration, which must be positive
+ *
+ * @return the furthest distance that can be travelled
+ */
+static inline double getMaxTrajectory1DDistance(double time, double max_velocity,
+                                                double max_acceleration)
+{
+    if (time <= 0)
+    {
+        return 0;
+    }
+    if (time <= 2 * max_velocity / max_acceleration)
+    {
+        // Half the time is spent accelerating and half decelerating
+        return max_acceleration * time * time / 4;
+    }
+    // The max velocity is reached, so all the extra time is spent cruising
+    return max_velocity * (time - max_velocity / max_acceleration);
+}
+
+/**
+ * Plans a 2D trajectory where each axis uses the given share of the limits
+ *
+ * @param displacement the displacement to travel
+ * @param initial_velocity the velocity at the start of the trajectory
+ * @param max_velocity the max speed during the trajectory
+ * @param max_acceleration the max magnitude of acceleration during the trajectory
+ * @param angle the angle, in [0, pi/2], that splits the limits between the axes. The x
+ * axis gets the cosine of the limits and the y axis gets the sine, but never less than
+ * TRAJECTORY_2D_MIN_LIMIT_SHARE of them
+ *
+ * @return the planned trajectory
+ */
+static inline Trajectory2D planTrajectory2DWithSplit(Vector2D displacement,
+                                                     Vector2D initial_velocity,
+                                                     double max_velocity,
+                                                     double max_acceleration,
+                                                     double angle)
+{
+    double x_share = fmax(cos(angle), TRAJECTORY_2D_MIN_LIMIT_SHARE);
+    double y_share = fmax(sin(angle), TRAJECTORY_2D_MIN_LIMIT_SHARE);
+
+    Trajectory2D trajectory;
+    trajectory.x = planTrajectory1D(displacement.x, initial_velocity.x,
+                                    max_velocity * x_share, max_acceleration * x_share);
+    trajectory.y = planTrajectory1D(displacement.y, initial_velocity.y,
+                                    max_velocity * y_share, max_acceleration * y_share);
+    return trajectory;
+}
+
+/**
+ * Plans the fastest 2D trajectory from rest or motion to rest at the given
+ * displacement, where both axes arrive at the same time
+ *
+ * @param displacement the displacement to travel
+ * @param initial_velocity the velocity at the start of the trajectory
+ * @param max_velocity the max speed during the trajectory, which must be positive
+ * @param max_acceleration the max magnitude of acceleration during the trajectory,
+ * which must be positive
+ *
+ * @return the planned trajectory
+ */
+static inline Trajectory2D planTrajectory2D(Vector2D displacement,
+                                            Vector2D initial_velocity,
+                                            double max_velocity, double max_acceleration)
+{
+    // If the initial velocity is along the line to the destination (or zero), the
+    // fastest trajectory is a straight line, so the limits are split along it
+    Vector2D direction = displacement;
+    if (direction.x == 0 && direction.y == 0)
+    {
+        direction = initial_velocity;
+    }
+    double cross =
+        displacement.x * initial_velocity.y - displacement.y * initial_velocity.x;
+    double scale = displacement.x * displacement.x + displacement.y * displacement.y +
+                   initial_velocity.x * initial_velocity.x +
+                   initial_velocity.y * initial_velocity.y;
+    if (fabs(cross) <= 1e-12 * scale)
+    {
+        double angle = (direction.x == 0 && direction.y == 0)
+                           ? M_PI / 4
+                           : atan2(fabs(direction.y), fabs(direction.x));
+        return planTrajectory2DWithSplit(displacement, initial_velocity, max_velocity,
+                                         max_acceleration, angle);
+    }
+
+    // Giving more of the limits to an axis makes it arrive sooner, so we bisect for the
+    // split where both axes arrive at the same time
+    double min_angle = 0;
+    double max_angle = M_PI / 2;
+    for (int i = 0; i < TRAJECTORY_2D_NUM_BISECTION_STEPS; i++)
+    {
+        double angle            = (min_angle + max_angle) / 2;
+        Trajectory2D trajectory = planTrajectory2DWithSplit(
+            displacement, initial_velocity, max_velocity, max_acceleration, angle);
+        if (getTrajectory1DDuration(&trajectory.x) >
+            getTrajectory1DDuration(&trajectory.y))
+        {
+            max_angle = angle;
+        }
+        else
+        {
+            min_angle = angle;
+        }
+    }
+
+    return planTrajectory2DWithSplit(displacement, initial_velocity, max_velocity,
+                                     max_acceleration, (min_angle + max_angle) / 2);
+}
+
+/**
+ * Returns how long the given 2D trajectory takes, in seconds
+ *
+ * @param trajectory the trajectory
+ *
+ * @return how long the trajectory takes until both axes come to rest
+ */
+static inline double getTrajectory2DDuration(const Trajectory2D *trajectory)
+{
+    return fmax(getTrajectory1DDuration(&trajectory->x),
+                getTrajectory1DDuration(&trajectory->y));
+}
+
+/**
+ * Finds the displacement and velocity along the given 2D trajectory at the given time
+ *
+ * @param trajectory the trajectory to sample
+ * @param time the time since the start of the trajectory, in seconds
+ * @param displacement[out] the displacement from the start of the trajectory
+ * @param velocity[out] the velocity
+ */
+static inline void sampleTrajectory2D(const Trajectory2D *trajectory, double time,
+                                      Vector2D *displacement, Vector2D *velocity)
+{
+    sampleTrajectory1D(&trajectory->x, time, &displacement->x, &velocity->x);
+    sampleTrajectory1D(&trajectory->y, time, &displacement->y, &velocity->y);
+}
@@ -7,11 +7,17 @@
 #include "ai/navigator/path_planning_navigator/path_planning_navigator.h"
 
 AI::AI()
-    : navigator(std::make_unique<PathPlanningNavigator>()),
-      // We use the current time in nanoseconds to initialize STP with a "random" seed
-      high_level(std::make_unique<STP>(
-          []() { return std::make_unique<HaltPlay>(); },
-          std::chrono::system_clock::now().time_since_epoch().count()))
+    : AI(
+          // We use the current time in nanoseconds to initialize STP with a "random" seed
+          std::make_unique<STP>(
+              []() { return std::make_unique<HaltPlay>(); },
+              std::chrono::system_clock::now().time_since_epoch().count()),
+          std::make_unique<PathPlanningNavigator>())
+{
+}
+
+AI::AI(std::unique_ptr<HL> high_level, std::unique_ptr<Navigator> navigator)
+    : high_level(std::move(high_level)), navigator(std::move(navigator))
 {
 }
 
@@ -19,6 +19,16 @@ class AI final
      */
     explicit AI();
 
+    /**
+     * Creates a new AI that uses the given high-level decision making and navigator.
+     * Each AI owns its own HL and Navigator, so several AIs can run independently in
+     * the same process
+     *
+     * @param high_level The high-level decision making for this AI
+     * @param navigator The navigator that turns the Intents from the HL into Primitives
+     */
+    explicit AI(std::unique_ptr<HL> high_level, std::unique_ptr<Navigator> navigator);
+
     /**
      * Calculates the Primitives that should be run by our Robots given the current
      * state of the world.
@@ -1,5 +1,7 @@
 #include "ai/evaluation/pass.h"
 
+#include "shared/trajectory.h"
+
 Duration AI::Evaluation::getTimeToOrientationForRobot(const Robot& robot,
                                                       const Angle& desired_orientation,
                                                       const double& max_velocity,
@@ -47,39 +49,21 @@ Duration AI::Evaluation::getTimeToPositionForRobot(const Robot& robot, const Poi
                                                    const double& max_acceleration,
                                                    const double& tolerance_meters)
 {
-    // We assume a linear acceleration profile:
-    // (1) velocity = MAX_ACCELERATION*time
-    // we integrate (1) to get:
-    // (2) displacement = MAX_ACCELERATION/2 * time^2
-    // we rearrange to get:
-    // (3) time = sqrt(2 * displacement / MAX_ACCELERATION)
-    // we sub. (3) into (1) to get:
-    // (4) velocity = MAX_ACCELERATION*sqrt(2 * displacement / MAX_ACCELERATION)
-    // and rearrange to get:
-    // (5) displacement = (velocity / MAX_ACCELERATION)^2 * MAX_ACCELERATION/2
-    // We re-arrange (3) to get:
-    // (6) displacement = time^2 * MAX_ACCELERATION/2
-
-    double dist = std::max(0.0, (robot.position() - dest).len() - tolerance_meters);
-
-    // Calculate the distance required to reach max possible velocity of the robot
-    // using (5)
-    double dist_to_max_possible_vel =
-        std::pow(max_velocity / max_acceleration, 2) * max_acceleration / 2;
-
-    // Calculate how long we'll accelerate for using (3), taking into account that we
-    // might not actually reach the max velocity if it will take too much distance
-    double acceleration_time =
-        std::sqrt(2 * std::min(dist / 2, dist_to_max_possible_vel) / max_acceleration);
+    // We use the same trajectory the robot follows when it is moved to a position, so
+    // this matches what the robot will actually do. The robot only needs to get within
+    // the tolerance of the destination, so we plan to the closest point in tolerance
+    Vector robot_to_dest = dest - robot.position();
+    double dist          = std::max(0.0, robot_to_dest.len() - tolerance_meters);
+    if (dist == 0)
+    {
+        return Duration::fromSeconds(0);
+    }
 
-    // Calculate how long we'll be at the max possible velocity (if any time at all)
-    double time_at_max_velocity =
-        std::max(0.0, dist - 2 * dist_to_max_possible_vel) / max_velocity;
-
-    // The time taken to get to the receiver point is:
-    // time to accelerate + time at the max velocity + time to de-accelerate
-    // Note that the acceleration time is the same as a de-acceleration time
-    double travel_time = 2 * acceleration_time + time_at_max_velocity;
+    Vector displacement = robot_to_dest.norm(dist);
+    Trajectory2D trajectory =
+        planTrajectory2D({displacement.x(), displacement.y()},
+                         {robot.velocity().x(), robot.velocity().y()}, max_velocity,
+                         max_acceleration);
 
-    return Duration::fromSeconds(travel_time);
+    return Duration::fromSeconds(getTrajectory2DDuration(&trajectory));
 }
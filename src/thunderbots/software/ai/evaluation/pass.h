@@ -29,7 +29,8 @@ namespace AI::Evaluation
     /**
      * Calculate minimum time it would take for the given robot to reach the given point
      *
-     * This is only a rough calculation in order to be as performant as possible
+     * This is the duration of the time-optimal trajectory from the robot's current
+     * position and velocity to rest at the point, as planned by shared/trajectory.h
      *
      * @param robot The robot to calculate the time for
      * @param dest The destination that the robot is going to
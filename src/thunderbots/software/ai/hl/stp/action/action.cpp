@@ -1,9 +1,11 @@
 #include "ai/hl/stp/action/action.h"
 
+#include "util/coroutine_stack_pool.h"
 #include "util/logger/init.h"
 
 Action::Action()
-    : intent_sequence(boost::bind(&Action::calculateNextIntentWrapper, this, _1))
+    : intent_sequence(Util::CoroutineStackPool::getInstance().getAllocator(),
+                      boost::bind(&Action::calculateNextIntentWrapper, this, _1))
 {
 }
 
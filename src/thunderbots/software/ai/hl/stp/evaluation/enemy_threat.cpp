@@ -1,6 +1,7 @@
 #include "ai/hl/stp/evaluation/enemy_threat.h"
 
 #include <deque>
+#include <stdexcept>
 
 #include "ai/hl/stp/evaluation/calc_best_shot.h"
 #include "ai/hl/stp/evaluation/intercept.h"
@@ -67,100 +68,149 @@ Evaluation::findAllReceiverPasserPairs(const std::vector<Robot> &possible_passer
     return receiver_passer_pairs;
 }
 
-std::optional<std::pair<int, std::optional<Robot>>> Evaluation::getNumPassesToRobot(
-    const Robot &initial_passer, const Robot &final_receiver, const Team &passing_team,
-    const Team &other_team)
+std::vector<uint64_t> Evaluation::getPassReachabilityGraph(
+    const std::vector<Robot> &robots)
 {
-    if (initial_passer == final_receiver)
+    if (robots.size() > 64)
     {
-        return std::make_pair(0, std::nullopt);
+        throw std::invalid_argument(
+            "Cannot build a pass reachability graph for more than 64 robots");
+    }
+
+    std::vector<uint64_t> graph(robots.size(), 0);
+
+    // The pass from i to j is blocked by the same robots as the pass from j to i, so
+    // each pass lane is only checked once
+    for (std::size_t i = 0; i < robots.size(); i++)
+    {
+        for (std::size_t j = i + 1; j < robots.size(); j++)
+        {
+            Segment pass_lane(robots[i].position(), robots[j].position());
+
+            // Check if the pass would be blocked by any robot other than the passer
+            // and receiver
+            bool pass_blocked = false;
+            for (std::size_t k = 0; k < robots.size() && !pass_blocked; k++)
+            {
+                pass_blocked =
+                    k != i && k != j &&
+                    intersects(Circle(robots[k].position(), ROBOT_MAX_RADIUS_METERS),
+                               pass_lane);
+            }
+
+            if (!pass_blocked)
+            {
+                graph[i] |= uint64_t(1) << j;
+                graph[j] |= uint64_t(1) << i;
+            }
+        }
     }
 
+    return graph;
+}
+
+std::vector<std::optional<std::pair<int, std::optional<Robot>>>>
+Evaluation::getNumPassesToAllRobots(const Robot &initial_passer,
+                                    const Team &passing_team, const Team &other_team)
+{
     // We calculate the minimum number of passes it would take for the initial_passer
-    // robot to pass the ball to the final_receiver, assuming both robots are on the given
-    // team
+    // robot to pass the ball to every other robot on the team
     //
-    // This algorithm essentially treats the team of robots like a Directed Acyclic
-    // Graph and "traverses" the graph to find the shortest path to the robot
+    // This algorithm treats the team of robots like a graph, where robots are connected
+    // if they can pass to each other, and does a breadth-first search from the initial
+    // passer to find the shortest path to every robot
+    const std::vector<Robot> &robots = passing_team.getAllRobots();
+    std::vector<std::optional<std::pair<int, std::optional<Robot>>>> result(
+        robots.size(), std::nullopt);
+
+    auto initial_passer_iter = std::find(robots.begin(), robots.end(), initial_passer);
+    if (initial_passer_iter == robots.end())
+    {
+        return result;
+    }
+    std::size_t initial_passer_index = initial_passer_iter - robots.begin();
+    result[initial_passer_index]     = std::make_pair(0, std::nullopt);
 
-    // The robots that could have the ball and make a pass at each iteration. They
-    // are on the "frontier" of the graph search
-    std::vector<Robot> current_passers{initial_passer};
-    // The remaining robots we haven't checked yet
-    std::vector<Robot> unvisited_robots = passing_team.getAllRobots();
-    // Remove the initial passer since we already start off visiting it, and don't need
-    // to again
-    unvisited_robots.erase(
-        std::remove(unvisited_robots.begin(), unvisited_robots.end(), initial_passer),
-        unvisited_robots.end());
-    std::vector<Robot> all_robots   = passing_team.getAllRobots();
-    std::vector<Robot> other_robots = other_team.getAllRobots();
     // TODO: possibly re-enable using friendly robots as obstacles if we can find a way to
     // stop defenders from oscillating between positions See
     // https://github.com/UBC-Thunderbots/Software/issues/642
-    // all_robots.insert(all_robots.end(), other_robots.begin(), other_robots.end());
+    std::vector<uint64_t> graph = getPassReachabilityGraph(robots);
 
-    // On each iteration, check what robots can be passed to. These receivers will
-    // become the passers on the next iteration. This is like expanding the frontier
-    // of the graph
-    //
-    // We continue to iterate and check greater numbers of passes until one of the
-    // following cases:
-    // * There are no more passers at the end of the iteration. This means no more
-    //   unvisited robots can be passed to
-    // * There are no more unvisited robots
-    // * We have iterated up to the size of the team. This is a fallback case to
-    //   prevent any infinite loops, just in case
-    //
-    // We already check the case where the passer and receiver are the same. If this was
-    // the case, 0 passes would be required. Since that case is already checked, when we
-    // start the loop we are checking for the possibility of the receiver getting the ball
-    // in 1 pass. This is why pass_num starts at 1.
-    for (int pass_num = 1; pass_num < passing_team.numRobots() &&
-                           !current_passers.empty() && !unvisited_robots.empty();
+    // The robots that could have the ball and make a pass at each iteration. They
+    // are on the "frontier" of the graph search
+    uint64_t current_passers = uint64_t(1) << initial_passer_index;
+    // The robots we have already found the number of passes to
+    uint64_t visited_robots = current_passers;
+
+    // On each iteration, check what unvisited robots can be passed to by the current
+    // passers. These receivers will become the passers on the next iteration. We stop
+    // when there are no more passers, or we have iterated up to the size of the team as
+    // a fallback to prevent any infinite loops
+    for (int pass_num = 1; pass_num < static_cast<int>(robots.size()) && current_passers;
          pass_num++)
     {
-        std::map<Robot, std::vector<Robot>, Robot::cmpRobotByID> receiver_passer_pairs =
-            findAllReceiverPasserPairs(current_passers, unvisited_robots, all_robots);
-
-        // If the robot we are looking for is a receiver, return the number of
-        // passes and the passer to this robot
-        if (receiver_passer_pairs.count(final_receiver) > 0)
+        uint64_t receivers = 0;
+        for (std::size_t receiver = 0; receiver < robots.size(); receiver++)
         {
+            uint64_t passers_to_receiver = graph[receiver] & current_passers;
+            if (((visited_robots >> receiver) & 1) || !passers_to_receiver)
+            {
+                continue;
+            }
+
             // If there are multiple robots that can pass to the robot, we assume
             // it will receive the ball from the closest one since this is more
             // likely
-            auto closest_passer = Evaluation::nearestRobot(
-                receiver_passer_pairs.at(final_receiver), final_receiver.position());
-            return std::make_pair(pass_num, closest_passer);
-        }
+            std::optional<std::size_t> closest_passer;
+            double closest_passer_distance_squared = 0;
+            for (std::size_t passer = 0; passer < robots.size(); passer++)
+            {
+                if (!((passers_to_receiver >> passer) & 1))
+                {
+                    continue;
+                }
+                double distance_squared =
+                    (robots[passer].position() - robots[receiver].position()).lensq();
+                if (!closest_passer || distance_squared < closest_passer_distance_squared)
+                {
+                    closest_passer                  = passer;
+                    closest_passer_distance_squared = distance_squared;
+                }
+            }
 
-        // Create a list of all robots that could receive the ball this iteration
-        std::vector<Robot> all_receivers;
-        for (auto it = receiver_passer_pairs.begin(); it != receiver_passer_pairs.end();
-             it++)
-        {
-            all_receivers.emplace_back(it->first);
+            result[receiver] = std::make_pair(pass_num, robots[*closest_passer]);
+            receivers |= uint64_t(1) << receiver;
         }
 
         // All robots that could have received the ball now become passers
-        current_passers = all_receivers;
-
-        // Remove any receivers from the unvisited robots, since they have
-        // now been visited
-        unvisited_robots.erase(remove_if(unvisited_robots.begin(), unvisited_robots.end(),
-                                         [&](auto x) {
-                                             return find(all_receivers.begin(),
-                                                         all_receivers.end(),
-                                                         x) != all_receivers.end();
-                                         }),
-                               unvisited_robots.end());
+        current_passers = receivers;
+        visited_robots |= receivers;
     }
 
-    // If we have checked all the robots we can and still haven't found the robot we
-    // are looking for, it must be blocked and unable to be passed to in the current
-    // state. Therefore, we return an std::nullopt
-    return std::nullopt;
+    // Any robots we have not visited must be blocked and unable to be passed to in the
+    // current state, so their result is left as an std::nullopt
+    return result;
+}
+
+std::optional<std::pair<int, std::optional<Robot>>> Evaluation::getNumPassesToRobot(
+    const Robot &initial_passer, const Robot &final_receiver, const Team &passing_team,
+    const Team &other_team)
+{
+    if (initial_passer == final_receiver)
+    {
+        return std::make_pair(0, std::nullopt);
+    }
+
+    const std::vector<Robot> &robots = passing_team.getAllRobots();
+    auto final_receiver_iter = std::find(robots.begin(), robots.end(), final_receiver);
+    if (final_receiver_iter == robots.end())
+    {
+        return std::nullopt;
+    }
+
+    auto all_pass_data =
+        getNumPassesToAllRobots(initial_passer, passing_team, other_team);
+    return all_pass_data.at(final_receiver_iter - robots.begin());
 }
 
 void Evaluation::sortThreatsInDecreasingOrder(
@@ -233,8 +283,23 @@ std::vector<Evaluation::EnemyThreat> Evaluation::getAllEnemyThreats(
 
     std::vector<Evaluation::EnemyThreat> threats;
 
-    for (const auto &robot : enemy_team.getAllRobots())
+    // Find how many passes it takes for each enemy to get the ball up front, so the
+    // pass reachability graph is only built once
+    std::vector<std::optional<std::pair<int, std::optional<Robot>>>> all_pass_data(
+        enemy_team.numRobots(), std::nullopt);
+    auto robot_with_effective_possession =
+        Evaluation::getRobotWithEffectiveBallPossession(enemy_team, ball, field);
+    if (robot_with_effective_possession)
+    {
+        all_pass_data = Evaluation::getNumPassesToAllRobots(
+            robot_with_effective_possession.value(), enemy_team, friendly_team);
+    }
+
+    const std::vector<Robot> &enemy_robots = enemy_team.getAllRobots();
+    for (std::size_t i = 0; i < enemy_robots.size(); i++)
     {
+        const Robot &robot = enemy_robots[i];
+
         bool has_ball = Evaluation::robotHasPossession(ball, robot);
 
         // Get the angle from the robot to each friendly goalpost, then find the
@@ -260,18 +325,10 @@ std::vector<Evaluation::EnemyThreat> Evaluation::getAllEnemyThreats(
         // passer to be an empty optional
         int num_passes              = enemy_team.numRobots();
         std::optional<Robot> passer = std::nullopt;
-        auto robot_with_effective_possession =
-            Evaluation::getRobotWithEffectiveBallPossession(enemy_team, ball, field);
-        if (robot_with_effective_possession)
+        if (all_pass_data[i])
         {
-            auto pass_data =
-                Evaluation::getNumPassesToRobot(robot_with_effective_possession.value(),
-                                                robot, enemy_team, friendly_team);
-            if (pass_data)
-            {
-                num_passes = pass_data->first;
-                passer     = pass_data->second;
-            }
+            num_passes = all_pass_data[i]->first;
+            passer     = all_pass_data[i]->second;
         }
 
         Evaluation::EnemyThreat threat{robot,           has_ball,         goal_angle,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <optional>
 #include <vector>
 
@@ -70,6 +71,39 @@ namespace Evaluation
         const std::vector<Robot> &possible_receivers,
         const std::vector<Robot> &all_robots);
 
+    /**
+     * Returns which of the given robots can pass directly to each other, as an
+     * adjacency bitmask over the indices of the robots. Bit j of element i is set if
+     * robot i can pass to robot j without the pass being blocked by any of the other
+     * given robots. Passes are symmetric, so the graph is undirected.
+     *
+     * @param robots The robots that can pass to each other, and that can block passes.
+     * There must be no more than 64 robots
+     * @throws std::invalid_argument if there are more than 64 robots
+     *
+     * @return The adjacency bitmask for each of the given robots
+     */
+    std::vector<uint64_t> getPassReachabilityGraph(const std::vector<Robot> &robots);
+
+    /**
+     * Returns how many passes it would take for the given passer to pass the ball to
+     * each robot on the passing team, and the intermediate passer each robot is most
+     * likely to receive the ball from. The pass reachability graph is only built once,
+     * so this is much cheaper than calling getNumPassesToRobot for each robot.
+     *
+     * @param initial_passer The robot the passes start from. This robot must be on the
+     * passing team
+     * @param passing_team The team the passer and receiver robots are a part of
+     * @param other_team The other team (the enemy of the passing team)
+     *
+     * @return A vector with one entry for each robot in passing_team.getAllRobots(),
+     * in the same order. Each entry is what getNumPassesToRobot would return for that
+     * robot as the final receiver
+     */
+    std::vector<std::optional<std::pair<int, std::optional<Robot>>>>
+    getNumPassesToAllRobots(const Robot &initial_passer, const Team &passing_team,
+                            const Team &other_team);
+
     /**
      * Returns how many passes it would take for the given passer to pass the ball to the
      * receiver so the receiver gains possession of the ball, and returns the intermediate
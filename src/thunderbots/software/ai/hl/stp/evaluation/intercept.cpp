@@ -3,98 +3,277 @@
  */
 #include "intercept.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "ai/evaluation/pass.h"
 #include "shared/constants.h"
-#include "util/gradient_descent.h"
+#include "shared/trajectory.h"
 
-namespace Evaluation
+namespace
 {
-    std::optional<std::pair<Point, Duration>> findBestInterceptForBall(Ball ball,
-                                                                       Field field,
-                                                                       Robot robot)
+    // The step size used to bracket the earliest intercept while the robot is still
+    // accelerating, where there is no closed-form solution
+    const double INTERCEPT_SEARCH_STEP_SECONDS = 0.02;
+
+    // How precisely the earliest intercept time is found within a bracket
+    const double INTERCEPT_TIME_TOLERANCE_SECONDS = 1e-6;
+
+    /**
+     * Returns the interval of time that the ball will be within the field lines, in
+     * seconds after the ball's timestamp. Since the ball travels in a straight line and
+     * the field is convex, this is a single interval
+     *
+     * @param ball The ball
+     * @param field The field
+     *
+     * @return The start and end of the interval the ball is in the field, or
+     * std::nullopt if the ball never enters the field in the future
+     */
+    std::optional<std::pair<double, double>> getTimeIntervalBallInField(
+        const Ball &ball, const Field &field)
     {
-        static const double gradient_approx_step_size = 0.000001;
-
-        // We use this to take a smooth absolute value in our objective function
-        static const double smooth_abs_eps = 1000 * gradient_approx_step_size;
-
-        // This is the objective function that we want to minimize, finding the
-        // shortest duration in the future at which we can feasibly intercept the
-        // ball
-        auto objective_function = [&](std::array<double, 1> x) {
-            // We take the absolute value here because a negative time makes no sense
-            double duration = std::abs(x.at(0));
-
-            // If the ball timestamp is less then the robot timestamp, add the difference
-            // here so that we're optimizing to a duration that is after the robot
-            // timestamp
-            if (ball.lastUpdateTimestamp() < robot.lastUpdateTimestamp())
+        // Intersect the ball's path with the "slab" between the field lines along each
+        // axis
+        double start = 0;
+        double end   = std::numeric_limits<double>::infinity();
+
+        auto intersect_slab = [&](double position, double velocity, double min,
+                                  double max) {
+            if (velocity == 0)
             {
-                duration += (robot.lastUpdateTimestamp() - ball.lastUpdateTimestamp())
-                                .getSeconds();
+                if (position < min || position > max)
+                {
+                    end = -1;
+                }
+                return;
             }
+            double t1 = (min - position) / velocity;
+            double t2 = (max - position) / velocity;
+            start     = std::max(start, std::min(t1, t2));
+            end       = std::min(end, std::max(t1, t2));
+        };
+
+        Point min_corner = field.friendlyCornerNeg();
+        Point max_corner = field.enemyCornerPos();
+        intersect_slab(ball.position().x(), ball.velocity().x(), min_corner.x(),
+                       max_corner.x());
+        intersect_slab(ball.position().y(), ball.velocity().y(), min_corner.y(),
+                       max_corner.y());
+
+        if (start > end)
+        {
+            return std::nullopt;
+        }
+        return std::make_pair(start, end);
+    }
 
-            // Estimate the ball position
-            Point new_ball_pos =
-                ball.estimatePositionAtFutureTime(Duration::fromSeconds(duration));
+    /**
+     * Finds the best intercept of the ball for a single robot
+     *
+     * @param ball The ball to intercept
+     * @param field The field on which we want the intercept to occur
+     * @param robot The robot that will hopefully intercept the ball
+     * @param ball_in_field_interval The interval of time the ball is in the field, as
+     * returned by getTimeIntervalBallInField
+     *
+     * @return The same as Evaluation::findBestInterceptForBall
+     */
+    std::optional<std::pair<Point, Duration>> findBestInterceptForBall(
+        const Ball &ball, const Field &field, const Robot &robot,
+        const std::pair<double, double> &ball_in_field_interval)
+    {
+        const double max_velocity     = ROBOT_MAX_SPEED_METERS_PER_SECOND;
+        const double max_acceleration = ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED;
+
+        // All times here are in seconds after the ball's timestamp. The robot starts
+        // moving at its own timestamp, which may be before or after the ball's
+        double robot_start_time =
+            (robot.lastUpdateTimestamp() - ball.lastUpdateTimestamp()).getSeconds();
 
-            // Figure out how long it will take the robot to get to the new ball position
-            Duration time_to_ball_pos = AI::Evaluation::getTimeToPositionForRobot(
-                robot, new_ball_pos, ROBOT_MAX_SPEED_METERS_PER_SECOND,
-                ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED);
+        // We can't predict where the ball was in the past, or intercept the ball before
+        // the robot starts moving or outside the field
+        double min_time =
+            std::max({0.0, robot_start_time, ball_in_field_interval.first});
+        double max_time = ball_in_field_interval.second;
+        if (min_time > max_time)
+        {
+            return std::nullopt;
+        }
 
-            // Figure out when the robot will reach the new ball position relative to the
-            // time that the ball will get there (ie. will we get there in time?)
-            double ball_robot_time_diff = duration - time_to_ball_pos.getSeconds();
+        // The ball position at time t is (ball.position() + ball_velocity * t), so the
+        // vector from the ball to the robot is (ball_to_robot - ball_velocity * t)
+        Vector ball_to_robot = robot.position() - ball.position();
+        Vector ball_velocity = ball.velocity();
 
-            // We want to get to the ball at the earliest opportunity possible, so
-            // aim for a time diff of zero. We use a smooth approximation of
-            // the maximum here
-            return std::sqrt(std::pow(ball_robot_time_diff, 2) + smooth_abs_eps);
+        // The robot can intercept the ball at time t if it can travel far enough to
+        // reach the ball by then, using the same trajectories as
+        // AI::Evaluation::getTimeToPositionForRobot from rest. This is non-negative when
+        // an intercept is feasible
+        auto intercept_margin = [&](double t) {
+            return getMaxTrajectory1DDistance(t - robot_start_time, max_velocity,
+                                              max_acceleration) -
+                   (ball_to_robot - ball_velocity * t).len();
         };
 
-        // Figure out when/where to intercept the ball. We do this by optimizing over
-        // the ball position as a function of it's travel time
-        // We make the weight here an inverse of the ball speed, so that the gradient
-        // descent takes smaller steps when the ball is moving faster
-        double descent_weight = 1 / (std::exp(ball.velocity().len() * 0.5));
-        Util::GradientDescentOptimizer<1> optimizer({descent_weight},
-                                                    gradient_approx_step_size);
-        Duration best_ball_travel_duration = Duration::fromSeconds(
-            std::abs(optimizer.minimize(objective_function, {0}, 50).at(0)));
-
-        // In the objective function above, if the robot timestamp > ball timestamp, we
-        // add on the difference so we get a intercept time after the robot timestamp, so
-        // we need to do the same here to get the duration we actually optimized on
-        if (robot.lastUpdateTimestamp() > ball.lastUpdateTimestamp())
+        // Find the earliest time the intercept is feasible
+        std::optional<double> intercept_time;
+        if (intercept_margin(min_time) >= 0)
         {
-            best_ball_travel_duration =
-                best_ball_travel_duration +
-                (robot.lastUpdateTimestamp() - ball.lastUpdateTimestamp());
+            intercept_time = min_time;
         }
 
-        Point best_ball_intercept_pos =
-            ball.estimatePositionAtFutureTime(best_ball_travel_duration);
+        // While the robot is still accelerating there is no simple closed-form solution,
+        // so we step forwards to bracket the earliest feasible time and then bisect
+        double acceleration_end_time = robot_start_time + 2 * max_velocity / max_acceleration;
+        double search_end_time       = std::min(max_time, acceleration_end_time);
+        for (double prev_t = min_time; !intercept_time && prev_t < search_end_time;)
+        {
+            double t = std::min(prev_t + INTERCEPT_SEARCH_STEP_SECONDS, search_end_time);
+            if (intercept_margin(t) >= 0)
+            {
+                double infeasible_t = prev_t;
+                while (t - infeasible_t > INTERCEPT_TIME_TOLERANCE_SECONDS)
+                {
+                    double mid_t = (infeasible_t + t) / 2;
+                    if (intercept_margin(mid_t) >= 0)
+                    {
+                        t = mid_t;
+                    }
+                    else
+                    {
+                        infeasible_t = mid_t;
+                    }
+                }
+                intercept_time = t;
+            }
+            prev_t = t;
+        }
 
-        // Check that we can get to the best position in time
-        Duration time_to_ball_pos = AI::Evaluation::getTimeToPositionForRobot(
-            robot, best_ball_intercept_pos, ROBOT_MAX_SPEED_METERS_PER_SECOND,
-            ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED);
-        Duration ball_robot_time_diff = time_to_ball_pos - best_ball_travel_duration;
-        // NOTE: if ball velocity is 0 then ball travel duration is infinite, so this
-        // check isn't relevent in that case
-        if (ball.velocity().len() != 0 &&
-            std::abs(ball_robot_time_diff.getSeconds()) > descent_weight)
+        // Once the robot can reach max velocity, the distance it can travel is linear in
+        // time, so the earliest feasible time is the first root of the quadratic
+        //   |ball_to_robot - ball_velocity * t|^2 - (max_velocity * (t - c))^2 = 0
+        // where c is the time lost to accelerating and decelerating
+        double cruise_start_time = std::max(min_time, acceleration_end_time);
+        if (!intercept_time && cruise_start_time <= max_time)
+        {
+            if (intercept_margin(cruise_start_time) >= 0)
+            {
+                intercept_time = cruise_start_time;
+            }
+            else
+            {
+                double c = robot_start_time + max_velocity / max_acceleration;
+                double a = ball_velocity.lensq() - std::pow(max_velocity, 2);
+                double b = -2 * ball_to_robot.dot(ball_velocity) +
+                           2 * std::pow(max_velocity, 2) * c;
+                double k = ball_to_robot.lensq() - std::pow(max_velocity * c, 2);
+
+                std::vector<double> roots;
+                if (std::abs(a) < 1e-12)
+                {
+                    if (b != 0)
+                    {
+                        roots.emplace_back(-k / b);
+                    }
+                }
+                else
+                {
+                    double discriminant = b * b - 4 * a * k;
+                    if (discriminant >= 0)
+                    {
+                        roots.emplace_back((-b - std::sqrt(discriminant)) / (2 * a));
+                        roots.emplace_back((-b + std::sqrt(discriminant)) / (2 * a));
+                    }
+                }
+
+                std::sort(roots.begin(), roots.end());
+                for (double root : roots)
+                {
+                    if (root >= cruise_start_time && root <= max_time)
+                    {
+                        intercept_time = root;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (!intercept_time)
         {
             return std::nullopt;
         }
 
-        // Check that the best intercept position is actually on the field
+        Point best_ball_intercept_pos =
+            ball.estimatePositionAtFutureTime(Duration::fromSeconds(*intercept_time));
+
+        // Check that the best intercept position is actually on the field. This can only
+        // fail due to floating point error at the edge of the field
         if (!field.pointInFieldLines(best_ball_intercept_pos))
         {
             return std::nullopt;
         }
 
+        Duration time_to_ball_pos = AI::Evaluation::getTimeToPositionForRobot(
+            robot, best_ball_intercept_pos, max_velocity, max_acceleration);
+
         return std::make_pair(best_ball_intercept_pos, time_to_ball_pos);
     }
+}  // namespace
+
+namespace Evaluation
+{
+    std::optional<std::pair<Point, Duration>> findBestInterceptForBall(
+        const Ball &ball, const Field &field, const Robot &robot)
+    {
+        auto ball_in_field_interval = getTimeIntervalBallInField(ball, field);
+        if (!ball_in_field_interval)
+        {
+            return std::nullopt;
+        }
+
+        return ::findBestInterceptForBall(ball, field, robot, *ball_in_field_interval);
+    }
+
+    std::vector<std::optional<std::pair<Point, Duration>>> findBestInterceptsForBall(
+        const Ball &ball, const Field &field, const std::vector<Robot> &robots)
+    {
+        std::vector<std::optional<std::pair<Point, Duration>>> intercepts(robots.size(),
+                                                                          std::nullopt);
+
+        auto ball_in_field_interval = getTimeIntervalBallInField(ball, field);
+        if (!ball_in_field_interval)
+        {
+            return intercepts;
+        }
+
+        for (size_t i = 0; i < robots.size(); i++)
+        {
+            intercepts[i] = ::findBestInterceptForBall(ball, field, robots[i],
+                                                       *ball_in_field_interval);
+        }
+
+        return intercepts;
+    }
+
+    std::optional<std::pair<size_t, std::pair<Point, Duration>>>
+    findFastestInterceptForBall(const Ball &ball, const Field &field,
+                                const std::vector<Robot> &robots)
+    {
+        auto intercepts = findBestInterceptsForBall(ball, field, robots);
+
+        std::optional<std::pair<size_t, std::pair<Point, Duration>>> fastest_intercept;
+        for (size_t i = 0; i < intercepts.size(); i++)
+        {
+            if (intercepts[i] &&
+                (!fastest_intercept ||
+                 intercepts[i]->second < fastest_intercept->second.second))
+            {
+                fastest_intercept = std::make_pair(i, *intercepts[i]);
+            }
+        }
+
+        return fastest_intercept;
+    }
 }  // namespace Evaluation
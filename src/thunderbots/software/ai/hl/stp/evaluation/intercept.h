@@ -1,8 +1,10 @@
 /**
  * Declaration for STP intercept-related evaluation functions
  */
+#pragma once
 
 #include <optional>
+#include <vector>
 
 #include "ai/world/ball.h"
 #include "ai/world/field.h"
@@ -14,6 +16,11 @@ namespace Evaluation
     /**
      * Finds the best place for the given robot to intercept the given ball
      *
+     * The best intercept is the earliest point along the ball's path that the robot can
+     * reach before the ball does, using the same motion profile as
+     * AI::Evaluation::getTimeToPositionForRobot. This is solved for directly, rather
+     * than by iterative optimization.
+     *
      * @param ball The ball to intercept
      * @param field The field on which we want the intercept to occur
      * @param robot The robot that will hopefully intercept the ball
@@ -23,7 +30,37 @@ namespace Evaluation
      *         relative to the timestamp of the robot. If no possible intercept could be
      * found within the field bounds, returns std::nullopt
      */
-    std::optional<std::pair<Point, Duration>> findBestInterceptForBall(Ball ball,
-                                                                       Field field,
-                                                                       Robot robot);
+    std::optional<std::pair<Point, Duration>> findBestInterceptForBall(
+        const Ball &ball, const Field &field, const Robot &robot);
+
+    /**
+     * Finds the best place for each of the given robots to intercept the given ball.
+     * This gives the same results as calling findBestInterceptForBall for each robot,
+     * but only does the work that depends on the ball and field once
+     *
+     * @param ball The ball to intercept
+     * @param field The field on which we want the intercepts to occur
+     * @param robots The robots that will hopefully intercept the ball
+     *
+     * @return A vector with the result of findBestInterceptForBall for each of the given
+     * robots, in the same order as the robots
+     */
+    std::vector<std::optional<std::pair<Point, Duration>>> findBestInterceptsForBall(
+        const Ball &ball, const Field &field, const std::vector<Robot> &robots);
+
+    /**
+     * Finds which of the given robots can intercept the given ball the soonest
+     *
+     * @param ball The ball to intercept
+     * @param field The field on which we want the intercept to occur
+     * @param robots The robots that will hopefully intercept the ball
+     *
+     * @return The index of the robot in the given robots that can intercept the ball
+     * the soonest, along with the result of findBestInterceptForBall for that robot. If
+     * none of the robots can intercept the ball within the field bounds, returns
+     * std::nullopt
+     */
+    std::optional<std::pair<size_t, std::pair<Point, Duration>>>
+    findFastestInterceptForBall(const Ball &ball, const Field &field,
+                                const std::vector<Robot> &robots);
 }  // namespace Evaluation
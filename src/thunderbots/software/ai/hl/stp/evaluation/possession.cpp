@@ -19,28 +19,16 @@ namespace Evaluation
             return std::nullopt;
         }
 
-        auto best_intercept =
-            Evaluation::findBestInterceptForBall(ball, field, team.getAllRobots().at(0));
-        auto baller_robot = team.getAllRobots().at(0);
-
         // Find the robot that can intercept the ball the quickest
-        for (const auto &robot : team.getAllRobots())
-        {
-            auto intercept = Evaluation::findBestInterceptForBall(ball, field, robot);
-            if (!best_intercept ||
-                (intercept && intercept->second < best_intercept->second))
-            {
-                best_intercept = intercept;
-                baller_robot   = robot;
-            }
-        }
+        auto fastest_intercept =
+            Evaluation::findFastestInterceptForBall(ball, field, team.getAllRobots());
 
         // Return the robot that can intercept the ball the fastest within the field. If
         // no robot is able to intercept the ball within the field, return the closest
         // robot to the ball
-        if (best_intercept)
+        if (fastest_intercept)
         {
-            return baller_robot;
+            return team.getAllRobots().at(fastest_intercept->first);
         }
         else
         {
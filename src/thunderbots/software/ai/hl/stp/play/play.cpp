@@ -1,6 +1,12 @@
 #include "ai/hl/stp/play/play.h"
 
-Play::Play() : tactic_sequence(boost::bind(&Play::getNextTacticsWrapper, this, _1)) {}
+#include "util/coroutine_stack_pool.h"
+
+Play::Play()
+    : tactic_sequence(Util::CoroutineStackPool::getInstance().getAllocator(),
+                      boost::bind(&Play::getNextTacticsWrapper, this, _1))
+{
+}
 
 bool Play::done() const
 {
@@ -1,56 +1,147 @@
 #include "ai/hl/stp/play/play_factory.h"
 
+#include <algorithm>
 #include <exception>
+#include <stdexcept>
 
-PlayRegistry& PlayFactory::getMutableRegistry()
+PlayFactory::PlayRegistry& PlayFactory::getMutableRegistry()
 {
     static PlayRegistry instance;
     return instance;
 }
 
-const PlayRegistry& PlayFactory::getRegistry()
+const std::vector<std::string>& PlayFactory::getRegisteredPlayNames()
 {
-    return PlayFactory::getMutableRegistry();
+    return PlayFactory::getMutableRegistry().names;
 }
 
-std::vector<std::string> PlayFactory::getRegisteredPlayNames()
+const std::vector<PlayConstructor>& PlayFactory::getRegisteredPlayConstructors()
 {
-    std::vector<std::string> names;
+    return PlayFactory::getMutableRegistry().constructors;
+}
+
+void PlayFactory::registerPlay(std::string play_name, PlayConstructor play_creator)
+{
+    PlayRegistry& registry = PlayFactory::getMutableRegistry();
 
-    for (auto iter = PlayFactory::getRegistry().begin();
-         iter != PlayFactory::getRegistry().end(); iter++)
+    // Keep the Plays sorted by name, so the PlayIds don't depend on the order the Plays
+    // were registered in
+    auto iter = std::lower_bound(registry.names.begin(), registry.names.end(), play_name);
+    if (iter != registry.names.end() && *iter == play_name)
     {
-        names.emplace_back(iter->first);
+        return;
     }
-    return names;
+
+    auto index = iter - registry.names.begin();
+    registry.names.insert(iter, std::move(play_name));
+    registry.constructors.insert(registry.constructors.begin() + index,
+                                 std::move(play_creator));
+
+    // Plays are only registered during static initialization, so rebuilding the whole
+    // lookup table here does not cost anything during gameplay
+    PlayFactory::buildNameLookupTable(registry);
 }
 
-std::vector<std::function<std::unique_ptr<Play>()>>
-PlayFactory::getRegisteredPlayConstructors()
+void PlayFactory::buildNameLookupTable(PlayRegistry& registry)
 {
-    std::vector<std::function<std::unique_ptr<Play>()>> constructors;
+    // The number of seeds to try for each table size before doubling the table size
+    static constexpr std::size_t MAX_SEEDS_PER_TABLE_SIZE = 64;
+
+    // Start with a table at least twice the number of names, which makes a seed with no
+    // collisions quick to find
+    std::size_t table_size = 1;
+    while (table_size < 2 * registry.names.size())
+    {
+        table_size *= 2;
+    }
 
-    for (auto iter = PlayFactory::getRegistry().begin();
-         iter != PlayFactory::getRegistry().end(); iter++)
+    for (std::size_t seed = 0;; seed++)
     {
-        constructors.emplace_back(iter->second);
+        if (seed > 0 && seed % MAX_SEEDS_PER_TABLE_SIZE == 0)
+        {
+            table_size *= 2;
+        }
+
+        registry.name_lookup_table.assign(table_size, std::nullopt);
+        bool has_collision = false;
+        for (PlayId id = 0; id < registry.names.size() && !has_collision; id++)
+        {
+            auto& slot = registry.name_lookup_table[hashPlayName(registry.names[id], seed) &
+                                                    (table_size - 1)];
+            has_collision = slot.has_value();
+            slot          = id;
+        }
+
+        if (!has_collision)
+        {
+            registry.name_hash_seed = seed;
+            return;
+        }
+    }
+}
+
+std::size_t PlayFactory::hashPlayName(std::string_view play_name, std::size_t seed)
+{
+    // The 64-bit FNV-1a hash, with the seed mixed into the offset basis
+    // https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
+    uint64_t hash = 14695981039346656037ULL ^ (seed * 0x9E3779B97F4A7C15ULL);
+    for (char c : play_name)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
     }
-    return constructors;
+    return static_cast<std::size_t>(hash ^ (hash >> 32));
 }
 
-void PlayFactory::registerPlay(std::string play_name,
-                               std::function<std::unique_ptr<Play>()> play_creator)
+std::optional<PlayId> PlayFactory::getPlayId(std::string_view play_name)
 {
-    PlayFactory::getMutableRegistry().insert(std::make_pair(play_name, play_creator));
+    const PlayRegistry& registry = PlayFactory::getMutableRegistry();
+    if (registry.names.empty())
+    {
+        return std::nullopt;
+    }
+
+    std::size_t slot = hashPlayName(play_name, registry.name_hash_seed) &
+                       (registry.name_lookup_table.size() - 1);
+    auto id = registry.name_lookup_table[slot];
+
+    // Names that are not registered can still hash to an occupied slot, so we have to
+    // check the name actually matches
+    if (id && registry.names[*id] == play_name)
+    {
+        return id;
+    }
+    return std::nullopt;
+}
+
+const std::string& PlayFactory::getPlayName(PlayId play_id)
+{
+    const auto& names = PlayFactory::getRegisteredPlayNames();
+    if (play_id >= names.size())
+    {
+        throw std::invalid_argument("No Play with id " + std::to_string(play_id) +
+                                    " found in the PlayFactory");
+    }
+    return names[play_id];
+}
+
+std::unique_ptr<Play> PlayFactory::createPlay(PlayId play_id)
+{
+    const auto& constructors = PlayFactory::getRegisteredPlayConstructors();
+    if (play_id >= constructors.size())
+    {
+        throw std::invalid_argument("No constructor for Play with id " +
+                                    std::to_string(play_id) + " found in the PlayFactory");
+    }
+    return constructors[play_id]();
 }
 
 std::unique_ptr<Play> PlayFactory::createPlay(const std::string& play_name)
 {
-    auto registry = PlayFactory::getRegistry();
-    auto iter     = registry.find(play_name);
-    if (iter != registry.end())
+    auto play_id = PlayFactory::getPlayId(play_name);
+    if (play_id)
     {
-        return iter->second();
+        return PlayFactory::createPlay(*play_id);
     }
     else
     {
@@ -1,18 +1,31 @@
 #pragma once
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 
 #include "ai/hl/stp/play/play.h"
 
 // A quality of life typedef to make things shorter and more readable
-typedef std::unordered_map<std::string, std::function<std::unique_ptr<Play>()>>
-    PlayRegistry;
+typedef std::function<std::unique_ptr<Play>()> PlayConstructor;
+
+// A PlayId uniquely identifies a Play in the PlayFactory registry. Ids are the index of
+// the Play when all registered Plays are sorted by name, so they are the same every time
+// the program is run with the same set of Plays
+typedef std::size_t PlayId;
 
 /**
  * The PlayFactory is an Abstract class that provides an interface for Play Factories
  * to follow. This makes it easy to maintain a list of factories and get the corresponding
  * plays through the generic interface.
+ *
+ * All Plays register themselves before main() runs (see TPlayFactory below), so the
+ * registry is built once and never changes during gameplay. The registry caches the
+ * name and constructor of every Play in vectors indexed by PlayId, and a perfect hash
+ * table is built over the Play names so a name can be resolved to a PlayId with a single
+ * hash and string comparison, without allocating.
  */
 class PlayFactory
 {
@@ -30,55 +43,109 @@ class PlayFactory
     static std::unique_ptr<Play> createPlay(const std::string& play_name);
 
     /**
-     * Returns a const reference to the Play registry. The registry is a map of Play names
-     * to a "create" function that will create and return a unique_ptr to a new concrete
-     * instance of the Play.
+     * Returns a unique pointer to a newly constructed Play with the given id
+     *
+     * @param play_id The id of the Play to construct
+     * @throws std::invalid_argument if the given play_id is not a registered PlayId
+     *
+     * @return a unique pointer to a newly constructed Play with the given id
+     */
+    static std::unique_ptr<Play> createPlay(PlayId play_id);
+
+    /**
+     * Returns the id of the Play with the given name
      *
-     * @return a const reference to the Play registry
+     * @param play_name The name of the Play
+     *
+     * @return the id of the Play with the given name, or std::nullopt if no Play with
+     * the given name is registered
      */
-    static const PlayRegistry& getRegistry();
+    static std::optional<PlayId> getPlayId(std::string_view play_name);
 
     /**
-     * Returns a list of names of all the existing Plays
+     * Returns the name of the Play with the given id
+     *
+     * @param play_id The id of the Play
+     * @throws std::invalid_argument if the given play_id is not a registered PlayId
+     *
+     * @return the name of the Play with the given id
+     */
+    static const std::string& getPlayName(PlayId play_id);
+
+    /**
+     * Returns a list of names of all the existing Plays. The name of the Play with id i
+     * is at index i
      *
      * @return a list of names of all the existing Plays
      */
-    static std::vector<std::string> getRegisteredPlayNames();
+    static const std::vector<std::string>& getRegisteredPlayNames();
 
     /**
-     * Returns a list of constructor functions for all the existing Plays
+     * Returns a list of constructor functions for all the existing Plays. The
+     * constructor of the Play with id i is at index i
      *
      * @return a list of constructor functions for all the existing Plays
      */
-    static std::vector<std::function<std::unique_ptr<Play>()>>
-    getRegisteredPlayConstructors();
+    static const std::vector<PlayConstructor>& getRegisteredPlayConstructors();
 
    protected:
     /**
-     * Adds a Play to the Play Registry
+     * Adds a Play to the Play Registry. If a Play with the same name has already been
+     * registered, the registry is not changed
      *
      * @param play_name The name of the Play to be added
      * @param play_creator A "create" function that takes no arguments and will return
      * a unique_ptr to a new instance of the specified Play
      */
-    static void registerPlay(std::string play_name,
-                             std::function<std::unique_ptr<Play>()> play_creator);
+    static void registerPlay(std::string play_name, PlayConstructor play_creator);
 
    private:
     /**
-     * Returns a reference to the Play registry. The registry is a map of Play names
-     * to a "create" function that will create and return a unique_ptr to a new concrete
-     * instance of the Play, which allows the code to be aware
-     * of all the Plays that are available.
-     *
-     * This is the same as the above public getRegistry function. We need a mutable
-     * version in order to add entries to the registry. The function is private so that
-     * only this class can make the modifications. Outside sources should not have direct
-     * access to modify the registry.
+     * The Play registry, which allows the code to be aware of all the Plays that are
+     * available
+     */
+    struct PlayRegistry
+    {
+        // The names and constructors of all the Plays, sorted by name and indexed by
+        // PlayId
+        std::vector<std::string> names;
+        std::vector<PlayConstructor> constructors;
+
+        // A hash table with no collisions between the registered names. The slot for a
+        // name is given by hashPlayName(name, name_hash_seed), and contains the id of
+        // the Play if a registered Play hashes to that slot. The size of the table is
+        // always a power of 2
+        std::vector<std::optional<PlayId>> name_lookup_table;
+        std::size_t name_hash_seed = 0;
+    };
+
+    /**
+     * Returns a reference to the Play registry. We need a mutable reference in order to
+     * add entries to the registry. The function is private so that only this class can
+     * make the modifications. Outside sources should not have direct access to modify
+     * the registry.
      *
      * @return a mutable reference to the Play registry
      */
     static PlayRegistry& getMutableRegistry();
+
+    /**
+     * Rebuilds the name lookup table of the given registry, searching for a table size
+     * and hash seed with no collisions between the registered names
+     *
+     * @param registry The registry to rebuild the name lookup table for
+     */
+    static void buildNameLookupTable(PlayRegistry& registry);
+
+    /**
+     * Hashes the given Play name
+     *
+     * @param play_name The Play name to hash
+     * @param seed The seed of the hash function
+     *
+     * @return the hash of the given Play name
+     */
+    static std::size_t hashPlayName(std::string_view play_name, std::size_t seed);
 };
 
 /**
@@ -0,0 +1,344 @@
+#include "ai/hl/stp/robot_tactic_assigner.h"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+RobotTacticAssigner::RobotTacticAssigner() {}
+
+std::vector<std::size_t> RobotTacticAssigner::assign(
+    const World &world, const std::vector<Robot> &robots,
+    const std::vector<std::shared_ptr<Tactic>> &tactics)
+{
+    if (tactics.size() > robots.size())
+    {
+        throw std::invalid_argument(
+            "Cannot assign robots to tactics because there are more tactics than robots");
+    }
+
+    std::size_t num_robots  = robots.size();
+    std::size_t num_tactics = tactics.size();
+
+    stats.num_tactics_assigned      = num_tactics;
+    stats.num_warm_started_pairs    = 0;
+    stats.num_tactics_kept_robot    = 0;
+    stats.num_tactics_changed_robot = 0;
+    stats.total_cost                = 0.0;
+
+    calculateCosts(world, robots, tactics);
+
+    // The rows of the matrix are the "workers" (the robots) and the columns are the
+    // "jobs" (the Tactics). There are never more tactics than robots, so the matrix is
+    // made square by padding the extra columns with the largest cost in the matrix
+    std::size_t size = num_robots;
+    double max_cost  = costs.empty() ? 0.0 : *std::max_element(costs.begin(), costs.end());
+    matrix.assign(size * size, max_cost);
+    for (std::size_t col = 0; col < num_tactics; col++)
+    {
+        for (std::size_t row = 0; row < num_robots; row++)
+        {
+            matrix[row * size + col] = costs[col * num_robots + row];
+        }
+    }
+
+    // Warm-start from the robots that were assigned to these tactics last time
+    warm_start_cells.clear();
+    std::vector<std::optional<unsigned int>> previous_robot_ids(num_tactics);
+    for (std::size_t col = 0; col < num_tactics; col++)
+    {
+        for (std::size_t i = 0; i < previous_tactics.size(); i++)
+        {
+            if (previous_tactics[i].lock() == tactics[col])
+            {
+                previous_robot_ids[col] = previous_assigned_robot_ids[i];
+                break;
+            }
+        }
+        if (!previous_robot_ids[col])
+        {
+            continue;
+        }
+        for (std::size_t row = 0; row < num_robots; row++)
+        {
+            if (robots[row].id() == *previous_robot_ids[col])
+            {
+                warm_start_cells.emplace_back(row * size + col);
+                break;
+            }
+        }
+    }
+
+    stats.num_warm_started_pairs = num_tactics > 0 ? solve(size) : 0;
+
+    // Read the assignment directly from the starred cells
+    std::vector<std::size_t> assignment(num_tactics);
+    for (std::size_t row = 0; row < num_robots; row++)
+    {
+        for (std::size_t col = 0; col < num_tactics; col++)
+        {
+            if (marks[row * size + col] == CellMark::STAR)
+            {
+                assignment[col] = row;
+            }
+        }
+    }
+
+    // Record the stability of the assignment and store the state needed to warm-start
+    // the next one
+    previous_tactics.assign(tactics.begin(), tactics.end());
+    previous_assigned_robot_ids.resize(num_tactics);
+    for (std::size_t col = 0; col < num_tactics; col++)
+    {
+        unsigned int robot_id = robots[assignment[col]].id();
+        if (previous_robot_ids[col])
+        {
+            if (*previous_robot_ids[col] == robot_id)
+            {
+                stats.num_tactics_kept_robot++;
+            }
+            else
+            {
+                stats.num_tactics_changed_robot++;
+            }
+        }
+        previous_assigned_robot_ids[col] = robot_id;
+        stats.total_cost += costs[col * num_robots + assignment[col]];
+    }
+    stats.total_num_tactics_changed_robot += stats.num_tactics_changed_robot;
+
+    return assignment;
+}
+
+const RobotTacticAssignmentStats &RobotTacticAssigner::getStats() const
+{
+    return stats;
+}
+
+void RobotTacticAssigner::calculateCosts(
+    const World &world, const std::vector<Robot> &robots,
+    const std::vector<std::shared_ptr<Tactic>> &tactics)
+{
+    std::size_t num_robots = robots.size();
+    costs.resize(tactics.size() * num_robots);
+
+    for (std::size_t col = 0; col < tactics.size(); col++)
+    {
+        const auto &tactic = tactics[col];
+        for (std::size_t row = 0; row < num_robots; row++)
+        {
+            const Robot &robot = robots[row];
+            double &cost       = costs[col * num_robots + row];
+
+            if (!robot.getRobotCapabilities().hasAllCapabilities(
+                    tactic->robotCapabilityRequirements()))
+            {
+                // hardware requirements of tactic are not satisfied by the current robot
+                cost = UNSATISFIED_CAPABILITIES_COST;
+            }
+            else
+            {
+                // hardware requirements are satisfied, calculate real cost
+                cost = tactic->calculateRobotCost(robot, world);
+            }
+        }
+    }
+}
+
+std::size_t RobotTacticAssigner::solve(std::size_t size)
+{
+    marks.assign(size * size, CellMark::NONE);
+    row_covered.assign(size, false);
+    col_covered.assign(size, false);
+
+    // Reduce the matrix so every column and every row contains a zero. This only
+    // subtracts the minimum when it is positive, so the matrix never goes negative
+    auto reduce = [this, size](bool over_columns) {
+        for (std::size_t i = 0; i < size; i++)
+        {
+            auto cell = [&](std::size_t j) -> double & {
+                return over_columns ? matrix[j * size + i] : matrix[i * size + j];
+            };
+            double min = cell(0);
+            for (std::size_t j = 1; j < size && min > 0; j++)
+            {
+                min = std::min(min, cell(j));
+            }
+            if (min > 0)
+            {
+                for (std::size_t j = 0; j < size; j++)
+                {
+                    cell(j) -= min;
+                }
+            }
+        }
+    };
+    // The matrix always has at least as many robots (rows) as tactics (columns)
+    reduce(true);
+    reduce(false);
+
+    // Step 1: Star the warm-start zeros first, then greedily star any remaining zeros
+    // that don't share a row or column with a starred zero
+    std::size_t num_warm_started = 0;
+    for (std::size_t cell : warm_start_cells)
+    {
+        std::size_t row = cell / size;
+        std::size_t col = cell % size;
+        if (matrix[cell] == 0 && !row_covered[row] && !col_covered[col])
+        {
+            marks[cell]      = CellMark::STAR;
+            row_covered[row] = true;
+            col_covered[col] = true;
+            num_warm_started++;
+        }
+    }
+    for (std::size_t row = 0; row < size; row++)
+    {
+        for (std::size_t col = 0; col < size && !row_covered[row]; col++)
+        {
+            if (matrix[row * size + col] == 0 && !col_covered[col])
+            {
+                marks[row * size + col] = CellMark::STAR;
+                row_covered[row]        = true;
+                col_covered[col]        = true;
+            }
+        }
+    }
+    std::fill(row_covered.begin(), row_covered.end(), false);
+    std::fill(col_covered.begin(), col_covered.end(), false);
+
+    while (true)
+    {
+        // Step 2: Cover every column containing a starred zero. If every column is
+        // covered, the starred zeros are the optimal assignment
+        std::size_t num_covered = 0;
+        for (std::size_t cell = 0; cell < size * size; cell++)
+        {
+            if (marks[cell] == CellMark::STAR)
+            {
+                col_covered[cell % size] = true;
+                num_covered++;
+            }
+        }
+        if (num_covered >= size)
+        {
+            break;
+        }
+
+        augment(size, findAugmentingPrime(size));
+    }
+
+    return num_warm_started;
+}
+
+std::size_t RobotTacticAssigner::findAugmentingPrime(std::size_t size)
+{
+    while (true)
+    {
+        // Step 3: Find an uncovered zero and prime it
+        std::optional<std::size_t> zero_cell;
+        for (std::size_t row = 0; row < size && !zero_cell; row++)
+        {
+            if (row_covered[row])
+            {
+                continue;
+            }
+            for (std::size_t col = 0; col < size; col++)
+            {
+                if (!col_covered[col] && matrix[row * size + col] == 0)
+                {
+                    zero_cell = row * size + col;
+                    break;
+                }
+            }
+        }
+
+        if (zero_cell)
+        {
+            marks[*zero_cell] = CellMark::PRIME;
+
+            // If there is a starred zero in the same row, cover the row and uncover the
+            // column of the starred zero and keep looking. Otherwise we have found the
+            // start of an augmenting path
+            std::size_t row = *zero_cell / size;
+            auto star_it    = std::find(marks.begin() + row * size,
+                                     marks.begin() + (row + 1) * size, CellMark::STAR);
+            if (star_it == marks.begin() + (row + 1) * size)
+            {
+                return *zero_cell;
+            }
+            row_covered[row] = true;
+            col_covered[(star_it - marks.begin()) % size] = false;
+        }
+        else
+        {
+            // Step 5: There are no uncovered zeros, so create one by subtracting the
+            // smallest uncovered value from every uncovered column, and adding it to
+            // every covered row
+            double h = std::numeric_limits<double>::max();
+            for (std::size_t row = 0; row < size; row++)
+            {
+                for (std::size_t col = 0; col < size; col++)
+                {
+                    double value = matrix[row * size + col];
+                    if (!row_covered[row] && !col_covered[col] && value != 0 && value < h)
+                    {
+                        h = value;
+                    }
+                }
+            }
+            for (std::size_t row = 0; row < size; row++)
+            {
+                for (std::size_t col = 0; col < size; col++)
+                {
+                    if (row_covered[row])
+                    {
+                        matrix[row * size + col] += h;
+                    }
+                    if (!col_covered[col])
+                    {
+                        matrix[row * size + col] -= h;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void RobotTacticAssigner::augment(std::size_t size, std::size_t prime_cell)
+{
+    // Step 4: Walk the alternating sequence of primed and starred zeros, starting at the
+    // given prime. Each prime is starred and each star in the sequence is un-starred
+    std::size_t row = prime_cell / size;
+    std::size_t col = prime_cell % size;
+    while (true)
+    {
+        std::optional<std::size_t> star_row;
+        for (std::size_t r = 0; r < size; r++)
+        {
+            if (marks[r * size + col] == CellMark::STAR)
+            {
+                star_row = r;
+                break;
+            }
+        }
+
+        marks[row * size + col] = CellMark::STAR;
+        if (!star_row)
+        {
+            break;
+        }
+
+        // There is always a prime in the row of a starred zero in the sequence
+        marks[*star_row * size + col] = CellMark::NONE;
+        row                           = *star_row;
+        col = std::find(marks.begin() + row * size, marks.begin() + (row + 1) * size,
+                        CellMark::PRIME) -
+              (marks.begin() + row * size);
+    }
+
+    // Erase all primes and uncover every row and column
+    std::replace(marks.begin(), marks.end(), CellMark::PRIME, CellMark::NONE);
+    std::fill(row_covered.begin(), row_covered.end(), false);
+    std::fill(col_covered.begin(), col_covered.end(), false);
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "ai/hl/stp/tactic/tactic.h"
+#include "ai/world/world.h"
+
+/**
+ * Statistics describing the most recent assignment made by the RobotTacticAssigner,
+ * and how stable the assignment has been over time
+ */
+struct RobotTacticAssignmentStats
+{
+    // The number of tactics that were assigned a robot
+    std::size_t num_tactics_assigned = 0;
+    // The number of robot-tactic pairs from the previous assignment that were used to
+    // warm-start the solver
+    std::size_t num_warm_started_pairs = 0;
+    // The number of tactics that are assigned the same robot as in the previous
+    // assignment
+    std::size_t num_tactics_kept_robot = 0;
+    // The number of tactics that were assigned in the previous assignment, but are now
+    // assigned a different robot
+    std::size_t num_tactics_changed_robot = 0;
+    // The total number of times a tactic has changed robots, over all assignments
+    std::size_t total_num_tactics_changed_robot = 0;
+    // The total cost of the most recent assignment
+    double total_cost = 0.0;
+};
+
+/**
+ * The RobotTacticAssigner optimizes the assignment of robots to tactics by minimizing
+ * the total cost of the assignment, using the Hungarian algorithm (also known as the
+ * Munkres algorithm) https://en.wikipedia.org/wiki/Hungarian_algorithm
+ *
+ * The assigner is meant to be run every tick, and keeps state between runs so that
+ * repeated assignments are cheap and stable:
+ * - The solver is warm-started from the previous assignment, so robots stay on the same
+ *   tactics when that is still optimal (including when there are ties in the cost)
+ * - The result is returned as an explicit assignment rather than being read back out of
+ *   the solved cost matrix
+ * - Working memory for the costs and the solver is re-used between assignments
+ *
+ * Costs are recalculated on every assignment. They depend on the robots, the ball, and
+ * the tactics' parameters, which plays update every tick, so a cached cost would almost
+ * never be valid, and calculating one is cheap.
+ *
+ * When there is no previous assignment to warm-start from, the result is the same as
+ * the munkres-cpp library (https://github.com/saebyn/munkres-cpp) which was previously
+ * used, including how ties are broken.
+ */
+class RobotTacticAssigner
+{
+   public:
+    /**
+     * Creates a new RobotTacticAssigner with no previous assignment
+     */
+    explicit RobotTacticAssigner();
+
+    /**
+     * Calculates the optimal assignment of the given robots to the given tactics. Every
+     * tactic will be assigned a robot, so there must be at least as many robots as
+     * there are tactics.
+     *
+     * The cost of assigning a robot to a tactic is the tactic's calculateRobotCost(),
+     * unless the robot does not have the capabilities required by the tactic, in which
+     * case the cost is a large constant.
+     *
+     * @param world The current state of the world
+     * @param robots The robots that can be assigned to the tactics
+     * @param tactics The tactics to assign robots to. The size of this vector must not be
+     * larger than the size of robots
+     * @throws std::invalid_argument if there are more tactics than robots
+     *
+     * @return A vector of the same size as tactics, where the value at index i is the
+     * index of the robot in robots that is assigned to tactics[i]
+     */
+    std::vector<std::size_t> assign(const World &world, const std::vector<Robot> &robots,
+                                    const std::vector<std::shared_ptr<Tactic>> &tactics);
+
+    /**
+     * Returns statistics describing the most recent assignment
+     *
+     * @return statistics describing the most recent assignment
+     */
+    const RobotTacticAssignmentStats &getStats() const;
+
+    // The cost of assigning a robot to a tactic when the robot does not have the
+    // capabilities required by the tactic
+    static constexpr double UNSATISFIED_CAPABILITIES_COST = 10.0;
+
+   private:
+    /**
+     * Fills `costs` with the cost of assigning each robot to each tactic
+     *
+     * @param world The current state of the world
+     * @param robots The robots being assigned
+     * @param tactics The tactics being assigned
+     */
+    void calculateCosts(const World &world, const std::vector<Robot> &robots,
+                        const std::vector<std::shared_ptr<Tactic>> &tactics);
+
+    /**
+     * Finds the cost-minimizing assignment for the square cost matrix stored in
+     * `matrix`, using the Munkres algorithm. Cells in `warm_start_cells` that are zero
+     * after the matrix is reduced are starred before any other zeros, so the previous
+     * assignment is kept whenever it is still optimal
+     *
+     * @param size The number of rows and columns in the matrix
+     *
+     * @return The number of warm-start cells that were used in the initial matching
+     */
+    std::size_t solve(std::size_t size);
+
+    /**
+     * Primes uncovered zeros, and manufactures new zeros when there are none, until a
+     * primed zero is found that has no starred zero in its row (Steps 3 and 5 of the
+     * Munkres algorithm)
+     *
+     * @param size The number of rows and columns in the matrix
+     *
+     * @return The row-major index of the primed zero that starts an augmenting path
+     */
+    std::size_t findAugmentingPrime(std::size_t size);
+
+    /**
+     * Flips the stars and primes along the alternating path starting at the given primed
+     * zero, increasing the number of starred zeros by one (Step 4 of the Munkres
+     * algorithm)
+     *
+     * @param size The number of rows and columns in the matrix
+     * @param prime_cell The row-major index of the primed zero that starts the path
+     */
+    void augment(std::size_t size, std::size_t prime_cell);
+
+    enum class CellMark : uint8_t
+    {
+        NONE,
+        STAR,
+        PRIME
+    };
+
+    // The tactics from the previous assignment, and the robot id assigned to each of
+    // them, which are used to warm-start the solver
+    std::vector<std::weak_ptr<Tactic>> previous_tactics;
+    std::vector<unsigned int> previous_assigned_robot_ids;
+
+    // The costs calculated for the current assignment, stored tactic-major, so the cost
+    // of assigning robots[r] to tactics[t] is at costs[t * robots.size() + r]
+    std::vector<double> costs;
+
+    // Working memory for the solver, which is re-used every assignment. The matrix is
+    // square and stored row-major, with robots as rows and tactics as columns
+    std::vector<double> matrix;
+    std::vector<CellMark> marks;
+    std::vector<bool> row_covered;
+    std::vector<bool> col_covered;
+    std::vector<std::size_t> warm_start_cells;
+
+    RobotTacticAssignmentStats stats;
+};
@@ -1,8 +1,5 @@
 #include "ai/hl/stp/stp.h"
 
-#include <ai/hl/stp/play/play_factory.h>
-#include <munkres/munkres.h>
-
 #include <chrono>
 #include <exception>
 #include <random>
@@ -10,6 +7,7 @@
 #include "ai/ai.h"
 #include "ai/hl/stp/play/halt_play.h"
 #include "ai/hl/stp/play/play.h"
+#include "ai/hl/stp/play/play_factory.h"
 #include "ai/hl/stp/tactic/tactic.h"
 #include "ai/intent/stop_intent.h"
 #include "util/logger/init.h"
@@ -34,7 +32,12 @@ std::vector<std::unique_ptr<Intent>> STP::getIntents(const World& world)
     bool override_play_name_value_changed =
         previous_override_play_name != override_play_name;
 
-    auto all_play_names = PlayFactory::getRegisteredPlayNames();
+    // Only look up the override play when its name changes, so we don't search the
+    // PlayFactory every tick
+    if (override_play_name_value_changed)
+    {
+        override_play_id = PlayFactory::getPlayId(override_play_name);
+    }
 
     // Assign a new play if we don't currently have a play assigned, the current play's
     // invariant no longer holds, or the current play is done
@@ -44,10 +47,9 @@ std::vector<std::unique_ptr<Intent>> STP::getIntents(const World& world)
     {
         if (override_play)
         {
-            if (std::find(all_play_names.begin(), all_play_names.end(),
-                          override_play_name) != all_play_names.end())
+            if (override_play_id)
             {
-                current_play = PlayFactory::createPlay(override_play_name);
+                current_play = PlayFactory::createPlay(*override_play_id);
             }
             else
             {
@@ -112,93 +114,40 @@ std::vector<std::unique_ptr<Intent>> STP::getIntents(const World& world)
 }
 
 std::vector<std::shared_ptr<Tactic>> STP::assignRobotsToTactics(
-    const World& world, std::vector<std::shared_ptr<Tactic>> tactics) const
+    const World& world, std::vector<std::shared_ptr<Tactic>> tactics)
 {
-    // This functions optimizes the assignment of robots to tactics by minimizing
-    // the total cost of assignment using the Hungarian algorithm
-    // (also known as the Munkres algorithm)
-    // https://en.wikipedia.org/wiki/Hungarian_algorithm
-    //
-    // https://github.com/saebyn/munkres-cpp is the implementation of the Hungarian
-    // algorithm that we use here
+    const auto& friendly_team_robots = world.friendlyTeam().getAllRobots();
 
-    if (world.friendlyTeam().numRobots() < tactics.size())
+    if (friendly_team_robots.size() < tactics.size())
     {
         // We do not have enough robots to assign all the tactics to. We "drop"
         // (aka don't assign) the tactics at the end of the vector since they are
         // considered lower priority
-        tactics.resize(world.friendlyTeam().numRobots());
+        tactics.resize(friendly_team_robots.size());
     }
 
-    auto friendly_team        = world.friendlyTeam();
-    auto friendly_team_robots = friendly_team.getAllRobots();
-    auto friendly_team_size   = friendly_team.numRobots();
-
-    size_t num_rows = world.friendlyTeam().numRobots();
-    size_t num_cols = tactics.size();
-
-    // The Matrix constructor will assert if the rows and columns of the matrix are
-    // not >= 1, so we perform that check first and return an empty vector of tactics.
     // This represents the cases where there are either no tactics or no robots
-    if (num_rows == 0 || num_cols == 0)
+    if (tactics.empty())
     {
         return {};
     }
 
-    // The rows of the matrix are the "workers" (the robots) and the columns are the
-    // "jobs" (the Tactics).
-    Matrix<double> matrix(num_rows, num_cols);
-
-    // Initialize the matrix with the cost of assigning each Robot to each Tactic
-    for (int row = 0; row < num_rows; row++)
-    {
-        for (int col = 0; col < num_cols; col++)
-        {
-            if (!friendly_team_robots.at(row).getRobotCapabilities().hasAllCapabilities(
-                    tactics.at(col)->robotCapabilityRequirements()))
-            {
-                // hardware requirements of tactic are not satisfied by the current robot
-                // set cost to 10.0f
-                matrix(row, col) = 10.0f;
-            }
-            else
-            {
-                // hardware requirements are satisfied, calculate real cost
-                matrix(row, col) = tactics.at(col)->calculateRobotCost(
-                    friendly_team_robots.at(row), world);
-            }
-        }
-    }
-
-    // Apply the Munkres/Hungarian algorithm to the matrix.
-    Munkres<double> m;
-    m.solve(matrix);
-
-    // The Munkres matrix gets solved such that there will be exactly one 0 in every row
-    // and exactly one 0 in every column. All other values will be -1. The 0's indicate
-    // the "workers" and "jobs" (robots and tactics for us) that are most optimally paired
-    // together
-    //
-    // Example matrices:
-    //        -1, 0,-1,         and            0,-1,
-    //         0,-1,-1,                       -1, 0,
-    //        -1,-1, 0,
-    for (int row = 0; row < num_rows; row++)
+    // The assigner returns the index of the robot assigned to each tactic
+    auto assignment =
+        robot_tactic_assigner.assign(world, friendly_team_robots, tactics);
+    for (std::size_t i = 0; i < tactics.size(); i++)
     {
-        for (int col = 0; col < num_cols; col++)
-        {
-            auto val = matrix(row, col);
-            if (val == 0)
-            {
-                tactics.at(col)->updateRobot(friendly_team_robots.at(row));
-                break;
-            }
-        }
+        tactics.at(i)->updateRobot(friendly_team_robots.at(assignment.at(i)));
     }
 
     return tactics;
 }
 
+const RobotTacticAssignmentStats& STP::getRobotTacticAssignmentStats() const
+{
+    return robot_tactic_assigner.getStats();
+}
+
 std::unique_ptr<Play> STP::calculateNewPlay(const World& world)
 {
     std::vector<std::unique_ptr<Play>> applicable_plays;
@@ -4,7 +4,9 @@
 
 #include "ai/hl/hl.h"
 #include "ai/hl/stp/play/play.h"
+#include "ai/hl/stp/play/play_factory.h"
 #include "ai/hl/stp/play_info.h"
+#include "ai/hl/stp/robot_tactic_assigner.h"
 #include "ai/intent/intent.h"
 
 /**
@@ -41,6 +43,9 @@ class STP : public HL
      * only 4 robots on the field at the time, only the first 4 Tactics in the vector
      * would be assigned to robots and run.
      *
+     * The assignment is made by a RobotTacticAssigner that is kept between calls, so
+     * robots will keep running the same tactics when that is still optimal.
+     *
      * @param world The state of the world, which contains the friendly Robots that will
      * be mapped to a Tactic
      * @param tactics The list of tactics that should be run (and paired with a Robot)
@@ -48,7 +53,15 @@ class STP : public HL
      * tactics with a robot assigned are returned
      */
     std::vector<std::shared_ptr<Tactic>> assignRobotsToTactics(
-        const World &world, std::vector<std::shared_ptr<Tactic>> tactics) const;
+        const World &world, std::vector<std::shared_ptr<Tactic>> tactics);
+
+    /**
+     * Returns statistics describing the most recent assignment of robots to tactics,
+     * including how stable the assignment has been
+     *
+     * @return statistics describing the most recent assignment of robots to tactics
+     */
+    const RobotTacticAssignmentStats &getRobotTacticAssignmentStats() const;
 
     /**
      * Given the state of the world, returns a unique_ptr to the Play that should be run
@@ -90,7 +103,13 @@ class STP : public HL
     std::mt19937 random_number_generator;
     std::string override_play_name;
     std::string previous_override_play_name;
+    // The id of the Play named by override_play_name, or std::nullopt if there is no
+    // Play with that name
+    std::optional<PlayId> override_play_id;
     bool override_play;
     bool previous_override_play;
     RefboxGameState current_game_state;
+    // Assigns robots to tactics, and remembers the previous assignment so it can be
+    // re-used
+    RobotTacticAssigner robot_tactic_assigner;
 };
@@ -1,9 +1,11 @@
 #include "ai/hl/stp/tactic/tactic.h"
 
+#include "util/coroutine_stack_pool.h"
 #include "util/logger/init.h"
 
 Tactic::Tactic(bool loop_forever, RobotCapabilityFlags capability_reqs_)
-    : intent_sequence(boost::bind(&Tactic::calculateNextIntentWrapper, this, _1)),
+    : intent_sequence(Util::CoroutineStackPool::getInstance().getAllocator(),
+                      boost::bind(&Tactic::calculateNextIntentWrapper, this, _1)),
       done_(false),
       loop_forever(loop_forever),
       capability_reqs(capability_reqs_)
@@ -45,6 +47,7 @@ std::unique_ptr<Intent> Tactic::getNextIntent(
         {
             // Re-start the intent sequence by re-creating it
             intent_sequence = IntentCoroutine::pull_type(
+                Util::CoroutineStackPool::getInstance().getAllocator(),
                 boost::bind(&Tactic::calculateNextIntentWrapper, this, _1));
             next_intent = getNextIntentHelper();
         }
@@ -78,7 +78,7 @@ void PathPlanningNavigator::visit(const MoveIntent &move_intent)
                 move_intent.isDribblerEnabled(), move_intent.isSlowEnabled(),
                 move_intent.getAutoKickType());
             current_primitive = std::move(move);
-            Util::CanvasMessenger::getInstance()->drawRobotPath(*path_points);
+            canvas_messenger->drawRobotPath(*path_points);
             return;
         }
         if ((*path_points).size() == 2)
@@ -92,7 +92,7 @@ void PathPlanningNavigator::visit(const MoveIntent &move_intent)
                 move_intent.isDribblerEnabled(), move_intent.isSlowEnabled(),
                 move_intent.getAutoKickType());
             current_primitive = std::move(move);
-            Util::CanvasMessenger::getInstance()->drawRobotPath(*path_points);
+            canvas_messenger->drawRobotPath(*path_points);
             return;
         }
     }
@@ -222,7 +222,7 @@ std::vector<std::unique_ptr<Primitive>> PathPlanningNavigator::getAssignedPrimit
         assigned_primitives.emplace_back(std::move(current_primitive));
     }
 
-    Util::CanvasMessenger::getInstance()->publishAndClearLayer(
+    canvas_messenger->publishAndClearLayer(
         Util::CanvasMessenger::Layer::NAVIGATOR);
 
     return assigned_primitives;
@@ -293,13 +293,13 @@ void PathPlanningNavigator::drawObstacle(const Obstacle &obstacle,
 {
     if (obstacle.getBoundaryPolygon())
     {
-        Util::CanvasMessenger::getInstance()->drawPolygonOutline(
+        canvas_messenger->drawPolygonOutline(
             Util::CanvasMessenger::Layer::NAVIGATOR, *obstacle.getBoundaryPolygon(),
             0.025, color);
     }
     else if (obstacle.getBoundaryCircle())
     {
-        Util::CanvasMessenger::getInstance()->drawPolygonOutline(
+        canvas_messenger->drawPolygonOutline(
             Util::CanvasMessenger::Layer::NAVIGATOR,
             circleToPolygon(*obstacle.getBoundaryCircle(), 12), 0.025, color);
     }
@@ -20,9 +20,18 @@
 class PathPlanningNavigator : public Navigator, public IntentVisitor
 {
    public:
-    explicit PathPlanningNavigator(){
-
-    };
+    /**
+     * Creates a new PathPlanningNavigator
+     *
+     * @param canvas_messenger The CanvasMessenger to draw the planned paths and
+     * obstacles on
+     */
+    explicit PathPlanningNavigator(
+        std::shared_ptr<Util::CanvasMessenger> canvas_messenger =
+            Util::CanvasMessenger::getInstance())
+        : canvas_messenger(canvas_messenger)
+    {
+    }
 
     std::vector<std::unique_ptr<Primitive>> getAssignedPrimitives(
         const World &world,
@@ -112,6 +121,8 @@ class PathPlanningNavigator : public Navigator, public IntentVisitor
     void drawObstacle(const Obstacle &obstacle,
                       const Util::CanvasMessenger::Color &color);
 
+    std::shared_ptr<Util::CanvasMessenger> canvas_messenger;
+
     // This navigators knowledge / state of the world
     World world;
 
@@ -20,6 +20,9 @@ double Passing::ratePass(const World& world, const Passing::Pass& pass,
                          const std::optional<Rectangle>& target_region,
                          std::optional<unsigned int> passer_robot_id)
 {
+    // Read the parameters once for the whole evaluation
+    const auto parameters = Util::DynamicParameters::getParameterSnapshot();
+
     double static_pass_quality =
         getStaticPositionQuality(world.field(), pass.receiverPoint());
 
@@ -39,9 +42,9 @@ double Passing::ratePass(const World& world, const Passing::Pass& pass,
 
     // Place strict limits on pass start time
     double min_pass_time_offset =
-        Util::DynamicParameters::Passing::min_time_offset_for_pass_seconds.value();
+        parameters->Passing.min_time_offset_for_pass_seconds;
     double max_pass_time_offset =
-        Util::DynamicParameters::Passing::max_time_offset_for_pass_seconds.value();
+        parameters->Passing.max_time_offset_for_pass_seconds;
     double pass_time_offset_quality =
         sigmoid(pass.startTime().getSeconds(),
                 min_pass_time_offset + world.getMostRecentTimestamp().getSeconds(), 0.5) *
@@ -51,10 +54,8 @@ double Passing::ratePass(const World& world, const Passing::Pass& pass,
                  0.5));
 
     // Place strict limits on the ball speed
-    double min_pass_speed =
-        Util::DynamicParameters::Passing::min_pass_speed_m_per_s.value();
-    double max_pass_speed =
-        Util::DynamicParameters::Passing::max_pass_speed_m_per_s.value();
+    double min_pass_speed     = parameters->Passing.min_pass_speed_m_per_s;
+    double max_pass_speed     = parameters->Passing.max_pass_speed_m_per_s;
     double pass_speed_quality = sigmoid(pass.speed(), min_pass_speed, 0.2) *
                                 (1 - sigmoid(pass.speed(), max_pass_speed, 0.2));
 
@@ -68,10 +69,10 @@ double Passing::ratePassShootScore(const Field& field, const Team& enemy_team,
                                    const Passing::Pass& pass)
 {
     // TODO: You don't even use this first parameter, but stuff is hardcoded below
-    double ideal_shoot_angle_degrees =
-        Util::DynamicParameters::Passing::ideal_min_shoot_angle_degrees.value();
+    const auto parameters            = Util::DynamicParameters::getParameterSnapshot();
+    double ideal_shoot_angle_degrees = parameters->Passing.ideal_min_shoot_angle_degrees;
     double ideal_max_rotation_to_shoot_degrees =
-        Util::DynamicParameters::Passing::ideal_max_rotation_to_shoot_degrees.value();
+        parameters->Passing.ideal_max_rotation_to_shoot_degrees;
 
     std::vector<Point> obstacles;
     for (const Robot& robot : enemy_team.getAllRobots())
@@ -118,8 +119,8 @@ double Passing::ratePassShootScore(const Field& field, const Team& enemy_team,
 
 double Passing::ratePassEnemyRisk(const Team& enemy_team, const Pass& pass)
 {
-    double enemy_proximity_importance =
-        Util::DynamicParameters::Passing::enemy_proximity_importance.value();
+    const auto parameters             = Util::DynamicParameters::getParameterSnapshot();
+    double enemy_proximity_importance = parameters->Passing.enemy_proximity_importance;
 
     // Calculate a risk score based on the distance of the enemy robots from the receive
     // point, based on an exponential function of the distance of each robot from the
@@ -195,7 +196,7 @@ double Passing::calculateInterceptRisk(const Robot& enemy_robot, const Pass& pas
 
     Duration time_until_pass     = pass.startTime() - enemy_robot.lastUpdateTimestamp();
     Duration enemy_reaction_time = Duration::fromSeconds(
-        Util::DynamicParameters::Passing::enemy_reaction_time.value());
+        Util::DynamicParameters::getParameterSnapshot()->Passing.enemy_reaction_time);
 
     double robot_ball_time_diff_at_closest_pass_point =
         ((enemy_robot_time_to_closest_pass_point + enemy_reaction_time) -
@@ -288,13 +289,11 @@ double Passing::getStaticPositionQuality(const Field& field, const Point& positi
     static const double sig_width = 0.1;
 
     // The offset from the sides of the field for the center of the sigmoid functions
-    double x_offset =
-        Util::DynamicParameters::Passing::static_field_position_quality_x_offset.value();
-    double y_offset =
-        Util::DynamicParameters::Passing::static_field_position_quality_y_offset.value();
+    const auto parameters = Util::DynamicParameters::getParameterSnapshot();
+    double x_offset       = parameters->Passing.static_field_position_quality_x_offset;
+    double y_offset       = parameters->Passing.static_field_position_quality_y_offset;
     double friendly_goal_weight =
-        Util::DynamicParameters::Passing::
-            static_field_position_quality_friendly_goal_distance_weight.value();
+        parameters->Passing.static_field_position_quality_friendly_goal_distance_weight;
 
     // Make a slightly smaller field, and positive weight values in this reduced field
     double half_field_length = field.length() / 2;
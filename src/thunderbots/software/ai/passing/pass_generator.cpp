@@ -131,11 +131,22 @@ void PassGenerator::continuouslyGeneratePasses()
 
 void PassGenerator::visualizePassesAndPassQualityGradient()
 {
+    auto canvas_messenger = Util::CanvasMessenger::getInstance();
+
+    // Rating passes over the whole field is expensive, so skip it entirely if the
+    // layer won't be published. The layer still has to be published (with nothing on
+    // it) to let the CanvasMessenger know this frame is over
+    if (!canvas_messenger->isDrawingLayer(Util::CanvasMessenger::Layer::PASS_GENERATION))
+    {
+        canvas_messenger->publishAndClearLayer(
+            Util::CanvasMessenger::Layer::PASS_GENERATION);
+        return;
+    }
+
     // Take ownership of the passer point for the duration of this function
     std::lock_guard<std::mutex> passer_point_lock(passer_point_mutex);
 
     // Draw all the points we have so far
-    auto canvas_messenger = Util::CanvasMessenger::getInstance();
 
     // Get field characteristics and the current time
     world_mutex.lock();
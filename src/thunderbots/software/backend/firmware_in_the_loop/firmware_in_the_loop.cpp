@@ -0,0 +1,267 @@
+#include "backend/firmware_in_the_loop/firmware_in_the_loop.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "backend/output/radio/mrf/messages.h"
+#include "util/parameter/dynamic_parameters.h"
+
+namespace
+{
+    // The 802.15.4 header the dongle puts on every drive packet. The frame control
+    // word marks it as an intra-PAN data frame with 16-bit addresses, and it is
+    // broadcast from the dongle's address
+    constexpr uint8_t FRAME_CONTROL_LSB      = 0b01000001;
+    constexpr uint8_t FRAME_CONTROL_MSB      = 0b10001000;
+    // The robots don't check the PAN ID, so it doesn't matter which one is used
+    constexpr uint16_t PAN_ID                = 0x0000;
+    constexpr uint16_t BROADCAST_ADDRESS     = 0xFFFF;
+    constexpr uint16_t DONGLE_ADDRESS        = 0x0100;
+    constexpr uint8_t DRIVE_MESSAGE_PURPOSE  = 0x0F;
+    constexpr uint8_t DRIVE_SERIAL_MASK      = 0x7F;
+    constexpr uint8_t DRIVE_FEEDBACK_REQUEST = 0x80;
+    constexpr std::size_t HEADER_LENGTH      = 9;
+    // The FCS, RSSI and LQI the radio appends to received frames
+    constexpr std::size_t FOOTER_LENGTH = 4;
+    constexpr std::size_t DRIVE_FRAME_LENGTH =
+        HEADER_LENGTH + 1 /* Message purpose */ +
+        MAX_ROBOTS_OVER_RADIO * (1 /* Serial */ + MRF::ENCODED_PRIMITIVE_LENGTH) +
+        1 /* Estop */ + FOOTER_LENGTH;
+}  // namespace
+
+FirmwareInTheLoop::FirmwareInTheLoop(const Field& field)
+    : field(field),
+      friendly_robots(),
+      ball_position(field.centerPoint()),
+      refbox_game_state(RefboxGameState::HALT),
+      drive_packet_encoder(),
+      dongle_drive_data(),
+      dongle_serials(),
+      dongle_frame_sequence_number(0),
+      dongle_poll_index(0),
+      num_ticks(0),
+      unsimulated_time_seconds(0.0),
+      world(field, Ball(field.centerPoint(), Vector(), Timestamp::fromSeconds(0)),
+            Team(Duration::fromMilliseconds(
+                Util::DynamicParameters::robot_expiry_buffer_milliseconds.value())),
+            Team(Duration::fromMilliseconds(
+                Util::DynamicParameters::robot_expiry_buffer_milliseconds.value())))
+{
+}
+
+void FirmwareInTheLoop::addFriendlyRobot(unsigned int id, const Point& position,
+                                         const Angle& orientation)
+{
+    if (id >= MAX_ROBOTS_OVER_RADIO)
+    {
+        throw std::invalid_argument("Robot id too large for radio.");
+    }
+
+    friendly_robots.erase(
+        std::remove_if(friendly_robots.begin(), friendly_robots.end(),
+                       [id](const SimulatedRobot& robot) { return robot.id == id; }),
+        friendly_robots.end());
+    friendly_robots.push_back(
+        {id, std::make_unique<FirmwareRobot>(id, position, orientation), {}, {}});
+    friendly_robots.back().firmware->setBallState(ball_position, Vector());
+}
+
+void FirmwareInTheLoop::setBallPosition(const Point& position)
+{
+    ball_position = position;
+    for (SimulatedRobot& robot : friendly_robots)
+    {
+        robot.firmware->setBallState(ball_position, Vector());
+    }
+}
+
+void FirmwareInTheLoop::setRefboxGameState(const RefboxGameState& game_state)
+{
+    refbox_game_state = game_state;
+}
+
+void FirmwareInTheLoop::setFriendlyPrimitives(ConstPrimitiveVectorPtr primitives)
+{
+    // Like the dongle, an empty set of primitives leaves the robots with the last
+    // primitives they were sent
+    if (primitives->empty())
+    {
+        return;
+    }
+
+    // Robots are always charged, since there is no estop
+    MRF::SequencedDrivePacket packet;
+    MRF::DriveSequenceNumbers sequence_numbers;
+    std::size_t packet_length =
+        drive_packet_encoder.encode(*primitives, true, packet, sequence_numbers);
+
+    // The dongle keeps the latest primitive and sequence number for each robot in the
+    // packet, and sends them until it is given new ones
+    for (std::size_t i = 0; i < packet_length; i += MRF::SEQUENCED_DRIVE_BYTES_PER_ROBOT)
+    {
+        unsigned int id    = packet[i];
+        dongle_serials[id] = packet[i + 1];
+        std::copy_n(&packet[i + 2], MRF::ENCODED_PRIMITIVE_LENGTH,
+                    &dongle_drive_data[id * MRF::ENCODED_PRIMITIVE_LENGTH]);
+    }
+
+    for (SimulatedRobot& robot : friendly_robots)
+    {
+        if (sequence_numbers[robot.id])
+        {
+            robot.sequence_number_send_ticks[*sequence_numbers[robot.id]] = num_ticks;
+            robot.last_sequence_number = sequence_numbers[robot.id];
+        }
+    }
+}
+
+void FirmwareInTheLoop::stepSimulation(const Duration& duration)
+{
+    // Time is simulated in whole ticks, rounding to the nearest tick so rounding error
+    // doesn't make the number of ticks per call vary
+    unsimulated_time_seconds += duration.getSeconds();
+    while (unsimulated_time_seconds >= TICK_SECONDS / 2)
+    {
+        if (num_ticks % TICKS_PER_DRIVE_PACKET == 0)
+        {
+            sendDrivePacket();
+        }
+        for (SimulatedRobot& robot : friendly_robots)
+        {
+            robot.firmware->tick();
+        }
+        num_ticks++;
+        unsimulated_time_seconds -= TICK_SECONDS;
+    }
+}
+
+void FirmwareInTheLoop::sendDrivePacket()
+{
+    std::array<uint8_t, DRIVE_FRAME_LENGTH> frame = {};
+    std::size_t i = 0;
+
+    frame[i++] = FRAME_CONTROL_LSB;
+    frame[i++] = FRAME_CONTROL_MSB;
+    frame[i++] = ++dongle_frame_sequence_number;
+    frame[i++] = static_cast<uint8_t>(PAN_ID);
+    frame[i++] = static_cast<uint8_t>(PAN_ID >> 8);
+    frame[i++] = static_cast<uint8_t>(BROADCAST_ADDRESS);
+    frame[i++] = static_cast<uint8_t>(BROADCAST_ADDRESS >> 8);
+    frame[i++] = static_cast<uint8_t>(DONGLE_ADDRESS);
+    frame[i++] = static_cast<uint8_t>(DONGLE_ADDRESS >> 8);
+
+    frame[i++] = DRIVE_MESSAGE_PURPOSE;
+    for (unsigned int id = 0; id < MAX_ROBOTS_OVER_RADIO; id++)
+    {
+        frame[i++] = (dongle_serials[id] & DRIVE_SERIAL_MASK) |
+                     (id == dongle_poll_index ? DRIVE_FEEDBACK_REQUEST : 0);
+        std::copy_n(&dongle_drive_data[id * MRF::ENCODED_PRIMITIVE_LENGTH],
+                    MRF::ENCODED_PRIMITIVE_LENGTH, &frame[i]);
+        i += MRF::ENCODED_PRIMITIVE_LENGTH;
+    }
+    // The estop is always in the run position
+    frame[i++] = 1;
+
+    dongle_poll_index = (dongle_poll_index + 1) % MAX_ROBOTS_OVER_RADIO;
+
+    for (SimulatedRobot& robot : friendly_robots)
+    {
+        // Each robot gets its own copy of the frame, as it would from its own radio
+        std::array<uint8_t, DRIVE_FRAME_LENGTH> received_frame = frame;
+        robot.firmware->receiveFrame(received_frame.data(), received_frame.size());
+    }
+}
+
+World FirmwareInTheLoop::getWorld()
+{
+    Timestamp timestamp = Timestamp::fromSeconds(getSimulatedTime().getSeconds());
+
+    world.updateBallState(Ball(ball_position, Vector(), timestamp));
+
+    std::vector<Robot> team_robots;
+    for (const SimulatedRobot& robot : friendly_robots)
+    {
+        team_robots.emplace_back(createRobot(robot));
+    }
+    world.mutableFriendlyTeam().updateRobots(team_robots);
+
+    world.updateRefboxGameState(refbox_game_state);
+    world.updateTimestamp(timestamp);
+
+    return world;
+}
+
+std::vector<RobotStatus> FirmwareInTheLoop::getRobotStatuses() const
+{
+    std::vector<RobotStatus> robot_statuses;
+    for (const SimulatedRobot& robot : friendly_robots)
+    {
+        RobotStatus robot_status = RobotStatus();
+        robot_status.robot       = static_cast<int32_t>(robot.id);
+        robot_status.alive       = true;
+
+        std::optional<fwsim_bridge_profile_t> profile = robot.firmware->getProfile();
+        if (profile)
+        {
+            robot_status.cpu_profile_valid      = true;
+            robot_status.normal_tick_mean_us    = profile->normal_tick_mean_us;
+            robot_status.normal_tick_max_us     = profile->normal_tick_max_us;
+            robot_status.busiest_module_mean_us = profile->busiest_module_mean_us;
+            if (profile->busiest_module < MRF::PROFILE_MODULE_COUNT)
+            {
+                robot_status.busiest_module =
+                    MRF::PROFILE_MODULE_NAMES[profile->busiest_module];
+            }
+        }
+
+        std::optional<std::pair<uint8_t, uint32_t>> last_applied_drive =
+            robot.firmware->getLastAppliedDrive();
+        if (last_applied_drive)
+        {
+            auto [sequence_number, age_ms] = *last_applied_drive;
+            robot_status.drive_ack_valid                    = true;
+            robot_status.last_applied_drive_sequence_number = sequence_number;
+
+            // The robot may still be running the primitive it was started with, which
+            // the AI never sent
+            if (robot.last_sequence_number)
+            {
+                robot_status.drive_primitives_behind =
+                    (*robot.last_sequence_number + MRF::NUM_DRIVE_SEQUENCE_NUMBERS -
+                     sequence_number) %
+                    MRF::NUM_DRIVE_SEQUENCE_NUMBERS;
+
+                // A robot far behind has probably wrapped around to a sequence number
+                // sent long ago
+                const std::optional<unsigned long>& send_tick =
+                    robot.sequence_number_send_ticks[sequence_number];
+                if (send_tick && robot_status.drive_primitives_behind <
+                                     MRF::NUM_DRIVE_SEQUENCE_NUMBERS / 2)
+                {
+                    double applied_seconds =
+                        getSimulatedTime().getSeconds() - age_ms / 1000.0;
+                    double sent_seconds = *send_tick * TICK_SECONDS;
+                    robot_status.drive_latency_valid = true;
+                    robot_status.drive_latency_ms =
+                        std::max(0.0, (applied_seconds - sent_seconds) * 1000.0);
+                }
+            }
+        }
+
+        robot_statuses.emplace_back(robot_status);
+    }
+    return robot_statuses;
+}
+
+Duration FirmwareInTheLoop::getSimulatedTime() const
+{
+    return Duration::fromSeconds(num_ticks * TICK_SECONDS);
+}
+
+Robot FirmwareInTheLoop::createRobot(const SimulatedRobot& robot) const
+{
+    fwsim_bridge_state_t state = robot.firmware->getState();
+    return Robot(robot.id, Point(state.x, state.y), Vector(state.vx, state.vy),
+                 Angle::ofRadians(state.angle), AngularVelocity::ofRadians(state.avel),
+                 Timestamp::fromSeconds(getSimulatedTime().getSeconds()));
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "ai/primitive/primitive.h"
+#include "ai/world/world.h"
+#include "backend/firmware_in_the_loop/firmware_robot.h"
+#include "backend/output/radio/mrf/packet_encoding.h"
+#include "backend/robot_status.h"
+#include "shared/constants.h"
+#include "typedefs.h"
+#include "util/refbox_constants.h"
+
+/**
+ * Runs the AI's primitives through the real radio encoding and the real robot firmware,
+ * on simulated robots, so the whole path from the AI to the robots' wheels can be
+ * exercised and measured without any hardware.
+ *
+ * Primitives are encoded by the same MRF drive packet encoder the radio backend uses.
+ * Like the dongle, the latest encoded primitive for each robot is broadcast in a drive
+ * packet 50 times a second, framed exactly as the dongle frames it over radio. Each
+ * robot is a FirmwareRobot, running its own copy of the firmware's receive and
+ * primitive code at the firmware's 200 Hz tick rate, and moving under the firmware's
+ * simulated physics.
+ *
+ * Only the friendly robots are simulated. The ball is not moved by the robots, and the
+ * robots do not collide with each other or the walls. The simulated robots know their
+ * own position exactly, so no camera packets are sent to them.
+ *
+ * The simulation advances in whole ticks, and only when it is asked to, so it can run
+ * much faster than real time.
+ */
+class FirmwareInTheLoop
+{
+   public:
+    /**
+     * Creates a new FirmwareInTheLoop with no robots and a stationary ball at the centre
+     * of the field
+     *
+     * @param field The field to simulate
+     */
+    explicit FirmwareInTheLoop(const Field& field);
+
+    /**
+     * Places a robot on the friendly team, replacing any robot with the same id. The
+     * robot starts its firmware from scratch, stopped
+     *
+     * @param id The id of the robot, which must be less than MAX_ROBOTS_OVER_RADIO
+     * @param position The position of the robot
+     * @param orientation The orientation of the robot
+     *
+     * @throws std::invalid_argument if the id is too large to send over radio
+     * @throws std::runtime_error if the firmware could not be loaded
+     */
+    void addFriendlyRobot(unsigned int id, const Point& position,
+                          const Angle& orientation);
+
+    /**
+     * Places the ball, which stays where it is put
+     *
+     * @param position The position of the ball
+     */
+    void setBallPosition(const Point& position);
+
+    /**
+     * Sets the refbox game state reported in the Worlds returned by getWorld
+     *
+     * @param game_state The refbox game state
+     */
+    void setRefboxGameState(const RefboxGameState& game_state);
+
+    /**
+     * Encodes the given primitives for the friendly robots, as the radio backend does,
+     * and hands them to the simulated dongle to send in its next drive packet
+     *
+     * @param primitives The primitives for the friendly robots
+     *
+     * @throws std::invalid_argument if the primitives could not be encoded
+     */
+    void setFriendlyPrimitives(ConstPrimitiveVectorPtr primitives);
+
+    /**
+     * Advances the simulation by the given duration. The simulation advances in whole
+     * ticks, and any difference is carried over to the next call
+     *
+     * @param duration How long to advance the simulation by
+     */
+    void stepSimulation(const Duration& duration);
+
+    /**
+     * Returns the current state of the simulation as seen by the AI. The timestamps in
+     * the World are the simulated time, starting from 0
+     *
+     * @return the current state of the simulation
+     */
+    World getWorld();
+
+    /**
+     * Returns the status of each friendly robot. The status reports which drive
+     * primitive the robot last applied and how long it took to be applied after the AI
+     * sent it, and how much CPU time the robot's normal tick took on the host over the
+     * last second. The fast tick is not run, so its times are always zero
+     *
+     * @return the status of each friendly robot
+     */
+    std::vector<RobotStatus> getRobotStatuses() const;
+
+    /**
+     * Returns how long has been simulated
+     *
+     * @return how long has been simulated
+     */
+    Duration getSimulatedTime() const;
+
+    // The length of each firmware tick
+    static constexpr double TICK_SECONDS = 1.0 / FirmwareRobot::TICKS_PER_SECOND;
+
+    // How many ticks pass between the drive packets sent by the dongle, which sends them
+    // at 50 Hz
+    static constexpr unsigned int TICKS_PER_DRIVE_PACKET = 4;
+
+   private:
+    struct SimulatedRobot
+    {
+        unsigned int id;
+        std::unique_ptr<FirmwareRobot> firmware;
+        // When each drive sequence number was last sent to the robot by the AI, in
+        // ticks, so the time the robot took to apply it can be found
+        std::array<std::optional<unsigned long>, MRF::NUM_DRIVE_SEQUENCE_NUMBERS>
+            sequence_number_send_ticks;
+        // The sequence number of the last primitive sent to the robot
+        std::optional<uint8_t> last_sequence_number;
+    };
+
+    /**
+     * Broadcasts the dongle's current drive data to every robot, framed as the dongle
+     * frames it
+     */
+    void sendDrivePacket();
+
+    /**
+     * Converts the given simulated robot into a Robot at the current simulated time
+     */
+    Robot createRobot(const SimulatedRobot& robot) const;
+
+    const Field field;
+    std::vector<SimulatedRobot> friendly_robots;
+    Point ball_position;
+    RefboxGameState refbox_game_state;
+
+    MRF::SequencedDrivePacketEncoder drive_packet_encoder;
+    // What the dongle sends to each robot in every drive packet, which is the last
+    // encoded primitive and sequence number it was given for the robot
+    std::array<uint8_t, MRF::DRIVE_PACKET_MAX_LENGTH> dongle_drive_data;
+    std::array<uint8_t, MAX_ROBOTS_OVER_RADIO> dongle_serials;
+    // The 802.15.4 sequence number of the last frame the dongle sent
+    uint8_t dongle_frame_sequence_number;
+    // The robot the dongle asks for feedback in the next drive packet
+    unsigned int dongle_poll_index;
+
+    // The number of ticks simulated so far
+    unsigned long num_ticks;
+    // Time passed to stepSimulation that has not been simulated yet
+    double unsimulated_time_seconds;
+
+    // The World returned by getWorld, kept so the history of the ball, robots, and game
+    // state builds up as it would for a real World
+    World world;
+};
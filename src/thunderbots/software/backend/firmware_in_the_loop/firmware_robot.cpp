@@ -0,0 +1,153 @@
+#include "backend/firmware_in_the_loop/firmware_robot.h"
+
+#include <dlfcn.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    /**
+     * Copies the firmware bridge library into a new in-memory file
+     *
+     * @return the file descriptor of the copy
+     *
+     * @throws std::runtime_error if the library could not be copied
+     */
+    int copyLibrary()
+    {
+        // The path to the library is set by the build system
+        std::ifstream library_file(FIRMWARE_BRIDGE_LIBRARY, std::ios::binary);
+        if (!library_file)
+        {
+            throw std::runtime_error(std::string("Could not open ") +
+                                     FIRMWARE_BRIDGE_LIBRARY);
+        }
+        std::vector<char> contents((std::istreambuf_iterator<char>(library_file)),
+                                   std::istreambuf_iterator<char>());
+
+        int fd = memfd_create("firmware_robot", MFD_CLOEXEC);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Could not create a file for the firmware");
+        }
+        std::size_t written = 0;
+        while (written < contents.size())
+        {
+            ssize_t result =
+                write(fd, contents.data() + written, contents.size() - written);
+            if (result <= 0)
+            {
+                close(fd);
+                throw std::runtime_error("Could not copy the firmware");
+            }
+            written += static_cast<std::size_t>(result);
+        }
+        return fd;
+    }
+}  // namespace
+
+template <typename Function>
+void FirmwareRobot::lookup(const char* name, Function& function) const
+{
+    void* symbol = dlsym(library, name);
+    if (!symbol)
+    {
+        throw std::runtime_error(std::string("Firmware is missing ") + name);
+    }
+    function = reinterpret_cast<Function>(symbol);
+}
+
+FirmwareRobot::FirmwareRobot(unsigned int index, const Point& position,
+                             const Angle& orientation)
+    : library_fd(copyLibrary()), library(nullptr)
+{
+    std::string library_path = "/proc/self/fd/" + std::to_string(library_fd);
+    library = dlopen(library_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!library)
+    {
+        std::string error = dlerror();
+        close(library_fd);
+        throw std::runtime_error("Could not load the firmware: " + error);
+    }
+
+    try
+    {
+        lookup("fwsim_bridge_set_ball", set_ball);
+        lookup("fwsim_bridge_receive", receive);
+        lookup("fwsim_bridge_tick", tick_firmware);
+        lookup("fwsim_bridge_get_state", get_state);
+        lookup("fwsim_bridge_last_serial_age", last_serial_age);
+        lookup("fwsim_bridge_profile", profile);
+
+        decltype(&fwsim_bridge_init) init;
+        lookup("fwsim_bridge_init", init);
+        const float pos[3] = {static_cast<float>(position.x()),
+                              static_cast<float>(position.y()),
+                              static_cast<float>(orientation.toRadians())};
+        init(index, pos);
+    }
+    catch (...)
+    {
+        dlclose(library);
+        close(library_fd);
+        throw;
+    }
+}
+
+FirmwareRobot::~FirmwareRobot()
+{
+    dlclose(library);
+    close(library_fd);
+}
+
+void FirmwareRobot::setBallState(const Point& position, const Vector& velocity)
+{
+    const float pos[2] = {static_cast<float>(position.x()),
+                          static_cast<float>(position.y())};
+    const float vel[2] = {static_cast<float>(velocity.x()),
+                          static_cast<float>(velocity.y())};
+    set_ball(pos, vel);
+}
+
+void FirmwareRobot::receiveFrame(uint8_t* frame, std::size_t frame_length)
+{
+    receive(frame, frame_length);
+}
+
+void FirmwareRobot::tick()
+{
+    tick_firmware();
+}
+
+fwsim_bridge_state_t FirmwareRobot::getState() const
+{
+    fwsim_bridge_state_t state;
+    get_state(&state);
+    return state;
+}
+
+std::optional<std::pair<uint8_t, uint32_t>> FirmwareRobot::getLastAppliedDrive() const
+{
+    uint8_t serial;
+    uint32_t age_ms;
+    if (!last_serial_age(&serial, &age_ms))
+    {
+        return std::nullopt;
+    }
+    return std::make_pair(serial, age_ms);
+}
+
+std::optional<fwsim_bridge_profile_t> FirmwareRobot::getProfile() const
+{
+    fwsim_bridge_profile_t tick_profile;
+    if (!profile(&tick_profile))
+    {
+        return std::nullopt;
+    }
+    return tick_profile;
+}
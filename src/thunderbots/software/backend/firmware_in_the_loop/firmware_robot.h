@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "firmware/tools/fwsim/bridge.h"
+#include "geom/angle.h"
+#include "geom/point.h"
+
+/**
+ * A single robot running the real robot firmware, built for the host with FWSIM, on the
+ * firmware's simulated robot.
+ *
+ * The firmware keeps all of its state in static variables, so each FirmwareRobot loads
+ * its own private copy of the firmware bridge library (firmware/tools/fwsim/bridge.h).
+ * The copies are independent, so any number of robots can run in the same process, but
+ * each robot must only be used by one thread at a time.
+ */
+class FirmwareRobot
+{
+   public:
+    /**
+     * Loads a new copy of the firmware and starts it, with the robot stopped at the
+     * given position
+     *
+     * @param index The index of the robot, which picks its data out of drive packets
+     * @param position The position of the robot
+     * @param orientation The orientation of the robot
+     *
+     * @throws std::runtime_error if the firmware could not be loaded
+     */
+    explicit FirmwareRobot(unsigned int index, const Point& position,
+                           const Angle& orientation);
+
+    ~FirmwareRobot();
+
+    FirmwareRobot(const FirmwareRobot&) = delete;
+    FirmwareRobot& operator=(const FirmwareRobot&) = delete;
+
+    /**
+     * Moves the ball the robot's primitives see
+     *
+     * @param position The position of the ball
+     * @param velocity The velocity of the ball
+     */
+    void setBallState(const Point& position, const Vector& velocity);
+
+    /**
+     * Hands the robot a frame received over radio, as the radio would
+     *
+     * @param frame The frame, starting with the 802.15.4 frame control word
+     * @param frame_length The length of the frame, including the FCS, RSSI and LQI at
+     * the end
+     */
+    void receiveFrame(uint8_t* frame, std::size_t frame_length);
+
+    /**
+     * Runs one tick of the firmware, and then advances the simulated robot by one
+     * control period
+     */
+    void tick();
+
+    /**
+     * Returns the position and velocity of the simulated robot
+     *
+     * @return the position and velocity of the simulated robot
+     */
+    fwsim_bridge_state_t getState() const;
+
+    /**
+     * Returns the sequence number of the last drive primitive the robot applied and how
+     * long ago it applied it, in milliseconds
+     *
+     * @return the sequence number and age of the last applied drive primitive, or
+     * std::nullopt if the robot has not received any drive packets
+     */
+    std::optional<std::pair<uint8_t, uint32_t>> getLastAppliedDrive() const;
+
+    /**
+     * Returns how much CPU time the robot's normal tick took on the host over the last
+     * second
+     *
+     * @return the CPU time of the normal tick, or std::nullopt if the robot has not run
+     * for a second yet
+     */
+    std::optional<fwsim_bridge_profile_t> getProfile() const;
+
+    // How often the firmware ticks, which is CONTROL_LOOP_HZ in firmware/main/physics.h
+    static constexpr unsigned int TICKS_PER_SECOND = 200;
+
+   private:
+    /**
+     * Looks up a function in this robot's copy of the firmware
+     *
+     * @param name The name of the function
+     * @param function Set to the function
+     *
+     * @throws std::runtime_error if the function could not be found
+     */
+    template <typename Function>
+    void lookup(const char* name, Function& function) const;
+
+    // The file holding this robot's copy of the library. The copies must be in different
+    // files, or the dynamic linker would load the library once and share it
+    int library_fd;
+    void* library;
+
+    decltype(&fwsim_bridge_set_ball) set_ball;
+    decltype(&fwsim_bridge_receive) receive;
+    decltype(&fwsim_bridge_tick) tick_firmware;
+    decltype(&fwsim_bridge_get_state) get_state;
+    decltype(&fwsim_bridge_last_serial_age) last_serial_age;
+    decltype(&fwsim_bridge_profile) profile;
+};
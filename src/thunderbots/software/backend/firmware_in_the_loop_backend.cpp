@@ -0,0 +1,108 @@
+#include "backend/firmware_in_the_loop_backend.h"
+
+#include <chrono>
+
+#include "backend/backend_factory.h"
+#include "util/parameter/dynamic_parameters.h"
+
+const std::string FirmwareInTheLoopBackend::name = "firmware_in_the_loop";
+
+FirmwareInTheLoopBackend::FirmwareInTheLoopBackend() : FirmwareInTheLoopBackend(false) {}
+
+FirmwareInTheLoopBackend::FirmwareInTheLoopBackend(bool run_faster_than_real_time)
+    : firmware_in_the_loop(
+          Field(9.0, 6.0, 1.0, 2.0, 1.0, 0.3, 0.5, Timestamp::fromSeconds(0))),
+      run_faster_than_real_time(run_faster_than_real_time),
+      primitives_received(false),
+      in_destructor(false)
+{
+    // Line the robots up across their own half, facing the enemy goal
+    for (unsigned int id = 0; id < NUM_ROBOTS; id++)
+    {
+        firmware_in_the_loop.addFriendlyRobot(id, Point(-1.5, -2.0 + 0.8 * id),
+                                              Angle::zero());
+    }
+    firmware_in_the_loop.setRefboxGameState(DEFAULT_GAME_STATE);
+
+    simulation_thread = std::thread(&FirmwareInTheLoopBackend::runSimulation, this);
+}
+
+FirmwareInTheLoopBackend::~FirmwareInTheLoopBackend()
+{
+    {
+        std::scoped_lock lock(simulation_mutex);
+        in_destructor = true;
+    }
+    primitives_received_cv.notify_all();
+    simulation_thread.join();
+}
+
+void FirmwareInTheLoopBackend::onValueReceived(ConstPrimitiveVectorPtr primitives)
+{
+    {
+        std::scoped_lock lock(simulation_mutex);
+        firmware_in_the_loop.setFriendlyPrimitives(std::move(primitives));
+        primitives_received = true;
+    }
+    primitives_received_cv.notify_all();
+}
+
+void FirmwareInTheLoopBackend::runSimulation()
+{
+    const auto world_update_period =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(WORLD_UPDATE_PERIOD_SECONDS));
+    const auto primitives_timeout =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(FAST_FORWARD_PRIMITIVES_TIMEOUT_SECONDS));
+    auto next_update_time = std::chrono::steady_clock::now();
+    unsigned int num_worlds = 0;
+
+    while (true)
+    {
+        World world;
+        std::vector<RobotStatus> robot_statuses;
+        {
+            std::scoped_lock lock(simulation_mutex);
+            if (in_destructor)
+            {
+                return;
+            }
+
+            firmware_in_the_loop.stepSimulation(
+                Duration::fromSeconds(WORLD_UPDATE_PERIOD_SECONDS));
+            world = firmware_in_the_loop.getWorld();
+            if (num_worlds % WORLDS_PER_ROBOT_STATUS_UPDATE == 0)
+            {
+                robot_statuses = firmware_in_the_loop.getRobotStatuses();
+            }
+            primitives_received = false;
+        }
+        num_worlds++;
+
+        world.mutableFriendlyTeam().assignGoalie(
+            Util::DynamicParameters::AI::refbox::friendly_goalie_id.value());
+        Subject<World>::sendValueToObservers(world);
+        for (const RobotStatus& robot_status : robot_statuses)
+        {
+            Subject<RobotStatus>::sendValueToObservers(robot_status);
+        }
+
+        std::unique_lock<std::mutex> lock(simulation_mutex);
+        if (run_faster_than_real_time)
+        {
+            primitives_received_cv.wait_for(lock, primitives_timeout, [this]() {
+                return primitives_received || in_destructor;
+            });
+        }
+        else
+        {
+            next_update_time += world_update_period;
+            primitives_received_cv.wait_until(lock, next_update_time,
+                                              [this]() { return in_destructor; });
+        }
+    }
+}
+
+// Register this backend in the BackendFactory
+static TBackendFactory<FirmwareInTheLoopBackend> factory;
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "backend/backend.h"
+#include "backend/firmware_in_the_loop/firmware_in_the_loop.h"
+
+/**
+ * A backend that runs the AI against FirmwareInTheLoop, so the AI's primitives go
+ * through the real radio encoding and are run by the real robot firmware, without any
+ * robots, dongle, or grSim.
+ *
+ * Like the SimulatorBackend, the simulation is stepped on its own thread, which
+ * publishes a new World every step, either paced by the wall clock or as soon as the AI
+ * has sent primitives for the previous World. The status of every robot is published
+ * every few Worlds, as the dongle would report it from robot feedback.
+ */
+class FirmwareInTheLoopBackend : public Backend
+{
+   public:
+    static const std::string name;
+
+    /**
+     * Creates a new FirmwareInTheLoopBackend that runs in real time, with the friendly
+     * robots lined up on their own half of a Division B field and the game in progress
+     */
+    FirmwareInTheLoopBackend();
+
+    /**
+     * Creates a new FirmwareInTheLoopBackend with the friendly robots lined up on their
+     * own half of a Division B field and the game in progress
+     *
+     * @param run_faster_than_real_time Whether to step the simulation as soon as the AI
+     * responds, rather than in real time
+     *
+     * @throws std::runtime_error if the firmware could not be loaded
+     */
+    explicit FirmwareInTheLoopBackend(bool run_faster_than_real_time);
+
+    ~FirmwareInTheLoopBackend() override;
+
+   private:
+    // How much simulated time passes between each World
+    static constexpr double WORLD_UPDATE_PERIOD_SECONDS = 1.0 / 60.0;
+
+    // How many Worlds are published between each set of robot statuses
+    static const unsigned int WORLDS_PER_ROBOT_STATUS_UPDATE = 10;
+
+    // In fast-forward mode, how long to wait for the AI to send primitives before
+    // stepping the simulation anyway
+    static constexpr double FAST_FORWARD_PRIMITIVES_TIMEOUT_SECONDS = 1.0;
+
+    static const unsigned int NUM_ROBOTS                = 6;
+    static constexpr RefboxGameState DEFAULT_GAME_STATE = RefboxGameState::FORCE_START;
+
+    void onValueReceived(ConstPrimitiveVectorPtr primitives) override;
+
+    /**
+     * Steps the simulation and publishes the new World and robot statuses until this
+     * backend is destroyed. This is intended to be run in a separate thread
+     */
+    void runSimulation();
+
+    FirmwareInTheLoop firmware_in_the_loop;
+    const bool run_faster_than_real_time;
+
+    // Protects firmware_in_the_loop and the flags below
+    std::mutex simulation_mutex;
+    std::condition_variable primitives_received_cv;
+    // Whether primitives have been received since the last World was published
+    bool primitives_received;
+    bool in_destructor;
+
+    std::thread simulation_thread;
+};
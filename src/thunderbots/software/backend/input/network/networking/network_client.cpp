@@ -129,11 +129,14 @@ void NetworkClient::filterAndPublishVisionData(SSL_WrapperPacket packet)
         SSL_DetectionFrame detection = *packet.mutable_detection();
         bool camera_disabled         = false;
 
+        // Read the parameters once for the whole packet
+        const auto parameters = Util::DynamicParameters::getParameterSnapshot();
+
         // We invert the field side if we explicitly choose to override the values
         // provided by refbox. The 'defending_positive_side' parameter dictates the side
         // we are defending if we are overriding the value
-        if (Util::DynamicParameters::AI::refbox::override_refbox_defending_side.value() &&
-            Util::DynamicParameters::AI::refbox::defending_positive_side.value())
+        if (parameters->AI.refbox.override_refbox_defending_side &&
+            parameters->AI.refbox.defending_positive_side)
         {
             invertFieldSide(detection);
         }
@@ -141,20 +144,16 @@ void NetworkClient::filterAndPublishVisionData(SSL_WrapperPacket packet)
         switch (detection.camera_id())
         {
             case 0:
-                camera_disabled =
-                    Util::DynamicParameters::cameras::ignore_camera_0.value();
+                camera_disabled = parameters->cameras.ignore_camera_0;
                 break;
             case 1:
-                camera_disabled =
-                    Util::DynamicParameters::cameras::ignore_camera_1.value();
+                camera_disabled = parameters->cameras.ignore_camera_1;
                 break;
             case 2:
-                camera_disabled =
-                    Util::DynamicParameters::cameras::ignore_camera_2.value();
+                camera_disabled = parameters->cameras.ignore_camera_2;
                 break;
             case 3:
-                camera_disabled =
-                    Util::DynamicParameters::cameras::ignore_camera_3.value();
+                camera_disabled = parameters->cameras.ignore_camera_3;
                 break;
             default:
                 LOG(WARNING) << "An unkown camera id was detected, disabled by default "
@@ -169,15 +168,11 @@ void NetworkClient::filterAndPublishVisionData(SSL_WrapperPacket packet)
             world.updateBallState(ball);
 
             Team friendly_team = network_filter.getFilteredFriendlyTeamData({detection});
-            int friendly_goalie_id =
-                Util::DynamicParameters::AI::refbox::friendly_goalie_id.value();
-            friendly_team.assignGoalie(friendly_goalie_id);
+            friendly_team.assignGoalie(parameters->AI.refbox.friendly_goalie_id);
             world.mutableFriendlyTeam() = friendly_team;
 
             Team enemy_team = network_filter.getFilteredEnemyTeamData({detection});
-            int enemy_goalie_id =
-                Util::DynamicParameters::AI::refbox::enemy_goalie_id.value();
-            enemy_team.assignGoalie(enemy_goalie_id);
+            enemy_team.assignGoalie(parameters->AI.refbox.enemy_goalie_id);
             world.mutableEnemyTeam() = enemy_team;
         }
     }
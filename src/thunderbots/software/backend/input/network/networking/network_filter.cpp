@@ -7,6 +7,9 @@
 #include "shared/constants.h"
 #include "util/constants.h"
 #include "util/refbox_constants.h"
+#include "util/units.h"
+
+using namespace Units;
 
 // We can initialize the field_state with all zeroes here because this state will never
 // be accessed by an external observer to this class. the getFieldData must be called to
@@ -87,12 +90,12 @@ Field NetworkFilter::createFieldFromPacketGeometry(
     }
 
     // Extract the data we care about and convert all units to meters
-    double field_length   = packet_geometry.field_length() * METERS_PER_MILLIMETER;
-    double field_width    = packet_geometry.field_width() * METERS_PER_MILLIMETER;
-    double goal_width     = packet_geometry.goalwidth() * METERS_PER_MILLIMETER;
-    double boundary_width = packet_geometry.boundary_width() * METERS_PER_MILLIMETER;
+    double field_length   = Millimeters(packet_geometry.field_length()).in<Meters>();
+    double field_width    = Millimeters(packet_geometry.field_width()).in<Meters>();
+    double goal_width     = Millimeters(packet_geometry.goalwidth()).in<Meters>();
+    double boundary_width = Millimeters(packet_geometry.boundary_width()).in<Meters>();
     double center_circle_radius =
-        ssl_circular_arcs["CenterCircle"].radius() * METERS_PER_MILLIMETER;
+        Millimeters(ssl_circular_arcs["CenterCircle"].radius()).in<Meters>();
 
     // We arbitraily use the left side here since the left and right sides are identical
     Point defense_length_p1 =
@@ -102,7 +105,7 @@ Field NetworkFilter::createFieldFromPacketGeometry(
         Point(ssl_field_lines["LeftFieldLeftPenaltyStretch"].p2().x(),
               ssl_field_lines["LeftFieldLeftPenaltyStretch"].p2().y());
     double defense_length =
-        (defense_length_p2 - defense_length_p1).len() * METERS_PER_MILLIMETER;
+        Millimeters((defense_length_p2 - defense_length_p1).len()).in<Meters>();
 
     // We arbitraily use the left side here since the left and right sides are identical
     Point defense_width_p1 = Point(ssl_field_lines["LeftPenaltyStretch"].p1().x(),
@@ -110,7 +113,7 @@ Field NetworkFilter::createFieldFromPacketGeometry(
     Point defense_width_p2 = Point(ssl_field_lines["LeftPenaltyStretch"].p2().x(),
                                    ssl_field_lines["LeftPenaltyStretch"].p2().y());
     double defense_width =
-        (defense_width_p1 - defense_width_p2).len() * METERS_PER_MILLIMETER;
+        Millimeters((defense_width_p1 - defense_width_p2).len()).in<Meters>();
 
     Field field =
         Field(field_length, field_width, defense_length, defense_width, goal_width,
@@ -120,6 +123,8 @@ Field NetworkFilter::createFieldFromPacketGeometry(
 
 Ball NetworkFilter::getFilteredBallData(const std::vector<SSL_DetectionFrame> &detections)
 {
+    // Read the parameters once for all the detections
+    const auto parameters = Util::DynamicParameters::getParameterSnapshot();
     auto ball_detections = std::vector<SSLBallDetection>();
 
     for (const auto &detection : detections)
@@ -128,18 +133,15 @@ Ball NetworkFilter::getFilteredBallData(const std::vector<SSL_DetectionFrame> &d
         {
             // Convert all data to meters and radians
             SSLBallDetection ball_detection;
-            ball_detection.position =
-                Point(ball.x() * METERS_PER_MILLIMETER, ball.y() * METERS_PER_MILLIMETER);
+            ball_detection.position = Point(Millimeters(ball.x()).in<Meters>(),
+                                            Millimeters(ball.y()).in<Meters>());
             ball_detection.timestamp = Timestamp::fromSeconds(detection.t_capture());
 
             bool ball_position_invalid =
-                Util::DynamicParameters::AI::refbox::min_valid_x.value() >
-                    ball_detection.position.x() ||
-                Util::DynamicParameters::AI::refbox::max_valid_x.value() <
-                    ball_detection.position.x();
+                parameters->AI.refbox.min_valid_x > ball_detection.position.x() ||
+                parameters->AI.refbox.max_valid_x < ball_detection.position.x();
             bool ignore_ball =
-                Util::DynamicParameters::AI::refbox::ignore_invalid_camera_data.value() &&
-                ball_position_invalid;
+                parameters->AI.refbox.ignore_invalid_camera_data && ball_position_invalid;
             if (!ignore_ball)
             {
                 ball_detections.push_back(ball_detection);
@@ -160,13 +162,15 @@ Ball NetworkFilter::getFilteredBallData(const std::vector<SSL_DetectionFrame> &d
 Team NetworkFilter::getFilteredFriendlyTeamData(
     const std::vector<SSL_DetectionFrame> &detections)
 {
+    // Read the parameters once for all the detections
+    const auto parameters = Util::DynamicParameters::getParameterSnapshot();
     auto friendly_robot_detections = std::vector<SSLRobotDetection>();
 
     // Collect all the visible robots from all camera frames
     for (const auto &detection : detections)
     {
         auto ssl_robots = detection.robots_yellow();
-        if (!Util::DynamicParameters::AI::refbox::friendly_color_yellow.value())
+        if (!parameters->AI.refbox.friendly_color_yellow)
         {
             ssl_robots = detection.robots_blue();
         }
@@ -177,8 +181,8 @@ Team NetworkFilter::getFilteredFriendlyTeamData(
 
             robot_detection.id = friendly_robot_detection.robot_id();
             robot_detection.position =
-                Point(friendly_robot_detection.x() * METERS_PER_MILLIMETER,
-                      friendly_robot_detection.y() * METERS_PER_MILLIMETER);
+                Point(Millimeters(friendly_robot_detection.x()).in<Meters>(),
+                      Millimeters(friendly_robot_detection.y()).in<Meters>());
             robot_detection.orientation =
                 Angle::ofRadians(friendly_robot_detection.orientation());
             robot_detection.confidence = friendly_robot_detection.confidence();
@@ -186,13 +190,10 @@ Team NetworkFilter::getFilteredFriendlyTeamData(
 
 
             bool robot_position_invalid =
-                Util::DynamicParameters::AI::refbox::min_valid_x.value() >
-                    robot_detection.position.x() ||
-                Util::DynamicParameters::AI::refbox::max_valid_x.value() <
-                    robot_detection.position.x();
-            bool ignore_robot =
-                Util::DynamicParameters::AI::refbox::ignore_invalid_camera_data.value() &&
-                robot_position_invalid;
+                parameters->AI.refbox.min_valid_x > robot_detection.position.x() ||
+                parameters->AI.refbox.max_valid_x < robot_detection.position.x();
+            bool ignore_robot = parameters->AI.refbox.ignore_invalid_camera_data &&
+                                robot_position_invalid;
             if (!ignore_robot)
             {
                 friendly_robot_detections.push_back(robot_detection);
@@ -210,13 +211,15 @@ Team NetworkFilter::getFilteredFriendlyTeamData(
 Team NetworkFilter::getFilteredEnemyTeamData(
     const std::vector<SSL_DetectionFrame> &detections)
 {
+    // Read the parameters once for all the detections
+    const auto parameters = Util::DynamicParameters::getParameterSnapshot();
     auto enemy_robot_detections = std::vector<SSLRobotDetection>();
 
     // Collect all the visible robots from all camera frames
     for (const auto &detection : detections)
     {
         auto ssl_robots = detection.robots_blue();
-        if (!Util::DynamicParameters::AI::refbox::friendly_color_yellow.value())
+        if (!parameters->AI.refbox.friendly_color_yellow)
         {
             ssl_robots = detection.robots_yellow();
         }
@@ -227,21 +230,18 @@ Team NetworkFilter::getFilteredEnemyTeamData(
 
             robot_detection.id = enemy_robot_detection.robot_id();
             robot_detection.position =
-                Point(enemy_robot_detection.x() * METERS_PER_MILLIMETER,
-                      enemy_robot_detection.y() * METERS_PER_MILLIMETER);
+                Point(Millimeters(enemy_robot_detection.x()).in<Meters>(),
+                      Millimeters(enemy_robot_detection.y()).in<Meters>());
             robot_detection.orientation =
                 Angle::ofRadians(enemy_robot_detection.orientation());
             robot_detection.confidence = enemy_robot_detection.confidence();
             robot_detection.timestamp  = Timestamp::fromSeconds(detection.t_capture());
 
             bool robot_position_invalid =
-                Util::DynamicParameters::AI::refbox::min_valid_x.value() >
-                    robot_detection.position.x() ||
-                Util::DynamicParameters::AI::refbox::max_valid_x.value() <
-                    robot_detection.position.x();
-            bool ignore_robot =
-                Util::DynamicParameters::AI::refbox::ignore_invalid_camera_data.value() &&
-                robot_position_invalid;
+                parameters->AI.refbox.min_valid_x > robot_detection.position.x() ||
+                parameters->AI.refbox.max_valid_x < robot_detection.position.x();
+            bool ignore_robot = parameters->AI.refbox.ignore_invalid_camera_data &&
+                                robot_position_invalid;
             if (!ignore_robot)
             {
                 enemy_robot_detections.push_back(robot_detection);
@@ -31,7 +31,14 @@ template <class... Ts>
 overload(Ts...)->overload<Ts...>;
 
 GrSimOutput::GrSimOutput(std::string network_address, unsigned short port)
-    : network_address(network_address), port(port), socket(io_service)
+    : network_address(network_address),
+      port(port),
+      socket(io_service),
+      motion_controller(ROBOT_MAX_SPEED_METERS_PER_SECOND,
+                        ROBOT_MAX_ANG_SPEED_RAD_PER_SECOND,
+                        ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED,
+                        ROBOT_MAX_ANG_ACCELERATION_RAD_PER_SECOND_SQUARED),
+      last_motion_controller_time(std::nullopt)
 {
     socket.open(ip::udp::v4());
     remote_endpoint = ip::udp::endpoint(ip::address::from_string(network_address), port);
@@ -50,26 +57,27 @@ void GrSimOutput::sendPrimitives(
     // class doesn't support absolute "wall time". This function will need to be
     // changed to make use of the timestamps stored with the robots
     // https://github.com/UBC-Thunderbots/Software/issues/279
-    //
-    // initial timestamp for bang-bang set as current time
-    static auto bangbang_timestamp = std::chrono::steady_clock::now();
-
-    std::chrono::duration<double> delta_time =
-        std::chrono::steady_clock::now() - bangbang_timestamp;
+    std::chrono::duration<double> delta_time(0);
+    if (last_motion_controller_time)
+    {
+        delta_time = std::chrono::steady_clock::now() - *last_motion_controller_time;
+    }
 
-    MotionController motionController(ROBOT_MAX_SPEED_METERS_PER_SECOND,
-                                      ROBOT_MAX_ANG_SPEED_RAD_PER_SECOND,
-                                      ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED,
-                                      ROBOT_MAX_ANG_ACCELERATION_RAD_PER_SECOND_SQUARED);
+    // Clearing the packet keeps the robot commands it already allocated, so they are
+    // re-used for this frame
+    robot_commands_packet.Clear();
+    grSim_Commands& commands = *robot_commands_packet.mutable_commands();
+    commands.set_isteamyellow(
+        Util::DynamicParameters::AI::refbox::friendly_color_yellow.value());
+    commands.set_timestamp(0.0);
 
     for (auto& prim : primitives)
     {
-        if (friendly_team.getRobotById(prim->getRobotId()))
+        std::optional<Robot> robot = friendly_team.getRobotById(prim->getRobotId());
+        if (robot)
         {
-            Robot robot = *friendly_team.getRobotById(prim->getRobotId());
-
             GrsimCommandPrimitiveVisitor grsim_command_primitive_visitor =
-                GrsimCommandPrimitiveVisitor(robot, ball);
+                GrsimCommandPrimitiveVisitor(*robot, ball);
             prim->accept(grsim_command_primitive_visitor);
 
             std::variant<MotionController::PositionCommand,
@@ -78,8 +86,8 @@ void GrSimOutput::sendPrimitives(
                     grsim_command_primitive_visitor.getMotionControllerCommand();
 
             MotionController::Velocity robot_velocities =
-                motionController.bangBangVelocityController(robot, delta_time.count(),
-                                                            motion_controller_command);
+                motion_controller.bangBangVelocityController(*robot, delta_time.count(),
+                                                             motion_controller_command);
 
             double kick_speed_meters_per_second;
             bool chip_instead_of_kick;
@@ -103,20 +111,22 @@ void GrSimOutput::sendPrimitives(
                          }},
                 motion_controller_command);
 
-            // send the velocity data via grsim_packet
-            grSim_Packet grsim_packet = createGrSimPacketWithRobotVelocity(
-                prim->getRobotId(),
-                Util::DynamicParameters::AI::refbox::friendly_color_yellow.value(),
-                robot_velocities.linear_velocity, robot_velocities.angular_velocity,
-                kick_speed_meters_per_second, chip_instead_of_kick, dribbler_on);
-
-            sendGrSimPacket(grsim_packet);
+            addRobotCommandWithVelocity(
+                commands, prim->getRobotId(), robot_velocities.linear_velocity,
+                robot_velocities.angular_velocity, kick_speed_meters_per_second,
+                chip_instead_of_kick, dribbler_on);
         }
     }
 
+    // Send the commands for all the robots at once, so grSim applies them together
+    if (commands.robot_commands_size() > 0)
+    {
+        sendGrSimPacket(robot_commands_packet);
+    }
+
     // timestamp of when the motion controller was last run (to be used for calculating
     // delta_time in the future)
-    bangbang_timestamp = std::chrono::steady_clock::now();
+    last_motion_controller_time = std::chrono::steady_clock::now();
 }
 
 grSim_Packet GrSimOutput::createGrSimPacketWithRobotVelocity(
@@ -128,7 +138,21 @@ grSim_Packet GrSimOutput::createGrSimPacketWithRobotVelocity(
 
     packet.mutable_commands()->set_isteamyellow(is_yellow);
     packet.mutable_commands()->set_timestamp(0.0);
-    grSim_Robot_Command* robot_command = packet.mutable_commands()->add_robot_commands();
+    addRobotCommandWithVelocity(*packet.mutable_commands(), robot_id, robot_velocity,
+                                angular_velocity, kick_speed_meters_per_second, chip,
+                                dribbler_on);
+
+    return packet;
+}
+
+void GrSimOutput::addRobotCommandWithVelocity(grSim_Commands& commands,
+                                              unsigned int robot_id,
+                                              Vector robot_velocity,
+                                              AngularVelocity angular_velocity,
+                                              double kick_speed_meters_per_second,
+                                              bool chip, bool dribbler_on)
+{
+    grSim_Robot_Command* robot_command = commands.add_robot_commands();
 
     robot_command->set_id(robot_id);
 
@@ -147,8 +171,6 @@ grSim_Packet GrSimOutput::createGrSimPacketWithRobotVelocity(
     robot_command->set_kickspeedz(
         static_cast<float>(chip ? kick_speed_meters_per_second : 0.0));
     robot_command->set_spinner(dribbler_on);
-
-    return packet;
 }
 
 void GrSimOutput::setBallState(Point destination, Vector velocity)
@@ -175,8 +197,9 @@ grSim_Packet GrSimOutput::createGrSimReplacementWithBallState(Point destination,
 
 void GrSimOutput::sendGrSimPacket(const grSim_Packet& packet)
 {
+    // Serialize into the same string every time, so its memory is re-used
+    packet.SerializeToString(&serialized_packet);
+
     boost::system::error_code err;
-    socket.send_to(
-        buffer(packet.SerializeAsString(), static_cast<size_t>(packet.ByteSize())),
-        remote_endpoint, 0, err);
+    socket.send_to(buffer(serialized_packet), remote_endpoint, 0, err);
 }
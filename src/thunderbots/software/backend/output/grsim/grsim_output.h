@@ -3,10 +3,13 @@
 #include <ai/world/ball.h>
 
 #include <boost/asio.hpp>
+#include <chrono>
+#include <optional>
 #include <string>
 
 #include "ai/primitive/primitive.h"
 #include "ai/world/team.h"
+#include "backend/output/grsim/motion_controller.h"
 #include "geom/angle.h"
 #include "geom/point.h"
 #include "proto/grSim_Packet.pb.h"
@@ -26,7 +29,8 @@ class GrSimOutput
     ~GrSimOutput();
 
     /**
-     * Sends the given primitives to be simulated in grSim
+     * Sends the given primitives to be simulated in grSim. The commands for all the
+     * robots are sent together in a single packet
      *
      * @param primitives the list of primitives to send
      * @param friendly_team A Team object containing the latest data for the friendly team
@@ -90,6 +94,18 @@ class GrSimOutput
     grSim_Packet createGrSimReplacementWithBallState(Point destination, Vector velocity);
 
    private:
+    /**
+     * Adds a command with the given velocity information for a robot to the given grSim
+     * commands. The parameters are the same as for createGrSimPacketWithRobotVelocity
+     *
+     * @param commands The grSim commands to add the robot command to
+     */
+    static void addRobotCommandWithVelocity(grSim_Commands& commands,
+                                            unsigned int robot_id, Vector robot_velocity,
+                                            AngularVelocity angular_velocity,
+                                            double kick_speed_meters_per_second,
+                                            bool chip, bool dribbler_on);
+
     /**
      * Sends a grSim packet to grSim via UDP
      *
@@ -97,6 +113,18 @@ class GrSimOutput
      */
     void sendGrSimPacket(const grSim_Packet& packet);
 
+    MotionController motion_controller;
+
+    // When the motion controller was last run, used to calculate how much time has
+    // passed since then. This is std::nullopt until primitives are first sent
+    std::optional<std::chrono::steady_clock::time_point> last_motion_controller_time;
+
+    // The packet holding the robot commands sent by sendPrimitives, and the buffer it
+    // is serialized into. These are re-used every time primitives are sent so the
+    // memory they allocate is re-used as well
+    grSim_Packet robot_commands_packet;
+    std::string serialized_packet;
+
     // Variables for networking
     std::string network_address;
     unsigned short port;
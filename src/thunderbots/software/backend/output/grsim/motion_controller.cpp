@@ -1,11 +1,14 @@
 /**
  * .cpp file for the grSim motion controller.
  *
- * In the current state it is a bang-bang controller.
+ * Position commands are followed using the time-optimal trajectories in
+ * shared/trajectory.h, which are the same trajectories the AI uses to estimate how long
+ * robots take to move. A new trajectory is planned from the robot's current state every
+ * time the controller runs, and the robot is commanded to the velocity it should have
+ * at the time the controller will next run.
  *
- * It assumed the robot max acceleration is constant.
- *
- * Uses constant acceleration kinematics equations to
+ * Velocity commands use a bang-bang controller, which assumes the robot max
+ * acceleration is constant and uses constant acceleration kinematics equations to
  * calculate changes in speed.
  *
  * See https://en.wikipedia.org/wiki/Bang%E2%80%93bang_control for more info
@@ -15,6 +18,7 @@
 
 #include <algorithm>
 
+#include "shared/trajectory.h"
 #include "util/logger/init.h"
 
 // Creates a struct which inherits all lambda function given to it and uses their
@@ -59,7 +63,7 @@ MotionController::Velocity MotionController::bangBangVelocityController(
                             robot, command.global_destination,
                             command.final_speed_at_destination, delta_time,
                             this->max_speed_meters_per_second,
-                            this->max_angular_speed_radians_per_second);
+                            this->max_acceleration_meters_per_second_squared);
                     robot_velocities.angular_velocity =
                         MotionController::determineAngularVelocityFromPosition(
                             robot, command.final_orientation, delta_time,
@@ -99,28 +103,16 @@ AngularVelocity MotionController::determineAngularVelocityFromPosition(
     // Calculate the angular difference between us and a goal
     Angle angle_difference = (desired_final_orientation - robot.orientation()).angleMod();
 
-    // Calculate our desired additional turn rate based on a sqrt-esque profile
-    // This allows us to rapidly bring the velocity to zero when we're near the
-    // target angle
-    double new_robot_angular_velocity_magnitude =
-        std::sqrt(std::max<double>(
-            (angle_difference.abs() - Angle::ofDegrees(0.2)).toRadians(), 0)) *
-        3;
-    // Cap our angular velocity at the robot's physical limit
-    new_robot_angular_velocity_magnitude = std::min<double>(
-        new_robot_angular_velocity_magnitude, max_angular_speed_radians_per_second);
-    // Figure out the maximum acceleration the robot is physically capable of
-    double max_additional_angular_velocity =
-        max_angular_acceleration_radians_per_second_squared * delta_time;
+    Trajectory1D trajectory = planTrajectory1D(
+        angle_difference.toRadians(), robot.angularVelocity().toRadians(),
+        max_angular_speed_radians_per_second,
+        max_angular_acceleration_radians_per_second_squared);
 
-    // Compute the final velocity by taking the minimum of the physical max additional
-    // turn rate and our desired additional turn rate
-    double new_angular_velocity =
-        robot.angularVelocity().toRadians() +
-        std::copysign(max_additional_angular_velocity, angle_difference.toRadians());
-    new_angular_velocity =
-        std::clamp<double>(new_angular_velocity, -new_robot_angular_velocity_magnitude,
-                           new_robot_angular_velocity_magnitude);
+    // The command is followed until the controller next runs, so we command the
+    // velocity the robot should have by then
+    double new_orientation_change, new_angular_velocity;
+    sampleTrajectory1D(&trajectory, delta_time, &new_orientation_change,
+                       &new_angular_velocity);
 
     return AngularVelocity::ofRadians(new_angular_velocity);
 }
@@ -130,59 +122,35 @@ Vector MotionController::determineLinearVelocityFromPosition(
     const double delta_time, const double max_speed_meters_per_second,
     const double max_acceleration_meters_per_second_squared)
 {
-    // Figure out the maximum (physically possible) velocity we can add to the robot
-    double max_magnitude_of_velocity_to_apply =
-        max_acceleration_meters_per_second_squared * delta_time;
-
-    // Calculate a unit vector from the robot to the destination
-    Vector unit_vector_to_dest = (dest - robot.position()).norm();
-
-    // Calculate the vector of our velocity perpendicular to the vector toward the
-    // destination
-    Vector robot_velocity_perpendicular_to_dest =
-        robot.velocity().dot(unit_vector_to_dest.perp()) * unit_vector_to_dest.perp();
-
-    // Use the "remaining" velocity (based on physical limits) to move us along the vector
-    // towards the destination
-    double magnitude_additional_velocity_towards_dest =
-        std::max<double>(0, max_magnitude_of_velocity_to_apply -
-                                robot_velocity_perpendicular_to_dest.len());
-    Vector additional_velocity_towards_dest =
-        magnitude_additional_velocity_towards_dest * unit_vector_to_dest;
-
-    // The resulting additional velocity to apply to the robot is the velocity required to
-    // counteract our movement perpendicular to the vector towards the destination, with
-    // the "remaining" velocity pushing us along the vector to the destination
-    Vector additional_velocity =
-        -robot_velocity_perpendicular_to_dest + additional_velocity_towards_dest;
-
-    // Clamp the new robot velocity to the minimum of the physical maximum velocity and
-    // a square root-esque function of the distance to the destination. This allows us to
-    // bring the robot velocity to zero as we approach the destination
-    double new_robot_velocity_magnitude =
-        std::sqrt(std::max<double>((dest - robot.position()).len() - 0.01, 0)) * 2 +
-        desired_final_speed;
-
-    // https://github.com/UBC-Thunderbots/Software/issues/270
-    // Check for the case where we are moving away from the target AND the additional
-    // velocity is greater in magnitude than the current velocity, as the above
-    // function will increase in magnitude as the distance to the destination increases
-
-    bool moving_away_from_dest =
-        (robot.velocity().orientation() - unit_vector_to_dest.orientation())
-            .angleMod()
-            .abs() > Angle::quarter();
-
-    if (moving_away_from_dest && additional_velocity.len() < robot.velocity().len())
+    // Trajectories end at rest, so to pass through the destination at the desired final
+    // speed we plan to the point past the destination where the robot would come to rest
+    // if it started decelerating at the destination. This is the same approach as
+    // PrepareBBTrajectory in the firmware
+    double final_speed =
+        std::clamp(desired_final_speed, 0.0, max_speed_meters_per_second);
+    Vector displacement = dest - robot.position();
+    displacement += displacement.norm(std::pow(final_speed, 2) /
+                                      (2 * max_acceleration_meters_per_second_squared));
+
+    Trajectory2D trajectory =
+        planTrajectory2D({displacement.x(), displacement.y()},
+                         {robot.velocity().x(), robot.velocity().y()},
+                         max_speed_meters_per_second,
+                         max_acceleration_meters_per_second_squared);
+
+    // The command is followed until the controller next runs, so we command the
+    // velocity the robot should have by then
+    Vector2D new_position_change, new_velocity;
+    sampleTrajectory2D(&trajectory, delta_time, &new_position_change, &new_velocity);
+    Vector new_robot_velocity = Vector(new_velocity.x, new_velocity.y);
+
+    // Each axis of the trajectory only gets a share of the max speed, but an axis that
+    // is still braking from a high initial velocity can be above its share, so we make
+    // sure we never command more than the robot can physically do
+    if (new_robot_velocity.len() > max_speed_meters_per_second)
     {
-        new_robot_velocity_magnitude *= -1;
+        new_robot_velocity = new_robot_velocity.norm(max_speed_meters_per_second);
     }
-    new_robot_velocity_magnitude =
-        std::clamp<double>(new_robot_velocity_magnitude, -max_speed_meters_per_second,
-                           max_speed_meters_per_second);
-
-    Vector new_robot_velocity =
-        new_robot_velocity_magnitude * (robot.velocity() + additional_velocity).norm();
 
     // Translate velocities into robot coordinates
     Vector new_robot_velocity_in_robot_coordinates =
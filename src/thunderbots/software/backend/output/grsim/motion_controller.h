@@ -143,10 +143,13 @@ class MotionController
 
     /**
      * Calculate new robot velocities based on current robot state and destination
-     * criteria or with the provided velocities using Bang-bang motion controller
+     * criteria or with the provided velocities using Bang-bang motion controller.
+     * Destinations are reached by following the time-optimal trajectories in
+     * shared/trajectory.h
      *
      * @param robot The robot whose motion is to be controlled
-     * @param delta_time The change in time since the motion controller was run last
+     * @param delta_time The change in time since the motion controller was run last,
+     * which is also how long the returned velocities will be followed for
      * @param motion_command A variant which contains either a Velocity or Position
      * command
      * @return The linear velocity of the robot as a Vector(X,Y) and the angular velocity
@@ -3,6 +3,9 @@
 
 #include <time.h>
 
+#include <algorithm>
+#include <chrono>
+
 #include "dongle.h"
 #include "messages.h"
 #include "shared/constants.h"
@@ -78,6 +81,19 @@ namespace
         return val;
     }
 
+    /**
+     * Extracts a 16-bit integer from a data buffer in little endian form.
+     *
+     * @param buffer the data to extract from.
+     *
+     * @return the integer.
+     */
+    inline uint16_t decode_u16_le(const void *buffer)
+    {
+        const uint8_t *buf = static_cast<const uint8_t *>(buffer);
+        return static_cast<uint16_t>(buf[0] | (buf[1] << 8));
+    }
+
     // Struct to keep track of previously published messages for a robot
     typedef struct
     {
@@ -94,11 +110,67 @@ namespace
         // Timestamp of when this bot last sent a status update
         time_t last_status_update;
 
+        // The time each drive sequence number was last sent to this bot, indexed by
+        // sequence number
+        std::array<std::optional<std::chrono::steady_clock::time_point>,
+                   MRF::NUM_DRIVE_SEQUENCE_NUMBERS>
+            drive_command_times;
+
+        // The sequence number of the last primitive sent to this bot
+        std::optional<uint8_t> last_drive_sequence_number;
+
     } RobotStatusState;
 
     // Map of robot number to their previously published messages
     std::map<uint8_t, RobotStatusState> robot_status_states;
 
+    /**
+     * Fills in how far behind a robot is from the drive acknowledgement in its status
+     * update. The caller must hold the robot's mutex.
+     *
+     * @param state the robot's status state
+     * @param sequence_number the sequence number of the last primitive the robot applied
+     * @param age_ms how long ago the robot applied it, in milliseconds
+     * @param robot_status the status to fill in
+     */
+    void handle_drive_acknowledgement(RobotStatusState &state, uint8_t sequence_number,
+                                      uint16_t age_ms, RobotStatus &robot_status)
+    {
+        sequence_number =
+            static_cast<uint8_t>(sequence_number % MRF::NUM_DRIVE_SEQUENCE_NUMBERS);
+        robot_status.drive_ack_valid                    = true;
+        robot_status.last_applied_drive_sequence_number = sequence_number;
+        if (!state.last_drive_sequence_number)
+        {
+            // Nothing has been sent to the robot yet, so the primitive it applied was
+            // sent by a previous run
+            return;
+        }
+
+        robot_status.drive_primitives_behind =
+            (*state.last_drive_sequence_number + MRF::NUM_DRIVE_SEQUENCE_NUMBERS -
+             sequence_number) %
+            MRF::NUM_DRIVE_SEQUENCE_NUMBERS;
+
+        // A robot more than half the sequence numbers behind can not be told apart from
+        // one that is ahead because it applied a primitive sent before the sequence
+        // numbers wrapped around, so its latency is unknown
+        const std::optional<std::chrono::steady_clock::time_point> &sent =
+            state.drive_command_times[sequence_number];
+        if (sent && robot_status.drive_primitives_behind <
+                        MRF::NUM_DRIVE_SEQUENCE_NUMBERS / 2)
+        {
+            // The robot measures the age in whole ticks, so it can be slightly longer
+            // than the time since the primitive was sent
+            std::chrono::steady_clock::time_point applied =
+                std::chrono::steady_clock::now() - std::chrono::milliseconds(age_ms);
+            robot_status.drive_latency_valid = true;
+            robot_status.drive_latency_ms =
+                std::max(0.0, std::chrono::duration<double, std::milli>(applied - *sent)
+                                  .count());
+        }
+    }
+
 }  // namespace
 
 Annunciator::Annunciator(std::function<void(RobotStatus)> received_robot_status_callback)
@@ -117,7 +189,7 @@ void Annunciator::handle_robot_message(int index, const void *data, std::size_t
                                        uint8_t lqi, uint8_t rssi)
 {
     std::vector<std::string> new_msgs;
-    RobotStatus robot_status;
+    RobotStatus robot_status = {};
 
     // Guard robot status state for this bot
     std::lock_guard<std::mutex> lock(robot_status_states[index].bot_mutex);
@@ -312,12 +384,68 @@ void Annunciator::handle_robot_message(int index, const void *data, std::size_t
                                 }
                                 break;
 
+                            case 0x03:  // CPU profile.
+                                ++bptr;
+                                --len;
+                                if (len >= 11)
+                                {
+                                    // Times are in tenths of a microsecond
+                                    robot_status.cpu_profile_valid = true;
+                                    robot_status.normal_tick_mean_us =
+                                        decode_u16_le(bptr) / 10.0;
+                                    robot_status.normal_tick_max_us =
+                                        decode_u16_le(bptr + 2) / 10.0;
+                                    robot_status.fast_tick_mean_us =
+                                        decode_u16_le(bptr + 4) / 10.0;
+                                    robot_status.fast_tick_max_us =
+                                        decode_u16_le(bptr + 6) / 10.0;
+                                    if (bptr[8] < MRF::PROFILE_MODULE_COUNT)
+                                    {
+                                        robot_status.busiest_module =
+                                            MRF::PROFILE_MODULE_NAMES[bptr[8]];
+                                    }
+                                    robot_status.busiest_module_mean_us =
+                                        decode_u16_le(bptr + 9) / 10.0;
+                                    bptr += 11;
+                                    len -= 11;
+                                }
+                                else
+                                {
+                                    LOG(WARNING) << "Received general robot status "
+                                                    "update with truncated CPU profile "
+                                                    "extension of length "
+                                                 << len << std::endl;
+                                }
+                                break;
+
+                            case 0x04:  // Drive acknowledgement.
+                                ++bptr;
+                                --len;
+                                if (len >= 3)
+                                {
+                                    handle_drive_acknowledgement(
+                                        robot_status_states[index], bptr[0],
+                                        decode_u16_le(bptr + 1), robot_status);
+                                    bptr += 3;
+                                    len -= 3;
+                                }
+                                else
+                                {
+                                    LOG(WARNING) << "Received general robot status "
+                                                    "update with truncated drive "
+                                                    "acknowledgement extension of "
+                                                    "length "
+                                                 << len << std::endl;
+                                }
+                                break;
+
                             case 0x02:  // LPS data. WARNING: unused, do not delete until
                                         // it's removed from firmware
                                 ++bptr;
                                 --len;
                                 if (len >= 4)
                                 {
+                                    bptr += 4;
                                     len -= 4;
                                 }
                                 else
@@ -440,10 +568,35 @@ std::vector<std::string> Annunciator::handle_dongle_messages(uint8_t status)
     return dongle_messages;
 }
 
-void Annunciator::update_vision_detections(std::vector<uint8_t> robots)
+void Annunciator::update_drive_commands(
+    const std::array<std::optional<uint8_t>, MAX_ROBOTS_OVER_RADIO> &sequence_numbers)
 {
-    for (uint8_t bot : robots)
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    for (uint8_t bot = 0; bot < MAX_ROBOTS_OVER_RADIO; ++bot)
     {
+        if (!sequence_numbers[bot])
+        {
+            continue;
+        }
+
+        // Guard robot status state for this bot
+        std::lock_guard<std::mutex> lock(robot_status_states[bot].bot_mutex);
+        uint8_t sequence_number = *sequence_numbers[bot];
+        robot_status_states[bot].drive_command_times[sequence_number] = now;
+        robot_status_states[bot].last_drive_sequence_number          = sequence_number;
+    }
+}
+
+void Annunciator::update_vision_detections(
+    const std::bitset<MAX_ROBOTS_OVER_RADIO> &robots)
+{
+    for (uint8_t bot = 0; bot < MAX_ROBOTS_OVER_RADIO; ++bot)
+    {
+        if (!robots[bot])
+        {
+            continue;
+        }
+
         // Guard robot status state for this bot
         robot_status_states[bot].bot_mutex.lock();
 
@@ -1,9 +1,13 @@
 #pragma once
 #include <ros/ros.h>
 
+#include <array>
+#include <bitset>
 #include <boost/signals2.hpp>
+#include <optional>
 
 #include "backend/robot_status.h"
+#include "shared/constants.h"
 
 /**
  * This class publishes messages received from the dongle.
@@ -22,10 +26,22 @@ class Annunciator
     /**
      * Updates detected robots from vision, used to determine dead bots.
      *
-     * @param robots vector of uints representing the robot detected in the last vision
-     * update.
+     * @param robots the robots detected in the last vision update, where bit i is set if
+     * the robot with id i was detected
      */
-    void update_vision_detections(std::vector<uint8_t> robots);
+    void update_vision_detections(const std::bitset<MAX_ROBOTS_OVER_RADIO> &robots);
+
+    /**
+     * Records the drive sequence numbers just sent to the robots, which are matched
+     * against the sequence numbers the robots report applying to find how long
+     * primitives take to be applied.
+     *
+     * @param sequence_numbers the sequence number sent to each robot, indexed by robot
+     * id, or std::nullopt for robots that were not sent a primitive
+     */
+    void update_drive_commands(
+        const std::array<std::optional<uint8_t>, MAX_ROBOTS_OVER_RADIO>
+            &sequence_numbers);
 
     /**
      * Decodes diagnostics and messages for each robot, and publishes them.
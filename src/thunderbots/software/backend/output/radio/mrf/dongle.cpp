@@ -13,7 +13,6 @@
 #include <string>
 #include <unordered_map>
 
-#include "backend/output/radio/visitor/mrf_primitive_visitor.h"
 #include "messages.h"
 #include "util/constants.h"
 #include "util/logger/init.h"
@@ -42,24 +41,21 @@ namespace
     // The dongle's MAC address
     static const uint64_t MAC = UINT64_C(0x20cb13bd834ab817);
 
-    // Used for sorting by robot ID
-    struct
-    {
-        bool operator()(std::tuple<uint8_t, Point, Angle> a,
-                        std::tuple<uint8_t, Point, Angle> b) const
-        {
-            return std::get<0>(a) < std::get<0>(b);
-        }
-    } customLess;
-
 }  // namespace
 
-MRFDongle::MRFDongle(unsigned int config, Annunciator &annunciator)
+MRFDongle::MRFDongle(unsigned int config, Annunciator &annunciator,
+                     bool compact_camera_packets)
     : context(),
       device(context, MRF::VENDOR_ID, MRF::PRODUCT_ID, std::getenv("MRF_SERIAL")),
       radio_interface(-1),
       configuration_altsetting(-1),
       normal_altsetting(-1),
+      drive_packet_encoder(),
+      drive_packet_length(0),
+      drive_packet_staged(false),
+      drive_stats{0, 0, 0},
+      compact_camera_packets(compact_camera_packets),
+      compact_camera_packet_encoder(),
       status_transfer(device, 3, 1, true, 0),
       pending_beep_length(0),
       estop_state(EStopState::STOP),
@@ -320,61 +316,15 @@ void MRFDongle::handle_status(AsyncOperation<void> &)
 }
 
 
-void MRFDongle::send_camera_packet(std::vector<std::tuple<uint8_t, Point, Angle>> detbots,
-                                   Point ball, uint64_t timestamp)
+void MRFDongle::send_camera_packet(const MRF::CameraPacketRobots &robots, Point ball,
+                                   uint64_t timestamp)
 {
-    int8_t camera_packet[55] = {0};
-    int8_t mask_vec = 0;  // Assume all robots don't have valid position at the start
-    uint8_t numbots = static_cast<uint8_t>(detbots.size());
-    std::vector<uint8_t> robot_ids;
-
-    // Initialize pointer to start at location of storing ball data. First 2
-    // bytes are for mask and flag vector
-    int8_t *rptr = &camera_packet[1];
-
-    int16_t ballX = static_cast<int16_t>(ball.x() * 1000.0);
-    int16_t ballY = static_cast<int16_t>(ball.y() * 1000.0);
-
-    *rptr++ = static_cast<int8_t>(ballX);  // Add Ball x position
-    *rptr++ = static_cast<int8_t>(ballX >> 8);
-
-    *rptr++ = static_cast<int8_t>(ballY);  // Add Ball Y position
-    *rptr++ = static_cast<int8_t>(ballY >> 8);
-
-    // Sort robots in ascending order by ID
-    std::sort(detbots.begin(), detbots.end(), customLess);
-
-    // For the number of robot for which data was passed in, assign robot ids to
-    // mask vector and position/angle data to camera packet
-    for (std::size_t i = 0; i < numbots; i++)
-    {
-        uint8_t robotID = std::get<0>(detbots[i]);
-        robot_ids.push_back(robotID);
-
-        int16_t robotX = static_cast<int16_t>((std::get<1>(detbots[i])).x() * 1000);
-        int16_t robotY = static_cast<int16_t>((std::get<1>(detbots[i])).y() * 1000);
-        int16_t robotT =
-            static_cast<int16_t>((std::get<2>(detbots[i])).toRadians() * 1000);
-
-        mask_vec |= int8_t(0x01 << (robotID));
-        *rptr++ = static_cast<int8_t>(robotX);
-        *rptr++ = static_cast<int8_t>(robotX >> 8);
-        *rptr++ = static_cast<int8_t>(robotY);
-        *rptr++ = static_cast<int8_t>(robotY >> 8);
-        *rptr++ = static_cast<int8_t>(robotT);
-        *rptr++ = static_cast<int8_t>(robotT >> 8);
-    }
-
-    // Write out the timestamp
-    for (std::size_t i = 0; i < 8; i++)
+    std::bitset<MAX_ROBOTS_OVER_RADIO> detected_robots;
+    for (std::size_t id = 0; id < robots.size(); id++)
     {
-        *rptr++ = static_cast<int8_t>(timestamp >> 8 * i);
+        detected_robots[id] = robots[id].has_value();
     }
 
-    // Mask and Flag Vectors should be fully initialized by now. Assign them to
-    // the packet
-    camera_packet[0] = mask_vec;
-
     std::lock_guard<std::mutex> lock(cam_mtx);
 
     if (camera_transfers.size() >= 8)
@@ -392,9 +342,26 @@ void MRFDongle::send_camera_packet(std::vector<std::tuple<uint8_t, Point, Angle>
         std::chrono::duration_cast<std::chrono::microseconds>(diff);
     uint64_t stamp = static_cast<uint64_t>(micros.count());
 
-    // Create and submit USB transfer with camera packet
-    std::unique_ptr<USB::BulkOutTransfer> elt(
-        new USB::BulkOutTransfer(device, 2, camera_packet, 55, 55, 0));
+    // Create and submit USB transfer with camera packet. The packet is only encoded once
+    // we know it will be sent, since compact camera packets depend on the packets
+    // sent before them
+    std::unique_ptr<USB::BulkOutTransfer> elt;
+    if (compact_camera_packets)
+    {
+        MRF::CompactCameraPacket camera_packet;
+        compact_camera_packet_encoder.encode(robots, ball, timestamp, camera_packet);
+        elt.reset(new USB::BulkOutTransfer(device, 2, camera_packet.data(),
+                                           camera_packet.size(), camera_packet.size(),
+                                           0));
+    }
+    else
+    {
+        MRF::CameraPacket camera_packet;
+        MRF::encodeCameraPacket(robots, ball, timestamp, camera_packet);
+        elt.reset(new USB::BulkOutTransfer(device, 2, camera_packet.data(),
+                                           camera_packet.size(), camera_packet.size(),
+                                           0));
+    }
     auto i = camera_transfers.insert(
         camera_transfers.end(),
         std::pair<std::unique_ptr<USB::BulkOutTransfer>, uint64_t>(std::move(elt),
@@ -410,156 +377,79 @@ void MRFDongle::send_camera_packet(std::vector<std::tuple<uint8_t, Point, Angle>
         this->annunciator.beep_dongle.connect(
             boost::bind(&MRFDongle::beep, this, ANNUNCIATOR_BEEP_LENGTH_MILLISECONDS));
     }
-    annunciator.update_vision_detections(robot_ids);
-};
+    annunciator.update_vision_detections(detected_robots);
+}
 
 void MRFDongle::send_drive_packet(const std::vector<std::unique_ptr<Primitive>> &prims)
 {
     // More than 1 prim.
     if (!prims.empty())
     {
-        std::size_t num_prims = prims.size();
-        if (num_prims > MAX_ROBOTS_OVER_RADIO)
+        std::lock_guard<std::mutex> lock(drive_mtx);
+
+        // Encode under the lock, so sequence numbers are used in the order packets are
+        // staged, but into a local buffer, so the staged packet is untouched if encoding
+        // fails. Robots are always charged if the estop is in RUN state; otherwise
+        // discharge them.
+        MRF::SequencedDrivePacket packet;
+        MRF::DriveSequenceNumbers sequence_numbers;
+        std::size_t packet_length = drive_packet_encoder.encode(
+            prims, estop_state == EStopState::RUN, packet, sequence_numbers);
+        annunciator.update_drive_commands(sequence_numbers);
+
+        // If the previously staged packet was never sent, it is replaced by this one
+        if (drive_packet_staged)
         {
-            throw std::invalid_argument("Too many primitives in vector.");
+            ++drive_stats.num_coalesced;
         }
+        drive_packet        = packet;
+        drive_packet_length = packet_length;
+        drive_packet_staged = true;
 
-        if (num_prims == MAX_ROBOTS_OVER_RADIO)
+        if (drive_transfer)
         {
-            // All robots are present. Build a full-size packet with all the
-            // robots’ data in index order.
-            for (std::size_t i = 0; i != num_prims; ++i)
-            {
-                encode_primitive(prims[i], &drive_packet[i * 8]);
-            }
-            drive_packet_length = 64;
+            // The staged packet will be sent when the current transfer is done
+            ++drive_stats.num_deferred;
         }
-        else if (num_prims < MAX_ROBOTS_OVER_RADIO)
+        else
         {
-            // Only some robots are present. Build a reduced-size packet
-            // with robot indices prefixed.
-            drive_packet_length = 0;
-            for (std::size_t i = 0; i != num_prims; ++i)
-            {
-                drive_packet[drive_packet_length++] =
-                    static_cast<uint8_t>(prims[i]->getRobotId());
-                encode_primitive(prims[i], &drive_packet[drive_packet_length]);
-                drive_packet_length += 8;
-            }
+            submit_drive_transfer();
         }
-
-        submit_drive_transfer();
     }
 }
 
-bool MRFDongle::submit_drive_transfer()
+MRFDongle::DrivePacketStats MRFDongle::drive_packet_stats()
 {
-    // Submit drive_packet when possible.
-    if (!drive_transfer)
-    {
-        drive_transfer.reset(new USB::BulkOutTransfer(device, 1, drive_packet,
-                                                      drive_packet_length, 64, 0));
-        drive_transfer->signal_done.connect(
-            boost::bind(&MRFDongle::handle_drive_transfer_done, this, _1));
-        drive_transfer->submit();
-    }
-
-    return false;
+    std::lock_guard<std::mutex> lock(drive_mtx);
+    return drive_stats;
 }
 
-void MRFDongle::encode_primitive(const std::unique_ptr<Primitive> &prim, void *out)
+void MRFDongle::submit_drive_transfer()
 {
-    uint16_t words[4];
-    MRFPrimitiveVisitor visitor = MRFPrimitiveVisitor();
-
-    // Visit the primitive.
-    prim->accept(visitor);
-    RadioPrimitive r_prim = visitor.getSerializedRadioPacket();
-
-    // Encode the parameter words.
-    for (std::size_t i = 0; i < r_prim.param_array.size(); ++i)
-    {
-        double value = r_prim.param_array[i];
-        switch (std::fpclassify(value))
-        {
-            case FP_NAN:
-                value = 0.0;
-                break;
-            case FP_INFINITE:
-                if (value > 0.0)
-                {
-                    value = 10000.0;
-                }
-                else
-                {
-                    value = -10000.0;
-                }
-                break;
-        }
-        words[i] = 0;
-        if (value < 0.0)
-        {
-            words[i] |= 1 << 10;
-            value = -value;
-        }
-        if (value > 1000.0)
-        {
-            words[i] |= 1 << 11;
-            value *= 0.1;
-        }
-        if (value > 1000.0)
-        {
-            value = 1000.0;
-        }
-        words[i] |= static_cast<uint16_t>(value);
-    }
-
-    // Encode the movement primitive number.
-    words[0] = static_cast<uint16_t>(words[0] |
-                                     static_cast<unsigned int>(r_prim.prim_type) << 12);
-
-    // Encode charge state
-    // Robots are always charged if the estop is in RUN state; otherwise discharge them.
-    switch (estop_state)
-    {
-        case EStopState::BROKEN:
-        case EStopState::STOP:
-            // Discharge`
-            words[1] |= 1 << 14;
-            break;
-        case EStopState::RUN:
-            // Charge
-            words[1] |= 2 << 14;
-            break;
-    }
-
-    // Encode extra data plus the slow flag.
-    uint8_t extra = r_prim.extra_bits;
-    bool slow     = r_prim.slow;
-    if (extra > 127)
-    {
-        throw std::invalid_argument("extra greater than 127");
-    }
-    uint8_t extra_encoded = static_cast<uint8_t>(extra | (slow ? 0x80 : 0x00));
-
-    words[2] = static_cast<uint16_t>(words[2] |
-                                     static_cast<uint16_t>((extra_encoded & 0xF) << 12));
-    words[3] = static_cast<uint16_t>(words[3] |
-                                     static_cast<uint16_t>((extra_encoded >> 4) << 12));
-
-    // Convert the words to bytes.
-    uint8_t *wptr = static_cast<uint8_t *>(out);
-    for (std::size_t i = 0; i != 4; ++i)
-    {
-        *wptr++ = static_cast<uint8_t>(words[i]);
-        *wptr++ = static_cast<uint8_t>(words[i] / 256);
-    }
+    // Submit the staged drive_packet. The caller must hold drive_mtx and make sure no
+    // other drive transfer is in flight
+    assert(drive_packet_staged && !drive_transfer);
+    drive_transfer.reset(new USB::BulkOutTransfer(device, 1, drive_packet.data(),
+                                                  drive_packet_length,
+                                                  MRF::SEQUENCED_DRIVE_PACKET_MAX_LENGTH, 0));
+    drive_transfer->signal_done.connect(
+        boost::bind(&MRFDongle::handle_drive_transfer_done, this, _1));
+    drive_transfer->submit();
+    drive_packet_staged = false;
+    ++drive_stats.num_sent;
 }
 
 void MRFDongle::handle_drive_transfer_done(AsyncOperation<void> &op)
 {
+    std::lock_guard<std::mutex> lock(drive_mtx);
     op.result();
     drive_transfer.reset();
+
+    // Send the newest packet that was staged while the transfer was in flight
+    if (drive_packet_staged)
+    {
+        submit_drive_transfer();
+    }
 }
 
 void MRFDongle::handle_camera_transfer_done(
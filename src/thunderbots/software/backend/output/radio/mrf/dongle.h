@@ -19,6 +19,7 @@
 #include "annunciator.h"
 #include "geom/angle.h"
 #include "geom/point.h"
+#include "packet_encoding.h"
 #include "send_reliable_message_operation.h"
 #include "shared/constants.h"
 #include "usb/libusb.h"
@@ -41,31 +42,70 @@ class MRFDongle final
      *
      * @param config MRF configuration to start dongle in
      * @param annunciator annunciator to publish robot statuses
+     * @param compact_camera_packets whether to send camera packets in the compact
+     * keyframe and delta format, which needs robot firmware that supports it
      */
-    explicit MRFDongle(unsigned int config, Annunciator &annunciator);
+    explicit MRFDongle(unsigned int config, Annunciator &annunciator,
+                       bool compact_camera_packets);
 
     /**
      * Destroys an MRFDongle.
      */
     ~MRFDongle();
 
+    /**
+     * Counts of what happened to the drive packets passed to send_drive_packet.
+     */
+    struct DrivePacketStats
+    {
+        /**
+         * The number of drive packets submitted to the dongle.
+         */
+        uint64_t num_sent;
+
+        /**
+         * The number of drive packets that had to wait for the previous drive transfer
+         * to finish before they could be submitted.
+         */
+        uint64_t num_deferred;
+
+        /**
+         * The number of drive packets that were never submitted, because a newer packet
+         * replaced them while they were waiting.
+         */
+        uint64_t num_coalesced;
+    };
+
     /**
      * Given a vector of primitives, constructs a single drive packet to send over radio
      * to all robots.
      *
+     * Each primitive is tagged with a per-robot sequence number, which the annunciator
+     * matches against the sequence numbers the robots report applying to track how long
+     * primitives take to be applied.
+     *
+     * If a drive packet is still being sent to the dongle, the new packet is staged and
+     * sent as soon as the transfer finishes. Only the newest staged packet is kept, so
+     * robots always receive the latest primitives.
+     *
      * @param prims vector of primatives from HL
      */
     void send_drive_packet(const std::vector<std::unique_ptr<Primitive>> &prims);
 
+    /**
+     * Returns counts of what happened to the drive packets passed to send_drive_packet.
+     */
+    DrivePacketStats drive_packet_stats();
+
     /**
      * Sends a camera packet over radio to all robots, including vision coordinates of
      * all robots and the ball.
-     * @param robots vector of tuples of {robot ID, robot location, robot orientation}
-     * @param ball ball location
+     * @param robots the location and orientation of each robot, indexed by robot ID
+     * @param ball ball location, in metres
      * @param timestamp timestamp in seconds when this data was received
      */
-    void send_camera_packet(std::vector<std::tuple<uint8_t, Point, Angle>> robots,
-                            Point ball, uint64_t timestamp);
+    void send_camera_packet(const MRF::CameraPacketRobots &robots, Point ball,
+                            uint64_t timestamp);
 
     /**
      * Generates an audible beep on the dongle.
@@ -121,13 +161,19 @@ class MRFDongle final
     uint8_t channel_;
     uint16_t pan_;
 
-    /* Functions that handle encoding and sending drive packets. */
-    void encode_primitive(const std::unique_ptr<Primitive> &prim, void *out);
-    bool submit_drive_transfer();
+    /* Functions that handle encoding and sending drive packets. The newest packet is
+     * staged in drive_packet until the in-flight drive_transfer (which holds its own
+     * copy of the packet it is sending) finishes. All drive packet state is protected
+     * by drive_mtx, since transfers finish on the libusb event thread. */
+    void submit_drive_transfer();
     void handle_drive_transfer_done(AsyncOperation<void> &);
-    uint8_t drive_packet[64];
+    std::mutex drive_mtx;
+    MRF::SequencedDrivePacketEncoder drive_packet_encoder;
+    MRF::SequencedDrivePacket drive_packet;
     std::size_t drive_packet_length;
+    bool drive_packet_staged;
     std::unique_ptr<USB::BulkOutTransfer> drive_transfer;
+    DrivePacketStats drive_stats;
 
     /* Camera (vision) packet stuff */
     void handle_camera_transfer_done(
@@ -135,6 +181,8 @@ class MRFDongle final
         std::list<std::pair<std::unique_ptr<USB::BulkOutTransfer>, uint64_t>>::iterator
             iter);
     std::mutex cam_mtx;
+    bool compact_camera_packets;
+    MRF::CompactCameraPacketEncoder compact_camera_packet_encoder;
     std::unique_ptr<USB::BulkOutTransfer> camera_transfer;
     std::list<std::pair<std::unique_ptr<USB::BulkOutTransfer>, uint64_t>>
         camera_transfers;
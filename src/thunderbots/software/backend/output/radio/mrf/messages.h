@@ -198,6 +198,30 @@ namespace MRF
         "SD card full",
     };
 
+    /* Robot CPU profile */
+    /**
+     * The modules whose tick the robot times, in the order the firmware numbers them.
+     * The busiest module in the CPU profile extension is an index into this array.
+     */
+    constexpr unsigned int PROFILE_MODULE_COUNT = 15;
+    const std::array<const char*, PROFILE_MODULE_COUNT> PROFILE_MODULE_NAMES = {
+        "feedback",
+        "receive",
+        "adc",
+        "leds",
+        "breakbeam",
+        "lps",
+        "hall",
+        "encoder",
+        "primitive",
+        "dr",
+        "wheels",
+        "dribbler",
+        "charger",
+        "chicker",
+        "motor",
+    };
+
     /* Dongle messages */
     static constexpr const char* ESTOP_BROKEN_MESSAGE = "EStop missing/broken";
     static constexpr const char* RX_FCS_FAIL_MESSAGE  = "Dongle receive FCS fail";
@@ -0,0 +1,403 @@
+#include "backend/output/radio/mrf/packet_encoding.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "backend/output/radio/radio_units.h"
+
+namespace
+{
+    /**
+     * Writes the given value to the given buffer in little-endian byte order, and
+     * advances the buffer past it
+     *
+     * @param value The value to write
+     * @param out The buffer to write to
+     */
+    template <typename T>
+    void writeLittleEndian(T value, int8_t *&out)
+    {
+        for (std::size_t i = 0; i < sizeof(T); i++)
+        {
+            *out++ = static_cast<int8_t>(static_cast<uint64_t>(value) >> 8 * i);
+        }
+    }
+
+    /**
+     * Returns whether the given value fits in an int8_t
+     *
+     * @param value The value to check
+     *
+     * @return true if the value fits in an int8_t, and false otherwise
+     */
+    bool fitsInInt8(int value)
+    {
+        return value >= std::numeric_limits<int8_t>::min() &&
+               value <= std::numeric_limits<int8_t>::max();
+    }
+}  // namespace
+
+void MRF::encodePrimitive(const RadioPrimitive &prim, bool charge, uint8_t *out)
+{
+    uint16_t words[4];
+
+    // Encode the parameter words.
+    for (std::size_t i = 0; i < prim.param_array.size(); ++i)
+    {
+        double value = prim.param_array[i];
+        switch (std::fpclassify(value))
+        {
+            case FP_NAN:
+                value = 0.0;
+                break;
+            case FP_INFINITE:
+                if (value > 0.0)
+                {
+                    value = 10000.0;
+                }
+                else
+                {
+                    value = -10000.0;
+                }
+                break;
+        }
+        words[i] = 0;
+        if (value < 0.0)
+        {
+            words[i] |= 1 << 10;
+            value = -value;
+        }
+        if (value > 1000.0)
+        {
+            words[i] |= 1 << 11;
+            value *= 0.1;
+        }
+        if (value > 1000.0)
+        {
+            value = 1000.0;
+        }
+        words[i] |= static_cast<uint16_t>(value);
+    }
+
+    // Encode the movement primitive number.
+    words[0] = static_cast<uint16_t>(words[0] |
+                                     static_cast<unsigned int>(prim.prim_type) << 12);
+
+    // Encode charge state
+    if (charge)
+    {
+        words[1] |= 2 << 14;
+    }
+    else
+    {
+        words[1] |= 1 << 14;
+    }
+
+    // Encode extra data plus the slow flag.
+    uint8_t extra = prim.extra_bits;
+    bool slow     = prim.slow;
+    if (extra > 127)
+    {
+        throw std::invalid_argument("extra greater than 127");
+    }
+    uint8_t extra_encoded = static_cast<uint8_t>(extra | (slow ? 0x80 : 0x00));
+
+    words[2] = static_cast<uint16_t>(words[2] |
+                                     static_cast<uint16_t>((extra_encoded & 0xF) << 12));
+    words[3] = static_cast<uint16_t>(words[3] |
+                                     static_cast<uint16_t>((extra_encoded >> 4) << 12));
+
+    // Convert the words to bytes.
+    for (std::size_t i = 0; i != 4; ++i)
+    {
+        *out++ = static_cast<uint8_t>(words[i]);
+        *out++ = static_cast<uint8_t>(words[i] / 256);
+    }
+}
+
+std::size_t MRF::encodeDrivePacket(const std::vector<std::unique_ptr<Primitive>> &prims,
+                                   bool charge, DrivePacket &packet)
+{
+    std::size_t num_prims = prims.size();
+    if (num_prims == 0)
+    {
+        throw std::invalid_argument("No primitives in vector.");
+    }
+    if (num_prims > MAX_ROBOTS_OVER_RADIO)
+    {
+        throw std::invalid_argument("Too many primitives in vector.");
+    }
+
+    // A single visitor is re-used for every primitive. The visitor stores the
+    // serialized primitive by value, so this does not allocate
+    MRFPrimitiveVisitor visitor;
+    auto encode = [&](const std::unique_ptr<Primitive> &prim, uint8_t *out) {
+        prim->accept(visitor);
+        encodePrimitive(visitor.getSerializedRadioPacket(), charge, out);
+    };
+
+    std::size_t packet_length = 0;
+    if (num_prims == MAX_ROBOTS_OVER_RADIO)
+    {
+        // All robots are present. Build a full-size packet with all the
+        // robots’ data in index order.
+        for (const auto &prim : prims)
+        {
+            encode(prim, &packet[packet_length]);
+            packet_length += ENCODED_PRIMITIVE_LENGTH;
+        }
+    }
+    else
+    {
+        // Only some robots are present. Build a reduced-size packet
+        // with robot indices prefixed.
+        for (const auto &prim : prims)
+        {
+            packet[packet_length++] = static_cast<uint8_t>(prim->getRobotId());
+            encode(prim, &packet[packet_length]);
+            packet_length += ENCODED_PRIMITIVE_LENGTH;
+        }
+    }
+
+    return packet_length;
+}
+
+MRF::SequencedDrivePacketEncoder::SequencedDrivePacketEncoder()
+    : next_sequence_numbers()
+{
+    next_sequence_numbers.fill(FIRST_DRIVE_SEQUENCE_NUMBER);
+}
+
+std::size_t MRF::SequencedDrivePacketEncoder::encode(
+    const std::vector<std::unique_ptr<Primitive>> &prims, bool charge,
+    SequencedDrivePacket &packet, DriveSequenceNumbers &sequence_numbers)
+{
+    std::size_t num_prims = prims.size();
+    if (num_prims == 0)
+    {
+        throw std::invalid_argument("No primitives in vector.");
+    }
+    if (num_prims > MAX_ROBOTS_OVER_RADIO)
+    {
+        throw std::invalid_argument("Too many primitives in vector.");
+    }
+
+    MRFPrimitiveVisitor visitor;
+    std::size_t packet_length = 0;
+    sequence_numbers.fill(std::nullopt);
+    for (const auto &prim : prims)
+    {
+        unsigned int robot_id = prim->getRobotId();
+        if (robot_id >= MAX_ROBOTS_OVER_RADIO)
+        {
+            throw std::invalid_argument("Robot id too large for radio.");
+        }
+        if (sequence_numbers[robot_id])
+        {
+            // The dongle only keeps one primitive for each robot, so the first one would
+            // be silently dropped
+            throw std::invalid_argument("More than one primitive for a robot.");
+        }
+        prim->accept(visitor);
+        packet[packet_length++] = static_cast<uint8_t>(robot_id);
+        packet[packet_length++] = next_sequence_numbers[robot_id];
+        encodePrimitive(visitor.getSerializedRadioPacket(), charge,
+                        &packet[packet_length]);
+        packet_length += ENCODED_PRIMITIVE_LENGTH;
+        sequence_numbers[robot_id] = next_sequence_numbers[robot_id];
+    }
+
+    // Only use up the sequence numbers once the whole packet has been encoded
+    for (std::size_t id = 0; id < MAX_ROBOTS_OVER_RADIO; id++)
+    {
+        if (sequence_numbers[id])
+        {
+            next_sequence_numbers[id] = static_cast<uint8_t>(
+                (*sequence_numbers[id] + 1) % NUM_DRIVE_SEQUENCE_NUMBERS);
+        }
+    }
+
+    return packet_length;
+}
+
+uint8_t MRF::encodeCameraPacket(const CameraPacketRobots &robots, const Point &ball,
+                                uint64_t timestamp, CameraPacket &packet)
+{
+    packet.fill(0);
+    uint8_t mask_vec = 0;  // Assume all robots don't have valid position at the start
+
+    // Initialize pointer to start at location of storing ball data. The first byte is
+    // for the mask vector
+    int8_t *rptr = &packet[1];
+
+    int16_t ballX = RadioUnits::encodeCameraLength(Units::Meters(ball.x()));
+    int16_t ballY = RadioUnits::encodeCameraLength(Units::Meters(ball.y()));
+
+    *rptr++ = static_cast<int8_t>(ballX);  // Add Ball x position
+    *rptr++ = static_cast<int8_t>(ballX >> 8);
+
+    *rptr++ = static_cast<int8_t>(ballY);  // Add Ball Y position
+    *rptr++ = static_cast<int8_t>(ballY >> 8);
+
+    // The robots are indexed by id, so they are already in ascending order by id.
+    // Assign robot ids to the mask vector and position/angle data to the camera packet
+    std::size_t num_robots = 0;
+    for (std::size_t id = 0; id < robots.size() && num_robots < CAMERA_PACKET_MAX_ROBOTS;
+         id++)
+    {
+        if (!robots[id])
+        {
+            continue;
+        }
+
+        const auto &[position, orientation] = *robots[id];
+        int16_t robotX = RadioUnits::encodeCameraLength(Units::Meters(position.x()));
+        int16_t robotY = RadioUnits::encodeCameraLength(Units::Meters(position.y()));
+        int16_t robotT =
+            RadioUnits::encodeCameraAngle(Units::Radians(orientation.toRadians()));
+
+        mask_vec |= static_cast<uint8_t>(0x01 << id);
+        *rptr++ = static_cast<int8_t>(robotX);
+        *rptr++ = static_cast<int8_t>(robotX >> 8);
+        *rptr++ = static_cast<int8_t>(robotY);
+        *rptr++ = static_cast<int8_t>(robotY >> 8);
+        *rptr++ = static_cast<int8_t>(robotT);
+        *rptr++ = static_cast<int8_t>(robotT >> 8);
+        num_robots++;
+    }
+
+    // Write out the timestamp
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        *rptr++ = static_cast<int8_t>(timestamp >> 8 * i);
+    }
+
+    // The mask vector is fully initialized by now. Assign it to the packet
+    packet[0] = static_cast<int8_t>(mask_vec);
+
+    return mask_vec;
+}
+
+MRF::CompactCameraPacketEncoder::CompactCameraPacketEncoder(unsigned int keyframe_interval)
+    : keyframe_interval(keyframe_interval),
+      packets_since_keyframe(0),
+      has_keyframe(false),
+      keyframe_id(0),
+      keyframe_mask(0),
+      keyframe_robots(),
+      keyframe_timestamp(0)
+{
+}
+
+std::size_t MRF::CompactCameraPacketEncoder::encode(const CameraPacketRobots &robots,
+                                                    const Point &ball,
+                                                    uint64_t timestamp,
+                                                    CompactCameraPacket &packet)
+{
+    // Convert the robots to the values that would be written in a keyframe, so deltas
+    // are exact differences between encoded values
+    std::array<EncodedRobot, MAX_ROBOTS_OVER_RADIO> encoded_robots = {};
+    uint8_t mask                                                     = 0;
+    for (std::size_t id = 0; id < robots.size(); id++)
+    {
+        if (robots[id])
+        {
+            const auto &[position, orientation] = *robots[id];
+            encoded_robots[id] = {
+                RadioUnits::encodeCameraLength(Units::Meters(position.x())),
+                RadioUnits::encodeCameraLength(Units::Meters(position.y())),
+                RadioUnits::encodeCameraAngle(Units::Radians(orientation.toRadians()))};
+            mask |= static_cast<uint8_t>(0x01 << id);
+        }
+    }
+
+    bool keyframe = !canEncodeDelta(encoded_robots, mask, timestamp);
+    if (keyframe)
+    {
+        // Only advance the keyframe id once we have sent a keyframe, so the first
+        // keyframe has id 0
+        if (has_keyframe)
+        {
+            keyframe_id = static_cast<uint8_t>((keyframe_id + 1) %
+                                               COMPACT_CAMERA_PACKET_NUM_KEYFRAME_IDS);
+        }
+        has_keyframe           = true;
+        keyframe_mask          = mask;
+        keyframe_robots        = encoded_robots;
+        keyframe_timestamp     = timestamp;
+        packets_since_keyframe = 0;
+    }
+    else
+    {
+        packets_since_keyframe++;
+    }
+
+    packet.fill(0);
+    int8_t *rptr = packet.data();
+
+    *rptr++ = static_cast<int8_t>((keyframe ? 0x80 : 0x00) | keyframe_id);
+    *rptr++ = static_cast<int8_t>(mask);
+
+    writeLittleEndian(RadioUnits::encodeCameraLength(Units::Meters(ball.x())), rptr);
+    writeLittleEndian(RadioUnits::encodeCameraLength(Units::Meters(ball.y())), rptr);
+
+    for (std::size_t id = 0; id < encoded_robots.size(); id++)
+    {
+        if (!(mask & (0x01 << id)))
+        {
+            continue;
+        }
+
+        const EncodedRobot &robot = encoded_robots[id];
+        if (keyframe)
+        {
+            writeLittleEndian(robot.x, rptr);
+            writeLittleEndian(robot.y, rptr);
+            writeLittleEndian(robot.angle, rptr);
+        }
+        else
+        {
+            const EncodedRobot &keyframe_robot = keyframe_robots[id];
+            *rptr++ = static_cast<int8_t>(robot.x - keyframe_robot.x);
+            *rptr++ = static_cast<int8_t>(robot.y - keyframe_robot.y);
+            *rptr++ = static_cast<int8_t>(robot.angle - keyframe_robot.angle);
+        }
+    }
+
+    if (keyframe)
+    {
+        writeLittleEndian(timestamp, rptr);
+    }
+    else
+    {
+        writeLittleEndian(static_cast<uint16_t>(timestamp - keyframe_timestamp), rptr);
+    }
+
+    return static_cast<std::size_t>(rptr - packet.data());
+}
+
+bool MRF::CompactCameraPacketEncoder::canEncodeDelta(
+    const std::array<EncodedRobot, MAX_ROBOTS_OVER_RADIO> &robots, uint8_t mask,
+    uint64_t timestamp) const
+{
+    if (!has_keyframe || packets_since_keyframe + 1 >= keyframe_interval ||
+        mask != keyframe_mask || timestamp < keyframe_timestamp ||
+        timestamp - keyframe_timestamp > std::numeric_limits<uint16_t>::max())
+    {
+        return false;
+    }
+
+    for (std::size_t id = 0; id < robots.size(); id++)
+    {
+        if ((mask & (0x01 << id)) &&
+            !(fitsInInt8(robots[id].x - keyframe_robots[id].x) &&
+              fitsInInt8(robots[id].y - keyframe_robots[id].y) &&
+              fitsInInt8(robots[id].angle - keyframe_robots[id].angle)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,294 @@
+/**
+ * This file contains functions that encode the packets sent to the robots over radio.
+ *
+ * All packets are encoded into fixed-size buffers, so no memory is allocated while
+ * encoding.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "ai/primitive/primitive.h"
+#include "backend/output/radio/visitor/mrf_primitive_visitor.h"
+#include "geom/angle.h"
+#include "geom/point.h"
+#include "shared/constants.h"
+
+namespace MRF
+{
+    /**
+     * The number of bytes used to encode a single primitive.
+     */
+    constexpr std::size_t ENCODED_PRIMITIVE_LENGTH = 8;
+
+    /**
+     * The maximum length of a drive packet, which is the length of a packet containing
+     * a primitive for every robot.
+     */
+    constexpr std::size_t DRIVE_PACKET_MAX_LENGTH =
+        MAX_ROBOTS_OVER_RADIO * ENCODED_PRIMITIVE_LENGTH;
+
+    /**
+     * The number of bytes used for each robot in a sequenced drive packet, which are
+     * the robot id, the sequence number and the encoded primitive.
+     */
+    constexpr std::size_t SEQUENCED_DRIVE_BYTES_PER_ROBOT = ENCODED_PRIMITIVE_LENGTH + 2;
+
+    /**
+     * The maximum length of a sequenced drive packet, which is the length of a packet
+     * containing a primitive for every robot.
+     */
+    constexpr std::size_t SEQUENCED_DRIVE_PACKET_MAX_LENGTH =
+        MAX_ROBOTS_OVER_RADIO * SEQUENCED_DRIVE_BYTES_PER_ROBOT;
+
+    /**
+     * The number of distinct drive sequence numbers. Sequence numbers are 7 bits, since
+     * the dongle sends them to the robots in the same byte as the feedback request
+     * flag, so they wrap around after this many primitives sent to a robot.
+     */
+    constexpr unsigned int NUM_DRIVE_SEQUENCE_NUMBERS = 128;
+
+    /**
+     * The sequence number of the first primitive sent to each robot. The dongle sends
+     * every robot serial 0 until it is given data for that robot, so a robot already
+     * holds 0 when its first primitive arrives and would drop a first primitive numbered
+     * 0 as one it had already applied.
+     */
+    constexpr uint8_t FIRST_DRIVE_SEQUENCE_NUMBER = 1;
+
+    /**
+     * The length of a camera packet.
+     */
+    constexpr std::size_t CAMERA_PACKET_LENGTH = 55;
+
+    /**
+     * The maximum number of robots that fit in a camera packet, after the 1 byte robot
+     * mask, 4 bytes of ball position and 8 bytes of timestamp. Each robot takes 6 bytes.
+     */
+    constexpr std::size_t CAMERA_PACKET_MAX_ROBOTS = (CAMERA_PACKET_LENGTH - 13) / 6;
+
+    /**
+     * The length of the USB transfer holding a compact camera packet. The dongle tells
+     * compact camera packets apart from regular camera packets by this length, and only
+     * sends the bytes actually used by the packet over radio.
+     */
+    constexpr std::size_t COMPACT_CAMERA_PACKET_LENGTH = 64;
+
+    /**
+     * The number of distinct keyframe ids in compact camera packets. Keyframe ids are 7
+     * bits, so they wrap around after this many keyframes.
+     */
+    constexpr unsigned int COMPACT_CAMERA_PACKET_NUM_KEYFRAME_IDS = 128;
+
+    typedef std::array<uint8_t, DRIVE_PACKET_MAX_LENGTH> DrivePacket;
+    typedef std::array<uint8_t, SEQUENCED_DRIVE_PACKET_MAX_LENGTH> SequencedDrivePacket;
+    typedef std::array<int8_t, CAMERA_PACKET_LENGTH> CameraPacket;
+    typedef std::array<int8_t, COMPACT_CAMERA_PACKET_LENGTH> CompactCameraPacket;
+
+    /**
+     * The position and orientation of each robot to send in a camera packet, indexed by
+     * robot id. Robots that were not detected are std::nullopt.
+     */
+    typedef std::array<std::optional<std::pair<Point, Angle>>, MAX_ROBOTS_OVER_RADIO>
+        CameraPacketRobots;
+
+    /**
+     * Encodes a single primitive.
+     *
+     * @param prim The serialized primitive to encode
+     * @param charge Whether the robot should charge its capacitors. If false, the robot
+     * will discharge them
+     * @param out The buffer to write the encoded primitive to. Exactly
+     * ENCODED_PRIMITIVE_LENGTH bytes are written
+     *
+     * @throws std::invalid_argument if the extra bits of the primitive do not fit in 7
+     * bits
+     */
+    void encodePrimitive(const RadioPrimitive &prim, bool charge, uint8_t *out);
+
+    /**
+     * Encodes a drive packet containing the given primitives.
+     *
+     * If there is a primitive for every robot, the primitives are written in order.
+     * Otherwise, each primitive is prefixed by the id of the robot it is for.
+     *
+     * @param prims The primitives to encode. There must be at least one primitive and no
+     * more than MAX_ROBOTS_OVER_RADIO primitives
+     * @param charge Whether the robots should charge their capacitors
+     * @param packet The packet to write to
+     *
+     * @throws std::invalid_argument if there are no primitives or too many primitives
+     *
+     * @return The number of bytes of the packet that were written
+     */
+    std::size_t encodeDrivePacket(const std::vector<std::unique_ptr<Primitive>> &prims,
+                                  bool charge, DrivePacket &packet);
+
+    /**
+     * The drive sequence number sent to each robot in a sequenced drive packet, indexed
+     * by robot id. Robots that were not in the packet are std::nullopt.
+     */
+    typedef std::array<std::optional<uint8_t>, MAX_ROBOTS_OVER_RADIO>
+        DriveSequenceNumbers;
+
+    /**
+     * Encodes drive packets in the sequenced drive packet format, which tags each
+     * robot's primitive with a sequence number.
+     *
+     * Each robot's primitive is prefixed by the id of the robot it is for and its
+     * sequence number. Every robot has its own sequence number, which is incremented
+     * for each primitive sent to it. The dongle passes the sequence numbers on to the
+     * robots, which report the sequence number of the last primitive they applied in
+     * their feedback, so the host can tell which primitives each robot has applied.
+     */
+    class SequencedDrivePacketEncoder
+    {
+       public:
+        /**
+         * Creates a new SequencedDrivePacketEncoder. The first primitive sent to each
+         * robot has sequence number FIRST_DRIVE_SEQUENCE_NUMBER.
+         */
+        explicit SequencedDrivePacketEncoder();
+
+        /**
+         * Encodes a sequenced drive packet containing the given primitives, and advances
+         * the sequence numbers of the robots in it.
+         *
+         * @param prims The primitives to encode. There must be at least one primitive,
+         * no more than MAX_ROBOTS_OVER_RADIO primitives, and no more than one primitive
+         * for each robot
+         * @param charge Whether the robots should charge their capacitors
+         * @param packet The packet to write to
+         * @param sequence_numbers Set to the sequence number of each robot in the packet
+         *
+         * @throws std::invalid_argument if there are no primitives, too many primitives,
+         * two primitives for the same robot, or a primitive can not be encoded, in which
+         * case no sequence numbers are used
+         *
+         * @return The number of bytes of the packet that were written
+         */
+        std::size_t encode(const std::vector<std::unique_ptr<Primitive>> &prims,
+                           bool charge, SequencedDrivePacket &packet,
+                           DriveSequenceNumbers &sequence_numbers);
+
+       private:
+        std::array<uint8_t, MAX_ROBOTS_OVER_RADIO> next_sequence_numbers;
+    };
+
+    /**
+     * Encodes a camera packet containing the vision data of the given robots and the
+     * ball.
+     *
+     * Robots are written in order of increasing id. If more than
+     * CAMERA_PACKET_MAX_ROBOTS robots are given, only the robots with the lowest ids are
+     * written.
+     *
+     * @param robots The position and orientation of each robot, indexed by robot id
+     * @param ball The position of the ball, in metres
+     * @param timestamp The timestamp of the vision data
+     * @param packet The packet to write to
+     *
+     * @return The mask of the robots that were written to the packet, where bit i is set
+     * if the robot with id i was written
+     */
+    uint8_t encodeCameraPacket(const CameraPacketRobots &robots, const Point &ball,
+                               uint64_t timestamp, CameraPacket &packet);
+
+    /**
+     * Encodes camera packets in the compact camera packet format, which takes less
+     * radio airtime than the format written by encodeCameraPacket.
+     *
+     * The compact format is a stream of keyframes and deltas. The first byte of every
+     * packet is a header, where the top bit is set for keyframes and the lower 7 bits
+     * are the id of the most recent keyframe. The second byte is the mask of the robots
+     * in the packet, followed by the ball position as two int16s.
+     *
+     * Keyframes then hold the x, y and orientation of each robot as int16s, followed by
+     * the full 8 byte timestamp. Deltas hold the difference between each robot's x, y
+     * and orientation and its values in the keyframe as int8s, followed by the
+     * difference between the timestamp and the keyframe timestamp as a uint16. All
+     * values are little-endian.
+     *
+     * Since deltas are always relative to a keyframe rather than to the previous
+     * packet, a robot that misses a delta does not lose anything, and a robot that
+     * misses a keyframe ignores deltas until the next keyframe. Keyframes are sent
+     * periodically to bound how long that takes.
+     */
+    class CompactCameraPacketEncoder
+    {
+       public:
+        /**
+         * By default, at least one of every this many packets is a keyframe.
+         */
+        static constexpr unsigned int DEFAULT_KEYFRAME_INTERVAL = 10;
+
+        /**
+         * Creates a new CompactCameraPacketEncoder. The first packet it encodes is
+         * always a keyframe.
+         *
+         * @param keyframe_interval At least one of every keyframe_interval packets is a
+         * keyframe. Keyframes are also sent whenever a delta can not represent the new
+         * values
+         */
+        explicit CompactCameraPacketEncoder(
+            unsigned int keyframe_interval = DEFAULT_KEYFRAME_INTERVAL);
+
+        /**
+         * Encodes a compact camera packet containing the vision data of the given robots
+         * and the ball. The packet is a keyframe if a delta can not represent the given
+         * values, or if it has been keyframe_interval packets since the last keyframe.
+         *
+         * @param robots The position and orientation of each robot, indexed by robot id
+         * @param ball The position of the ball, in metres
+         * @param timestamp The timestamp of the vision data
+         * @param packet The packet to write to. The bytes after the encoded packet are
+         * zeroed
+         *
+         * @return The number of bytes of the packet that were written
+         */
+        std::size_t encode(const CameraPacketRobots &robots, const Point &ball,
+                           uint64_t timestamp, CompactCameraPacket &packet);
+
+       private:
+        /**
+         * The vision data of a robot as it is encoded in a keyframe
+         */
+        struct EncodedRobot
+        {
+            int16_t x;
+            int16_t y;
+            int16_t angle;
+        };
+
+        /**
+         * Returns whether a delta can represent the given robots and timestamp relative
+         * to the last keyframe
+         *
+         * @param robots The robots, as they would be encoded in a keyframe
+         * @param mask The mask of the given robots
+         * @param timestamp The timestamp of the vision data
+         *
+         * @return true if a delta can represent the given values, and false if a
+         * keyframe must be sent instead
+         */
+        bool canEncodeDelta(
+            const std::array<EncodedRobot, MAX_ROBOTS_OVER_RADIO> &robots, uint8_t mask,
+            uint64_t timestamp) const;
+
+        unsigned int keyframe_interval;
+        unsigned int packets_since_keyframe;
+
+        // Whether a keyframe has been encoded yet
+        bool has_keyframe;
+        uint8_t keyframe_id;
+        uint8_t keyframe_mask;
+        std::array<EncodedRobot, MAX_ROBOTS_OVER_RADIO> keyframe_robots;
+        uint64_t keyframe_timestamp;
+    };
+}  // namespace MRF
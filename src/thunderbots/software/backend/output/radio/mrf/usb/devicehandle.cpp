@@ -52,7 +52,6 @@ USB::DeviceHandle::DeviceHandle(Context &context, unsigned int vendor_id,
 
             check_fn("libusb_open", libusb_open(device.device, &handle), 0);
             init_descriptors();
-            context.open_devices.push_back(this);
             return;
         }
     }
@@ -3,6 +3,7 @@
 #include <poll.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cerrno>
 #include <cstdlib>
@@ -20,7 +21,7 @@
 namespace
 {
     std::thread libusb_event_thread;
-    bool running;
+    std::atomic<bool> running;
 }  // namespace
 
 USB::Context::Context()
@@ -43,13 +44,9 @@ USB::Context::~Context()
     // Terminate event thread
     running = false;
 
-    // Close all devices
-    for (auto &dev : open_devices)
-    {
-        dev->~DeviceHandle();
-    }
-
-    // This wakes up libusb_handle_events, now let the thread join
+    // This wakes up libusb_handle_events, now let the thread join. All the devices
+    // have already been closed, so there may be no other events to wake it up
+    libusb_interrupt_event_handler(context);
     libusb_event_thread.join();
 
     // Cleanup libusb
@@ -45,9 +45,6 @@ namespace USB
          */
         ~Context();
 
-       protected:
-        std::vector<USB::DeviceHandle *> open_devices;
-
        private:
         friend class DeviceList;
         friend class DeviceHandle;
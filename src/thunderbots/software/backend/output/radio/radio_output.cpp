@@ -5,9 +5,10 @@
 #include "util/logger/init.h"
 
 RadioOutput::RadioOutput(unsigned int config,
-                         std::function<void(RobotStatus)> received_robot_status_callback)
+                         std::function<void(RobotStatus)> received_robot_status_callback,
+                         bool compact_camera_packets)
     : annunciator(Annunciator(received_robot_status_callback)),
-      dongle(MRFDongle(config, annunciator))
+      dongle(MRFDongle(config, annunciator, compact_camera_packets))
 {
 }
 
@@ -20,18 +21,33 @@ void RadioOutput::sendPrimitives(
 void RadioOutput::sendVisionPacket(
     std::vector<std::tuple<uint8_t, Point, Angle>> friendly_robots, Ball ball)
 {
-    uint64_t timestamp = static_cast<uint64_t>(ball.lastUpdateTimestamp().getSeconds());
-    dongle.send_camera_packet(friendly_robots, ball.position() * MILLIMETERS_PER_METER,
-                              timestamp);
+    MRF::CameraPacketRobots robots;
+    for (const auto &[id, position, orientation] : friendly_robots)
+    {
+        if (id < robots.size())
+        {
+            robots[id] = std::make_pair(position, orientation);
+        }
+    }
+    sendVisionPacket(robots, ball);
 }
 
 void RadioOutput::sendVisionPacket(const Team &friendly_team, Ball ball)
 {
-    std::vector<std::tuple<uint8_t, Point, Angle>> robot_tuples;
+    MRF::CameraPacketRobots robots;
     for (const Robot &robot : friendly_team.getAllRobots())
     {
-        robot_tuples.emplace_back(std::make_tuple<uint8_t, Point, Angle>(
-            robot.id(), robot.position(), robot.orientation()));
+        if (robot.id() < robots.size())
+        {
+            robots[robot.id()] = std::make_pair(robot.position(), robot.orientation());
+        }
     }
-    sendVisionPacket(robot_tuples, ball);
+    sendVisionPacket(robots, ball);
+}
+
+void RadioOutput::sendVisionPacket(const MRF::CameraPacketRobots &friendly_robots,
+                                   Ball ball)
+{
+    uint64_t timestamp = static_cast<uint64_t>(ball.lastUpdateTimestamp().getSeconds());
+    dongle.send_camera_packet(friendly_robots, ball.position(), timestamp);
 }
@@ -19,9 +19,12 @@ class RadioOutput
      * @param config MRF configuration to start dongle in
      * @param received_robot_status_callback The callback function to call with new
      *                                       robot status messages
+     * @param compact_camera_packets Whether to send camera packets in the compact
+     *                               keyframe and delta format
      */
     explicit RadioOutput(unsigned int config,
-                         std::function<void(RobotStatus)> received_robot_status_callback);
+                         std::function<void(RobotStatus)> received_robot_status_callback,
+                         bool compact_camera_packets);
 
     /**
      * Sends the given primitives to the backend to control the robots
@@ -48,6 +51,16 @@ class RadioOutput
      */
     void sendVisionPacket(const Team& friendly_team, Ball ball);
 
+    /**
+     * Sends a camera packet with the detected robots and ball. Robots with ids that do
+     * not fit in a camera packet are not sent.
+     *
+     * @param friendly_robots the location and orientation of each robot, indexed by
+     *                        robot id
+     * @param ball
+     */
+    void sendVisionPacket(const MRF::CameraPacketRobots& friendly_robots, Ball ball);
+
    private:
     MRFDongle dongle;
 
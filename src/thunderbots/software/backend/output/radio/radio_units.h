@@ -0,0 +1,135 @@
+/**
+ * This file contains the conversions from physical quantities to the fixed point units
+ * they are sent to the robots in over radio. The units themselves are shared with
+ * firmware, which decodes them, in shared/radio_units.h.
+ *
+ * Every conversion is constexpr and its scale is resolved at compile time, so
+ * converting a value costs a single multiply.
+ */
+#pragma once
+
+#include <cstdint>
+#include <ratio>
+
+#include "shared/radio_units.h"
+#include "util/units.h"
+
+namespace RadioUnits
+{
+    /**
+     * The units primitive parameters are sent in
+     */
+    typedef Units::Quantity<Units::Dimensions::Length,
+                            std::ratio<1, RADIO_PRIMITIVE_LENGTH_UNITS_PER_METER>>
+        PrimitiveLength;
+    typedef Units::Quantity<Units::Dimensions::Speed,
+                            std::ratio<1, RADIO_PRIMITIVE_LENGTH_UNITS_PER_METER>>
+        PrimitiveSpeed;
+    typedef Units::Quantity<Units::Dimensions::Angle,
+                            std::ratio<1, RADIO_PRIMITIVE_ANGLE_UNITS_PER_RADIAN>>
+        PrimitiveAngle;
+    typedef Units::Quantity<Units::Dimensions::AngularVelocity,
+                            std::ratio<1, RADIO_PRIMITIVE_ANGLE_UNITS_PER_RADIAN>>
+        PrimitiveAngularVelocity;
+    typedef Units::Quantity<Units::Dimensions::RotationalSpeed,
+                            std::ratio<RADIO_DRIBBLER_RPM_PER_UNIT>>
+        DribblerSpeed;
+
+    /**
+     * The units camera packets are sent in
+     */
+    typedef Units::Quantity<Units::Dimensions::Length,
+                            std::ratio<1, RADIO_CAMERA_LENGTH_UNITS_PER_METER>>
+        CameraLength;
+    typedef Units::Quantity<Units::Dimensions::Angle,
+                            std::ratio<1, RADIO_CAMERA_ANGLE_UNITS_PER_RADIAN>>
+        CameraAngle;
+
+    /**
+     * Converts a length to the unit of a primitive parameter. The parameter is
+     * quantized when the primitive is encoded, since large values lose precision
+     *
+     * @param length the length
+     *
+     * @return the primitive parameter
+     */
+    constexpr double encodePrimitiveLength(Units::Meters length)
+    {
+        return PrimitiveLength(length).value();
+    }
+
+    /**
+     * Converts a speed to the unit of a primitive parameter
+     *
+     * @param speed the speed
+     *
+     * @return the primitive parameter
+     */
+    constexpr double encodePrimitiveSpeed(Units::MetersPerSecond speed)
+    {
+        return PrimitiveSpeed(speed).value();
+    }
+
+    /**
+     * Converts an angle to the unit of a primitive parameter
+     *
+     * @param angle the angle
+     *
+     * @return the primitive parameter
+     */
+    constexpr double encodePrimitiveAngle(Units::Radians angle)
+    {
+        return PrimitiveAngle(angle).value();
+    }
+
+    /**
+     * Converts an angular velocity to the unit of a primitive parameter
+     *
+     * @param angular_velocity the angular velocity
+     *
+     * @return the primitive parameter
+     */
+    constexpr double encodePrimitiveAngularVelocity(
+        Units::RadiansPerSecond angular_velocity)
+    {
+        return PrimitiveAngularVelocity(angular_velocity).value();
+    }
+
+    /**
+     * Converts a dribbler speed to the value sent in the extra bits of a primitive,
+     * rounding down
+     *
+     * @param speed the dribbler speed
+     *
+     * @return the extra bits
+     */
+    constexpr uint8_t encodeDribblerSpeed(Units::RevolutionsPerMinute speed)
+    {
+        return static_cast<uint8_t>(DribblerSpeed(speed).value());
+    }
+
+    /**
+     * Converts a position coordinate to the unit of a camera packet, rounding towards
+     * zero
+     *
+     * @param length the coordinate
+     *
+     * @return the coordinate in the camera packet
+     */
+    constexpr int16_t encodeCameraLength(Units::Meters length)
+    {
+        return static_cast<int16_t>(CameraLength(length).value());
+    }
+
+    /**
+     * Converts an orientation to the unit of a camera packet, rounding towards zero
+     *
+     * @param angle the orientation
+     *
+     * @return the orientation in the camera packet
+     */
+    constexpr int16_t encodeCameraAngle(Units::Radians angle)
+    {
+        return static_cast<int16_t>(CameraAngle(angle).value());
+    }
+}  // namespace RadioUnits
@@ -1,6 +1,9 @@
 #include "backend/output/radio/visitor/mrf_primitive_visitor.h"
 
-#include "shared/constants.h"
+#include "backend/output/radio/radio_units.h"
+
+using namespace RadioUnits;
+using namespace Units;
 
 RadioPrimitive MRFPrimitiveVisitor::getSerializedRadioPacket()
 {
@@ -31,10 +34,10 @@ void MRFPrimitiveVisitor::visit(const ChipPrimitive &chip_primitive)
     radio_prim              = RadioPrimitive();
     radio_prim->prim_type   = FirmwarePrimitiveType::SHOOT;
     radio_prim->param_array = {
-        chip_primitive.getChipOrigin().x() * MILLIMETERS_PER_METER,
-        chip_primitive.getChipOrigin().y() * MILLIMETERS_PER_METER,
-        chip_primitive.getChipDirection().toRadians() * CENTIRADIANS_PER_RADIAN,
-        chip_primitive.getChipDistance() * MILLIMETERS_PER_METER};
+        encodePrimitiveLength(Meters(chip_primitive.getChipOrigin().x())),
+        encodePrimitiveLength(Meters(chip_primitive.getChipOrigin().y())),
+        encodePrimitiveAngle(Radians(chip_primitive.getChipDirection().toRadians())),
+        encodePrimitiveLength(Meters(chip_primitive.getChipDistance()))};
     radio_prim->extra_bits = static_cast<uint8_t>(2 | 1);
 }
 
@@ -43,11 +46,13 @@ void MRFPrimitiveVisitor::visit(const DirectVelocityPrimitive &direct_velocity_p
     radio_prim              = RadioPrimitive();
     radio_prim->prim_type   = FirmwarePrimitiveType::DIRECT_VELOCITY;
     radio_prim->param_array = {
-        direct_velocity_primitive.getXVelocity() * MILLIMETERS_PER_METER,
-        direct_velocity_primitive.getYVelocity() * MILLIMETERS_PER_METER,
-        direct_velocity_primitive.getAngularVelocity() * CENTIRADIANS_PER_RADIAN, 0};
-    radio_prim->extra_bits = direct_velocity_primitive.getDribblerRpm() *
-                             DRIBBLER_RPM_TO_RADIO_CONVERSION_FACTOR;
+        encodePrimitiveSpeed(MetersPerSecond(direct_velocity_primitive.getXVelocity())),
+        encodePrimitiveSpeed(MetersPerSecond(direct_velocity_primitive.getYVelocity())),
+        encodePrimitiveAngularVelocity(
+            RadiansPerSecond(direct_velocity_primitive.getAngularVelocity())),
+        0};
+    radio_prim->extra_bits = encodeDribblerSpeed(
+        RevolutionsPerMinute(direct_velocity_primitive.getDribblerRpm()));
 }
 
 void MRFPrimitiveVisitor::visit(const DirectWheelsPrimitive &direct_wheels_primitive)
@@ -59,8 +64,8 @@ void MRFPrimitiveVisitor::visit(const DirectWheelsPrimitive &direct_wheels_primi
         static_cast<double>(direct_wheels_primitive.getWheel1Power()),
         static_cast<double>(direct_wheels_primitive.getWheel2Power()),
         static_cast<double>(direct_wheels_primitive.getWheel3Power())};
-    radio_prim->extra_bits = direct_wheels_primitive.getDribblerRPM() *
-                             DRIBBLER_RPM_TO_RADIO_CONVERSION_FACTOR;
+    radio_prim->extra_bits = encodeDribblerSpeed(
+        RevolutionsPerMinute(direct_wheels_primitive.getDribblerRPM()));
 }
 
 void MRFPrimitiveVisitor::visit(const DribblePrimitive &dribble_primitive)
@@ -68,9 +73,9 @@ void MRFPrimitiveVisitor::visit(const DribblePrimitive &dribble_primitive)
     radio_prim              = RadioPrimitive();
     radio_prim->prim_type   = FirmwarePrimitiveType::DRIBBLE;
     radio_prim->param_array = {
-        dribble_primitive.getDestination().x() * MILLIMETERS_PER_METER,
-        dribble_primitive.getDestination().y() * MILLIMETERS_PER_METER,
-        dribble_primitive.getFinalAngle().toRadians() * CENTIRADIANS_PER_RADIAN,
+        encodePrimitiveLength(Meters(dribble_primitive.getDestination().x())),
+        encodePrimitiveLength(Meters(dribble_primitive.getDestination().y())),
+        encodePrimitiveAngle(Radians(dribble_primitive.getFinalAngle().toRadians())),
         // For this primitive, we don't divide the RPM
         dribble_primitive.getRpm()};
     radio_prim->extra_bits = dribble_primitive.isSmallKickAllowed();
@@ -81,10 +86,10 @@ void MRFPrimitiveVisitor::visit(const KickPrimitive &kick_primitive)
     radio_prim              = RadioPrimitive();
     radio_prim->prim_type   = FirmwarePrimitiveType::SHOOT;
     radio_prim->param_array = {
-        kick_primitive.getKickOrigin().x() * MILLIMETERS_PER_METER,
-        kick_primitive.getKickOrigin().y() * MILLIMETERS_PER_METER,
-        kick_primitive.getKickDirection().toRadians() * CENTIRADIANS_PER_RADIAN,
-        kick_primitive.getKickSpeed() * MILLIMETERS_PER_METER};
+        encodePrimitiveLength(Meters(kick_primitive.getKickOrigin().x())),
+        encodePrimitiveLength(Meters(kick_primitive.getKickOrigin().y())),
+        encodePrimitiveAngle(Radians(kick_primitive.getKickDirection().toRadians())),
+        encodePrimitiveSpeed(MetersPerSecond(kick_primitive.getKickSpeed()))};
     radio_prim->extra_bits = static_cast<uint8_t>(2 | 0);
 }
 
@@ -93,10 +98,10 @@ void MRFPrimitiveVisitor::visit(const MovePrimitive &move_primitive)
     radio_prim              = RadioPrimitive();
     radio_prim->prim_type   = FirmwarePrimitiveType::MOVE;
     radio_prim->param_array = {
-        move_primitive.getDestination().x() * MILLIMETERS_PER_METER,
-        move_primitive.getDestination().y() * MILLIMETERS_PER_METER,
-        move_primitive.getFinalAngle().toRadians() * CENTIRADIANS_PER_RADIAN,
-        move_primitive.getFinalSpeed() * MILLIMETERS_PER_METER};
+        encodePrimitiveLength(Meters(move_primitive.getDestination().x())),
+        encodePrimitiveLength(Meters(move_primitive.getDestination().y())),
+        encodePrimitiveAngle(Radians(move_primitive.getFinalAngle().toRadians())),
+        encodePrimitiveSpeed(MetersPerSecond(move_primitive.getFinalSpeed()))};
     radio_prim->slow       = move_primitive.isSlowEnabled();
     radio_prim->extra_bits = 0;
     radio_prim->extra_bits |= (move_primitive.getAutoKickType() == AUTOKICK) * 0x01;
@@ -109,10 +114,11 @@ void MRFPrimitiveVisitor::visit(const MoveSpinPrimitive &movespin_primitive)
     radio_prim              = RadioPrimitive();
     radio_prim->prim_type   = FirmwarePrimitiveType::SPIN;
     radio_prim->param_array = {
-        movespin_primitive.getDestination().x() * MILLIMETERS_PER_METER,
-        movespin_primitive.getDestination().y() * MILLIMETERS_PER_METER,
-        movespin_primitive.getAngularVelocity().toRadians() * CENTIRADIANS_PER_RADIAN,
-        movespin_primitive.getFinalSpeed() * MILLIMETERS_PER_METER};
+        encodePrimitiveLength(Meters(movespin_primitive.getDestination().x())),
+        encodePrimitiveLength(Meters(movespin_primitive.getDestination().y())),
+        encodePrimitiveAngularVelocity(
+            RadiansPerSecond(movespin_primitive.getAngularVelocity().toRadians())),
+        encodePrimitiveSpeed(MetersPerSecond(movespin_primitive.getFinalSpeed()))};
     radio_prim->extra_bits = 0;
 }
 
@@ -121,10 +127,11 @@ void MRFPrimitiveVisitor::visit(const PivotPrimitive &pivot_primitive)
     radio_prim              = RadioPrimitive();
     radio_prim->prim_type   = FirmwarePrimitiveType::PIVOT;
     radio_prim->param_array = {
-        pivot_primitive.getPivotPoint().x() * MILLIMETERS_PER_METER,
-        pivot_primitive.getPivotPoint().y() * MILLIMETERS_PER_METER,
-        pivot_primitive.getFinalAngle().toRadians() * CENTIRADIANS_PER_RADIAN,
-        pivot_primitive.getPivotSpeed().toRadians() * CENTIRADIANS_PER_RADIAN};
+        encodePrimitiveLength(Meters(pivot_primitive.getPivotPoint().x())),
+        encodePrimitiveLength(Meters(pivot_primitive.getPivotPoint().y())),
+        encodePrimitiveAngle(Radians(pivot_primitive.getFinalAngle().toRadians())),
+        encodePrimitiveAngularVelocity(
+            RadiansPerSecond(pivot_primitive.getPivotSpeed().toRadians()))};
     radio_prim->extra_bits = pivot_primitive.isDribblerEnabled();
 }
 
@@ -11,9 +11,11 @@ RadioBackend::RadioBackend()
                     Util::Constants::SSL_GAMECONTROLLER_MULTICAST_ADDRESS,
                     Util::Constants::SSL_GAMECONTROLLER_MULTICAST_PORT,
                     boost::bind(&RadioBackend::receiveWorld, this, _1)),
-      radio_output(DEFAULT_RADIO_CONFIG, [this](RobotStatus status) {
-          Subject<RobotStatus>::sendValueToObservers(status);
-      })
+      radio_output(DEFAULT_RADIO_CONFIG,
+                   [this](RobotStatus status) {
+                       Subject<RobotStatus>::sendValueToObservers(status);
+                   },
+                   USE_COMPACT_CAMERA_PACKETS)
 {
 }
 
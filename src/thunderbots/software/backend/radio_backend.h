@@ -14,6 +14,10 @@ class RadioBackend : public Backend
    private:
     static const int DEFAULT_RADIO_CONFIG = 0;
 
+    // Whether to send vision to the robots as compact camera packets. Only enable this
+    // once all the robots are running firmware that can decode them
+    static const bool USE_COMPACT_CAMERA_PACKETS = false;
+
     void onValueReceived(ConstPrimitiveVectorPtr primitives) override;
 
     /**
@@ -83,4 +83,38 @@ struct RobotStatus
 
     // The FPGA bitstream build ID.
     uint32_t fpga_build_id;
+
+    // Whether or not the CPU profile information is valid.
+    bool cpu_profile_valid;
+
+    // The mean and maximum time the robot spent in its 200 Hz normal tick over the last
+    // second, in microseconds.
+    double normal_tick_mean_us;
+    double normal_tick_max_us;
+
+    // The mean and maximum time the robot spent in its 8 kHz fast tick over the last
+    // second, in microseconds.
+    double fast_tick_mean_us;
+    double fast_tick_max_us;
+
+    // The module that spent the most time in the normal tick over the last second, and
+    // its mean time in microseconds.
+    std::string busiest_module;
+    double busiest_module_mean_us;
+
+    // Whether or not the robot has reported the last drive primitive it applied.
+    bool drive_ack_valid;
+
+    // The sequence number of the last drive primitive the robot applied.
+    uint8_t last_applied_drive_sequence_number;
+
+    // The number of drive primitives sent to the robot after the last one it applied.
+    uint32_t drive_primitives_behind;
+
+    // Whether or not the drive latency is valid.
+    bool drive_latency_valid;
+
+    // The time from sending the last drive primitive the robot applied to the robot
+    // applying it, in milliseconds.
+    double drive_latency_ms;
 };
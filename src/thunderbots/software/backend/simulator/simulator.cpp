@@ -0,0 +1,434 @@
+#include "backend/simulator/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "backend/output/grsim/grsim_command_primitive_visitor.h"
+#include "shared/constants.h"
+#include "util/parameter/dynamic_parameters.h"
+
+Simulator::Simulator(const Field& field, unsigned int seed,
+                     double vision_noise_stddev_meters)
+    : field(field),
+      random_number_generator(seed),
+      vision_noise_stddev_meters(vision_noise_stddev_meters),
+      motion_controller(ROBOT_MAX_SPEED_METERS_PER_SECOND,
+                        ROBOT_MAX_ANG_SPEED_RAD_PER_SECOND,
+                        ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED,
+                        ROBOT_MAX_ANG_ACCELERATION_RAD_PER_SECOND_SQUARED),
+      friendly_robots(),
+      enemy_robots(),
+      friendly_primitives(),
+      enemy_primitives(),
+      ball({field.centerPoint(), Vector(), 0.0, 0.0}),
+      refbox_game_state(RefboxGameState::HALT),
+      num_physics_steps(0),
+      unsimulated_time_seconds(0.0),
+      world(field, Ball(field.centerPoint(), Vector(), Timestamp::fromSeconds(0)),
+            Team(Duration::fromMilliseconds(
+                Util::DynamicParameters::robot_expiry_buffer_milliseconds.value())),
+            Team(Duration::fromMilliseconds(
+                Util::DynamicParameters::robot_expiry_buffer_milliseconds.value())))
+{
+}
+
+void Simulator::addFriendlyRobot(unsigned int id, const Point& position,
+                                 const Angle& orientation, const Vector& velocity)
+{
+    addRobot(friendly_robots, id, position, orientation, velocity);
+}
+
+void Simulator::addEnemyRobot(unsigned int id, const Point& position,
+                              const Angle& orientation, const Vector& velocity)
+{
+    addRobot(enemy_robots, id, position, orientation, velocity);
+}
+
+void Simulator::addRobot(std::vector<SimulatedRobot>& robots, unsigned int id,
+                         const Point& position, const Angle& orientation,
+                         const Vector& velocity)
+{
+    robots.erase(
+        std::remove_if(robots.begin(), robots.end(),
+                       [id](const SimulatedRobot& robot) { return robot.id == id; }),
+        robots.end());
+    robots.push_back({id, position, velocity, orientation, AngularVelocity::zero(),
+                      nullptr, 0.0, false, false});
+}
+
+void Simulator::setBallState(const Point& position, const Vector& velocity)
+{
+    ball = {position, velocity, 0.0, 0.0};
+}
+
+void Simulator::setRefboxGameState(const RefboxGameState& game_state)
+{
+    refbox_game_state = game_state;
+}
+
+void Simulator::setFriendlyPrimitives(ConstPrimitiveVectorPtr primitives)
+{
+    friendly_primitives = std::move(primitives);
+    setPrimitives(friendly_robots, *friendly_primitives);
+}
+
+void Simulator::setEnemyPrimitives(ConstPrimitiveVectorPtr primitives)
+{
+    enemy_primitives = std::move(primitives);
+    setPrimitives(enemy_robots, *enemy_primitives);
+}
+
+void Simulator::setPrimitives(std::vector<SimulatedRobot>& robots,
+                              const std::vector<std::unique_ptr<Primitive>>& primitives)
+{
+    for (SimulatedRobot& robot : robots)
+    {
+        robot.primitive = nullptr;
+        for (const auto& primitive : primitives)
+        {
+            if (primitive->getRobotId() == robot.id)
+            {
+                robot.primitive = primitive.get();
+            }
+        }
+    }
+}
+
+void Simulator::stepSimulation(const Duration& duration)
+{
+    // Time is simulated in whole physics steps, rounding to the nearest step so rounding
+    // error doesn't make the number of steps per call vary
+    unsimulated_time_seconds += duration.getSeconds();
+    while (unsimulated_time_seconds >= PHYSICS_STEP_SECONDS / 2)
+    {
+        stepPhysics();
+        unsimulated_time_seconds -= PHYSICS_STEP_SECONDS;
+    }
+}
+
+World Simulator::getWorld()
+{
+    Timestamp timestamp = Timestamp::fromSeconds(getSimulatedTime().getSeconds());
+
+    // Vision only measures positions, so the noise is not added to velocities
+    auto add_vision_noise = [this](const Point& position) {
+        if (vision_noise_stddev_meters <= 0)
+        {
+            return position;
+        }
+        std::normal_distribution<double> noise(0.0, vision_noise_stddev_meters);
+        double x_noise = noise(random_number_generator);
+        double y_noise = noise(random_number_generator);
+        return position + Vector(x_noise, y_noise);
+    };
+
+    world.updateBallState(
+        Ball(add_vision_noise(ball.position), ball.velocity, timestamp));
+
+    for (auto [robots, team] :
+         {std::make_pair(&friendly_robots, &world.mutableFriendlyTeam()),
+          std::make_pair(&enemy_robots, &world.mutableEnemyTeam())})
+    {
+        std::vector<Robot> team_robots;
+        for (const SimulatedRobot& robot : *robots)
+        {
+            team_robots.emplace_back(robot.id, add_vision_noise(robot.position),
+                                     robot.velocity, robot.orientation,
+                                     robot.angular_velocity, timestamp);
+        }
+        team->updateRobots(team_robots);
+    }
+
+    world.updateRefboxGameState(refbox_game_state);
+    world.updateTimestamp(timestamp);
+
+    return world;
+}
+
+Duration Simulator::getSimulatedTime() const
+{
+    return Duration::fromSeconds(num_physics_steps * PHYSICS_STEP_SECONDS);
+}
+
+double Simulator::getBallHeight() const
+{
+    return ball.height;
+}
+
+Robot Simulator::createRobot(const SimulatedRobot& robot) const
+{
+    return Robot(robot.id, robot.position, robot.velocity, robot.orientation,
+                 robot.angular_velocity,
+                 Timestamp::fromSeconds(getSimulatedTime().getSeconds()));
+}
+
+void Simulator::stepPhysics()
+{
+    for (SimulatedRobot& robot : friendly_robots)
+    {
+        stepRobot(robot);
+    }
+    for (SimulatedRobot& robot : enemy_robots)
+    {
+        stepRobot(robot);
+    }
+
+    // Check every pair of robots, regardless of their team
+    std::vector<SimulatedRobot*> all_robots;
+    for (SimulatedRobot& robot : friendly_robots)
+    {
+        all_robots.emplace_back(&robot);
+    }
+    for (SimulatedRobot& robot : enemy_robots)
+    {
+        all_robots.emplace_back(&robot);
+    }
+    for (std::size_t i = 0; i < all_robots.size(); i++)
+    {
+        for (std::size_t j = i + 1; j < all_robots.size(); j++)
+        {
+            handleRobotRobotCollision(*all_robots[i], *all_robots[j]);
+        }
+    }
+
+    stepBall();
+    for (const SimulatedRobot* robot : all_robots)
+    {
+        handleRobotBallContact(*robot);
+    }
+
+    handleWallCollisions();
+
+    num_physics_steps++;
+}
+
+void Simulator::stepRobot(SimulatedRobot& robot)
+{
+    Vector target_velocity;
+    AngularVelocity target_angular_velocity = AngularVelocity::zero();
+    robot.kick_speed_meters_per_second      = 0.0;
+    robot.chip_instead_of_kick              = false;
+    robot.dribbler_on                       = false;
+
+    if (robot.primitive)
+    {
+        GrsimCommandPrimitiveVisitor grsim_command_primitive_visitor(
+            createRobot(robot),
+            Ball(ball.position, ball.velocity,
+                 Timestamp::fromSeconds(getSimulatedTime().getSeconds())));
+        robot.primitive->accept(grsim_command_primitive_visitor);
+        MotionControllerCommand motion_controller_command =
+            grsim_command_primitive_visitor.getMotionControllerCommand();
+
+        MotionController::Velocity robot_velocities =
+            motion_controller.bangBangVelocityController(
+                createRobot(robot), PHYSICS_STEP_SECONDS, motion_controller_command);
+
+        // The motion controller outputs velocities in robot coordinates
+        target_velocity = robot_velocities.linear_velocity.rotate(robot.orientation);
+        target_angular_velocity = robot_velocities.angular_velocity;
+
+        std::visit(
+            [&robot](const auto& command) {
+                robot.kick_speed_meters_per_second = command.kick_speed_meters_per_second;
+                robot.chip_instead_of_kick         = command.chip_instead_of_kick;
+                robot.dribbler_on                  = command.dribbler_on;
+            },
+            motion_controller_command);
+    }
+
+    // The robot can't change its velocity faster than its motors allow
+    Vector velocity_change    = target_velocity - robot.velocity;
+    double max_velocity_change =
+        ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED * PHYSICS_STEP_SECONDS;
+    if (velocity_change.len() > max_velocity_change)
+    {
+        velocity_change = velocity_change.norm(max_velocity_change);
+    }
+    robot.velocity += velocity_change;
+
+    double max_angular_velocity_change =
+        ROBOT_MAX_ANG_ACCELERATION_RAD_PER_SECOND_SQUARED * PHYSICS_STEP_SECONDS;
+    double angular_velocity_change =
+        std::clamp((target_angular_velocity - robot.angular_velocity).toRadians(),
+                   -max_angular_velocity_change, max_angular_velocity_change);
+    robot.angular_velocity += AngularVelocity::ofRadians(angular_velocity_change);
+
+    robot.position += robot.velocity * PHYSICS_STEP_SECONDS;
+    robot.orientation =
+        (robot.orientation + robot.angular_velocity * PHYSICS_STEP_SECONDS).angleMod();
+}
+
+void Simulator::stepBall()
+{
+    if (ball.height > 0 || ball.vertical_velocity > 0)
+    {
+        // The ball is in the air, so it falls under gravity
+        ball.height += ball.vertical_velocity * PHYSICS_STEP_SECONDS -
+                       GRAVITY_METERS_PER_SECOND_SQUARED *
+                           std::pow(PHYSICS_STEP_SECONDS, 2) / 2;
+        ball.vertical_velocity -=
+            GRAVITY_METERS_PER_SECOND_SQUARED * PHYSICS_STEP_SECONDS;
+        if (ball.height <= 0)
+        {
+            // Bounce off the ground, and stop bouncing once the bounces are small
+            ball.height            = 0;
+            ball.vertical_velocity = -ball.vertical_velocity * BALL_GROUND_RESTITUTION;
+            if (ball.vertical_velocity < BALL_MIN_BOUNCE_SPEED_METERS_PER_SECOND)
+            {
+                ball.vertical_velocity = 0;
+            }
+        }
+    }
+    else if (ball.velocity.len() > 0)
+    {
+        // The ball is rolling on the ground, so it slows down
+        double speed_change =
+            BALL_ROLLING_FRICTION_METERS_PER_SECOND_SQUARED * PHYSICS_STEP_SECONDS;
+        double new_speed = std::max(0.0, ball.velocity.len() - speed_change);
+        ball.velocity = ball.velocity.norm(new_speed);
+    }
+
+    ball.position += ball.velocity * PHYSICS_STEP_SECONDS;
+}
+
+void Simulator::handleRobotBallContact(const SimulatedRobot& robot)
+{
+    if (ball.height > ROBOT_HEIGHT_METERS)
+    {
+        return;
+    }
+
+    // The position of the ball relative to the robot, in robot coordinates where the
+    // robot faces along the positive x axis
+    Vector ball_offset = (ball.position - robot.position).rotate(-robot.orientation);
+    Vector facing      = Vector::createFromAngle(robot.orientation);
+
+    bool ball_in_front_of_robot =
+        ball.height == 0 && std::abs(ball_offset.y()) <= DRIBBLER_WIDTH / 2 &&
+        ball_offset.x() >= DIST_TO_FRONT_OF_ROBOT_METERS &&
+        ball_offset.x() <= DIST_TO_FRONT_OF_ROBOT_METERS + BALL_MAX_RADIUS_METERS +
+                               DRIBBLER_CAPTURE_DISTANCE_METERS;
+    if (ball_in_front_of_robot && robot.kick_speed_meters_per_second > 0)
+    {
+        // Kick the ball along the direction the robot is facing. Like grSim, chips
+        // give the ball the same vertical speed as horizontal speed, which launches it
+        // at roughly 45 degrees
+        double kick_speed = std::min(robot.kick_speed_meters_per_second,
+                                     BALL_MAX_SPEED_METERS_PER_SECOND);
+        ball.position     = robot.position +
+                        Vector(DIST_TO_FRONT_OF_ROBOT_METERS + BALL_MAX_RADIUS_METERS,
+                               ball_offset.y())
+                            .rotate(robot.orientation);
+        ball.velocity = robot.velocity + facing * kick_speed;
+        if (robot.chip_instead_of_kick)
+        {
+            ball.vertical_velocity = kick_speed;
+        }
+        return;
+    }
+    if (ball_in_front_of_robot && robot.dribbler_on)
+    {
+        // The dribbler holds the ball against the middle of the front of the robot, so
+        // it moves with the robot
+        Vector dribbler_offset =
+            facing * (DIST_TO_FRONT_OF_ROBOT_METERS + BALL_MAX_RADIUS_METERS);
+        ball.position = robot.position + dribbler_offset;
+        ball.velocity = robot.velocity +
+                        dribbler_offset.perp() * robot.angular_velocity.toRadians();
+        return;
+    }
+
+    // Otherwise the ball bounces off the robot, which is a circle with a flat front
+    double front_half_width = std::sqrt(std::pow(ROBOT_MAX_RADIUS_METERS, 2) -
+                                        std::pow(DIST_TO_FRONT_OF_ROBOT_METERS, 2));
+    Vector normal;
+    double penetration;
+    if (ball_offset.x() > 0 && std::abs(ball_offset.y()) <= front_half_width)
+    {
+        normal = facing;
+        penetration =
+            DIST_TO_FRONT_OF_ROBOT_METERS + BALL_MAX_RADIUS_METERS - ball_offset.x();
+    }
+    else
+    {
+        normal = (ball.position - robot.position).norm();
+        penetration =
+            ROBOT_MAX_RADIUS_METERS + BALL_MAX_RADIUS_METERS - ball_offset.len();
+    }
+
+    if (penetration > 0)
+    {
+        ball.position += normal * penetration;
+        double normal_speed = (ball.velocity - robot.velocity).dot(normal);
+        if (normal_speed < 0)
+        {
+            ball.velocity -= normal * ((1 + BALL_ROBOT_RESTITUTION) * normal_speed);
+        }
+    }
+}
+
+void Simulator::handleRobotRobotCollision(SimulatedRobot& robot1, SimulatedRobot& robot2)
+{
+    Vector offset  = robot2.position - robot1.position;
+    double overlap = 2 * ROBOT_MAX_RADIUS_METERS - offset.len();
+    if (overlap <= 0)
+    {
+        return;
+    }
+
+    // Push the robots apart equally, and stop them moving into each other as if they
+    // collided inelastically
+    Vector normal = offset.len() > 0 ? offset.norm() : Vector(1, 0);
+    robot1.position -= normal * (overlap / 2);
+    robot2.position += normal * (overlap / 2);
+
+    double closing_speed = (robot1.velocity - robot2.velocity).dot(normal);
+    if (closing_speed > 0)
+    {
+        robot1.velocity -= normal * (closing_speed / 2);
+        robot2.velocity += normal * (closing_speed / 2);
+    }
+}
+
+void Simulator::handleWallCollisions()
+{
+    double wall_x = field.totalLength() / 2;
+    double wall_y = field.totalWidth() / 2;
+
+    // Robots stop against the walls
+    for (std::vector<SimulatedRobot>* robots : {&friendly_robots, &enemy_robots})
+    {
+        for (SimulatedRobot& robot : *robots)
+        {
+            double max_x = wall_x - ROBOT_MAX_RADIUS_METERS;
+            double max_y = wall_y - ROBOT_MAX_RADIUS_METERS;
+            if (std::abs(robot.position.x()) > max_x)
+            {
+                robot.position.setX(std::copysign(max_x, robot.position.x()));
+                robot.velocity.setX(0);
+            }
+            if (std::abs(robot.position.y()) > max_y)
+            {
+                robot.position.setY(std::copysign(max_y, robot.position.y()));
+                robot.velocity.setY(0);
+            }
+        }
+    }
+
+    // The ball bounces off the walls
+    double max_x = wall_x - BALL_MAX_RADIUS_METERS;
+    double max_y = wall_y - BALL_MAX_RADIUS_METERS;
+    if (std::abs(ball.position.x()) > max_x)
+    {
+        ball.position.setX(std::copysign(max_x, ball.position.x()));
+        double speed = std::abs(ball.velocity.x()) * BALL_WALL_RESTITUTION;
+        ball.velocity.setX(-std::copysign(speed, ball.position.x()));
+    }
+    if (std::abs(ball.position.y()) > max_y)
+    {
+        ball.position.setY(std::copysign(max_y, ball.position.y()));
+        double speed = std::abs(ball.velocity.y()) * BALL_WALL_RESTITUTION;
+        ball.velocity.setY(-std::copysign(speed, ball.position.y()));
+    }
+}
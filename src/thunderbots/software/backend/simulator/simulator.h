@@ -0,0 +1,247 @@
+#pragma once
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "ai/primitive/primitive.h"
+#include "ai/world/world.h"
+#include "backend/output/grsim/motion_controller.h"
+#include "typedefs.h"
+#include "util/refbox_constants.h"
+
+/**
+ * A lightweight, fully in-process simulation of the robots and the ball, so the AI
+ * can be run without grSim, a display, or a network.
+ *
+ * The field is modelled in 2D, with the robots and ball as rigid bodies. The robots are
+ * controlled by the same primitive visitor and motion controller used for grSim, and
+ * their acceleration is limited by the physical limits in shared/constants.h. The ball
+ * rolls with friction and can be chipped into the air, where it falls under gravity
+ * and bounces. Robots can kick, chip and dribble the ball with their front, and collide
+ * with the ball, each other, and the walls at the edge of the field boundary.
+ *
+ * The simulation advances in fixed steps, and only when it is asked to, so it can run
+ * much faster than real time. Given the same seed and the same inputs, it always
+ * produces the same Worlds.
+ */
+class Simulator
+{
+   public:
+    /**
+     * Creates a new Simulator with no robots and a stationary ball at the centre of the
+     * field
+     *
+     * @param field The field to simulate
+     * @param seed The seed used to generate vision noise
+     * @param vision_noise_stddev_meters The standard deviation of the noise added to the
+     * positions of the robots and ball in the Worlds returned by getWorld
+     */
+    explicit Simulator(const Field& field, unsigned int seed = 0,
+                       double vision_noise_stddev_meters = 0.0);
+
+    /**
+     * Places a robot on the friendly team, replacing any robot with the same id
+     *
+     * @param id The id of the robot
+     * @param position The position of the robot
+     * @param orientation The orientation of the robot
+     * @param velocity The velocity of the robot
+     */
+    void addFriendlyRobot(unsigned int id, const Point& position,
+                          const Angle& orientation, const Vector& velocity = Vector());
+
+    /**
+     * Places a robot on the enemy team, replacing any robot with the same id
+     *
+     * @param id The id of the robot
+     * @param position The position of the robot
+     * @param orientation The orientation of the robot
+     * @param velocity The velocity of the robot
+     */
+    void addEnemyRobot(unsigned int id, const Point& position, const Angle& orientation,
+                       const Vector& velocity = Vector());
+
+    /**
+     * Places the ball on the ground with the given velocity
+     *
+     * @param position The position of the ball
+     * @param velocity The velocity of the ball
+     */
+    void setBallState(const Point& position, const Vector& velocity);
+
+    /**
+     * Sets the refbox game state reported in the Worlds returned by getWorld
+     *
+     * @param game_state The refbox game state
+     */
+    void setRefboxGameState(const RefboxGameState& game_state);
+
+    /**
+     * Sets the primitives the friendly robots follow. Each robot follows its primitive
+     * until it is given a new one, and robots without a primitive come to a stop. Like
+     * grSim, the primitives are converted into motion controller commands at every
+     * physics step, using the current state of the robot and ball
+     *
+     * @param primitives The primitives for the friendly robots
+     */
+    void setFriendlyPrimitives(ConstPrimitiveVectorPtr primitives);
+
+    /**
+     * Sets the primitives the enemy robots follow, in the same way as
+     * setFriendlyPrimitives. The primitives use the same coordinates as the friendly
+     * team
+     *
+     * @param primitives The primitives for the enemy robots
+     */
+    void setEnemyPrimitives(ConstPrimitiveVectorPtr primitives);
+
+    /**
+     * Advances the simulation by the given duration. The simulation advances in whole
+     * physics steps, and any difference is carried over to the next call
+     *
+     * @param duration How long to advance the simulation by
+     */
+    void stepSimulation(const Duration& duration);
+
+    /**
+     * Returns the current state of the simulation as seen by the AI. The timestamps in
+     * the World are the simulated time, starting from 0
+     *
+     * @return the current state of the simulation
+     */
+    World getWorld();
+
+    /**
+     * Returns how long has been simulated
+     *
+     * @return how long has been simulated
+     */
+    Duration getSimulatedTime() const;
+
+    /**
+     * Returns the height of the bottom of the ball above the ground, which is only
+     * non-zero after the ball has been chipped
+     *
+     * @return the height of the ball, in meters
+     */
+    double getBallHeight() const;
+
+    // The length of each physics step
+    static constexpr double PHYSICS_STEP_SECONDS = 1.0 / 240.0;
+
+   private:
+    struct SimulatedRobot
+    {
+        unsigned int id;
+        Point position;
+        Vector velocity;
+        Angle orientation;
+        AngularVelocity angular_velocity;
+        // The primitive the robot is following, which points into the primitives given
+        // to the simulator for the robot's team, or null if it has no primitive
+        const Primitive* primitive;
+        // What the robot's kicker and dribbler were last commanded to do
+        double kick_speed_meters_per_second;
+        bool chip_instead_of_kick;
+        bool dribbler_on;
+    };
+
+    struct SimulatedBall
+    {
+        Point position;
+        Vector velocity;
+        double height;
+        double vertical_velocity;
+    };
+
+    /**
+     * Places a robot in the given list of robots, replacing any robot with the same id
+     */
+    static void addRobot(std::vector<SimulatedRobot>& robots, unsigned int id,
+                         const Point& position, const Angle& orientation,
+                         const Vector& velocity);
+
+    /**
+     * Assigns each of the given primitives to the robot it is for
+     */
+    static void setPrimitives(std::vector<SimulatedRobot>& robots,
+                              const std::vector<std::unique_ptr<Primitive>>& primitives);
+
+    /**
+     * Converts the given simulated robot into a Robot at the current simulated time
+     */
+    Robot createRobot(const SimulatedRobot& robot) const;
+
+    /**
+     * Advances the simulation by a single physics step
+     */
+    void stepPhysics();
+
+    /**
+     * Accelerates the given robot towards the velocity requested by its primitive, and
+     * moves it
+     */
+    void stepRobot(SimulatedRobot& robot);
+
+    /**
+     * Moves the ball, applying rolling friction while it is on the ground and gravity
+     * while it is in the air
+     */
+    void stepBall();
+
+    /**
+     * Kicks, chips, dribbles or bounces the ball off of the given robot if they are in
+     * contact
+     */
+    void handleRobotBallContact(const SimulatedRobot& robot);
+
+    /**
+     * Separates the given robots if they overlap
+     */
+    static void handleRobotRobotCollision(SimulatedRobot& robot1,
+                                          SimulatedRobot& robot2);
+
+    /**
+     * Keeps the robots and ball inside the walls at the edge of the field boundary
+     */
+    void handleWallCollisions();
+
+    // How quickly a ball rolling on the ground slows down
+    static constexpr double BALL_ROLLING_FRICTION_METERS_PER_SECOND_SQUARED = 0.5;
+    static constexpr double GRAVITY_METERS_PER_SECOND_SQUARED               = 9.81;
+    // The fraction of its speed the ball keeps when bouncing off of the ground, walls
+    // or robots
+    static constexpr double BALL_GROUND_RESTITUTION = 0.5;
+    static constexpr double BALL_WALL_RESTITUTION   = 0.5;
+    static constexpr double BALL_ROBOT_RESTITUTION  = 0.3;
+    // A bouncing ball slower than this comes to rest on the ground
+    static constexpr double BALL_MIN_BOUNCE_SPEED_METERS_PER_SECOND = 0.1;
+    // The ball flies over robots when it is higher than this
+    static constexpr double ROBOT_HEIGHT_METERS = 0.15;
+    // How far in front of the robot the ball can be and still be kicked or dribbled
+    static constexpr double DRIBBLER_CAPTURE_DISTANCE_METERS = 0.01;
+
+    const Field field;
+    std::mt19937 random_number_generator;
+    const double vision_noise_stddev_meters;
+
+    MotionController motion_controller;
+
+    std::vector<SimulatedRobot> friendly_robots;
+    std::vector<SimulatedRobot> enemy_robots;
+    // Kept so the primitives the robots point to stay alive
+    ConstPrimitiveVectorPtr friendly_primitives;
+    ConstPrimitiveVectorPtr enemy_primitives;
+    SimulatedBall ball;
+    RefboxGameState refbox_game_state;
+
+    // The number of physics steps simulated so far
+    unsigned long num_physics_steps;
+    // Time passed to stepSimulation that has not been simulated yet
+    double unsimulated_time_seconds;
+
+    // The World returned by getWorld, kept so the history of the ball, robots, and game
+    // state builds up as it would for a real World
+    World world;
+};
@@ -0,0 +1,116 @@
+#include "backend/simulator_backend.h"
+
+#include <chrono>
+#include <stdexcept>
+
+#include "backend/backend_factory.h"
+#include "util/parameter/dynamic_parameters.h"
+
+const std::string SimulatorBackend::name = "simulator";
+
+SimulatorBackend::SimulatorBackend()
+    : SimulatorBackend(
+          static_cast<unsigned int>(
+              Util::DynamicParameters::SimulatorBackend::seed.value()),
+          Util::DynamicParameters::SimulatorBackend::fast_forward_factor.value())
+{
+}
+
+SimulatorBackend::SimulatorBackend(unsigned int seed, double fast_forward_factor)
+    : simulator(Field(9.0, 6.0, 1.0, 2.0, 1.0, 0.3, 0.5, Timestamp::fromSeconds(0)),
+                seed),
+      fast_forward_factor(fast_forward_factor),
+      primitives_received(false),
+      in_destructor(false)
+{
+    if (fast_forward_factor < 0)
+    {
+        throw std::invalid_argument(
+            "The SimulatorBackend fast-forward factor must not be negative");
+    }
+
+    // Line the teams up across their own halves, facing the other team
+    for (unsigned int id = 0; id < NUM_ROBOTS_PER_TEAM; id++)
+    {
+        double y = -2.0 + 0.8 * id;
+        simulator.addFriendlyRobot(id, Point(-1.5, y), Angle::zero());
+        simulator.addEnemyRobot(id, Point(1.5, y), Angle::half());
+    }
+    simulator.setRefboxGameState(DEFAULT_GAME_STATE);
+
+    simulation_thread = std::thread(&SimulatorBackend::runSimulation, this);
+}
+
+SimulatorBackend::~SimulatorBackend()
+{
+    {
+        std::scoped_lock lock(simulator_mutex);
+        in_destructor = true;
+    }
+    primitives_received_cv.notify_all();
+    simulation_thread.join();
+}
+
+void SimulatorBackend::onValueReceived(ConstPrimitiveVectorPtr primitives)
+{
+    {
+        std::scoped_lock lock(simulator_mutex);
+        simulator.setFriendlyPrimitives(std::move(primitives));
+        primitives_received = true;
+    }
+    primitives_received_cv.notify_all();
+}
+
+void SimulatorBackend::runSimulation()
+{
+    // The wall clock time between steps, which is unused when stepping as soon as the AI
+    // responds
+    const double world_update_period_seconds =
+        fast_forward_factor > 0 ? WORLD_UPDATE_PERIOD_SECONDS / fast_forward_factor : 0.0;
+    const auto world_update_period =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(world_update_period_seconds));
+    const auto primitives_timeout =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(FAST_FORWARD_PRIMITIVES_TIMEOUT_SECONDS));
+    auto next_update_time = std::chrono::steady_clock::now();
+
+    while (true)
+    {
+        World world;
+        {
+            std::scoped_lock lock(simulator_mutex);
+            if (in_destructor)
+            {
+                return;
+            }
+
+            simulator.stepSimulation(Duration::fromSeconds(WORLD_UPDATE_PERIOD_SECONDS));
+            world = simulator.getWorld();
+            primitives_received = false;
+        }
+
+        world.mutableFriendlyTeam().assignGoalie(
+            Util::DynamicParameters::AI::refbox::friendly_goalie_id.value());
+        world.mutableEnemyTeam().assignGoalie(
+            Util::DynamicParameters::AI::refbox::enemy_goalie_id.value());
+        Subject<World>::sendValueToObservers(world);
+
+        std::unique_lock<std::mutex> lock(simulator_mutex);
+        if (fast_forward_factor == 0)
+        {
+            primitives_received_cv.wait_for(lock, primitives_timeout, [this]() {
+                return primitives_received || in_destructor;
+            });
+        }
+        else
+        {
+            next_update_time += world_update_period;
+            primitives_received_cv.wait_until(lock, next_update_time,
+                                              [this]() { return in_destructor; });
+        }
+    }
+}
+
+// Register this backend in the BackendFactory
+static TBackendFactory<SimulatorBackend> factory;
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "backend/backend.h"
+#include "backend/simulator/simulator.h"
+
+/**
+ * A backend that runs the AI against the in-process Simulator, so it needs no grSim,
+ * radio, or network.
+ *
+ * The simulation is stepped on its own thread, which publishes a new World every step.
+ * The steps are paced by the wall clock, like vision from grSim, but can be sped up by a
+ * fast-forward factor. With a fast-forward factor of 0, each step is taken as soon as
+ * the AI has sent primitives for the previous World, so the AI sees the same sequence of
+ * Worlds it would in real time, as fast as it can process them.
+ *
+ * When the backend is created by the BackendFactory, the seed and fast-forward factor
+ * are read from the SimulatorBackend dynamic parameters.
+ */
+class SimulatorBackend : public Backend
+{
+   public:
+    static const std::string name;
+
+    /**
+     * Creates a new SimulatorBackend with the seed and fast-forward factor from the
+     * SimulatorBackend dynamic parameters, with both teams lined up on their own halves
+     * of a Division B field and the game in progress
+     */
+    SimulatorBackend();
+
+    /**
+     * Creates a new SimulatorBackend with both teams lined up on their own halves of a
+     * Division B field and the game in progress
+     *
+     * @param seed The seed for the simulator, which makes runs reproducible
+     * @param fast_forward_factor How many times faster than real time to step the
+     * simulation, or 0 to step it as soon as the AI responds
+     *
+     * @throws std::invalid_argument if the fast-forward factor is negative
+     */
+    explicit SimulatorBackend(unsigned int seed, double fast_forward_factor);
+
+    ~SimulatorBackend() override;
+
+   private:
+    // How much simulated time passes between each World
+    static constexpr double WORLD_UPDATE_PERIOD_SECONDS = 1.0 / 60.0;
+
+    // When stepping as soon as the AI responds, how long to wait for the AI to send
+    // primitives before stepping the simulation anyway
+    static constexpr double FAST_FORWARD_PRIMITIVES_TIMEOUT_SECONDS = 1.0;
+
+    static const unsigned int NUM_ROBOTS_PER_TEAM     = 6;
+    static constexpr RefboxGameState DEFAULT_GAME_STATE = RefboxGameState::FORCE_START;
+
+    void onValueReceived(ConstPrimitiveVectorPtr primitives) override;
+
+    /**
+     * Steps the simulation and publishes the new World until this backend is destroyed.
+     * This is intended to be run in a separate thread
+     */
+    void runSimulation();
+
+    Simulator simulator;
+    const double fast_forward_factor;
+
+    // Protects the simulator and the flags below
+    std::mutex simulator_mutex;
+    std::condition_variable primitives_received_cv;
+    // Whether primitives have been received since the last World was published
+    bool primitives_received;
+    bool in_destructor;
+
+    std::thread simulation_thread;
+};
@@ -10,6 +10,7 @@
 #include "backend/backend_factory.h"
 #include "backend/grsim_backend.h"
 #include "backend/radio_backend.h"
+#include "backend/simulator_backend.h"
 #include "util/canvas_messenger/canvas_messenger.h"
 #include "util/constants.h"
 #include "util/logger/init.h"
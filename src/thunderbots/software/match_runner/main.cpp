@@ -0,0 +1,130 @@
+#include <boost/program_options.hpp>
+#include <iomanip>
+#include <iostream>
+
+#include "match_runner/match_runner.h"
+#include "match_runner/match_scenario.h"
+#include "util/logger/init.h"
+
+using namespace boost::program_options;
+
+namespace
+{
+    // The options given on the command line
+    struct Options
+    {
+        unsigned int num_runs_per_scenario;
+        unsigned int num_threads;
+        // If positive, the largest mean CPU time per tick, in milliseconds, that any
+        // scenario may use before the run is considered a failure
+        double max_mean_tick_cpu_time_milliseconds;
+    };
+
+    /**
+     * Prints a table of the given summaries
+     *
+     * @param summaries The summaries to print
+     */
+    void printSummaries(const std::vector<MatchSummary> &summaries)
+    {
+        std::cout << std::left << std::setw(16) << "scenario" << std::right
+                  << std::setw(8) << "matches" << std::setw(8) << "goals"
+                  << std::setw(10) << "against" << std::setw(12) << "possession"
+                  << std::setw(12) << "enemy_poss" << std::setw(14) << "time_to_ball"
+                  << std::setw(14) << "mean_tick_ms" << std::setw(14) << "max_tick_ms"
+                  << std::endl;
+
+        std::cout << std::fixed << std::setprecision(3);
+        for (const MatchSummary &summary : summaries)
+        {
+            std::cout << std::left << std::setw(16) << summary.scenario_name
+                      << std::right << std::setw(8) << summary.num_matches
+                      << std::setw(8) << summary.friendly_goals << std::setw(10)
+                      << summary.enemy_goals << std::setw(12)
+                      << summary.mean_friendly_possession_fraction << std::setw(12)
+                      << summary.mean_enemy_possession_fraction << std::setw(14);
+            if (summary.mean_friendly_time_to_ball)
+            {
+                std::cout << summary.mean_friendly_time_to_ball->getSeconds();
+            }
+            else
+            {
+                std::cout << "-";
+            }
+            std::cout << std::setw(14) << summary.mean_tick_cpu_time.getMilliseconds()
+                      << std::setw(14) << summary.max_tick_cpu_time.getMilliseconds()
+                      << std::endl;
+        }
+    }
+}  // namespace
+
+/**
+ * Runs the AI through the default scenarios on every core and prints how it did and how
+ * much CPU time it used
+ *
+ * @return 0 if the run succeeded, or 1 if the options were invalid or a scenario used
+ * more CPU time per tick than allowed
+ */
+int main(int argc, char **argv)
+{
+    Util::Logger::LoggerSingleton::initializeLogger();
+
+    Options options;
+    try
+    {
+        options_description desc{"Options"};
+        desc.add_options()("help,h", "Help screen")(
+            "runs", value<unsigned int>(&options.num_runs_per_scenario)->default_value(8),
+            "The number of times to run each scenario, each with a different seed")(
+            "threads", value<unsigned int>(&options.num_threads)->default_value(0),
+            "The number of matches to run at once, or 0 to use every hardware thread")(
+            "max_mean_tick_ms",
+            value<double>(&options.max_mean_tick_cpu_time_milliseconds)
+                ->default_value(0),
+            "Fail if the mean CPU time the AI uses per tick in any scenario is more "
+            "than this many milliseconds, or 0 to never fail");
+
+        variables_map vm;
+        store(parse_command_line(argc, argv, desc), vm);
+        if (vm.count("help"))
+        {
+            std::cout << desc << std::endl;
+            return 0;
+        }
+        notify(vm);
+    }
+    catch (const error &ex)
+    {
+        std::cerr << ex.what() << '\n';
+        return 1;
+    }
+
+    // The same Division B field used by the simulator backend
+    Field field(9.0, 6.0, 1.0, 2.0, 1.0, 0.3, 0.5, Timestamp::fromSeconds(0));
+    MatchRunner runner(field, options.num_threads);
+
+    std::vector<MatchResult> results = runner.runMatches(
+        getDefaultMatchScenarios(field), options.num_runs_per_scenario);
+    std::vector<MatchSummary> summaries = MatchRunner::summarizeResults(results);
+    printSummaries(summaries);
+
+    if (options.max_mean_tick_cpu_time_milliseconds > 0)
+    {
+        for (const MatchSummary &summary : summaries)
+        {
+            if (summary.mean_tick_cpu_time.getMilliseconds() >
+                options.max_mean_tick_cpu_time_milliseconds)
+            {
+                std::cerr << "The AI used "
+                          << summary.mean_tick_cpu_time.getMilliseconds()
+                          << "ms per tick in the " << summary.scenario_name
+                          << " scenario, more than the allowed "
+                          << options.max_mean_tick_cpu_time_milliseconds << "ms"
+                          << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
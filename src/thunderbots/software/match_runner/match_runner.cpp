@@ -0,0 +1,279 @@
+#include "match_runner/match_runner.h"
+
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "ai/ai.h"
+#include "ai/hl/stp/evaluation/robot.h"
+#include "ai/hl/stp/play/halt_play.h"
+#include "ai/hl/stp/stp.h"
+#include "ai/navigator/path_planning_navigator/path_planning_navigator.h"
+#include "shared/constants.h"
+#include "util/canvas_messenger/canvas_messenger.h"
+#include "util/parameter/parameter.h"
+
+namespace
+{
+    /**
+     * Returns how much CPU time the calling thread has used, which unlike the wall
+     * clock is not affected by other threads running on the same core
+     *
+     * @return how much CPU time the calling thread has used
+     */
+    Duration getThreadCpuTime()
+    {
+        timespec cpu_time;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_time);
+        return Duration::fromSeconds(static_cast<double>(cpu_time.tv_sec) +
+                                     static_cast<double>(cpu_time.tv_nsec) / 1.0e9);
+    }
+
+    /**
+     * Returns true if any robot on the given team has possession of the ball
+     *
+     * @param team The team to check
+     * @param ball The ball
+     *
+     * @return true if any robot on the given team has possession of the ball
+     */
+    bool teamHasBall(const Team& team, const Ball& ball)
+    {
+        const std::vector<Robot> robots = team.getAllRobots();
+        return std::any_of(robots.begin(), robots.end(), [&ball](const Robot& robot) {
+            return Evaluation::robotHasPossession(ball, robot);
+        });
+    }
+
+    /**
+     * Removes every parameter override the calling thread has set, so the next match run
+     * on it starts from the shared parameters
+     */
+    void clearThreadLocalParameters()
+    {
+        Parameter<bool>::clearAllThreadLocalValues();
+        Parameter<int32_t>::clearAllThreadLocalValues();
+        Parameter<double>::clearAllThreadLocalValues();
+        Parameter<std::string>::clearAllThreadLocalValues();
+    }
+}  // namespace
+
+MatchRunner::MatchRunner(const Field& field, unsigned int num_threads)
+    : field(field),
+      num_threads(num_threads > 0 ? num_threads
+                                  : std::max(1u, std::thread::hardware_concurrency()))
+{
+}
+
+MatchResult MatchRunner::runMatch(const MatchScenario& scenario, unsigned int seed) const
+{
+    clearThreadLocalParameters();
+    if (scenario.set_parameters)
+    {
+        scenario.set_parameters();
+    }
+
+    Simulator simulator(field, seed);
+    scenario.setup(simulator);
+
+    // Each match draws on its own CanvasMessenger, which is never published, so the
+    // matches don't contend for the one shared with the visualizer
+    AI ai(std::make_unique<STP>([]() { return std::make_unique<HaltPlay>(); }, seed),
+          std::make_unique<PathPlanningNavigator>(
+              std::make_shared<Util::CanvasMessenger>()));
+
+    MatchResult result          = {};
+    result.scenario_name        = scenario.name;
+    result.seed                 = seed;
+    const Duration tick_period  = Duration::fromSeconds(TICK_PERIOD_SECONDS);
+    auto next_refbox_game_state = scenario.refbox_game_states.begin();
+
+    while (simulator.getSimulatedTime() < scenario.duration)
+    {
+        while (next_refbox_game_state != scenario.refbox_game_states.end() &&
+               next_refbox_game_state->first <= simulator.getSimulatedTime())
+        {
+            simulator.setRefboxGameState(next_refbox_game_state->second);
+            next_refbox_game_state++;
+        }
+
+        World world = simulator.getWorld();
+        world.mutableFriendlyTeam().assignGoalie(FRIENDLY_GOALIE_ID);
+        world.mutableEnemyTeam().assignGoalie(ENEMY_GOALIE_ID);
+
+        // The ball is only in a goal once it has completely crossed the goal line
+        const Point ball_position = world.ball().position();
+        if (std::abs(ball_position.y()) < field.goalWidth() / 2 &&
+            std::abs(ball_position.x()) > field.length() / 2 + BALL_MAX_RADIUS_METERS)
+        {
+            if (ball_position.x() > 0)
+            {
+                result.friendly_goals++;
+            }
+            else
+            {
+                result.enemy_goals++;
+            }
+            break;
+        }
+
+        if (teamHasBall(world.friendlyTeam(), world.ball()))
+        {
+            result.friendly_possession_time =
+                result.friendly_possession_time + tick_period;
+            if (!result.friendly_time_to_ball)
+            {
+                result.friendly_time_to_ball = simulator.getSimulatedTime();
+            }
+        }
+        if (teamHasBall(world.enemyTeam(), world.ball()))
+        {
+            result.enemy_possession_time = result.enemy_possession_time + tick_period;
+        }
+
+        const Duration cpu_time_before_tick = getThreadCpuTime();
+        auto primitives                     = ai.getPrimitives(world);
+        const Duration tick_cpu_time        = getThreadCpuTime() - cpu_time_before_tick;
+
+        result.num_ticks++;
+        result.total_tick_cpu_time = result.total_tick_cpu_time + tick_cpu_time;
+        result.max_tick_cpu_time   = std::max(result.max_tick_cpu_time, tick_cpu_time);
+
+        simulator.setFriendlyPrimitives(
+            std::make_shared<const std::vector<std::unique_ptr<Primitive>>>(
+                std::move(primitives)));
+        simulator.stepSimulation(tick_period);
+    }
+
+    result.simulated_time = simulator.getSimulatedTime();
+    clearThreadLocalParameters();
+    return result;
+}
+
+std::vector<MatchResult> MatchRunner::runMatches(
+    const std::vector<MatchScenario>& scenarios, unsigned int num_runs_per_scenario) const
+{
+    const std::size_t num_matches = scenarios.size() * num_runs_per_scenario;
+    std::vector<MatchResult> results(num_matches);
+
+    // Each thread repeatedly takes the next match that hasn't been run yet. Every match
+    // writes to its own result, so the results don't need to be locked
+    std::atomic<std::size_t> next_match_index(0);
+    std::exception_ptr first_exception;
+    std::mutex first_exception_mutex;
+
+    auto run_matches = [&]() {
+        for (std::size_t i = next_match_index++; i < num_matches; i = next_match_index++)
+        {
+            try
+            {
+                const unsigned int seed =
+                    static_cast<unsigned int>(i % num_runs_per_scenario);
+                results[i] = runMatch(scenarios[i / num_runs_per_scenario], seed);
+            }
+            catch (...)
+            {
+                std::scoped_lock lock(first_exception_mutex);
+                if (!first_exception)
+                {
+                    first_exception = std::current_exception();
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    const std::size_t num_threads_to_start =
+        std::min<std::size_t>(num_threads, num_matches);
+    for (std::size_t i = 0; i < num_threads_to_start; i++)
+    {
+        threads.emplace_back(run_matches);
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    if (first_exception)
+    {
+        std::rethrow_exception(first_exception);
+    }
+
+    return results;
+}
+
+std::vector<MatchSummary> MatchRunner::summarizeResults(
+    const std::vector<MatchResult>& results)
+{
+    std::vector<MatchSummary> summaries;
+    std::map<std::string, std::size_t> summary_indices;
+    // Totals that are turned into means once every result has been added
+    std::vector<Duration> total_time_to_ball;
+    std::vector<Duration> total_tick_cpu_time;
+    std::vector<unsigned int> total_num_ticks;
+
+    for (const MatchResult& result : results)
+    {
+        auto [summary_index, is_new_scenario] =
+            summary_indices.emplace(result.scenario_name, summaries.size());
+        if (is_new_scenario)
+        {
+            MatchSummary summary  = {};
+            summary.scenario_name = result.scenario_name;
+            summaries.emplace_back(summary);
+            total_time_to_ball.emplace_back();
+            total_tick_cpu_time.emplace_back();
+            total_num_ticks.emplace_back(0);
+        }
+
+        const std::size_t i   = summary_index->second;
+        MatchSummary& summary = summaries[i];
+        summary.num_matches++;
+        summary.friendly_goals += result.friendly_goals;
+        summary.enemy_goals += result.enemy_goals;
+        if (result.simulated_time.getSeconds() > 0)
+        {
+            summary.mean_friendly_possession_fraction +=
+                result.friendly_possession_time.getSeconds() /
+                result.simulated_time.getSeconds();
+            summary.mean_enemy_possession_fraction +=
+                result.enemy_possession_time.getSeconds() /
+                result.simulated_time.getSeconds();
+        }
+        if (result.friendly_time_to_ball)
+        {
+            summary.num_matches_friendly_reached_ball++;
+            total_time_to_ball[i] = total_time_to_ball[i] + *result.friendly_time_to_ball;
+        }
+        total_tick_cpu_time[i] = total_tick_cpu_time[i] + result.total_tick_cpu_time;
+        total_num_ticks[i] += result.num_ticks;
+        summary.max_tick_cpu_time =
+            std::max(summary.max_tick_cpu_time, result.max_tick_cpu_time);
+    }
+
+    for (std::size_t i = 0; i < summaries.size(); i++)
+    {
+        MatchSummary& summary = summaries[i];
+        summary.mean_friendly_possession_fraction /= summary.num_matches;
+        summary.mean_enemy_possession_fraction /= summary.num_matches;
+        if (summary.num_matches_friendly_reached_ball > 0)
+        {
+            summary.mean_friendly_time_to_ball = Duration::fromSeconds(
+                total_time_to_ball[i].getSeconds() /
+                summary.num_matches_friendly_reached_ball);
+        }
+        if (total_num_ticks[i] > 0)
+        {
+            summary.mean_tick_cpu_time = Duration::fromSeconds(
+                total_tick_cpu_time[i].getSeconds() / total_num_ticks[i]);
+        }
+    }
+
+    return summaries;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "ai/world/field.h"
+#include "match_runner/match_scenario.h"
+#include "util/time/duration.h"
+
+/**
+ * The outcome of running the AI through a single MatchScenario, and how much CPU time
+ * the AI used to do it
+ */
+struct MatchResult
+{
+    // The name of the scenario that was run
+    std::string scenario_name;
+    // The seed the simulator and AI were given
+    unsigned int seed;
+
+    // The match stops when the first goal is scored, so at most one of these is 1
+    unsigned int friendly_goals;
+    unsigned int enemy_goals;
+
+    // How long the match was simulated for
+    Duration simulated_time;
+    // How long each team had a robot in possession of the ball
+    Duration friendly_possession_time;
+    Duration enemy_possession_time;
+    // How long it took for a friendly robot to first get possession of the ball, if
+    // one did
+    std::optional<Duration> friendly_time_to_ball;
+
+    // The number of times the AI was run, and the CPU time it used to do so
+    unsigned int num_ticks;
+    Duration total_tick_cpu_time;
+    Duration max_tick_cpu_time;
+};
+
+/**
+ * The combined results of all the matches run for a single MatchScenario
+ */
+struct MatchSummary
+{
+    std::string scenario_name;
+    unsigned int num_matches;
+
+    unsigned int friendly_goals;
+    unsigned int enemy_goals;
+    // The mean fraction of each match that each team had possession of the ball
+    double mean_friendly_possession_fraction;
+    double mean_enemy_possession_fraction;
+    // The number of matches where a friendly robot got possession of the ball, and the
+    // mean time it took in those matches
+    unsigned int num_matches_friendly_reached_ball;
+    std::optional<Duration> mean_friendly_time_to_ball;
+
+    // The mean and max CPU time used by the AI in a single tick, over all the matches
+    Duration mean_tick_cpu_time;
+    Duration max_tick_cpu_time;
+};
+
+/**
+ * Runs the AI through scripted MatchScenarios in the Simulator, without ROS or a
+ * visualizer, and measures how well it does and how much CPU time it uses.
+ *
+ * Every match gets its own AI (with its own STP, PathPlanningNavigator, and
+ * CanvasMessenger) and its own Simulator, so many matches can be run at once on
+ * separate threads. The AI is run once for every World, and the simulation only
+ * advances after the AI has finished, so the results do not depend on how fast the
+ * machine is or how many matches are run at once. Given the same seed, a match always
+ * plays out the same way.
+ */
+class MatchRunner
+{
+   public:
+    /**
+     * Creates a new MatchRunner
+     *
+     * @param field The field to play the matches on
+     * @param num_threads The number of matches to run at once. If 0, one match is run
+     * for every hardware thread
+     */
+    explicit MatchRunner(const Field& field, unsigned int num_threads = 0);
+
+    /**
+     * Runs a single match on the calling thread. The robots and ball are placed by the
+     * scenario, and the match runs until a goal is scored or the scenario's duration
+     * has passed
+     *
+     * @param scenario The scenario to play
+     * @param seed The seed for the simulator and the AI
+     *
+     * @return the result of the match
+     */
+    MatchResult runMatch(const MatchScenario& scenario, unsigned int seed) const;
+
+    /**
+     * Runs every scenario the given number of times, with seeds from 0 up to the number
+     * of runs, spreading the matches across this runner's threads
+     *
+     * @param scenarios The scenarios to play
+     * @param num_runs_per_scenario How many times to play each scenario
+     *
+     * @throws any exception thrown while running a match, after all the threads have
+     * finished
+     * @return the results of every match, in the order of the scenarios and then the
+     * seeds
+     */
+    std::vector<MatchResult> runMatches(const std::vector<MatchScenario>& scenarios,
+                                        unsigned int num_runs_per_scenario) const;
+
+    /**
+     * Combines the results of the matches for each scenario
+     *
+     * @param results The results of the matches
+     *
+     * @return a summary for each scenario, in the order the scenarios first appear in
+     * the results
+     */
+    static std::vector<MatchSummary> summarizeResults(
+        const std::vector<MatchResult>& results);
+
+    // How much simulated time passes between each World given to the AI
+    static constexpr double TICK_PERIOD_SECONDS = 1.0 / 60.0;
+
+   private:
+    // The goalies are the robots given this id by the scenarios
+    static const unsigned int FRIENDLY_GOALIE_ID = 0;
+    static const unsigned int ENEMY_GOALIE_ID    = 0;
+
+    const Field field;
+    const unsigned int num_threads;
+};
@@ -0,0 +1,91 @@
+#include "match_runner/match_scenario.h"
+
+#include "ai/hl/stp/play/corner_kick_play.h"
+#include "shared/constants.h"
+#include "util/parameter/dynamic_parameters.h"
+
+namespace
+{
+    const unsigned int NUM_ROBOTS_PER_TEAM = 6;
+
+    // How long the robots have to get into position before a kickoff or penalty kick is
+    // started
+    const Duration RESTART_SETUP_DURATION = Duration::fromSeconds(3);
+
+    /**
+     * Lines up both teams across their own halves, facing the other team
+     *
+     * @param simulator The simulator to place the robots in
+     */
+    void lineUpTeams(Simulator& simulator)
+    {
+        for (unsigned int id = 0; id < NUM_ROBOTS_PER_TEAM; id++)
+        {
+            double y = -2.0 + 0.8 * id;
+            simulator.addFriendlyRobot(id, Point(-1.5, y), Angle::zero());
+            simulator.addEnemyRobot(id, Point(1.5, y), Angle::half());
+        }
+    }
+}  // namespace
+
+std::vector<MatchScenario> getDefaultMatchScenarios(const Field& field)
+{
+    MatchScenario kickoff;
+    kickoff.name  = "kickoff";
+    kickoff.setup = [field](Simulator& simulator) {
+        lineUpTeams(simulator);
+        simulator.setBallState(field.centerPoint(), Vector());
+    };
+    kickoff.refbox_game_states = {
+        {Duration::fromSeconds(0), RefboxGameState::PREPARE_KICKOFF_US},
+        {RESTART_SETUP_DURATION, RefboxGameState::NORMAL_START}};
+    kickoff.duration = Duration::fromSeconds(15);
+
+    // The corner kick is taken from just inside the enemy corner. The CornerKickPlay is
+    // forced, since it is only chosen automatically for the ball in a friendly corner
+    MatchScenario corner_kick;
+    corner_kick.name  = "corner_kick";
+    corner_kick.setup = [field](Simulator& simulator) {
+        lineUpTeams(simulator);
+        simulator.setBallState(field.enemyCornerPos() + Vector(-0.1, -0.1), Vector());
+    };
+    corner_kick.refbox_game_states = {
+        {Duration::fromSeconds(0), RefboxGameState::DIRECT_FREE_US}};
+    corner_kick.duration       = Duration::fromSeconds(15);
+    corner_kick.set_parameters = []() {
+        Util::DynamicParameters::AI::override_ai_play.setThreadLocalValue(true);
+        Util::DynamicParameters::AI::current_ai_play.setThreadLocalValue(
+            CornerKickPlay::name);
+    };
+
+    MatchScenario penalty_kick;
+    penalty_kick.name  = "penalty_kick";
+    penalty_kick.setup = [field](Simulator& simulator) {
+        lineUpTeams(simulator);
+        // The enemy goalie waits on its goal line
+        simulator.addEnemyRobot(0, field.enemyGoal() - Vector(ROBOT_MAX_RADIUS_METERS, 0),
+                                Angle::half());
+        simulator.setBallState(field.penaltyEnemy(), Vector());
+    };
+    penalty_kick.refbox_game_states = {
+        {Duration::fromSeconds(0), RefboxGameState::PREPARE_PENALTY_US},
+        {RESTART_SETUP_DURATION, RefboxGameState::NORMAL_START}};
+    penalty_kick.duration = Duration::fromSeconds(10);
+
+    // An enemy has just shot at our goal from the edge of our half
+    MatchScenario defense;
+    defense.name  = "defense";
+    defense.setup = [field](Simulator& simulator) {
+        lineUpTeams(simulator);
+        Point shot_origin(-1.0, 1.0);
+        simulator.addEnemyRobot(NUM_ROBOTS_PER_TEAM, shot_origin + Vector(0.2, 0),
+                                Angle::half());
+        simulator.setBallState(shot_origin,
+                               (field.friendlyGoal() - shot_origin).norm(3.0));
+    };
+    defense.refbox_game_states = {
+        {Duration::fromSeconds(0), RefboxGameState::FORCE_START}};
+    defense.duration = Duration::fromSeconds(10);
+
+    return {kickoff, corner_kick, penalty_kick, defense};
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ai/world/field.h"
+#include "backend/simulator/simulator.h"
+#include "util/refbox_constants.h"
+#include "util/time/duration.h"
+
+/**
+ * A scripted situation to run the AI through in the Simulator, such as a kickoff or a
+ * penalty kick
+ */
+struct MatchScenario
+{
+    // The name of the scenario, used to group and report results
+    std::string name;
+
+    // Places the robots and the ball in the simulator before the match starts
+    std::function<void(Simulator&)> setup;
+
+    // The refbox game states given to the AI, each with how long after the start of the
+    // match it is given. These must be in order of time
+    std::vector<std::pair<Duration, RefboxGameState>> refbox_game_states;
+
+    // How long the match runs for if no goal is scored
+    Duration duration;
+
+    // Sets any parameters the scenario needs with Parameter::setThreadLocalValue. This
+    // is called on the thread that runs the match, so matches on other threads are not
+    // affected. May be empty
+    std::function<void()> set_parameters;
+};
+
+/**
+ * Returns the scenarios used to benchmark the AI: a kickoff, a corner kick, a penalty
+ * kick and defending against a shot, each starting from the same lineup
+ *
+ * @param field The field the scenarios are played on
+ *
+ * @return the scenarios used to benchmark the AI
+ */
+std::vector<MatchScenario> getDefaultMatchScenarios(const Field& field);
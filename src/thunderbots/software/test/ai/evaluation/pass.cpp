@@ -82,8 +82,8 @@ TEST(PassingEvaluationTest, getTimeToPositionForRobot_reaches_max_velocity)
 
     double travel_time = 2 * acceleration_time + time_at_max_vel;
 
-    EXPECT_EQ(Duration::fromSeconds(travel_time),
-              getTimeToPositionForRobot(robot, dest, 2.0, 3.0));
+    EXPECT_NEAR(travel_time,
+                getTimeToPositionForRobot(robot, dest, 2.0, 3.0).getSeconds(), 1e-9);
 }
 
 TEST(PassingEvaluationTest, getTimeToPositionForRobot_reaches_max_velocity_with_tolerance)
@@ -117,6 +117,35 @@ TEST(PassingEvaluationTest, getTimeToPositionForRobot_reaches_max_velocity_with_
 
     double travel_time = 2 * acceleration_time + time_at_max_vel;
 
-    EXPECT_EQ(Duration::fromSeconds(travel_time),
-              getTimeToPositionForRobot(robot, target_location, 2.0, 3.0, 0.5));
+    EXPECT_NEAR(
+        travel_time,
+        getTimeToPositionForRobot(robot, target_location, 2.0, 3.0, 0.5).getSeconds(),
+        1e-9);
+}
+
+TEST(PassingEvaluationTest, getTimeToPositionForRobot_accounts_for_robot_velocity)
+{
+    // A robot already moving towards the dest should get there sooner than a stationary
+    // robot, and a robot moving away from it should take longer
+    Point dest(2, 0);
+    Robot stationary_robot(0, Point(0, 0), Vector(0, 0), Angle::zero(),
+                           AngularVelocity::zero(), Timestamp::fromSeconds(0));
+    Robot robot_moving_towards_dest(1, Point(0, 0), Vector(1, 0), Angle::zero(),
+                                    AngularVelocity::zero(), Timestamp::fromSeconds(0));
+    Robot robot_moving_away_from_dest(2, Point(0, 0), Vector(-1, 0), Angle::zero(),
+                                      AngularVelocity::zero(), Timestamp::fromSeconds(0));
+
+    Duration stationary_time =
+        getTimeToPositionForRobot(stationary_robot, dest, 2.0, 3.0);
+    EXPECT_LT(getTimeToPositionForRobot(robot_moving_towards_dest, dest, 2.0, 3.0),
+              stationary_time);
+    EXPECT_GT(getTimeToPositionForRobot(robot_moving_away_from_dest, dest, 2.0, 3.0),
+              stationary_time);
+
+    // Braking from 1m/s takes 1/3s, then the robot is 1/6m further from the dest than it
+    // started. It has 2 1/6m to go, so it can just reach max velocity
+    EXPECT_NEAR(1.0 / 3 + 2 * 2.0 / 3 + (2 + 1.0 / 6 - 4.0 / 3) / 2.0,
+                getTimeToPositionForRobot(robot_moving_away_from_dest, dest, 2.0, 3.0)
+                    .getSeconds(),
+                1e-9);
 }
@@ -152,6 +152,72 @@ TEST(GetNumPassesToRobotTest, one_simple_pass_to_robot_with_no_obstacles)
     EXPECT_EQ(passer.value(), friendly_robot_0);
 }
 
+TEST(GetPassReachabilityGraphTest, no_robots)
+{
+    EXPECT_TRUE(Evaluation::getPassReachabilityGraph({}).empty());
+}
+
+TEST(GetPassReachabilityGraphTest, middle_robot_blocks_pass_between_outer_robots)
+{
+    Robot robot_0 = Robot(0, Point(0, 0), Vector(0, 0), Angle::zero(),
+                          AngularVelocity::zero(), Timestamp::fromSeconds(0));
+    Robot robot_1 = Robot(1, Point(2, 0), Vector(0, 0), Angle::zero(),
+                          AngularVelocity::zero(), Timestamp::fromSeconds(0));
+    Robot robot_2 = Robot(2, Point(4, 0), Vector(0, 0), Angle::zero(),
+                          AngularVelocity::zero(), Timestamp::fromSeconds(0));
+
+    auto result = Evaluation::getPassReachabilityGraph({robot_0, robot_1, robot_2});
+
+    // Robot 1 can pass to both other robots, but blocks the pass between them
+    std::vector<uint64_t> expected_result = {0b010, 0b101, 0b010};
+    EXPECT_EQ(expected_result, result);
+}
+
+TEST(GetNumPassesToAllRobotsTest, passes_around_a_blocking_robot)
+{
+    Robot friendly_robot_0 = Robot(0, Point(0, 0), Vector(0, 0), Angle::zero(),
+                                   AngularVelocity::zero(), Timestamp::fromSeconds(0));
+    Robot friendly_robot_1 = Robot(1, Point(2, 0), Vector(0, 0), Angle::zero(),
+                                   AngularVelocity::zero(), Timestamp::fromSeconds(0));
+    Robot friendly_robot_2 = Robot(2, Point(4, 0), Vector(0, 0), Angle::zero(),
+                                   AngularVelocity::zero(), Timestamp::fromSeconds(0));
+    Team friendly_team     = Team(Duration::fromSeconds(1));
+    friendly_team.updateRobots({friendly_robot_0, friendly_robot_1, friendly_robot_2});
+
+    Team enemy_team = Team(Duration::fromSeconds(1));
+
+    auto result =
+        Evaluation::getNumPassesToAllRobots(friendly_robot_0, friendly_team, enemy_team);
+
+    // There should be a result for every robot on the team, in the same order
+    ASSERT_EQ(friendly_team.getAllRobots().size(), result.size());
+    for (std::size_t i = 0; i < result.size(); i++)
+    {
+        const Robot &robot = friendly_team.getAllRobots().at(i);
+        ASSERT_TRUE(result.at(i));
+        EXPECT_EQ(Evaluation::getNumPassesToRobot(friendly_robot_0, robot,
+                                                  friendly_team, enemy_team),
+                  result.at(i));
+
+        if (robot == friendly_robot_0)
+        {
+            EXPECT_EQ(0, result.at(i)->first);
+            EXPECT_FALSE(result.at(i)->second);
+        }
+        else if (robot == friendly_robot_1)
+        {
+            EXPECT_EQ(1, result.at(i)->first);
+            EXPECT_EQ(friendly_robot_0, result.at(i)->second);
+        }
+        else
+        {
+            // Robot 1 blocks the direct pass, so the ball must go through it
+            EXPECT_EQ(2, result.at(i)->first);
+            EXPECT_EQ(friendly_robot_1, result.at(i)->second);
+        }
+    }
+}
+
 // TODO: Re-enable as part of https://github.com/UBC-Thunderbots/Software/issues/642
 // TEST(GetNumPassesToRobotTest, two_passes_around_a_single_obstacle)
 //{
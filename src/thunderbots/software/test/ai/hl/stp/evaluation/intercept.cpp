@@ -258,3 +258,49 @@ TEST(InterceptEvaluationTest, findBestInterceptForBall_ball_moving_too_fast_to_i
     auto best_intercept = Evaluation::findBestInterceptForBall(ball, field, robot);
     ASSERT_FALSE(best_intercept);
 }
+
+TEST(InterceptEvaluationTest, findBestInterceptsForBall_matches_single_robot_results)
+{
+    Field field = ::Test::TestUtil::createSSLDivBField();
+    Ball ball({0, 0}, {1, 0}, Timestamp::fromSeconds(0));
+    Robot robot_0(0, {2, 0.2}, {0, 0}, Angle::zero(), AngularVelocity::zero(),
+                  Timestamp::fromSeconds(0));
+    Robot robot_1(1, {-3, 2}, {0, 0}, Angle::zero(), AngularVelocity::zero(),
+                  Timestamp::fromSeconds(0));
+    std::vector<Robot> robots = {robot_0, robot_1};
+
+    auto intercepts = Evaluation::findBestInterceptsForBall(ball, field, robots);
+
+    ASSERT_EQ(2, intercepts.size());
+    EXPECT_EQ(Evaluation::findBestInterceptForBall(ball, field, robot_0), intercepts[0]);
+    EXPECT_EQ(Evaluation::findBestInterceptForBall(ball, field, robot_1), intercepts[1]);
+}
+
+TEST(InterceptEvaluationTest, findFastestInterceptForBall_picks_robot_on_ball_path)
+{
+    Field field = ::Test::TestUtil::createSSLDivBField();
+    Ball ball({0, 0}, {1, 0}, Timestamp::fromSeconds(0));
+    Robot far_robot(0, {-3, 2}, {0, 0}, Angle::zero(), AngularVelocity::zero(),
+                    Timestamp::fromSeconds(0));
+    Robot near_robot(1, {1, 0}, {0, 0}, Angle::zero(), AngularVelocity::zero(),
+                     Timestamp::fromSeconds(0));
+
+    auto fastest_intercept =
+        Evaluation::findFastestInterceptForBall(ball, field, {far_robot, near_robot});
+
+    ASSERT_TRUE(fastest_intercept);
+    EXPECT_EQ(1, fastest_intercept->first);
+    EXPECT_EQ(Evaluation::findBestInterceptForBall(ball, field, near_robot),
+              fastest_intercept->second);
+}
+
+TEST(InterceptEvaluationTest, findFastestInterceptForBall_no_robots_can_intercept)
+{
+    Field field = ::Test::TestUtil::createSSLDivBField();
+    Ball ball({3, 3}, {1, 1}, Timestamp::fromSeconds(0));
+    Robot robot(0, {2, 0}, {0, 0}, Angle::zero(), AngularVelocity::zero(),
+                Timestamp::fromSeconds(0));
+
+    EXPECT_FALSE(Evaluation::findFastestInterceptForBall(ball, field, {robot}));
+    EXPECT_FALSE(Evaluation::findFastestInterceptForBall(ball, field, {}));
+}
@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <exception>
 
 #include "test/ai/hl/stp/test_plays/halt_test_play.h"
@@ -42,3 +43,47 @@ TEST(PlayFactoryTest, test_get_registered_play_constructors)
     // as the number of TestPlays, since the number of "real" Plays can change a lot
     EXPECT_GE(registered_constructors.size(), 2);
 }
+
+TEST(PlayFactoryTest, test_get_play_id_with_valid_name)
+{
+    auto play_id = PlayFactory::getPlayId(MoveTestPlay::name);
+
+    ASSERT_TRUE(play_id);
+    EXPECT_EQ(MoveTestPlay::name, PlayFactory::getPlayName(*play_id));
+}
+
+TEST(PlayFactoryTest, test_get_play_id_with_invalid_name)
+{
+    EXPECT_FALSE(PlayFactory::getPlayId("_FooBar_"));
+    EXPECT_FALSE(PlayFactory::getPlayId(""));
+}
+
+TEST(PlayFactoryTest, test_every_registered_play_name_maps_to_its_own_id)
+{
+    auto registered_names = PlayFactory::getRegisteredPlayNames();
+    for (PlayId id = 0; id < registered_names.size(); id++)
+    {
+        EXPECT_EQ(std::make_optional(id), PlayFactory::getPlayId(registered_names[id]));
+    }
+}
+
+TEST(PlayFactoryTest, test_registered_play_names_are_sorted)
+{
+    auto registered_names = PlayFactory::getRegisteredPlayNames();
+    EXPECT_TRUE(std::is_sorted(registered_names.begin(), registered_names.end()));
+}
+
+TEST(PlayFactoryTest, test_create_play_with_valid_id)
+{
+    auto play_ptr = PlayFactory::createPlay(*PlayFactory::getPlayId(HaltTestPlay::name));
+
+    ASSERT_TRUE(play_ptr);
+    EXPECT_EQ(HaltTestPlay::name, play_ptr->getName());
+}
+
+TEST(PlayFactoryTest, test_create_play_with_invalid_id)
+{
+    PlayId invalid_id = PlayFactory::getRegisteredPlayNames().size();
+    EXPECT_THROW(PlayFactory::createPlay(invalid_id), std::invalid_argument);
+    EXPECT_THROW(PlayFactory::getPlayName(invalid_id), std::invalid_argument);
+}
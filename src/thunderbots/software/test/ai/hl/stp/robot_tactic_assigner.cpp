@@ -0,0 +1,159 @@
+#include "ai/hl/stp/robot_tactic_assigner.h"
+
+#include <gtest/gtest.h>
+
+#include "test/ai/hl/stp/test_tactics/move_test_tactic.h"
+#include "test/ai/hl/stp/test_tactics/stop_test_tactic.h"
+#include "test/test_util/test_util.h"
+
+class RobotTacticAssignerTest : public ::testing::Test
+{
+   protected:
+    void SetUp() override
+    {
+        world = ::Test::TestUtil::createBlankTestingWorld();
+        world = ::Test::TestUtil::setFriendlyRobotPositions(
+            world, {Point(-1, 0), Point(1, 0), Point(0, 3)}, Timestamp::fromSeconds(0));
+    }
+
+    World world;
+    RobotTacticAssigner assigner;
+};
+
+TEST_F(RobotTacticAssignerTest, test_no_tactics_returns_empty_assignment)
+{
+    auto assignment =
+        assigner.assign(world, world.friendlyTeam().getAllRobots(), {});
+
+    EXPECT_TRUE(assignment.empty());
+    EXPECT_EQ(0, assigner.getStats().num_tactics_assigned);
+}
+
+TEST_F(RobotTacticAssignerTest, test_more_tactics_than_robots_throws_exception)
+{
+    std::vector<std::shared_ptr<Tactic>> tactics = {
+        std::make_shared<StopTestTactic>(), std::make_shared<StopTestTactic>()};
+
+    EXPECT_THROW(assigner.assign(world, {world.friendlyTeam().getAllRobots().at(0)},
+                                 tactics),
+                 std::invalid_argument);
+}
+
+TEST_F(RobotTacticAssignerTest, test_assignment_contains_index_of_robot_for_each_tactic)
+{
+    auto move_tactic_1 = std::make_shared<MoveTestTactic>();
+    auto move_tactic_2 = std::make_shared<MoveTestTactic>();
+    move_tactic_1->updateParams(Point(0, 2.5));
+    move_tactic_2->updateParams(Point(1.5, 0));
+    std::vector<std::shared_ptr<Tactic>> tactics = {move_tactic_1, move_tactic_2};
+
+    auto assignment =
+        assigner.assign(world, world.friendlyTeam().getAllRobots(), tactics);
+
+    ASSERT_EQ(2, assignment.size());
+    EXPECT_EQ(2, assignment.at(0));
+    EXPECT_EQ(1, assignment.at(1));
+    EXPECT_DOUBLE_EQ(0.1, assigner.getStats().total_cost);
+}
+
+TEST_F(RobotTacticAssignerTest, test_repeated_assignment_keeps_robots)
+{
+    auto move_tactic = std::make_shared<MoveTestTactic>();
+    move_tactic->updateParams(Point(0, 2.5));
+    std::vector<std::shared_ptr<Tactic>> tactics = {move_tactic};
+
+    assigner.assign(world, world.friendlyTeam().getAllRobots(), tactics);
+    auto assignment =
+        assigner.assign(world, world.friendlyTeam().getAllRobots(), tactics);
+
+    ASSERT_EQ(1, assignment.size());
+    EXPECT_EQ(2, assignment.at(0));
+    EXPECT_EQ(1, assigner.getStats().num_tactics_kept_robot);
+    EXPECT_EQ(0, assigner.getStats().num_tactics_changed_robot);
+}
+
+TEST_F(RobotTacticAssignerTest, test_costs_follow_tactic_params_when_world_is_unchanged)
+{
+    auto move_tactic = std::make_shared<MoveTestTactic>();
+    move_tactic->updateParams(Point(0, 2.5));
+    std::vector<std::shared_ptr<Tactic>> tactics = {move_tactic};
+    assigner.assign(world, world.friendlyTeam().getAllRobots(), tactics);
+
+    // Plays update their tactics every tick, often without the World changing
+    move_tactic->updateParams(Point(-1, 0.5));
+    auto assignment =
+        assigner.assign(world, world.friendlyTeam().getAllRobots(), tactics);
+
+    ASSERT_EQ(1, assignment.size());
+    EXPECT_EQ(0, assignment.at(0));
+    EXPECT_EQ(1, assigner.getStats().num_tactics_changed_robot);
+}
+
+TEST_F(RobotTacticAssignerTest, test_assignment_follows_robots_when_the_world_changes)
+{
+    auto move_tactic = std::make_shared<MoveTestTactic>();
+    move_tactic->updateParams(Point(0, 2.5));
+    std::vector<std::shared_ptr<Tactic>> tactics = {move_tactic};
+    assigner.assign(world, world.friendlyTeam().getAllRobots(), tactics);
+
+    // Move robot 2 far away from the destination, so robot 0 is now the closest robot
+    world = ::Test::TestUtil::setFriendlyRobotPositions(
+        world, {Point(-1, 2), Point(1, 0), Point(0, -3)}, Timestamp::fromSeconds(1));
+    auto assignment =
+        assigner.assign(world, world.friendlyTeam().getAllRobots(), tactics);
+
+    ASSERT_EQ(1, assignment.size());
+    EXPECT_EQ(0, assignment.at(0));
+    EXPECT_EQ(0, assigner.getStats().num_tactics_kept_robot);
+    EXPECT_EQ(1, assigner.getStats().num_tactics_changed_robot);
+    EXPECT_EQ(1, assigner.getStats().total_num_tactics_changed_robot);
+}
+
+TEST_F(RobotTacticAssignerTest, test_robots_keep_their_tactics_when_costs_are_tied)
+{
+    auto stop_tactic_1 = std::make_shared<StopTestTactic>();
+    auto stop_tactic_2 = std::make_shared<StopTestTactic>();
+    auto stop_tactic_3 = std::make_shared<StopTestTactic>();
+    std::vector<std::shared_ptr<Tactic>> tactics = {stop_tactic_1, stop_tactic_2,
+                                                    stop_tactic_3};
+
+    auto first_assignment =
+        assigner.assign(world, world.friendlyTeam().getAllRobots(), tactics);
+    EXPECT_EQ(std::vector<std::size_t>({0, 1, 2}), first_assignment);
+
+    // Without warm-starting, the first tactic would always be assigned the first robot
+    // since every cost is the same
+    std::reverse(tactics.begin(), tactics.end());
+    auto second_assignment =
+        assigner.assign(world, world.friendlyTeam().getAllRobots(), tactics);
+
+    EXPECT_EQ(std::vector<std::size_t>({2, 1, 0}), second_assignment);
+    EXPECT_EQ(3, assigner.getStats().num_warm_started_pairs);
+    EXPECT_EQ(3, assigner.getStats().num_tactics_kept_robot);
+    EXPECT_EQ(0, assigner.getStats().num_tactics_changed_robot);
+}
+
+TEST_F(RobotTacticAssignerTest, test_warm_start_does_not_keep_suboptimal_assignment)
+{
+    auto move_tactic_1 = std::make_shared<MoveTestTactic>();
+    auto move_tactic_2 = std::make_shared<MoveTestTactic>();
+    move_tactic_1->updateParams(Point(-1, 0.5));
+    move_tactic_2->updateParams(Point(1, 0.5));
+    std::vector<std::shared_ptr<Tactic>> tactics = {move_tactic_1, move_tactic_2};
+
+    auto first_assignment =
+        assigner.assign(world, world.friendlyTeam().getAllRobots(), tactics);
+    EXPECT_EQ(std::vector<std::size_t>({0, 1}), first_assignment);
+
+    // Swap the destinations, so the robots should swap tactics
+    move_tactic_1->updateParams(Point(1, 0.5));
+    move_tactic_2->updateParams(Point(-1, 0.5));
+    world = ::Test::TestUtil::setBallPosition(world, Point(0, 0),
+                                              Timestamp::fromSeconds(1));
+    auto second_assignment =
+        assigner.assign(world, world.friendlyTeam().getAllRobots(), tactics);
+
+    EXPECT_EQ(std::vector<std::size_t>({1, 0}), second_assignment);
+    EXPECT_EQ(0, assigner.getStats().num_warm_started_pairs);
+    EXPECT_EQ(2, assigner.getStats().num_tactics_changed_robot);
+}
@@ -0,0 +1,154 @@
+#include "backend/firmware_in_the_loop/firmware_in_the_loop.h"
+
+#include <gtest/gtest.h>
+
+#include <functional>
+
+#include "ai/primitive/move_primitive.h"
+#include "backend/output/radio/mrf/packet_encoding.h"
+#include "shared/constants.h"
+#include "test/test_util/test_util.h"
+
+class FirmwareInTheLoopTest : public ::testing::Test
+{
+   protected:
+    FirmwareInTheLoopTest() : firmware_in_the_loop(::Test::TestUtil::createSSLDivBField())
+    {
+    }
+
+    /**
+     * Sends the given primitives every time the AI would get a new World, for the given
+     * duration
+     */
+    void runPrimitives(std::function<ConstPrimitiveVectorPtr()> create_primitives,
+                       const Duration& duration)
+    {
+        const Duration world_period = Duration::fromSeconds(1.0 / 60.0);
+        for (Duration time = Duration::fromSeconds(0); time < duration;
+             time = time + world_period)
+        {
+            firmware_in_the_loop.setFriendlyPrimitives(create_primitives());
+            firmware_in_the_loop.stepSimulation(world_period);
+        }
+    }
+
+    /**
+     * Returns a primitive vector that moves the given robot to the given destination
+     */
+    static ConstPrimitiveVectorPtr createMovePrimitive(unsigned int id,
+                                                       const Point& destination)
+    {
+        auto primitives = std::make_shared<std::vector<std::unique_ptr<Primitive>>>();
+        primitives->emplace_back(
+            std::make_unique<MovePrimitive>(id, destination, Angle::zero(), 0.0));
+        return primitives;
+    }
+
+    FirmwareInTheLoop firmware_in_the_loop;
+};
+
+TEST_F(FirmwareInTheLoopTest, simulated_time_advances_in_ticks)
+{
+    for (int i = 0; i < 60; i++)
+    {
+        firmware_in_the_loop.stepSimulation(Duration::fromSeconds(1.0 / 60.0));
+    }
+    EXPECT_NEAR(1.0, firmware_in_the_loop.getSimulatedTime().getSeconds(), 1e-9);
+    EXPECT_NEAR(1.0,
+                firmware_in_the_loop.getWorld().getMostRecentTimestamp().getSeconds(),
+                1e-9);
+}
+
+TEST_F(FirmwareInTheLoopTest, robots_start_stopped_where_they_are_placed)
+{
+    firmware_in_the_loop.addFriendlyRobot(0, Point(-1, 0.5), Angle::quarter());
+    firmware_in_the_loop.addFriendlyRobot(3, Point(2, -1), Angle::zero());
+    firmware_in_the_loop.stepSimulation(Duration::fromSeconds(0.5));
+
+    World world = firmware_in_the_loop.getWorld();
+    ASSERT_EQ(2, world.friendlyTeam().numRobots());
+    Robot robot0 = *world.friendlyTeam().getRobotById(0);
+    EXPECT_TRUE(robot0.position().isClose(Point(-1, 0.5), 1e-6));
+    EXPECT_NEAR(Angle::quarter().toRadians(), robot0.orientation().toRadians(), 1e-6);
+    EXPECT_TRUE(world.friendlyTeam().getRobotById(3)->position().isClose(Point(2, -1),
+                                                                           1e-6));
+    EXPECT_EQ(0, world.enemyTeam().numRobots());
+    EXPECT_EQ(world.field().centerPoint(), world.ball().position());
+}
+
+TEST_F(FirmwareInTheLoopTest, move_primitive_drives_robot_to_destination)
+{
+    firmware_in_the_loop.addFriendlyRobot(0, Point(0, 0), Angle::zero());
+
+    // Before the AI sends anything, the robot applies the dongle's default drive data.
+    // The first primitive must still be applied from the first drive frame carrying it
+    firmware_in_the_loop.stepSimulation(Duration::fromSeconds(0.1));
+    firmware_in_the_loop.setFriendlyPrimitives(createMovePrimitive(0, Point(1, 0.5)));
+    firmware_in_the_loop.stepSimulation(Duration::fromSeconds(0.02));
+    std::vector<RobotStatus> robot_statuses = firmware_in_the_loop.getRobotStatuses();
+    ASSERT_EQ(1, robot_statuses.size());
+    EXPECT_TRUE(robot_statuses[0].drive_ack_valid);
+    EXPECT_EQ(MRF::FIRST_DRIVE_SEQUENCE_NUMBER,
+              robot_statuses[0].last_applied_drive_sequence_number);
+    EXPECT_EQ(0, robot_statuses[0].drive_primitives_behind);
+
+    runPrimitives([]() { return createMovePrimitive(0, Point(1, 0.5)); },
+                  Duration::fromSeconds(4.0));
+
+    Robot robot = *firmware_in_the_loop.getWorld().friendlyTeam().getRobotById(0);
+    EXPECT_TRUE(robot.position().isClose(Point(1, 0.5), 0.05));
+    EXPECT_LT(robot.velocity().len(), 0.1);
+}
+
+TEST_F(FirmwareInTheLoopTest, each_robot_runs_its_own_firmware)
+{
+    for (unsigned int id = 0; id < MAX_ROBOTS_OVER_RADIO; id++)
+    {
+        firmware_in_the_loop.addFriendlyRobot(id, Point(-2, -2.0 + 0.5 * id),
+                                              Angle::zero());
+    }
+    runPrimitives([]() { return createMovePrimitive(5, Point(0, 0)); },
+                  Duration::fromSeconds(4.0));
+
+    World world = firmware_in_the_loop.getWorld();
+    for (unsigned int id = 0; id < MAX_ROBOTS_OVER_RADIO; id++)
+    {
+        Point expected_position = id == 5 ? Point(0, 0) : Point(-2, -2.0 + 0.5 * id);
+        EXPECT_TRUE(
+            world.friendlyTeam().getRobotById(id)->position().isClose(expected_position,
+                                                                       0.05))
+            << "robot " << id;
+    }
+}
+
+TEST_F(FirmwareInTheLoopTest, reports_drive_latency_and_cpu_profile)
+{
+    firmware_in_the_loop.addFriendlyRobot(2, Point(0, 0), Angle::zero());
+    runPrimitives([]() { return createMovePrimitive(2, Point(1, 0)); },
+                  Duration::fromSeconds(1.5));
+
+    std::vector<RobotStatus> robot_statuses = firmware_in_the_loop.getRobotStatuses();
+    ASSERT_EQ(1, robot_statuses.size());
+    RobotStatus robot_status = robot_statuses[0];
+    EXPECT_EQ(2, robot_status.robot);
+
+    // The dongle sends drive packets every 20 ms, and primitives are sent more often than
+    // that, so the robot is always a primitive or two behind and applies them within a
+    // drive packet period
+    EXPECT_TRUE(robot_status.drive_ack_valid);
+    EXPECT_LE(robot_status.drive_primitives_behind, 2);
+    EXPECT_TRUE(robot_status.drive_latency_valid);
+    EXPECT_LE(robot_status.drive_latency_ms, 20.0);
+
+    EXPECT_TRUE(robot_status.cpu_profile_valid);
+    EXPECT_GT(robot_status.normal_tick_mean_us, 0.0);
+    EXPECT_GE(robot_status.normal_tick_max_us, robot_status.normal_tick_mean_us);
+    EXPECT_EQ("primitive", robot_status.busiest_module);
+}
+
+TEST_F(FirmwareInTheLoopTest, robot_id_too_large_for_radio_throws)
+{
+    EXPECT_THROW(
+        firmware_in_the_loop.addFriendlyRobot(MAX_ROBOTS_OVER_RADIO, Point(), Angle()),
+        std::invalid_argument);
+}
@@ -3,8 +3,10 @@
 #include <google/protobuf/util/message_differencer.h>
 #include <gtest/gtest.h>
 
+#include <boost/asio.hpp>
 #include <limits>
 
+#include "ai/primitive/direct_velocity_primitive.h"
 #include "proto/grSim_Commands.pb.h"
 #include "proto/grSim_Packet.pb.h"
 
@@ -271,3 +273,45 @@ TEST(GrSimOutputTest, create_grsim_packet_with_dribbler_on)
         google::protobuf::util::MessageDifferencer::Equals(result, expected);
     EXPECT_TRUE(messages_equal);
 }
+
+TEST(GrSimOutputTest, send_primitives_sends_one_packet_for_all_robots)
+{
+    // Listen for the packets sent to grSim on any free port
+    boost::asio::io_service io_service;
+    boost::asio::ip::udp::socket receiver(
+        io_service, boost::asio::ip::udp::endpoint(
+                        boost::asio::ip::address::from_string("127.0.0.1"), 0));
+    GrSimOutput backend("127.0.0.1", receiver.local_endpoint().port());
+
+    Timestamp timestamp = Timestamp::fromSeconds(0);
+    Team friendly_team(Duration::fromSeconds(10),
+                       {Robot(0, Point(0, 0), Vector(), Angle::zero(),
+                              AngularVelocity::zero(), timestamp),
+                        Robot(3, Point(1, 1), Vector(), Angle::zero(),
+                              AngularVelocity::zero(), timestamp)});
+    Ball ball(Point(), Vector(), timestamp);
+
+    std::vector<std::unique_ptr<Primitive>> primitives;
+    primitives.emplace_back(std::make_unique<DirectVelocityPrimitive>(0, 0, 0, 0, 0));
+    primitives.emplace_back(std::make_unique<DirectVelocityPrimitive>(3, 0, 0, 0, 0));
+    // There is no robot with this id, so no command is sent for it
+    primitives.emplace_back(std::make_unique<DirectVelocityPrimitive>(5, 0, 0, 0, 0));
+
+    backend.sendPrimitives(primitives, friendly_team, ball);
+    backend.sendPrimitives(primitives, friendly_team, ball);
+
+    // Both calls send exactly one packet, holding the commands for both robots
+    for (int i = 0; i < 2; i++)
+    {
+        ASSERT_GT(receiver.available(), 0);
+        std::array<char, 1024> data;
+        std::size_t length = receiver.receive(boost::asio::buffer(data));
+
+        grSim_Packet packet;
+        ASSERT_TRUE(packet.ParseFromArray(data.data(), static_cast<int>(length)));
+        ASSERT_EQ(2, packet.commands().robot_commands_size());
+        EXPECT_EQ(0, packet.commands().robot_commands(0).id());
+        EXPECT_EQ(3, packet.commands().robot_commands(1).id());
+    }
+    EXPECT_EQ(0, receiver.available());
+}
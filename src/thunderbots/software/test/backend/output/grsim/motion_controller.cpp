@@ -7,6 +7,7 @@
 #include "geom/angle.h"
 #include "gtest/gtest.h"
 #include "shared/constants.h"
+#include "shared/trajectory.h"
 
 
 using namespace std::chrono;
@@ -153,7 +154,9 @@ TEST_F(MotionControllerTest, no_overspeed_ang_acceleration_test)
 {
     Robot robot              = Robot(4, Point(-1, -1), Vector(0, 0), Angle::ofRadians(0),
                         AngularVelocity::ofRadians(-3.9), current_time);
-    double delta_time        = 1;
+    // The robot reaches the destination angle in under a second, so we use a short time
+    // step to see it while it is still turning as fast as it can
+    double delta_time        = 0.1;
     Point destination        = Point(-1, -1);
     Angle destination_angle  = Angle::ofDegrees(210);
     double destination_speed = 0;
@@ -1079,3 +1082,49 @@ TEST_F(MotionControllerTest, velocity_command_velocity_above_max_speed)
                 calculateVelocityTolerance(expected_linear_velocity.len()));
     EXPECT_EQ(expected_angular_velocity, robot_velocities.angular_velocity);
 }
+
+TEST_F(MotionControllerTest, reaches_destination_in_planned_trajectory_time)
+{
+    // The robot starts moving sideways to the destination, so the controller has to
+    // cancel that velocity while moving towards the destination
+    Vector initial_velocity(0, 1.5);
+    Robot robot = Robot(4, Point(-2, 0), initial_velocity, Angle::ofRadians(0),
+                        AngularVelocity::ofRadians(0), current_time);
+    const double delta_time  = TIME_STEP;
+    Point destination        = Point(1, -0.5);
+    Angle destination_angle  = Angle::ofDegrees(0);
+    double destination_speed = 0;
+
+    MotionController::PositionCommand position_command(
+        destination, destination_angle, destination_speed, 0, false, false);
+    MotionControllerCommand motion_command;
+    motion_command.emplace<MotionController::PositionCommand>(position_command);
+
+    // The AI estimates how long robots take to move using the same trajectory
+    Vector displacement     = destination - robot.position();
+    Trajectory2D trajectory =
+        planTrajectory2D({displacement.x(), displacement.y()},
+                         {initial_velocity.x(), initial_velocity.y()},
+                         ROBOT_MAX_SPEED_METERS_PER_SECOND,
+                         ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED);
+    int planned_steps =
+        static_cast<int>(std::ceil(getTrajectory2DDuration(&trajectory) / delta_time));
+
+    // Allow a little extra time to settle, since the simulated robot lags one step
+    // behind the commanded velocity
+    for (int iteration_count = 0; iteration_count < planned_steps + 50; iteration_count++)
+    {
+        MotionController::Velocity robot_velocities =
+            motionController.bangBangVelocityController(robot, delta_time,
+                                                        motion_command);
+
+        Point new_position = robot.position() + robot.velocity() * delta_time;
+        robot.updateState(new_position, robot_velocities.linear_velocity,
+                          robot.orientation(), robot_velocities.angular_velocity,
+                          current_time);
+    }
+
+    EXPECT_NEAR(robot.position().x(), destination.x(), POSITION_TOLERANCE);
+    EXPECT_NEAR(robot.position().y(), destination.y(), POSITION_TOLERANCE);
+    EXPECT_NEAR(robot.velocity().len(), 0, calculateVelocityTolerance(0));
+}
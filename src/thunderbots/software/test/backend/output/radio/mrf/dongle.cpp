@@ -0,0 +1,324 @@
+#include "backend/output/radio/mrf/dongle.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ai/primitive/stop_primitive.h"
+#include "backend/output/radio/mrf/messages.h"
+#include "backend/output/radio/mrf/send_reliable_message_operation.h"
+#include "test/test_util/mrf_dongle_emulator.h"
+
+class MRFDongleTest : public ::testing::Test
+{
+   protected:
+    MRFDongleTest()
+        : annunciator([this](RobotStatus robot_status) {
+              std::lock_guard<std::mutex> lock(robot_statuses_mutex);
+              robot_statuses.push_back(robot_status);
+          }),
+          dongle(0, annunciator, false)
+    {
+    }
+
+    std::vector<RobotStatus> getRobotStatuses()
+    {
+        std::lock_guard<std::mutex> lock(robot_statuses_mutex);
+        return robot_statuses;
+    }
+
+    const std::chrono::milliseconds TIMEOUT = std::chrono::milliseconds(1000);
+
+    // The emulator must outlive the dongle, so it is declared first
+    ::Test::MRFDongleEmulator emulator;
+    std::mutex robot_statuses_mutex;
+    std::vector<RobotStatus> robot_statuses;
+    Annunciator annunciator;
+    MRFDongle dongle;
+};
+
+TEST_F(MRFDongleTest, configures_radio_on_construction)
+{
+    EXPECT_EQ(24, emulator.getChannel());
+    EXPECT_EQ(250, emulator.getSymbolRate());
+    EXPECT_EQ(0x1846, emulator.getPanId());
+    EXPECT_EQ(UINT64_C(0x20cb13bd834ab817), emulator.getMacAddress());
+}
+
+TEST_F(MRFDongleTest, sends_drive_packet)
+{
+    std::vector<std::unique_ptr<Primitive>> prims;
+    prims.emplace_back(std::make_unique<StopPrimitive>(2, true));
+    dongle.send_drive_packet(prims);
+
+    ASSERT_TRUE(
+        emulator.waitUntil([&]() { return emulator.getDrivePackets().size() == 1; },
+                           TIMEOUT));
+
+    // The estop is not in the RUN state, so the robots are told not to charge
+    MRF::SequencedDrivePacketEncoder encoder;
+    MRF::SequencedDrivePacket expected;
+    MRF::DriveSequenceNumbers sequence_numbers;
+    std::size_t length = encoder.encode(prims, false, expected, sequence_numbers);
+    EXPECT_EQ(std::vector<uint8_t>(expected.begin(), expected.begin() + length),
+              emulator.getDrivePackets()[0]);
+    EXPECT_TRUE(emulator.waitUntil(
+        [&]() { return dongle.drive_packet_stats().num_sent == 1; }, TIMEOUT));
+}
+
+TEST_F(MRFDongleTest, coalesces_drive_packets_while_transfer_in_flight)
+{
+    // Emulate a slow USB link, so drive packets are sent faster than they can be
+    // transferred
+    emulator.setTransferLatency(std::chrono::milliseconds(5));
+
+    // Sequence numbers are used even by packets that are replaced, so the expected
+    // packets are encoded alongside the real ones
+    const unsigned int num_packets = 20;
+    std::vector<std::unique_ptr<Primitive>> prims;
+    MRF::SequencedDrivePacketEncoder encoder;
+    MRF::SequencedDrivePacket expected;
+    MRF::DriveSequenceNumbers sequence_numbers;
+    std::size_t length = 0;
+    for (unsigned int i = 0; i < num_packets; i++)
+    {
+        prims.clear();
+        prims.emplace_back(std::make_unique<StopPrimitive>(i % 8, true));
+        dongle.send_drive_packet(prims);
+        length = encoder.encode(prims, false, expected, sequence_numbers);
+    }
+
+    ASSERT_TRUE(emulator.waitUntil(
+        [&]() {
+            MRFDongle::DrivePacketStats stats = dongle.drive_packet_stats();
+            return stats.num_sent + stats.num_coalesced == num_packets &&
+                   emulator.getTransferStats().num_drive_packets == stats.num_sent;
+        },
+        TIMEOUT));
+
+    // Packets were replaced while waiting for a transfer, but the newest one was sent
+    EXPECT_LT(emulator.getDrivePackets().size(), num_packets);
+    EXPECT_EQ(std::vector<uint8_t>(expected.begin(), expected.begin() + length),
+              emulator.getDrivePackets().back());
+}
+
+TEST_F(MRFDongleTest, sends_camera_packet)
+{
+    MRF::CameraPacketRobots robots;
+    robots[1] = std::make_pair(Point(1, 2), Angle::ofRadians(0.5));
+    dongle.send_camera_packet(robots, Point(-1, 0.5), 12345);
+
+    ASSERT_TRUE(
+        emulator.waitUntil([&]() { return emulator.getCameraPackets().size() == 1; },
+                           TIMEOUT));
+
+    MRF::CameraPacket expected;
+    MRF::encodeCameraPacket(robots, Point(-1, 0.5), 12345, expected);
+    std::vector<uint8_t> packet = emulator.getCameraPackets()[0];
+    ASSERT_EQ(expected.size(), packet.size());
+    for (std::size_t i = 0; i < expected.size(); i++)
+    {
+        EXPECT_EQ(static_cast<uint8_t>(expected[i]), packet[i]);
+    }
+}
+
+TEST_F(MRFDongleTest, estop_state_follows_dongle_status)
+{
+    EXPECT_TRUE(emulator.waitUntil(
+        [&]() { return dongle.estop_state == MRFDongle::EStopState::STOP; }, TIMEOUT));
+
+    emulator.setStatus(static_cast<uint8_t>(MRFDongle::EStopState::RUN));
+    EXPECT_TRUE(emulator.waitUntil(
+        [&]() { return dongle.estop_state == MRFDongle::EStopState::RUN; }, TIMEOUT));
+}
+
+TEST_F(MRFDongleTest, reliable_message_reports_delivery_status)
+{
+    // Hold the delivery reports until we have connected to the operations, so we can't
+    // miss them
+    emulator.setDeliverMessagesImmediately(false);
+
+    const uint8_t data[] = {0x12, 0x34};
+    std::atomic<int> num_done(0);
+
+    SendReliableMessageOperation delivered(dongle, 3, 20, data, sizeof(data));
+    delivered.signal_done.connect([&](AsyncOperation<void> &) { ++num_done; });
+    emulator.deliverMessageDeliveryReports();
+    ASSERT_TRUE(emulator.waitUntil([&]() { return num_done == 1; }, TIMEOUT));
+    EXPECT_NO_THROW(delivered.result());
+
+    emulator.setMessageDeliveryStatus(MRF::MDR_STATUS_NOT_ACKNOWLEDGED);
+    SendReliableMessageOperation not_acknowledged(dongle, 3, 20, data, sizeof(data));
+    not_acknowledged.signal_done.connect([&](AsyncOperation<void> &) { ++num_done; });
+    emulator.deliverMessageDeliveryReports();
+    ASSERT_TRUE(emulator.waitUntil([&]() { return num_done == 2; }, TIMEOUT));
+    EXPECT_THROW(not_acknowledged.result(),
+                 SendReliableMessageOperation::NotAcknowledgedError);
+
+    std::vector<::Test::MRFDongleEmulator::RobotMessage> messages =
+        emulator.getRobotMessages();
+    ASSERT_EQ(2, messages.size());
+    EXPECT_EQ(3, messages[0].robot);
+    EXPECT_TRUE(messages[0].reliable);
+    EXPECT_EQ(20, messages[0].tries);
+    EXPECT_EQ(std::vector<uint8_t>(data, data + sizeof(data)), messages[0].data);
+    EXPECT_NE(messages[0].message_id, messages[1].message_id);
+}
+
+TEST_F(MRFDongleTest, message_ids_are_freed_by_delivery_reports)
+{
+    // Hold the delivery reports, as if the messages were still being sent over radio
+    emulator.setDeliverMessagesImmediately(false);
+
+    const uint8_t data[] = {0x00};
+    std::atomic<int> num_done(0);
+    std::vector<std::unique_ptr<SendReliableMessageOperation>> operations;
+    for (int i = 0; i < 256; i++)
+    {
+        operations.emplace_back(
+            std::make_unique<SendReliableMessageOperation>(dongle, 0, 1, data, 1));
+        operations.back()->signal_done.connect(
+            [&](AsyncOperation<void> &) { ++num_done; });
+    }
+    EXPECT_THROW(SendReliableMessageOperation(dongle, 0, 1, data, 1),
+                 std::runtime_error);
+
+    ASSERT_TRUE(emulator.waitUntil(
+        [&]() { return emulator.getRobotMessages().size() == 256; }, TIMEOUT));
+    emulator.deliverMessageDeliveryReports();
+    ASSERT_TRUE(emulator.waitUntil([&]() { return num_done == 256; }, TIMEOUT));
+    EXPECT_EQ(256, emulator.getTransferStats().num_mdrs);
+
+    // Now that the messages were delivered, their ids can be used again
+    SendReliableMessageOperation operation(dongle, 0, 1, data, 1);
+    operation.signal_done.connect([&](AsyncOperation<void> &) { ++num_done; });
+    emulator.deliverMessageDeliveryReports();
+    ASSERT_TRUE(emulator.waitUntil([&]() { return num_done == 257; }, TIMEOUT));
+    EXPECT_NO_THROW(operation.result());
+}
+
+TEST_F(MRFDongleTest, robot_messages_are_passed_to_annunciator)
+{
+    // Message type 0x01 reports that the robot's autokick fired
+    emulator.receiveRobotMessage(4, {0x01}, 255, 0);
+
+    ASSERT_TRUE(emulator.waitUntil([&]() { return getRobotStatuses().size() == 1; },
+                                   TIMEOUT));
+    RobotStatus robot_status = getRobotStatuses()[0];
+    EXPECT_TRUE(robot_status.autokick_fired);
+    EXPECT_DOUBLE_EQ(1.0, robot_status.link_quality);
+}
+
+TEST_F(MRFDongleTest, tracks_drive_primitives_applied_by_robot)
+{
+    // Send three primitives to robot 2, waiting for each to reach the dongle
+    std::vector<std::unique_ptr<Primitive>> prims;
+    prims.emplace_back(std::make_unique<StopPrimitive>(2, true));
+    for (std::size_t i = 1; i <= 3; i++)
+    {
+        dongle.send_drive_packet(prims);
+        ASSERT_TRUE(emulator.waitUntil(
+            [&]() { return emulator.getDrivePackets().size() == i; }, TIMEOUT));
+    }
+
+    // The dongle sends robot 2 the sequence number of its latest primitive, which the
+    // robot reports applying 1 ms ago in the drive acknowledgement extension of a
+    // general status update
+    uint8_t serial = emulator.getDriveSerials()[2];
+    EXPECT_EQ(MRF::FIRST_DRIVE_SEQUENCE_NUMBER + 2, serial);
+    std::vector<uint8_t> status_update(14, 0);
+    status_update.insert(status_update.end(), {0x04, serial, 0x01, 0x00});
+    emulator.receiveRobotMessage(2, status_update, 255, 0);
+
+    ASSERT_TRUE(emulator.waitUntil([&]() { return getRobotStatuses().size() == 1; },
+                                   TIMEOUT));
+    RobotStatus robot_status = getRobotStatuses()[0];
+    EXPECT_TRUE(robot_status.drive_ack_valid);
+    EXPECT_EQ(serial, robot_status.last_applied_drive_sequence_number);
+    EXPECT_EQ(0, robot_status.drive_primitives_behind);
+    ASSERT_TRUE(robot_status.drive_latency_valid);
+    EXPECT_GE(robot_status.drive_latency_ms, 0.0);
+    EXPECT_LT(robot_status.drive_latency_ms, TIMEOUT.count());
+}
+
+TEST_F(MRFDongleTest, reports_robot_behind_on_drive_primitives)
+{
+    std::vector<std::unique_ptr<Primitive>> prims;
+    prims.emplace_back(std::make_unique<StopPrimitive>(5, true));
+    for (std::size_t i = 1; i <= 3; i++)
+    {
+        dongle.send_drive_packet(prims);
+        ASSERT_TRUE(emulator.waitUntil(
+            [&]() { return emulator.getDrivePackets().size() == i; }, TIMEOUT));
+    }
+
+    // The robot has only applied its first primitive
+    std::vector<uint8_t> status_update(14, 0);
+    status_update.insert(status_update.end(),
+                         {0x04, MRF::FIRST_DRIVE_SEQUENCE_NUMBER, 0x00, 0x00});
+    emulator.receiveRobotMessage(5, status_update, 255, 0);
+
+    ASSERT_TRUE(emulator.waitUntil([&]() { return getRobotStatuses().size() == 1; },
+                                   TIMEOUT));
+    RobotStatus robot_status = getRobotStatuses()[0];
+    EXPECT_TRUE(robot_status.drive_ack_valid);
+    EXPECT_EQ(MRF::FIRST_DRIVE_SEQUENCE_NUMBER,
+              robot_status.last_applied_drive_sequence_number);
+    EXPECT_EQ(2, robot_status.drive_primitives_behind);
+}
+
+TEST_F(MRFDongleTest, first_primitive_after_startup_is_applied)
+{
+    // Until the host sends a robot anything, the dongle sends it the default drive data
+    // with serial 0, which the robot applies and reports. That was never sent by the
+    // host, so it has no latency
+    uint8_t startup_serial = emulator.getDriveSerials()[3];
+    std::vector<uint8_t> status_update(14, 0);
+    status_update.insert(status_update.end(), {0x04, startup_serial, 0x00, 0x00});
+    emulator.receiveRobotMessage(3, status_update, 255, 0);
+    ASSERT_TRUE(emulator.waitUntil([&]() { return getRobotStatuses().size() == 1; },
+                                   TIMEOUT));
+    EXPECT_FALSE(getRobotStatuses()[0].drive_latency_valid);
+
+    std::vector<std::unique_ptr<Primitive>> prims;
+    prims.emplace_back(std::make_unique<StopPrimitive>(3, true));
+    dongle.send_drive_packet(prims);
+    ASSERT_TRUE(
+        emulator.waitUntil([&]() { return emulator.getDrivePackets().size() == 1; },
+                           TIMEOUT));
+
+    // The robot only starts a primitive whose serial differs from the last one it
+    // applied, so the first primitive must not reuse the startup serial
+    uint8_t serial = emulator.getDriveSerials()[3];
+    EXPECT_NE(startup_serial, serial);
+    EXPECT_EQ(MRF::FIRST_DRIVE_SEQUENCE_NUMBER, serial);
+
+    // The robot applies it as soon as it arrives, some time after it was sent
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    status_update.resize(14);
+    status_update.insert(status_update.end(), {0x04, serial, 0x00, 0x00});
+    emulator.receiveRobotMessage(3, status_update, 255, 0);
+    ASSERT_TRUE(emulator.waitUntil([&]() { return getRobotStatuses().size() == 2; },
+                                   TIMEOUT));
+    RobotStatus robot_status = getRobotStatuses()[1];
+    EXPECT_TRUE(robot_status.drive_ack_valid);
+    EXPECT_EQ(serial, robot_status.last_applied_drive_sequence_number);
+    EXPECT_EQ(0, robot_status.drive_primitives_behind);
+    ASSERT_TRUE(robot_status.drive_latency_valid);
+    EXPECT_GT(robot_status.drive_latency_ms, 0.0);
+    EXPECT_LT(robot_status.drive_latency_ms, TIMEOUT.count());
+}
+
+TEST_F(MRFDongleTest, beeps_dongle)
+{
+    dongle.beep(100);
+
+    ASSERT_TRUE(
+        emulator.waitUntil([&]() { return emulator.getBeeps().size() == 1; }, TIMEOUT));
+    EXPECT_EQ(100, emulator.getBeeps()[0]);
+}
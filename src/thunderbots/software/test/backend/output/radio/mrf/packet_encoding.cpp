@@ -0,0 +1,360 @@
+#include "backend/output/radio/mrf/packet_encoding.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "ai/primitive/move_primitive.h"
+#include "ai/primitive/stop_primitive.h"
+
+TEST(MRFPacketEncodingTest, encode_primitive_clamps_and_flags_parameters)
+{
+    RadioPrimitive prim;
+    prim.prim_type   = FirmwarePrimitiveType::STOP;
+    prim.param_array = {-12.7, 5000, std::numeric_limits<double>::quiet_NaN(),
+                        -std::numeric_limits<double>::infinity()};
+    prim.extra_bits  = 0x35;
+    prim.slow        = true;
+
+    std::array<uint8_t, MRF::ENCODED_PRIMITIVE_LENGTH> encoded;
+    MRF::encodePrimitive(prim, true, encoded.data());
+
+    // Negative values set bit 10, values over 1000 are scaled down by 10 and set bit 11,
+    // NaN is encoded as 0 and infinity is clamped. The extra bits and slow flag are
+    // split across the top nibbles of the last two words
+    std::array<uint8_t, MRF::ENCODED_PRIMITIVE_LENGTH> expected = {
+        0x0c, 0x04, 0xf4, 0x89, 0x00, 0x50, 0xe8, 0xbf};
+    EXPECT_EQ(expected, encoded);
+}
+
+TEST(MRFPacketEncodingTest, encode_primitive_with_extra_bits_too_large)
+{
+    RadioPrimitive prim;
+    prim.prim_type  = FirmwarePrimitiveType::STOP;
+    prim.extra_bits = 128;
+
+    std::array<uint8_t, MRF::ENCODED_PRIMITIVE_LENGTH> encoded;
+    EXPECT_THROW(MRF::encodePrimitive(prim, true, encoded.data()),
+                 std::invalid_argument);
+}
+
+TEST(MRFPacketEncodingTest, encode_drive_packet_with_some_robots)
+{
+    std::vector<std::unique_ptr<Primitive>> prims;
+    prims.emplace_back(std::make_unique<MovePrimitive>(
+        3, Point(1, -2), Angle::ofRadians(0.5), 1.5, true, false, AUTOKICK));
+    prims.emplace_back(std::make_unique<StopPrimitive>(5, true));
+
+    MRF::DrivePacket packet;
+    std::size_t length = MRF::encodeDrivePacket(prims, true, packet);
+
+    std::vector<uint8_t> expected = {0x03, 0xe8, 0x13, 0xc8, 0x8c, 0x32, 0x30,
+                                     0x96, 0x08, 0x05, 0x00, 0x00, 0x00, 0x80,
+                                     0x00, 0x10, 0x00, 0x00};
+    ASSERT_EQ(expected.size(), length);
+    EXPECT_EQ(expected, std::vector<uint8_t>(packet.begin(), packet.begin() + length));
+}
+
+TEST(MRFSequencedDrivePacketEncoderTest, encode_with_some_robots)
+{
+    std::vector<std::unique_ptr<Primitive>> prims;
+    prims.emplace_back(std::make_unique<MovePrimitive>(
+        3, Point(1, -2), Angle::ofRadians(0.5), 1.5, true, false, AUTOKICK));
+    prims.emplace_back(std::make_unique<StopPrimitive>(5, true));
+
+    MRF::SequencedDrivePacketEncoder encoder;
+    MRF::SequencedDrivePacket packet;
+    MRF::DriveSequenceNumbers sequence_numbers;
+    std::size_t length = encoder.encode(prims, true, packet, sequence_numbers);
+
+    // Each primitive is prefixed by its robot id and sequence number
+    std::vector<uint8_t> expected = {0x03, 0x01, 0xe8, 0x13, 0xc8, 0x8c, 0x32,
+                                     0x30, 0x96, 0x08, 0x05, 0x01, 0x00, 0x00,
+                                     0x00, 0x80, 0x00, 0x10, 0x00, 0x00};
+    ASSERT_EQ(expected.size(), length);
+    EXPECT_EQ(expected, std::vector<uint8_t>(packet.begin(), packet.begin() + length));
+
+    MRF::DriveSequenceNumbers expected_sequence_numbers;
+    expected_sequence_numbers[3] = MRF::FIRST_DRIVE_SEQUENCE_NUMBER;
+    expected_sequence_numbers[5] = MRF::FIRST_DRIVE_SEQUENCE_NUMBER;
+    EXPECT_EQ(expected_sequence_numbers, sequence_numbers);
+}
+
+TEST(MRFSequencedDrivePacketEncoderTest, sequence_numbers_are_per_robot_and_wrap)
+{
+    MRF::SequencedDrivePacketEncoder encoder;
+    MRF::SequencedDrivePacket packet;
+    MRF::DriveSequenceNumbers sequence_numbers;
+
+    std::vector<std::unique_ptr<Primitive>> prims;
+    prims.emplace_back(std::make_unique<StopPrimitive>(1, true));
+    encoder.encode(prims, true, packet, sequence_numbers);
+    EXPECT_EQ(MRF::FIRST_DRIVE_SEQUENCE_NUMBER, sequence_numbers[1]);
+
+    // Once a robot has been sent a primitive, 0 is used like any other sequence number
+    // when they wrap around
+    for (unsigned int i = 0; i < MRF::NUM_DRIVE_SEQUENCE_NUMBERS; i++)
+    {
+        encoder.encode(prims, true, packet, sequence_numbers);
+    }
+    EXPECT_EQ(1, sequence_numbers[1]);
+    EXPECT_EQ(1, packet[1]);
+    encoder.encode(prims, true, packet, sequence_numbers);
+    EXPECT_EQ(2, sequence_numbers[1]);
+
+    // Robots that were not sent a primitive keep their own sequence numbers
+    prims.emplace_back(std::make_unique<StopPrimitive>(6, true));
+    encoder.encode(prims, true, packet, sequence_numbers);
+    EXPECT_EQ(3, sequence_numbers[1]);
+    EXPECT_EQ(MRF::FIRST_DRIVE_SEQUENCE_NUMBER, sequence_numbers[6]);
+    EXPECT_FALSE(sequence_numbers[0]);
+}
+
+TEST(MRFSequencedDrivePacketEncoderTest, failed_encode_does_not_use_sequence_numbers)
+{
+    MRF::SequencedDrivePacketEncoder encoder;
+    MRF::SequencedDrivePacket packet;
+    MRF::DriveSequenceNumbers sequence_numbers;
+
+    // Robot 8 can not be sent over radio
+    std::vector<std::unique_ptr<Primitive>> prims;
+    prims.emplace_back(std::make_unique<StopPrimitive>(1, true));
+    prims.emplace_back(std::make_unique<StopPrimitive>(8, true));
+    EXPECT_THROW(encoder.encode(prims, true, packet, sequence_numbers),
+                 std::invalid_argument);
+
+    prims.pop_back();
+    encoder.encode(prims, true, packet, sequence_numbers);
+    EXPECT_EQ(MRF::FIRST_DRIVE_SEQUENCE_NUMBER, sequence_numbers[1]);
+}
+
+TEST(MRFSequencedDrivePacketEncoderTest, two_primitives_for_one_robot_throws)
+{
+    MRF::SequencedDrivePacketEncoder encoder;
+    MRF::SequencedDrivePacket packet;
+    MRF::DriveSequenceNumbers sequence_numbers;
+
+    std::vector<std::unique_ptr<Primitive>> prims;
+    prims.emplace_back(std::make_unique<StopPrimitive>(4, true));
+    prims.emplace_back(std::make_unique<StopPrimitive>(2, true));
+    prims.emplace_back(std::make_unique<StopPrimitive>(4, false));
+    EXPECT_THROW(encoder.encode(prims, true, packet, sequence_numbers),
+                 std::invalid_argument);
+
+    // Neither robot used up a sequence number
+    prims.pop_back();
+    encoder.encode(prims, true, packet, sequence_numbers);
+    EXPECT_EQ(MRF::FIRST_DRIVE_SEQUENCE_NUMBER, sequence_numbers[4]);
+    EXPECT_EQ(MRF::FIRST_DRIVE_SEQUENCE_NUMBER, sequence_numbers[2]);
+}
+
+TEST(MRFPacketEncodingTest, encode_drive_packet_without_charging)
+{
+    std::vector<std::unique_ptr<Primitive>> prims;
+    prims.emplace_back(std::make_unique<StopPrimitive>(5, true));
+
+    MRF::DrivePacket packet;
+    std::size_t length = MRF::encodeDrivePacket(prims, false, packet);
+
+    std::vector<uint8_t> expected = {0x05, 0x00, 0x00, 0x00, 0x40,
+                                     0x00, 0x10, 0x00, 0x00};
+    ASSERT_EQ(expected.size(), length);
+    EXPECT_EQ(expected, std::vector<uint8_t>(packet.begin(), packet.begin() + length));
+}
+
+TEST(MRFPacketEncodingTest, encode_drive_packet_with_all_robots)
+{
+    std::vector<std::unique_ptr<Primitive>> prims;
+    for (unsigned int id = 0; id < MAX_ROBOTS_OVER_RADIO; id++)
+    {
+        prims.emplace_back(std::make_unique<StopPrimitive>(id, id % 2 == 1));
+    }
+
+    MRF::DrivePacket packet;
+    std::size_t length = MRF::encodeDrivePacket(prims, true, packet);
+
+    // There are no robot ids in a full packet, since the primitives are in id order
+    ASSERT_EQ(MRF::DRIVE_PACKET_MAX_LENGTH, length);
+    for (std::size_t id = 0; id < MAX_ROBOTS_OVER_RADIO; id++)
+    {
+        std::vector<uint8_t> expected = {
+            0x00, 0x00, 0x00, 0x80, 0x00, static_cast<uint8_t>(id % 2 == 1 ? 0x10 : 0x00),
+            0x00, 0x00};
+        auto start = packet.begin() + id * MRF::ENCODED_PRIMITIVE_LENGTH;
+        EXPECT_EQ(expected, std::vector<uint8_t>(
+                                start, start + MRF::ENCODED_PRIMITIVE_LENGTH));
+    }
+}
+
+TEST(MRFPacketEncodingTest, encode_drive_packet_with_no_primitives)
+{
+    std::vector<std::unique_ptr<Primitive>> prims;
+    MRF::DrivePacket packet;
+    EXPECT_THROW(MRF::encodeDrivePacket(prims, true, packet), std::invalid_argument);
+}
+
+TEST(MRFPacketEncodingTest, encode_drive_packet_with_too_many_primitives)
+{
+    std::vector<std::unique_ptr<Primitive>> prims;
+    for (unsigned int id = 0; id < MAX_ROBOTS_OVER_RADIO + 1; id++)
+    {
+        prims.emplace_back(std::make_unique<StopPrimitive>(id, false));
+    }
+
+    MRF::DrivePacket packet;
+    EXPECT_THROW(MRF::encodeDrivePacket(prims, true, packet), std::invalid_argument);
+}
+
+TEST(MRFPacketEncodingTest, encode_camera_packet)
+{
+    MRF::CameraPacketRobots robots;
+    robots[1] = std::make_pair(Point(1, 2), Angle::ofRadians(0.5));
+    robots[4] = std::make_pair(Point(-1.5, 0.25), Angle::ofRadians(-1));
+
+    MRF::CameraPacket packet;
+    uint8_t mask =
+        MRF::encodeCameraPacket(robots, Point(0.3, -0.4), 0x0102030405060708, packet);
+
+    EXPECT_EQ(0x12, mask);
+
+    MRF::CameraPacket expected = {};
+    std::vector<uint8_t> expected_bytes = {
+        0x12, 0x2c, 0x01, 0x70, 0xfe, 0xe8, 0x03, 0xd0, 0x07, 0xf4, 0x01, 0x24, 0xfa,
+        0xfa, 0x00, 0x18, 0xfc, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01};
+    for (std::size_t i = 0; i < expected_bytes.size(); i++)
+    {
+        expected[i] = static_cast<int8_t>(expected_bytes[i]);
+    }
+    EXPECT_EQ(expected, packet);
+}
+
+TEST(MRFPacketEncodingTest, encode_camera_packet_with_too_many_robots)
+{
+    MRF::CameraPacketRobots robots;
+    for (std::size_t id = 0; id < MAX_ROBOTS_OVER_RADIO; id++)
+    {
+        robots[id] = std::make_pair(Point(0, 0), Angle::zero());
+    }
+
+    MRF::CameraPacket packet;
+    uint8_t mask = MRF::encodeCameraPacket(robots, Point(0, 0), 0, packet);
+
+    // Only the robots with the lowest ids fit in the packet
+    EXPECT_EQ(0x7f, mask);
+    EXPECT_EQ(static_cast<int8_t>(0x7f), packet[0]);
+}
+
+TEST(MRFCompactCameraPacketEncoderTest, first_packet_is_keyframe)
+{
+    MRF::CameraPacketRobots robots;
+    robots[1] = std::make_pair(Point(1, 2), Angle::ofRadians(0.5));
+    robots[4] = std::make_pair(Point(-1.5, 0.25), Angle::ofRadians(-1));
+
+    MRF::CompactCameraPacketEncoder encoder;
+    MRF::CompactCameraPacket packet;
+    std::size_t length =
+        encoder.encode(robots, Point(0.3, -0.4), 0x0102030405060708, packet);
+
+    std::vector<uint8_t> expected = {0x80, 0x12, 0x2c, 0x01, 0x70, 0xfe, 0xe8,
+                                     0x03, 0xd0, 0x07, 0xf4, 0x01, 0x24, 0xfa,
+                                     0xfa, 0x00, 0x18, 0xfc, 0x08, 0x07, 0x06,
+                                     0x05, 0x04, 0x03, 0x02, 0x01};
+    ASSERT_EQ(expected.size(), length);
+    EXPECT_EQ(expected, std::vector<uint8_t>(packet.begin(), packet.begin() + length));
+
+    // The rest of the packet is zeroed
+    for (std::size_t i = length; i < packet.size(); i++)
+    {
+        EXPECT_EQ(0, packet[i]);
+    }
+}
+
+TEST(MRFCompactCameraPacketEncoderTest, small_changes_are_encoded_as_deltas)
+{
+    MRF::CameraPacketRobots robots;
+    robots[1] = std::make_pair(Point(1, 2), Angle::ofRadians(0.5));
+    robots[4] = std::make_pair(Point(-1.5, 0.25), Angle::ofRadians(-1));
+
+    MRF::CompactCameraPacketEncoder encoder;
+    MRF::CompactCameraPacket packet;
+    encoder.encode(robots, Point(0.3, -0.4), 1000, packet);
+
+    robots[1] = std::make_pair(Point(1.1, 1.95), Angle::ofRadians(0.51));
+    robots[4] = std::make_pair(Point(-1.5, 0.25), Angle::ofRadians(-1.1));
+    std::size_t length = encoder.encode(robots, Point(2, 1), 1300, packet);
+
+    // The deltas are relative to the keyframe, and the ball is always absolute
+    std::vector<uint8_t> expected = {0x00, 0x12, 0xd0, 0x07, 0xe8, 0x03, 0x64, 0xce,
+                                     0x0a, 0x00, 0x00, 0x9c, 0x2c, 0x01};
+    ASSERT_EQ(expected.size(), length);
+    EXPECT_EQ(expected, std::vector<uint8_t>(packet.begin(), packet.begin() + length));
+}
+
+TEST(MRFCompactCameraPacketEncoderTest, large_changes_are_encoded_as_keyframes)
+{
+    MRF::CameraPacketRobots robots;
+    robots[0] = std::make_pair(Point(0, 0), Angle::zero());
+
+    MRF::CompactCameraPacketEncoder encoder;
+    MRF::CompactCameraPacket packet;
+    encoder.encode(robots, Point(0, 0), 0, packet);
+    EXPECT_EQ(static_cast<int8_t>(0x80), packet[0]);
+
+    // The robot moved too far for a delta
+    robots[0] = std::make_pair(Point(0.2, 0), Angle::zero());
+    encoder.encode(robots, Point(0, 0), 0, packet);
+    EXPECT_EQ(static_cast<int8_t>(0x81), packet[0]);
+
+    // A robot appeared
+    robots[1] = std::make_pair(Point(0, 0), Angle::zero());
+    encoder.encode(robots, Point(0, 0), 0, packet);
+    EXPECT_EQ(static_cast<int8_t>(0x82), packet[0]);
+
+    // Too much time passed for a delta
+    encoder.encode(robots, Point(0, 0), 0x10000, packet);
+    EXPECT_EQ(static_cast<int8_t>(0x83), packet[0]);
+
+    // Nothing changed, so this is a delta relative to the last keyframe
+    encoder.encode(robots, Point(0, 0), 0x10000, packet);
+    EXPECT_EQ(static_cast<int8_t>(0x03), packet[0]);
+}
+
+TEST(MRFCompactCameraPacketEncoderTest, keyframes_are_sent_periodically)
+{
+    MRF::CameraPacketRobots robots;
+    robots[0] = std::make_pair(Point(0, 0), Angle::zero());
+
+    MRF::CompactCameraPacketEncoder encoder(3);
+    MRF::CompactCameraPacket packet;
+    std::vector<int8_t> headers;
+    for (int i = 0; i < 7; i++)
+    {
+        encoder.encode(robots, Point(0, 0), 0, packet);
+        headers.emplace_back(packet[0]);
+    }
+
+    std::vector<int8_t> expected = {static_cast<int8_t>(0x80), 0x00, 0x00,
+                                    static_cast<int8_t>(0x81), 0x01, 0x01,
+                                    static_cast<int8_t>(0x82)};
+    EXPECT_EQ(expected, headers);
+}
+
+TEST(MRFCompactCameraPacketEncoderTest, keyframe_with_all_robots_fits_in_packet)
+{
+    MRF::CameraPacketRobots robots;
+    for (std::size_t id = 0; id < MAX_ROBOTS_OVER_RADIO; id++)
+    {
+        robots[id] = std::make_pair(Point(0, 0), Angle::zero());
+    }
+
+    MRF::CompactCameraPacketEncoder encoder;
+    MRF::CompactCameraPacket packet;
+    std::size_t length = encoder.encode(robots, Point(0, 0), 0, packet);
+
+    EXPECT_EQ(static_cast<int8_t>(0xff), packet[1]);
+    EXPECT_EQ(2 + 4 + 6 * MAX_ROBOTS_OVER_RADIO + 8, length);
+
+    // Deltas for all robots are much smaller
+    length = encoder.encode(robots, Point(0, 0), 0, packet);
+    EXPECT_EQ(2 + 4 + 3 * MAX_ROBOTS_OVER_RADIO + 2, length);
+}
@@ -0,0 +1,55 @@
+#include "backend/output/radio/radio_units.h"
+
+#include <gtest/gtest.h>
+
+using namespace RadioUnits;
+using namespace Units;
+
+// The encoders are resolved at compile time
+static_assert(encodePrimitiveLength(Meters(1.25)) == 1250.0,
+              "primitive lengths must be encoded in constant expressions");
+static_assert(encodeCameraLength(Meters(-2.5)) == -2500,
+              "camera lengths must be encoded in constant expressions");
+
+TEST(RadioUnitsTest, encodes_primitive_parameters)
+{
+    EXPECT_DOUBLE_EQ(-3000.0, encodePrimitiveLength(Meters(-3.0)));
+    EXPECT_DOUBLE_EQ(1500.0, encodePrimitiveSpeed(MetersPerSecond(1.5)));
+    EXPECT_DOUBLE_EQ(50.0, encodePrimitiveAngle(Radians(0.5)));
+    EXPECT_DOUBLE_EQ(-400.0, encodePrimitiveAngularVelocity(RadiansPerSecond(-4.0)));
+
+    // Lengths in other units are converted first
+    EXPECT_DOUBLE_EQ(20.0, encodePrimitiveLength(Millimeters(20.0)));
+}
+
+TEST(RadioUnitsTest, encodes_dribbler_speed_rounding_down)
+{
+    EXPECT_EQ(0, encodeDribblerSpeed(RevolutionsPerMinute(299.0)));
+    EXPECT_EQ(53, encodeDribblerSpeed(RevolutionsPerMinute(16000.0)));
+}
+
+TEST(RadioUnitsTest, encodes_camera_data_rounding_towards_zero)
+{
+    EXPECT_EQ(1234, encodeCameraLength(Meters(1.2346)));
+    EXPECT_EQ(-1234, encodeCameraLength(Meters(-1.2346)));
+    EXPECT_EQ(3141, encodeCameraAngle(Radians(3.1416)));
+}
+
+TEST(RadioUnitsTest, firmware_decodes_what_software_encodes)
+{
+    EXPECT_FLOAT_EQ(-1.25f, radio_decode_primitive_length(static_cast<int16_t>(
+                                encodePrimitiveLength(Meters(-1.25)))));
+    EXPECT_FLOAT_EQ(1.5f, radio_decode_primitive_angle(
+                              static_cast<int16_t>(encodePrimitiveAngle(Radians(1.5)))));
+    EXPECT_EQ(15900u, radio_decode_dribbler_rpm(
+                          encodeDribblerSpeed(RevolutionsPerMinute(16000.0))));
+    EXPECT_FLOAT_EQ(-4.375f,
+                    radio_decode_camera_length(encodeCameraLength(Meters(-4.375))));
+    EXPECT_FLOAT_EQ(-0.5f, radio_decode_camera_angle(encodeCameraAngle(Radians(-0.5))));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
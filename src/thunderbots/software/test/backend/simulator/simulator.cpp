@@ -0,0 +1,250 @@
+#include "backend/simulator/simulator.h"
+
+#include <gtest/gtest.h>
+
+#include "ai/primitive/chip_primitive.h"
+#include "ai/primitive/dribble_primitive.h"
+#include "ai/primitive/kick_primitive.h"
+#include "ai/primitive/move_primitive.h"
+#include "shared/constants.h"
+#include "test/test_util/test_util.h"
+
+class SimulatorTest : public ::testing::Test
+{
+   protected:
+    SimulatorTest() : simulator(::Test::TestUtil::createSSLDivBField()) {}
+
+    /**
+     * Makes the friendly robots follow the given primitive
+     */
+    void setFriendlyPrimitive(std::unique_ptr<Primitive> primitive)
+    {
+        auto primitives = std::make_shared<std::vector<std::unique_ptr<Primitive>>>();
+        primitives->emplace_back(std::move(primitive));
+        simulator.setFriendlyPrimitives(primitives);
+    }
+
+    Simulator simulator;
+};
+
+TEST_F(SimulatorTest, simulated_time_advances_in_physics_steps)
+{
+    for (int i = 0; i < 60; i++)
+    {
+        simulator.stepSimulation(Duration::fromSeconds(1.0 / 60.0));
+    }
+    EXPECT_NEAR(1.0, simulator.getSimulatedTime().getSeconds(), 1e-9);
+    EXPECT_NEAR(1.0, simulator.getWorld().getMostRecentTimestamp().getSeconds(), 1e-9);
+}
+
+TEST_F(SimulatorTest, ball_rolls_and_slows_down)
+{
+    simulator.setBallState(Point(0, 0), Vector(2, 0));
+    simulator.stepSimulation(Duration::fromSeconds(1.0));
+
+    Ball ball = simulator.getWorld().ball();
+    EXPECT_LT(ball.velocity().len(), 2.0);
+    EXPECT_GT(ball.velocity().len(), 1.0);
+    EXPECT_GT(ball.position().x(), 1.0);
+    EXPECT_LT(ball.position().x(), 2.0);
+    EXPECT_DOUBLE_EQ(0, ball.position().y());
+
+    // The ball eventually comes to rest
+    simulator.stepSimulation(Duration::fromSeconds(10.0));
+    EXPECT_EQ(Vector(), simulator.getWorld().ball().velocity());
+}
+
+TEST_F(SimulatorTest, ball_bounces_off_walls)
+{
+    simulator.setBallState(Point(0, 2.5), Vector(0, 3));
+    simulator.stepSimulation(Duration::fromSeconds(1.0));
+
+    Ball ball = simulator.getWorld().ball();
+    EXPECT_LT(ball.velocity().y(), 0);
+    EXPECT_LT(ball.position().y(), 3.3);
+}
+
+TEST_F(SimulatorTest, robot_without_primitive_stays_still)
+{
+    simulator.addFriendlyRobot(0, Point(1, 1), Angle::quarter());
+    simulator.stepSimulation(Duration::fromSeconds(1.0));
+
+    std::optional<Robot> robot = simulator.getWorld().friendlyTeam().getRobotById(0);
+    ASSERT_TRUE(robot);
+    EXPECT_EQ(Point(1, 1), robot->position());
+    EXPECT_EQ(Angle::quarter(), robot->orientation());
+}
+
+TEST_F(SimulatorTest, robot_follows_move_primitive)
+{
+    simulator.addFriendlyRobot(0, Point(-2, -1), Angle::zero());
+    setFriendlyPrimitive(
+        std::make_unique<MovePrimitive>(0, Point(1, 1), Angle::half(), 0.0));
+    simulator.stepSimulation(Duration::fromSeconds(5.0));
+
+    std::optional<Robot> robot = simulator.getWorld().friendlyTeam().getRobotById(0);
+    ASSERT_TRUE(robot);
+    EXPECT_LT((robot->position() - Point(1, 1)).len(), 0.01);
+    EXPECT_LT(robot->velocity().len(), 0.01);
+    EXPECT_LT(robot->orientation().minDiff(Angle::half()), Angle::ofDegrees(1));
+}
+
+TEST_F(SimulatorTest, robot_acceleration_is_limited)
+{
+    simulator.addFriendlyRobot(0, Point(0, 0), Angle::zero());
+    setFriendlyPrimitive(
+        std::make_unique<MovePrimitive>(0, Point(3, 0), Angle::zero(), 0));
+    simulator.stepSimulation(Duration::fromSeconds(0.1));
+
+    std::optional<Robot> robot = simulator.getWorld().friendlyTeam().getRobotById(0);
+    ASSERT_TRUE(robot);
+    EXPECT_LE(robot->velocity().len(),
+              ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED * 0.1 + 1e-9);
+}
+
+TEST_F(SimulatorTest, robot_kicks_ball)
+{
+    simulator.addFriendlyRobot(0, Point(-1, 0), Angle::zero());
+    simulator.setBallState(Point(0, 0), Vector());
+    setFriendlyPrimitive(
+        std::make_unique<KickPrimitive>(0, Point(0, 0), Angle::zero(), 5.0));
+    for (int i = 0; i < 180 && simulator.getWorld().ball().position().x() < 1.0; i++)
+    {
+        simulator.stepSimulation(Duration::fromSeconds(1.0 / 60.0));
+    }
+
+    Ball ball = simulator.getWorld().ball();
+    EXPECT_GT(ball.position().x(), 1.0);
+    // The ball also keeps the velocity of the robot that kicked it
+    EXPECT_GE(ball.velocity().x(), 5.0 - 0.5);
+    EXPECT_LE(ball.velocity().x(), 5.0 + ROBOT_MAX_SPEED_METERS_PER_SECOND);
+    EXPECT_NEAR(0, ball.velocity().y(), 0.1);
+    EXPECT_DOUBLE_EQ(0, simulator.getBallHeight());
+}
+
+TEST_F(SimulatorTest, robot_chips_ball_over_robots)
+{
+    simulator.addFriendlyRobot(0, Point(-1, 0), Angle::zero());
+    // A robot in the way of the chip
+    simulator.addEnemyRobot(0, Point(0.6, 0), Angle::half());
+    simulator.setBallState(Point(0, 0), Vector());
+    setFriendlyPrimitive(
+        std::make_unique<ChipPrimitive>(0, Point(0, 0), Angle::zero(), 3.0));
+
+    bool ball_left_ground = false;
+    for (int i = 0; i < 120 && simulator.getWorld().ball().position().x() < 1.5; i++)
+    {
+        simulator.stepSimulation(Duration::fromSeconds(1.0 / 60.0));
+        // Robots are 0.15m tall
+        ball_left_ground |= simulator.getBallHeight() > 0.15;
+    }
+
+    EXPECT_TRUE(ball_left_ground);
+    EXPECT_GT(simulator.getWorld().ball().position().x(), 1.5);
+
+    // The ball lands again
+    simulator.stepSimulation(Duration::fromSeconds(3.0));
+    EXPECT_DOUBLE_EQ(0, simulator.getBallHeight());
+}
+
+TEST_F(SimulatorTest, robot_dribbles_ball)
+{
+    simulator.addFriendlyRobot(0, Point(-0.1, 0), Angle::zero());
+    // The ball starts against the dribbler
+    double dribbler_distance = DIST_TO_FRONT_OF_ROBOT_METERS + BALL_MAX_RADIUS_METERS;
+    simulator.setBallState(Point(-0.1 + dribbler_distance, 0), Vector());
+    setFriendlyPrimitive(std::make_unique<DribblePrimitive>(
+        0, Point(-1, 1), Angle::quarter(), 10000, false));
+    simulator.stepSimulation(Duration::fromSeconds(4.0));
+
+    World world                = simulator.getWorld();
+    std::optional<Robot> robot = world.friendlyTeam().getRobotById(0);
+    ASSERT_TRUE(robot);
+    EXPECT_LT((robot->position() - Point(-1, 1)).len(), 0.01);
+
+    // The ball is held in front of the robot
+    Point dribbler_position =
+        robot->position() +
+        Vector::createFromAngle(robot->orientation()).norm(dribbler_distance);
+    EXPECT_LT((world.ball().position() - dribbler_position).len(), 0.01);
+}
+
+TEST_F(SimulatorTest, ball_bounces_off_robot)
+{
+    simulator.addEnemyRobot(0, Point(1, 0), Angle::zero());
+    simulator.setBallState(Point(0, 0), Vector(2, 0));
+    simulator.stepSimulation(Duration::fromSeconds(1.0));
+
+    Ball ball = simulator.getWorld().ball();
+    EXPECT_LT(ball.velocity().x(), 0);
+    EXPECT_LT(ball.position().x(), 1 - ROBOT_MAX_RADIUS_METERS);
+}
+
+TEST_F(SimulatorTest, robots_do_not_drive_through_each_other)
+{
+    simulator.addFriendlyRobot(0, Point(-1, 0), Angle::zero());
+    simulator.addEnemyRobot(0, Point(0, 0), Angle::zero());
+    setFriendlyPrimitive(
+        std::make_unique<MovePrimitive>(0, Point(1, 0), Angle::zero(), 0));
+    simulator.stepSimulation(Duration::fromSeconds(3.0));
+
+    World world             = simulator.getWorld();
+    Point friendly_position = world.friendlyTeam().getRobotById(0)->position();
+    Point enemy_position    = world.enemyTeam().getRobotById(0)->position();
+    EXPECT_GE((friendly_position - enemy_position).len(),
+              2 * ROBOT_MAX_RADIUS_METERS - 1e-9);
+    // The friendly robot pushed the enemy robot
+    EXPECT_GT(enemy_position.x(), 0.1);
+    EXPECT_LT(friendly_position.x(), enemy_position.x());
+}
+
+TEST_F(SimulatorTest, robots_stay_inside_field_boundary)
+{
+    Field field = ::Test::TestUtil::createSSLDivBField();
+    simulator.addFriendlyRobot(0, Point(0, 0), Angle::zero());
+    setFriendlyPrimitive(
+        std::make_unique<MovePrimitive>(0, Point(10, 0), Angle::zero(), 0));
+    simulator.stepSimulation(Duration::fromSeconds(5.0));
+
+    Point position = simulator.getWorld().friendlyTeam().getRobotById(0)->position();
+    EXPECT_LE(position.x(), field.totalLength() / 2 - ROBOT_MAX_RADIUS_METERS + 1e-9);
+}
+
+TEST_F(SimulatorTest, reports_refbox_game_state)
+{
+    simulator.setRefboxGameState(RefboxGameState::FORCE_START);
+
+    // The World takes the consensus of a few game states, like it does for refbox
+    World world = simulator.getWorld();
+    for (int i = 0; i < 3; i++)
+    {
+        world = simulator.getWorld();
+    }
+    EXPECT_EQ(RefboxGameState::FORCE_START, world.gameState().getRefboxGameState());
+}
+
+TEST(SimulatorDeterminismTest, same_seed_gives_same_worlds)
+{
+    auto run_simulation = [](unsigned int seed) {
+        Simulator simulator(::Test::TestUtil::createSSLDivBField(), seed, 0.005);
+        simulator.addFriendlyRobot(0, Point(-1, 0), Angle::zero());
+        simulator.addEnemyRobot(0, Point(1, 0.05), Angle::half());
+        simulator.setBallState(Point(0, 0), Vector(0.5, 0.2));
+
+        auto primitives = std::make_shared<std::vector<std::unique_ptr<Primitive>>>();
+        primitives->emplace_back(
+            std::make_unique<KickPrimitive>(0, Point(0, 0), Angle::zero(), 4.0));
+        simulator.setFriendlyPrimitives(primitives);
+
+        std::vector<Point> ball_positions;
+        for (int i = 0; i < 120; i++)
+        {
+            simulator.stepSimulation(Duration::fromSeconds(1.0 / 60.0));
+            ball_positions.emplace_back(simulator.getWorld().ball().position());
+        }
+        return ball_positions;
+    };
+
+    EXPECT_EQ(run_simulation(1), run_simulation(1));
+    EXPECT_NE(run_simulation(1), run_simulation(2));
+}
@@ -0,0 +1,152 @@
+#include "match_runner/match_runner.h"
+
+#include <gtest/gtest.h>
+
+#include "test/test_util/test_util.h"
+
+class MatchRunnerTest : public ::testing::Test
+{
+   protected:
+    /**
+     * Returns a scenario where the robots are halted and the ball is rolling towards the
+     * centre of the given goal, so a goal is always scored
+     */
+    MatchScenario createBallRollingIntoGoalScenario(const Point &goal)
+    {
+        MatchScenario scenario;
+        scenario.name  = "ball_rolling_into_goal";
+        scenario.setup = [goal](Simulator &simulator) {
+            simulator.addFriendlyRobot(0, Point(-1, 2), Angle::zero());
+            simulator.addEnemyRobot(0, Point(1, 2), Angle::half());
+            Point ball_position(goal.x() / 2, 0);
+            simulator.setBallState(ball_position, (goal - ball_position).norm(4.0));
+        };
+        scenario.refbox_game_states = {
+            {Duration::fromSeconds(0), RefboxGameState::HALT}};
+        scenario.duration = Duration::fromSeconds(5);
+        return scenario;
+    }
+
+    Field field = ::Test::TestUtil::createSSLDivBField();
+};
+
+TEST_F(MatchRunnerTest, test_ball_rolling_into_enemy_goal_is_friendly_goal)
+{
+    MatchRunner runner(field, 1);
+    MatchResult result =
+        runner.runMatch(createBallRollingIntoGoalScenario(field.enemyGoal()), 0);
+
+    EXPECT_EQ(1, result.friendly_goals);
+    EXPECT_EQ(0, result.enemy_goals);
+    // The match stops as soon as the goal is scored
+    EXPECT_LT(result.simulated_time, Duration::fromSeconds(5));
+    EXPECT_EQ(Duration(), result.friendly_possession_time);
+    EXPECT_FALSE(result.friendly_time_to_ball);
+    EXPECT_GT(result.num_ticks, 0);
+    EXPECT_LE(result.max_tick_cpu_time, result.total_tick_cpu_time);
+}
+
+TEST_F(MatchRunnerTest, test_ball_rolling_into_friendly_goal_is_enemy_goal)
+{
+    MatchRunner runner(field, 1);
+    MatchResult result =
+        runner.runMatch(createBallRollingIntoGoalScenario(field.friendlyGoal()), 0);
+
+    EXPECT_EQ(0, result.friendly_goals);
+    EXPECT_EQ(1, result.enemy_goals);
+}
+
+TEST_F(MatchRunnerTest, test_match_without_goal_runs_for_scenario_duration)
+{
+    MatchScenario scenario;
+    scenario.name  = "halted";
+    scenario.setup = [](Simulator &simulator) {
+        simulator.addFriendlyRobot(0, Point(-1, 0), Angle::zero());
+    };
+    scenario.refbox_game_states = {{Duration::fromSeconds(0), RefboxGameState::HALT}};
+    scenario.duration           = Duration::fromSeconds(1);
+
+    MatchRunner runner(field, 1);
+    MatchResult result = runner.runMatch(scenario, 0);
+
+    EXPECT_EQ(0, result.friendly_goals);
+    EXPECT_EQ(0, result.enemy_goals);
+    EXPECT_NEAR(1.0, result.simulated_time.getSeconds(),
+                MatchRunner::TICK_PERIOD_SECONDS);
+    EXPECT_EQ(60, result.num_ticks);
+}
+
+TEST_F(MatchRunnerTest, test_run_matches_on_many_threads_matches_running_each_match_alone)
+{
+    std::vector<MatchScenario> scenarios = {
+        createBallRollingIntoGoalScenario(field.enemyGoal()),
+        createBallRollingIntoGoalScenario(field.friendlyGoal())};
+    scenarios[1].name = "ball_rolling_into_friendly_goal";
+
+    MatchRunner runner(field, 4);
+    std::vector<MatchResult> results = runner.runMatches(scenarios, 3);
+
+    ASSERT_EQ(6, results.size());
+    for (unsigned int i = 0; i < results.size(); i++)
+    {
+        MatchResult expected = runner.runMatch(scenarios[i / 3], i % 3);
+        EXPECT_EQ(expected.scenario_name, results[i].scenario_name);
+        EXPECT_EQ(expected.seed, results[i].seed);
+        EXPECT_EQ(expected.friendly_goals, results[i].friendly_goals);
+        EXPECT_EQ(expected.enemy_goals, results[i].enemy_goals);
+        EXPECT_EQ(expected.simulated_time, results[i].simulated_time);
+        EXPECT_EQ(expected.num_ticks, results[i].num_ticks);
+    }
+}
+
+TEST(MatchRunnerSummaryTest, test_summarize_results_groups_by_scenario)
+{
+    MatchResult kickoff_1              = {};
+    kickoff_1.scenario_name            = "kickoff";
+    kickoff_1.friendly_goals           = 1;
+    kickoff_1.simulated_time           = Duration::fromSeconds(10);
+    kickoff_1.friendly_possession_time = Duration::fromSeconds(5);
+    kickoff_1.friendly_time_to_ball    = Duration::fromSeconds(2);
+    kickoff_1.num_ticks                = 10;
+    kickoff_1.total_tick_cpu_time      = Duration::fromMilliseconds(10);
+    kickoff_1.max_tick_cpu_time        = Duration::fromMilliseconds(3);
+
+    MatchResult defense           = {};
+    defense.scenario_name         = "defense";
+    defense.enemy_goals           = 1;
+    defense.simulated_time        = Duration::fromSeconds(4);
+    defense.enemy_possession_time = Duration::fromSeconds(1);
+    defense.num_ticks             = 4;
+
+    MatchResult kickoff_2         = {};
+    kickoff_2.scenario_name       = "kickoff";
+    kickoff_2.simulated_time      = Duration::fromSeconds(10);
+    kickoff_2.num_ticks           = 30;
+    kickoff_2.total_tick_cpu_time = Duration::fromMilliseconds(30);
+    kickoff_2.max_tick_cpu_time   = Duration::fromMilliseconds(2);
+
+    std::vector<MatchSummary> summaries =
+        MatchRunner::summarizeResults({kickoff_1, defense, kickoff_2});
+
+    ASSERT_EQ(2, summaries.size());
+
+    const MatchSummary &kickoff = summaries[0];
+    EXPECT_EQ("kickoff", kickoff.scenario_name);
+    EXPECT_EQ(2, kickoff.num_matches);
+    EXPECT_EQ(1, kickoff.friendly_goals);
+    EXPECT_EQ(0, kickoff.enemy_goals);
+    EXPECT_DOUBLE_EQ(0.25, kickoff.mean_friendly_possession_fraction);
+    EXPECT_DOUBLE_EQ(0, kickoff.mean_enemy_possession_fraction);
+    EXPECT_EQ(1, kickoff.num_matches_friendly_reached_ball);
+    ASSERT_TRUE(kickoff.mean_friendly_time_to_ball);
+    EXPECT_DOUBLE_EQ(2, kickoff.mean_friendly_time_to_ball->getSeconds());
+    EXPECT_DOUBLE_EQ(1, kickoff.mean_tick_cpu_time.getMilliseconds());
+    EXPECT_DOUBLE_EQ(3, kickoff.max_tick_cpu_time.getMilliseconds());
+
+    const MatchSummary &defense_summary = summaries[1];
+    EXPECT_EQ("defense", defense_summary.scenario_name);
+    EXPECT_EQ(1, defense_summary.num_matches);
+    EXPECT_EQ(1, defense_summary.enemy_goals);
+    EXPECT_DOUBLE_EQ(0.25, defense_summary.mean_enemy_possession_fraction);
+    EXPECT_FALSE(defense_summary.mean_friendly_time_to_ball);
+}
@@ -0,0 +1,948 @@
+#include "test/test_util/mrf_dongle_emulator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+
+#include "backend/output/radio/mrf/messages.h"
+
+/*
+ * The opaque libusb types. Since the emulator is the only device, these only need
+ * enough state to keep track of which handle transfers belong to.
+ */
+struct libusb_context
+{
+};
+
+struct libusb_device
+{
+    std::atomic<unsigned int> ref_count;
+};
+
+struct libusb_device_handle
+{
+    libusb_device *device;
+};
+
+namespace
+{
+    // The emulator that is currently attached, if any
+    std::atomic<Test::MRFDongleEmulator *> attached_emulator(nullptr);
+
+    libusb_device emulated_device{{0}};
+
+    // The index of the serial number string descriptor, and its value
+    const uint8_t SERIAL_NUMBER_INDEX = 1;
+    const char SERIAL_NUMBER[]        = "EMULATOR";
+
+    // The radio interface, and its alternate settings for configuration, normal mode
+    // and promiscuous mode. These are the same as the descriptors of the real dongle
+    const uint8_t RADIO_INTERFACE                         = 0;
+    const int CONFIGURATION_ALTSETTING                    = 0;
+    const int NORMAL_ALTSETTING                           = 1;
+    const libusb_interface_descriptor RADIO_ALTSETTINGS[] = {
+        {LIBUSB_DT_INTERFACE_SIZE, LIBUSB_DT_INTERFACE, RADIO_INTERFACE, 0, 0, 0xFF,
+         MRF::SUBCLASS, MRF::PROTOCOL_OFF, 0, nullptr, nullptr, 0},
+        {LIBUSB_DT_INTERFACE_SIZE, LIBUSB_DT_INTERFACE, RADIO_INTERFACE, 1, 6, 0xFF,
+         MRF::SUBCLASS, MRF::PROTOCOL_NORMAL, 0, nullptr, nullptr, 0},
+        {LIBUSB_DT_INTERFACE_SIZE, LIBUSB_DT_INTERFACE, RADIO_INTERFACE, 2, 1, 0xFF,
+         MRF::SUBCLASS, MRF::PROTOCOL_PROMISCUOUS, 0, nullptr, nullptr, 0},
+    };
+    const libusb_interface RADIO_INTERFACE_DESCRIPTOR = {
+        RADIO_ALTSETTINGS, sizeof(RADIO_ALTSETTINGS) / sizeof(*RADIO_ALTSETTINGS)};
+
+    // The status reported before setStatus is called: the emergency stop switch is in
+    // the STOP position, and there are no errors
+    const uint8_t INITIAL_STATUS = 0x01;
+
+    // The maximum number of MDRs the dongle reports in a single transfer
+    const std::size_t MAX_MDRS_PER_TRANSFER = 4;
+
+    // The length of a full drive packet, and the number of bytes per robot in a
+    // partial drive packet and a sequenced drive packet, as accepted by the dongle
+    const std::size_t DRIVE_PACKET_LENGTH             = 64;
+    const std::size_t PARTIAL_DRIVE_BYTES_PER_ROBOT   = 9;
+    const std::size_t SEQUENCED_DRIVE_BYTES_PER_ROBOT = 10;
+
+    // The bits of the drive serial number the dongle sends to the robots
+    const uint8_t DRIVE_SERIAL_MASK = 0x7F;
+
+    // The lengths of a camera packet and a compact camera packet
+    const std::size_t CAMERA_PACKET_LENGTH         = 55;
+    const std::size_t COMPACT_CAMERA_PACKET_LENGTH = 64;
+
+    // How long libusb_handle_events waits for a transfer to complete before returning
+    const std::chrono::milliseconds HANDLE_EVENTS_TIMEOUT(50);
+
+    // How long cancelling a transfer takes. USB::Transfer disowns transfers just after
+    // cancelling them, which takes a round trip to the device with real hardware
+    const std::chrono::milliseconds CANCEL_LATENCY(10);
+
+    // How often waitUntil checks its condition
+    const std::chrono::milliseconds WAIT_UNTIL_POLL_INTERVAL(1);
+
+    unsigned int decodeTries(uint8_t tries)
+    {
+        // The dongle treats 0 tries as 256
+        return tries ? tries : 256;
+    }
+}  // namespace
+
+Test::MRFDongleEmulator::MRFDongleEmulator()
+    : configuration(1),
+      alternate_setting(CONFIGURATION_ALTSETTING),
+      transfer_latency(0),
+      event_handler_interrupted(false),
+      channel(0),
+      symbol_rate(250),
+      pan_id(0xFFFF),
+      mac_address(0),
+      time(0),
+      message_delivery_status(MRF::MDR_STATUS_OK),
+      deliver_messages_immediately(true),
+      status(INITIAL_STATUS),
+      status_changed(true),
+      drive_serials(),
+      stats{0, 0, 0, 0, 0}
+{
+    MRFDongleEmulator *expected = nullptr;
+    if (!attached_emulator.compare_exchange_strong(expected, this))
+    {
+        throw std::logic_error("Only one MRFDongleEmulator can be attached at a time");
+    }
+}
+
+Test::MRFDongleEmulator::~MRFDongleEmulator()
+{
+    attached_emulator = nullptr;
+}
+
+void Test::MRFDongleEmulator::setMessageDeliveryStatus(uint8_t status)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    message_delivery_status = status;
+}
+
+void Test::MRFDongleEmulator::setDeliverMessagesImmediately(bool deliver_immediately)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    deliver_messages_immediately = deliver_immediately;
+}
+
+void Test::MRFDongleEmulator::deliverMessageDeliveryReports()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    queued_mdrs.insert(queued_mdrs.end(), held_mdrs.begin(), held_mdrs.end());
+    held_mdrs.clear();
+    fillInTransfers();
+}
+
+void Test::MRFDongleEmulator::receiveRobotMessage(uint8_t robot,
+                                                  const std::vector<uint8_t> &data,
+                                                  uint8_t lqi, uint8_t rssi)
+{
+    std::vector<uint8_t> message;
+    message.reserve(data.size() + 3);
+    message.push_back(robot);
+    message.insert(message.end(), data.begin(), data.end());
+    message.push_back(lqi);
+    message.push_back(rssi);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    queued_robot_messages.push_back(std::move(message));
+    fillInTransfers();
+}
+
+void Test::MRFDongleEmulator::setStatus(uint8_t status)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (status != this->status)
+    {
+        this->status   = status;
+        status_changed = true;
+        fillInTransfers();
+    }
+}
+
+void Test::MRFDongleEmulator::setTransferLatency(std::chrono::microseconds latency)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    transfer_latency = latency;
+}
+
+std::vector<std::vector<uint8_t>> Test::MRFDongleEmulator::getDrivePackets()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return drive_packets;
+}
+
+std::array<uint8_t, 8> Test::MRFDongleEmulator::getDriveSerials()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::array<uint8_t, 8> serials;
+    for (std::size_t i = 0; i < serials.size(); i++)
+    {
+        serials[i] = static_cast<uint8_t>(drive_serials[i] & DRIVE_SERIAL_MASK);
+    }
+    return serials;
+}
+
+std::vector<std::vector<uint8_t>> Test::MRFDongleEmulator::getCameraPackets()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return camera_packets;
+}
+
+std::vector<Test::MRFDongleEmulator::RobotMessage>
+Test::MRFDongleEmulator::getRobotMessages()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return robot_messages;
+}
+
+std::vector<unsigned int> Test::MRFDongleEmulator::getBeeps()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return beeps;
+}
+
+Test::MRFDongleEmulator::TransferStats Test::MRFDongleEmulator::getTransferStats()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+uint8_t Test::MRFDongleEmulator::getChannel()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return channel;
+}
+
+unsigned int Test::MRFDongleEmulator::getSymbolRate()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return symbol_rate;
+}
+
+uint16_t Test::MRFDongleEmulator::getPanId()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return pan_id;
+}
+
+uint64_t Test::MRFDongleEmulator::getMacAddress()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return mac_address;
+}
+
+bool Test::MRFDongleEmulator::waitUntil(const std::function<bool()> &condition,
+                                        std::chrono::milliseconds timeout)
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition())
+    {
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(WAIT_UNTIL_POLL_INTERVAL);
+    }
+    return true;
+}
+
+int Test::MRFDongleEmulator::handleControlRequest(uint8_t request_type, uint8_t request,
+                                                  uint16_t value, uint16_t index,
+                                                  unsigned char *data, uint16_t length)
+{
+    // Anything the dongle does not understand is rejected with a stall, which libusb
+    // reports as a pipe error
+    if ((request_type & 0x60) != LIBUSB_REQUEST_TYPE_VENDOR)
+    {
+        return LIBUSB_ERROR_PIPE;
+    }
+
+    bool in            = (request_type & LIBUSB_ENDPOINT_DIR_MASK) == LIBUSB_ENDPOINT_IN;
+    bool configuring   = alternate_setting == CONFIGURATION_ALTSETTING;
+    uint8_t recipient  = request_type & 0x1F;
+    bool for_interface = recipient == LIBUSB_RECIPIENT_INTERFACE && index == RADIO_INTERFACE;
+
+    auto write_value = [&](uint64_t value, std::size_t size) {
+        if (length < size)
+        {
+            return static_cast<int>(LIBUSB_ERROR_PIPE);
+        }
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            data[i] = static_cast<unsigned char>(value >> 8 * i);
+        }
+        return static_cast<int>(size);
+    };
+    auto read_value = [&](uint64_t &value) {
+        if (length != sizeof(value))
+        {
+            return false;
+        }
+        value = 0;
+        for (std::size_t i = 0; i < sizeof(value); ++i)
+        {
+            value |= static_cast<uint64_t>(data[i]) << 8 * i;
+        }
+        return true;
+    };
+
+    if (in && for_interface)
+    {
+        switch (request)
+        {
+            case MRF::CONTROL_REQUEST_GET_CHANNEL:
+                return write_value(channel, 1);
+            case MRF::CONTROL_REQUEST_GET_SYMBOL_RATE:
+                return write_value(symbol_rate == 625 ? 1 : 0, 1);
+            case MRF::CONTROL_REQUEST_GET_PAN_ID:
+                return write_value(pan_id, 2);
+            case MRF::CONTROL_REQUEST_GET_MAC_ADDRESS:
+                return write_value(mac_address, 8);
+        }
+    }
+    else if (!in && for_interface)
+    {
+        switch (request)
+        {
+            case MRF::CONTROL_REQUEST_SET_CHANNEL:
+                if (configuring && length == 0 && value >= 0x0B && value <= 0x1A)
+                {
+                    channel = static_cast<uint8_t>(value);
+                    return 0;
+                }
+                break;
+            case MRF::CONTROL_REQUEST_SET_SYMBOL_RATE:
+                if (configuring && length == 0 && value <= 1)
+                {
+                    symbol_rate = value ? 625 : 250;
+                    return 0;
+                }
+                break;
+            case MRF::CONTROL_REQUEST_SET_PAN_ID:
+                if (configuring && length == 0 && value != 0xFFFF)
+                {
+                    pan_id = value;
+                    return 0;
+                }
+                break;
+            case MRF::CONTROL_REQUEST_SET_MAC_ADDRESS:
+                if (configuring && read_value(mac_address))
+                {
+                    return length;
+                }
+                break;
+            case MRF::CONTROL_REQUEST_BEEP:
+                if (length == 0)
+                {
+                    beeps.push_back(value);
+                    return 0;
+                }
+                break;
+        }
+    }
+    else if (!in && recipient == LIBUSB_RECIPIENT_DEVICE &&
+             request == MRF::CONTROL_REQUEST_SET_TIME)
+    {
+        if (read_value(time))
+        {
+            return length;
+        }
+    }
+
+    return LIBUSB_ERROR_PIPE;
+}
+
+bool Test::MRFDongleEmulator::handleOutTransfer(unsigned char endpoint,
+                                                const unsigned char *data,
+                                                std::size_t length)
+{
+    switch (endpoint)
+    {
+        case 1:
+            // A drive packet for every robot, a partial drive packet with a robot index
+            // before each robot's data, or a sequenced drive packet with a robot index
+            // and sequence number before each robot's data
+            if (length == DRIVE_PACKET_LENGTH)
+            {
+                for (uint8_t &serial : drive_serials)
+                {
+                    ++serial;
+                }
+            }
+            else if (length && length <= drive_serials.size() *
+                                             SEQUENCED_DRIVE_BYTES_PER_ROBOT &&
+                     length % SEQUENCED_DRIVE_BYTES_PER_ROBOT == 0)
+            {
+                for (std::size_t i = 0; i < length; i += SEQUENCED_DRIVE_BYTES_PER_ROBOT)
+                {
+                    if (data[i] >= drive_serials.size())
+                    {
+                        return false;
+                    }
+                }
+                for (std::size_t i = 0; i < length; i += SEQUENCED_DRIVE_BYTES_PER_ROBOT)
+                {
+                    drive_serials[data[i]] = data[i + 1];
+                }
+            }
+            else if (length && length <= drive_serials.size() *
+                                             PARTIAL_DRIVE_BYTES_PER_ROBOT &&
+                     length % PARTIAL_DRIVE_BYTES_PER_ROBOT == 0)
+            {
+                for (std::size_t i = 0; i < length; i += PARTIAL_DRIVE_BYTES_PER_ROBOT)
+                {
+                    if (data[i] >= drive_serials.size())
+                    {
+                        return false;
+                    }
+                }
+                for (std::size_t i = 0; i < length; i += PARTIAL_DRIVE_BYTES_PER_ROBOT)
+                {
+                    ++drive_serials[data[i]];
+                }
+            }
+            else
+            {
+                return false;
+            }
+            drive_packets.emplace_back(data, data + length);
+            ++stats.num_drive_packets;
+            return true;
+
+        case 2:
+            // The format of camera packets is given by their length
+            if (length == CAMERA_PACKET_LENGTH || length == COMPACT_CAMERA_PACKET_LENGTH)
+            {
+                camera_packets.emplace_back(data, data + length);
+                ++stats.num_camera_packets;
+                return true;
+            }
+            return false;
+
+        case 3:
+            if (length >= 3 && (data[0] & 0xF0) && (data[0] & 0x0F) < 8)
+            {
+                // A reliable message, whose delivery is reported on IN endpoint 1
+                robot_messages.push_back({static_cast<uint8_t>(data[0] & 0x0F), true,
+                                          data[1], decodeTries(data[2]),
+                                          std::vector<uint8_t>(data + 3, data + length)});
+                auto mdr = std::make_pair(data[1], message_delivery_status);
+                if (deliver_messages_immediately)
+                {
+                    queued_mdrs.push_back(mdr);
+                }
+                else
+                {
+                    held_mdrs.push_back(mdr);
+                }
+            }
+            else if (length >= 2 && data[0] < 8)
+            {
+                robot_messages.push_back({data[0], false, 0, decodeTries(data[1]),
+                                          std::vector<uint8_t>(data + 2, data + length)});
+            }
+            else
+            {
+                return false;
+            }
+            ++stats.num_robot_messages;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void Test::MRFDongleEmulator::fillInTransfers()
+{
+    while (!pending_mdr_transfers.empty() && !queued_mdrs.empty())
+    {
+        libusb_transfer *transfer = pending_mdr_transfers.front();
+        pending_mdr_transfers.pop_front();
+
+        std::size_t num_mdrs =
+            std::min({MAX_MDRS_PER_TRANSFER, queued_mdrs.size(),
+                      static_cast<std::size_t>(transfer->length) / 2});
+        for (std::size_t i = 0; i < num_mdrs; ++i)
+        {
+            transfer->buffer[2 * i]     = queued_mdrs.front().first;
+            transfer->buffer[2 * i + 1] = queued_mdrs.front().second;
+            queued_mdrs.pop_front();
+        }
+        transfer->actual_length = static_cast<int>(2 * num_mdrs);
+        stats.num_mdrs += num_mdrs;
+        completeTransfer(transfer, LIBUSB_TRANSFER_COMPLETED,
+                         std::chrono::microseconds(0));
+    }
+
+    while (!pending_robot_message_transfers.empty() && !queued_robot_messages.empty())
+    {
+        libusb_transfer *transfer = pending_robot_message_transfers.front();
+        pending_robot_message_transfers.pop_front();
+
+        const std::vector<uint8_t> &message = queued_robot_messages.front();
+        std::size_t length =
+            std::min(message.size(), static_cast<std::size_t>(transfer->length));
+        std::copy(message.begin(), message.begin() + length, transfer->buffer);
+        transfer->actual_length = static_cast<int>(length);
+        completeTransfer(transfer,
+                         length < message.size() ? LIBUSB_TRANSFER_OVERFLOW
+                                                 : LIBUSB_TRANSFER_COMPLETED,
+                         std::chrono::microseconds(0));
+        queued_robot_messages.pop_front();
+    }
+
+    if (!pending_status_transfers.empty() && status_changed)
+    {
+        libusb_transfer *transfer = pending_status_transfers.front();
+        pending_status_transfers.pop_front();
+
+        transfer->buffer[0]     = status;
+        transfer->actual_length = 1;
+        status_changed          = false;
+        completeTransfer(transfer, LIBUSB_TRANSFER_COMPLETED,
+                         std::chrono::microseconds(0));
+    }
+}
+
+void Test::MRFDongleEmulator::completeTransfer(libusb_transfer *transfer,
+                                               libusb_transfer_status status,
+                                               std::chrono::microseconds latency)
+{
+    if (status == LIBUSB_TRANSFER_STALL)
+    {
+        ++stats.num_stalls;
+    }
+    transfer->status = status;
+    completed_transfers.push_back({std::chrono::steady_clock::now() + latency, transfer});
+    events_changed.notify_all();
+}
+
+void Test::MRFDongleEmulator::dispatchCompletedTransfers(bool wait_for_events,
+                                                         libusb_device_handle *dev_handle)
+{
+    std::vector<libusb_transfer *> ready_transfers;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (wait_for_events)
+        {
+            auto deadline = std::chrono::steady_clock::now() + HANDLE_EVENTS_TIMEOUT;
+            while (!event_handler_interrupted)
+            {
+                auto now       = std::chrono::steady_clock::now();
+                auto wake_time = deadline;
+                for (const CompletedTransfer &completed : completed_transfers)
+                {
+                    wake_time = std::min(wake_time, completed.ready_time);
+                }
+                if (wake_time <= now)
+                {
+                    break;
+                }
+                events_changed.wait_until(lock, wake_time);
+            }
+            event_handler_interrupted = false;
+        }
+    }
+
+    // Only one thread calls callbacks at a time, like libusb's event lock
+    std::lock_guard<std::mutex> dispatch_lock(dispatch_mutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto now = std::chrono::steady_clock::now();
+        auto ready =
+            std::stable_partition(completed_transfers.begin(), completed_transfers.end(),
+                                  [&](const CompletedTransfer &completed) {
+                                      return dev_handle
+                                                 ? completed.transfer->dev_handle !=
+                                                       dev_handle
+                                                 : completed.ready_time > now;
+                                  });
+        std::transform(ready, completed_transfers.end(),
+                       std::back_inserter(ready_transfers),
+                       [](const CompletedTransfer &completed) {
+                           return completed.transfer;
+                       });
+        completed_transfers.erase(ready, completed_transfers.end());
+    }
+
+    // Callbacks may submit more transfers, so they are called without holding the
+    // mutex
+    for (libusb_transfer *transfer : ready_transfers)
+    {
+        transfer->callback(transfer);
+    }
+}
+
+/*
+ * The libusb API, implemented on top of the attached emulator.
+ */
+
+int LIBUSB_CALL libusb_init(libusb_context **ctx)
+{
+    *ctx = new libusb_context();
+    return LIBUSB_SUCCESS;
+}
+
+void LIBUSB_CALL libusb_exit(libusb_context *ctx)
+{
+    delete ctx;
+}
+
+ssize_t LIBUSB_CALL libusb_get_device_list(libusb_context *, libusb_device ***list)
+{
+    // The list is null-terminated, like the list returned by libusb
+    ssize_t num_devices = attached_emulator ? 1 : 0;
+    *list               = new libusb_device *[num_devices + 1]();
+    if (num_devices)
+    {
+        (*list)[0] = libusb_ref_device(&emulated_device);
+    }
+    return num_devices;
+}
+
+void LIBUSB_CALL libusb_free_device_list(libusb_device **list, int unref_devices)
+{
+    for (libusb_device **device = list; unref_devices && *device; ++device)
+    {
+        libusb_unref_device(*device);
+    }
+    delete[] list;
+}
+
+libusb_device *LIBUSB_CALL libusb_ref_device(libusb_device *dev)
+{
+    ++dev->ref_count;
+    return dev;
+}
+
+void LIBUSB_CALL libusb_unref_device(libusb_device *dev)
+{
+    --dev->ref_count;
+}
+
+int LIBUSB_CALL libusb_get_device_descriptor(libusb_device *,
+                                             struct libusb_device_descriptor *desc)
+{
+    *desc                    = {};
+    desc->bLength            = LIBUSB_DT_DEVICE_SIZE;
+    desc->bDescriptorType    = LIBUSB_DT_DEVICE;
+    desc->bcdUSB             = 0x0200;
+    desc->bMaxPacketSize0    = 8;
+    desc->idVendor           = MRF::VENDOR_ID;
+    desc->idProduct          = MRF::PRODUCT_ID;
+    desc->iSerialNumber      = SERIAL_NUMBER_INDEX;
+    desc->bNumConfigurations = 1;
+    return LIBUSB_SUCCESS;
+}
+
+int LIBUSB_CALL libusb_get_config_descriptor(libusb_device *, uint8_t config_index,
+                                             struct libusb_config_descriptor **config)
+{
+    if (config_index != 0)
+    {
+        return LIBUSB_ERROR_NOT_FOUND;
+    }
+
+    // The interface descriptors are static, so only the top-level descriptor needs to
+    // be freed
+    *config                        = new libusb_config_descriptor();
+    (*config)->bLength             = LIBUSB_DT_CONFIG_SIZE;
+    (*config)->bDescriptorType     = LIBUSB_DT_CONFIG;
+    (*config)->bNumInterfaces      = 1;
+    (*config)->bConfigurationValue = 1;
+    (*config)->interface           = &RADIO_INTERFACE_DESCRIPTOR;
+    return LIBUSB_SUCCESS;
+}
+
+void LIBUSB_CALL libusb_free_config_descriptor(struct libusb_config_descriptor *config)
+{
+    delete config;
+}
+
+int LIBUSB_CALL libusb_open(libusb_device *dev, libusb_device_handle **dev_handle)
+{
+    if (!attached_emulator)
+    {
+        return LIBUSB_ERROR_NO_DEVICE;
+    }
+    *dev_handle = new libusb_device_handle{dev};
+    return LIBUSB_SUCCESS;
+}
+
+void LIBUSB_CALL libusb_close(libusb_device_handle *dev_handle)
+{
+    Test::MRFDongleEmulator *emulator = attached_emulator;
+    if (emulator)
+    {
+        // Finish any transfers that were cancelled before closing, so their memory is
+        // freed. Transfers that are still pending can never complete
+        emulator->dispatchCompletedTransfers(false, dev_handle);
+
+        std::lock_guard<std::mutex> lock(emulator->mutex);
+        for (auto pending : {&emulator->pending_mdr_transfers,
+                             &emulator->pending_robot_message_transfers,
+                             &emulator->pending_status_transfers})
+        {
+            pending->erase(std::remove_if(pending->begin(), pending->end(),
+                                          [&](libusb_transfer *transfer) {
+                                              return transfer->dev_handle == dev_handle;
+                                          }),
+                           pending->end());
+        }
+    }
+    delete dev_handle;
+}
+
+libusb_device *LIBUSB_CALL libusb_get_device(libusb_device_handle *dev_handle)
+{
+    return dev_handle->device;
+}
+
+int LIBUSB_CALL libusb_get_configuration(libusb_device_handle *, int *config)
+{
+    Test::MRFDongleEmulator *emulator = attached_emulator;
+    if (!emulator)
+    {
+        return LIBUSB_ERROR_NO_DEVICE;
+    }
+    std::lock_guard<std::mutex> lock(emulator->mutex);
+    *config = emulator->configuration;
+    return LIBUSB_SUCCESS;
+}
+
+int LIBUSB_CALL libusb_set_configuration(libusb_device_handle *, int configuration)
+{
+    Test::MRFDongleEmulator *emulator = attached_emulator;
+    if (!emulator)
+    {
+        return LIBUSB_ERROR_NO_DEVICE;
+    }
+    if (configuration != -1 && configuration != 0 && configuration != 1)
+    {
+        return LIBUSB_ERROR_NOT_FOUND;
+    }
+    std::lock_guard<std::mutex> lock(emulator->mutex);
+    emulator->configuration     = configuration == 1 ? 1 : 0;
+    emulator->alternate_setting = CONFIGURATION_ALTSETTING;
+    return LIBUSB_SUCCESS;
+}
+
+int LIBUSB_CALL libusb_claim_interface(libusb_device_handle *, int interface_number)
+{
+    return interface_number == RADIO_INTERFACE ? LIBUSB_SUCCESS : LIBUSB_ERROR_NOT_FOUND;
+}
+
+int LIBUSB_CALL libusb_release_interface(libusb_device_handle *, int interface_number)
+{
+    return interface_number == RADIO_INTERFACE ? LIBUSB_SUCCESS : LIBUSB_ERROR_NOT_FOUND;
+}
+
+int LIBUSB_CALL libusb_set_interface_alt_setting(libusb_device_handle *,
+                                                 int interface_number,
+                                                 int alternate_setting)
+{
+    Test::MRFDongleEmulator *emulator = attached_emulator;
+    if (!emulator)
+    {
+        return LIBUSB_ERROR_NO_DEVICE;
+    }
+    if (interface_number != RADIO_INTERFACE || alternate_setting < 0 ||
+        alternate_setting >= RADIO_INTERFACE_DESCRIPTOR.num_altsetting)
+    {
+        return LIBUSB_ERROR_NOT_FOUND;
+    }
+    std::lock_guard<std::mutex> lock(emulator->mutex);
+    emulator->alternate_setting = alternate_setting;
+    return LIBUSB_SUCCESS;
+}
+
+int LIBUSB_CALL libusb_clear_halt(libusb_device_handle *, unsigned char)
+{
+    return LIBUSB_SUCCESS;
+}
+
+int LIBUSB_CALL libusb_reset_device(libusb_device_handle *)
+{
+    return LIBUSB_SUCCESS;
+}
+
+int LIBUSB_CALL libusb_get_string_descriptor_ascii(libusb_device_handle *,
+                                                   uint8_t desc_index,
+                                                   unsigned char *data, int length)
+{
+    if (desc_index != SERIAL_NUMBER_INDEX)
+    {
+        return LIBUSB_ERROR_PIPE;
+    }
+
+    // Like libusb, the string is truncated to fit and null-terminated
+    int string_length = std::min(static_cast<int>(sizeof(SERIAL_NUMBER)) - 1, length - 1);
+    std::memcpy(data, SERIAL_NUMBER, static_cast<std::size_t>(string_length));
+    data[string_length] = '\0';
+    return string_length;
+}
+
+int LIBUSB_CALL libusb_control_transfer(libusb_device_handle *, uint8_t request_type,
+                                        uint8_t bRequest, uint16_t wValue,
+                                        uint16_t wIndex, unsigned char *data,
+                                        uint16_t wLength, unsigned int)
+{
+    Test::MRFDongleEmulator *emulator = attached_emulator;
+    if (!emulator)
+    {
+        return LIBUSB_ERROR_NO_DEVICE;
+    }
+    std::lock_guard<std::mutex> lock(emulator->mutex);
+    return emulator->handleControlRequest(request_type, bRequest, wValue, wIndex, data,
+                                          wLength);
+}
+
+int LIBUSB_CALL libusb_bulk_transfer(libusb_device_handle *, unsigned char,
+                                     unsigned char *, int, int *, unsigned int)
+{
+    // The dongle is only ever used asynchronously
+    return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+int LIBUSB_CALL libusb_interrupt_transfer(libusb_device_handle *, unsigned char,
+                                          unsigned char *, int, int *, unsigned int)
+{
+    return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+struct libusb_transfer *LIBUSB_CALL libusb_alloc_transfer(int iso_packets)
+{
+    std::size_t size = sizeof(libusb_transfer) +
+                       sizeof(libusb_iso_packet_descriptor) *
+                           static_cast<std::size_t>(std::max(iso_packets, 0));
+    return static_cast<libusb_transfer *>(std::calloc(1, size));
+}
+
+void LIBUSB_CALL libusb_free_transfer(struct libusb_transfer *transfer)
+{
+    if (transfer && (transfer->flags & LIBUSB_TRANSFER_FREE_BUFFER))
+    {
+        std::free(transfer->buffer);
+    }
+    std::free(transfer);
+}
+
+int LIBUSB_CALL libusb_submit_transfer(struct libusb_transfer *transfer)
+{
+    Test::MRFDongleEmulator *emulator = attached_emulator;
+    if (!emulator)
+    {
+        return LIBUSB_ERROR_NO_DEVICE;
+    }
+    std::lock_guard<std::mutex> lock(emulator->mutex);
+
+    transfer->actual_length = 0;
+    if (transfer->type == LIBUSB_TRANSFER_TYPE_CONTROL)
+    {
+        const libusb_control_setup *setup = libusb_control_transfer_get_setup(transfer);
+        int result                        = emulator->handleControlRequest(
+            setup->bmRequestType, setup->bRequest, libusb_le16_to_cpu(setup->wValue),
+            libusb_le16_to_cpu(setup->wIndex), libusb_control_transfer_get_data(transfer),
+            libusb_le16_to_cpu(setup->wLength));
+        transfer->actual_length = std::max(result, 0);
+        emulator->completeTransfer(
+            transfer, result < 0 ? LIBUSB_TRANSFER_STALL : LIBUSB_TRANSFER_COMPLETED,
+            emulator->transfer_latency);
+        return LIBUSB_SUCCESS;
+    }
+
+    // The data endpoints only exist in normal mode
+    unsigned char endpoint = transfer->endpoint & LIBUSB_ENDPOINT_ADDRESS_MASK;
+    if (emulator->alternate_setting != NORMAL_ALTSETTING || endpoint < 1 || endpoint > 3)
+    {
+        return LIBUSB_ERROR_NOT_FOUND;
+    }
+
+    if ((transfer->endpoint & LIBUSB_ENDPOINT_DIR_MASK) == LIBUSB_ENDPOINT_IN)
+    {
+        switch (endpoint)
+        {
+            case 1:
+                emulator->pending_mdr_transfers.push_back(transfer);
+                break;
+            case 2:
+                emulator->pending_robot_message_transfers.push_back(transfer);
+                break;
+            case 3:
+                emulator->pending_status_transfers.push_back(transfer);
+                break;
+        }
+    }
+    else
+    {
+        bool accepted = emulator->handleOutTransfer(
+            endpoint, transfer->buffer, static_cast<std::size_t>(transfer->length));
+        transfer->actual_length = accepted ? transfer->length : 0;
+        emulator->completeTransfer(
+            transfer, accepted ? LIBUSB_TRANSFER_COMPLETED : LIBUSB_TRANSFER_STALL,
+            emulator->transfer_latency);
+    }
+
+    emulator->fillInTransfers();
+    return LIBUSB_SUCCESS;
+}
+
+int LIBUSB_CALL libusb_cancel_transfer(struct libusb_transfer *transfer)
+{
+    Test::MRFDongleEmulator *emulator = attached_emulator;
+    if (!emulator)
+    {
+        return LIBUSB_ERROR_NO_DEVICE;
+    }
+    std::lock_guard<std::mutex> lock(emulator->mutex);
+
+    // Only IN transfers can still be pending. Anything else has already completed, and
+    // its callback will be called as usual
+    for (auto pending : {&emulator->pending_mdr_transfers,
+                         &emulator->pending_robot_message_transfers,
+                         &emulator->pending_status_transfers})
+    {
+        auto iter = std::find(pending->begin(), pending->end(), transfer);
+        if (iter != pending->end())
+        {
+            pending->erase(iter);
+            emulator->completeTransfer(transfer, LIBUSB_TRANSFER_CANCELLED,
+                                       CANCEL_LATENCY);
+            return LIBUSB_SUCCESS;
+        }
+    }
+    return LIBUSB_ERROR_NOT_FOUND;
+}
+
+int LIBUSB_CALL libusb_handle_events(libusb_context *)
+{
+    Test::MRFDongleEmulator *emulator = attached_emulator;
+    if (!emulator)
+    {
+        std::this_thread::sleep_for(HANDLE_EVENTS_TIMEOUT);
+        return LIBUSB_SUCCESS;
+    }
+    emulator->dispatchCompletedTransfers(true, nullptr);
+    return LIBUSB_SUCCESS;
+}
+
+void LIBUSB_CALL libusb_interrupt_event_handler(libusb_context *)
+{
+    Test::MRFDongleEmulator *emulator = attached_emulator;
+    if (emulator)
+    {
+        std::lock_guard<std::mutex> lock(emulator->mutex);
+        emulator->event_handler_interrupted = true;
+        emulator->events_changed.notify_all();
+    }
+}
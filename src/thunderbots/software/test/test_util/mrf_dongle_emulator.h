@@ -0,0 +1,309 @@
+#pragma once
+
+#include <libusb.h>
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "util/noncopyable.h"
+
+namespace Test
+{
+    /**
+     * An in-process emulator of the MRF dongle, for running the radio code in
+     * backend/output/radio/mrf without the physical dongle.
+     *
+     * The emulator replaces libusb itself, so MRFDongle, SendReliableMessageOperation
+     * and the USB wrappers run unmodified on top of it. Test targets that use it must
+     * link the emulator instead of libusb.
+     *
+     * While an emulator exists, it is the only device libusb can find. It reproduces
+     * the endpoints of the dongle in normal mode, as implemented in
+     * firmware/dongle/normal.c:
+     *  - OUT endpoint 1 accepts drive packets
+     *  - OUT endpoint 2 accepts camera packets
+     *  - OUT endpoint 3 accepts reliable and unreliable messages to the robots
+     *  - IN endpoint 1 reports message delivery reports (MDRs) for reliable messages,
+     *    up to 4 at a time
+     *  - IN endpoint 2 reports messages received from the robots
+     *  - IN endpoint 3 reports the dongle status whenever it changes
+     * Transfers the real dongle would reject by halting the endpoint fail with a
+     * stall. The vendor control requests used to configure the radio are accepted in
+     * the configuration alternate setting, as on the real dongle.
+     *
+     * Transfers complete on the thread that runs the libusb event loop (which
+     * USB::Context creates), so tests should use waitUntil to wait for the effects of
+     * the code under test.
+     */
+    class MRFDongleEmulator final : public NonCopyable
+    {
+       public:
+        /**
+         * A message sent to a robot through OUT endpoint 3
+         */
+        struct RobotMessage
+        {
+            uint8_t robot;
+            bool reliable;
+            // The id used to report delivery of reliable messages, or 0 for unreliable
+            // messages
+            uint8_t message_id;
+            unsigned int tries;
+            std::vector<uint8_t> data;
+        };
+
+        /**
+         * Counts of the transfers completed by the emulator, for measuring throughput
+         */
+        struct TransferStats
+        {
+            uint64_t num_drive_packets;
+            uint64_t num_camera_packets;
+            uint64_t num_robot_messages;
+            uint64_t num_mdrs;
+            uint64_t num_stalls;
+        };
+
+        /**
+         * Creates a new emulator and attaches it, so libusb finds it as a dongle. Only
+         * one emulator can be attached at a time.
+         *
+         * @throws std::logic_error if another emulator is already attached
+         */
+        explicit MRFDongleEmulator();
+
+        /**
+         * Detaches the emulator. Any MRFDongle or USB::Context using it must be
+         * destroyed first.
+         */
+        ~MRFDongleEmulator();
+
+        /**
+         * Sets the delivery status reported for reliable messages.
+         *
+         * @param status one of the MRF::MDR_STATUS_* codes
+         */
+        void setMessageDeliveryStatus(uint8_t status);
+
+        /**
+         * Sets whether message delivery reports are reported as soon as a reliable
+         * message is received. If not, they are held until deliverMessageDeliveryReports
+         * is called, which emulates messages that are still being sent over radio.
+         *
+         * @param deliver_immediately whether to report delivery immediately
+         */
+        void setDeliverMessagesImmediately(bool deliver_immediately);
+
+        /**
+         * Reports delivery of all the reliable messages whose delivery reports are
+         * being held.
+         */
+        void deliverMessageDeliveryReports();
+
+        /**
+         * Emulates the dongle receiving a message from a robot over radio.
+         *
+         * @param robot the index of the robot that sent the message
+         * @param data the message
+         * @param lqi the link quality indicator of the received message
+         * @param rssi the received signal strength of the received message
+         */
+        void receiveRobotMessage(uint8_t robot, const std::vector<uint8_t> &data,
+                                 uint8_t lqi, uint8_t rssi);
+
+        /**
+         * Sets the dongle status byte, which holds the emergency stop switch state in
+         * the lower 2 bits and error flags in the upper bits. The status is reported on
+         * IN endpoint 3 if it changed.
+         *
+         * @param status the new status
+         */
+        void setStatus(uint8_t status);
+
+        /**
+         * Sets how long OUT transfers take to complete after they are submitted, which
+         * emulates the time taken to send them over USB.
+         *
+         * @param latency how long OUT transfers take to complete
+         */
+        void setTransferLatency(std::chrono::microseconds latency);
+
+        /**
+         * Returns the drive packets received on OUT endpoint 1, in order
+         */
+        std::vector<std::vector<uint8_t>> getDrivePackets();
+
+        /**
+         * Returns the serial number the dongle sends to each robot along with its drive
+         * data, indexed by robot id. This is the sequence number of the robot's latest
+         * primitive for sequenced drive packets, and otherwise counts the drive packets
+         * with new data for the robot, as in firmware/dongle/normal.c.
+         */
+        std::array<uint8_t, 8> getDriveSerials();
+
+        /**
+         * Returns the camera packets received on OUT endpoint 2, in order
+         */
+        std::vector<std::vector<uint8_t>> getCameraPackets();
+
+        /**
+         * Returns the messages received on OUT endpoint 3, in order
+         */
+        std::vector<RobotMessage> getRobotMessages();
+
+        /**
+         * Returns the lengths of the beeps requested from the dongle, in milliseconds
+         */
+        std::vector<unsigned int> getBeeps();
+
+        /**
+         * Returns counts of the transfers completed by the emulator
+         */
+        TransferStats getTransferStats();
+
+        /**
+         * Returns the radio channel, symbol rate, PAN ID and MAC address the dongle was
+         * configured with
+         */
+        uint8_t getChannel();
+        unsigned int getSymbolRate();
+        uint16_t getPanId();
+        uint64_t getMacAddress();
+
+        /**
+         * Waits until the given condition is true, or the timeout expires.
+         *
+         * @param condition the condition to wait for
+         * @param timeout the longest time to wait
+         *
+         * @return whether the condition became true before the timeout expired
+         */
+        bool waitUntil(const std::function<bool()> &condition,
+                       std::chrono::milliseconds timeout);
+
+       private:
+        friend int LIBUSB_CALL ::libusb_get_configuration(libusb_device_handle *dev,
+                                                          int *config);
+        friend int LIBUSB_CALL ::libusb_set_configuration(libusb_device_handle *dev_handle,
+                                                          int configuration);
+        friend int LIBUSB_CALL ::libusb_set_interface_alt_setting(
+            libusb_device_handle *dev_handle, int interface_number,
+            int alternate_setting);
+        friend int LIBUSB_CALL ::libusb_control_transfer(
+            libusb_device_handle *dev_handle, uint8_t request_type, uint8_t bRequest,
+            uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength,
+            unsigned int timeout);
+        friend int LIBUSB_CALL ::libusb_submit_transfer(struct libusb_transfer *transfer);
+        friend int LIBUSB_CALL ::libusb_cancel_transfer(struct libusb_transfer *transfer);
+        friend int LIBUSB_CALL ::libusb_handle_events(libusb_context *ctx);
+        friend void LIBUSB_CALL ::libusb_interrupt_event_handler(libusb_context *ctx);
+        friend void LIBUSB_CALL ::libusb_close(libusb_device_handle *dev_handle);
+
+        /**
+         * A transfer that has finished, and whose callback will be called by the event
+         * loop once the ready time has passed
+         */
+        struct CompletedTransfer
+        {
+            std::chrono::steady_clock::time_point ready_time;
+            libusb_transfer *transfer;
+        };
+
+        /**
+         * Handles a vendor control request. The caller must hold the mutex.
+         *
+         * @return the number of bytes of data transferred, or a libusb error code
+         */
+        int handleControlRequest(uint8_t request_type, uint8_t request, uint16_t value,
+                                 uint16_t index, unsigned char *data, uint16_t length);
+
+        /**
+         * Handles data sent to an OUT endpoint. The caller must hold the mutex.
+         *
+         * @return whether the dongle accepted the data. The real dongle halts the
+         * endpoint if it does not
+         */
+        bool handleOutTransfer(unsigned char endpoint, const unsigned char *data,
+                               std::size_t length);
+
+        /**
+         * Fills pending IN transfers with any data that is waiting to be reported. The
+         * caller must hold the mutex.
+         */
+        void fillInTransfers();
+
+        /**
+         * Marks the given transfer as finished with the given status. The caller must
+         * hold the mutex.
+         */
+        void completeTransfer(libusb_transfer *transfer, libusb_transfer_status status,
+                              std::chrono::microseconds latency);
+
+        /**
+         * Calls the callbacks of the completed transfers that are ready, optionally only
+         * those for the given device handle. The mutex must not be held by the caller.
+         *
+         * @param wait_for_events whether to wait a short time for a transfer to become
+         * ready if there are none
+         * @param dev_handle if not null, only transfers for this handle are completed,
+         * regardless of their ready time
+         */
+        void dispatchCompletedTransfers(bool wait_for_events,
+                                        libusb_device_handle *dev_handle);
+
+        std::mutex mutex;
+        std::condition_variable events_changed;
+
+        // Held while callbacks are being called, so callbacks are never called
+        // concurrently from different threads
+        std::mutex dispatch_mutex;
+
+        // USB device state
+        int configuration;
+        int alternate_setting;
+        std::chrono::microseconds transfer_latency;
+        bool event_handler_interrupted;
+
+        // Radio configuration
+        uint8_t channel;
+        unsigned int symbol_rate;
+        uint16_t pan_id;
+        uint64_t mac_address;
+        uint64_t time;
+
+        // Reliable message handling
+        uint8_t message_delivery_status;
+        bool deliver_messages_immediately;
+        std::vector<std::pair<uint8_t, uint8_t>> held_mdrs;
+
+        // Data waiting for IN transfers
+        std::deque<std::pair<uint8_t, uint8_t>> queued_mdrs;
+        std::deque<std::vector<uint8_t>> queued_robot_messages;
+        uint8_t status;
+        bool status_changed;
+
+        // IN transfers waiting for data, by endpoint number
+        std::deque<libusb_transfer *> pending_mdr_transfers;
+        std::deque<libusb_transfer *> pending_robot_message_transfers;
+        std::deque<libusb_transfer *> pending_status_transfers;
+
+        std::deque<CompletedTransfer> completed_transfers;
+
+        // The serial number sent over radio with each robot's drive data
+        std::array<uint8_t, 8> drive_serials;
+
+        // Everything the dongle has received
+        std::vector<std::vector<uint8_t>> drive_packets;
+        std::vector<std::vector<uint8_t>> camera_packets;
+        std::vector<RobotMessage> robot_messages;
+        std::vector<unsigned int> beeps;
+        TransferStats stats;
+    };
+}  // namespace Test
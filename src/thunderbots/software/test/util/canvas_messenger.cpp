@@ -0,0 +1,33 @@
+#include "util/canvas_messenger/canvas_messenger.h"
+
+#include <gtest/gtest.h>
+
+using namespace Util;
+
+TEST(CanvasMessengerTest, layers_are_not_drawn_without_publisher)
+{
+    CanvasMessenger canvas_messenger;
+
+    EXPECT_FALSE(canvas_messenger.isDrawingLayer(CanvasMessenger::Layer::NAVIGATOR));
+
+    canvas_messenger.publishAndClearLayer(CanvasMessenger::Layer::NAVIGATOR);
+    EXPECT_FALSE(canvas_messenger.isDrawingLayer(CanvasMessenger::Layer::NAVIGATOR));
+}
+
+TEST(CanvasMessengerTest, draw_gradient_does_not_evaluate_function_for_layer_not_drawn)
+{
+    CanvasMessenger canvas_messenger;
+    int num_evaluations = 0;
+
+    canvas_messenger.drawGradient(
+        CanvasMessenger::Layer::PASS_GENERATION,
+        [&num_evaluations](Point p) {
+            num_evaluations++;
+            return 0.0;
+        },
+        Rectangle(Point(-1, -1), Point(1, 1)), 0, 1, {0, 0, 255, 160}, {255, 0, 0, 160},
+        4);
+    canvas_messenger.publishAndClearLayer(CanvasMessenger::Layer::PASS_GENERATION);
+
+    EXPECT_EQ(0, num_evaluations);
+}
@@ -0,0 +1,134 @@
+/**
+ * Tests for the `CoroutineStackPool`
+ */
+
+#include "util/coroutine_stack_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <boost/coroutine2/all.hpp>
+
+using namespace Util;
+
+typedef boost::coroutines2::coroutine<int> IntCoroutine;
+
+// A small stack size keeps these tests fast, while still being large enough to run
+// the simple coroutines below
+static constexpr std::size_t TEST_STACK_SIZE_BYTES = 64 * 1024;
+
+TEST(CoroutineStackPoolTest, stats_of_new_pool)
+{
+    CoroutineStackPool pool(TEST_STACK_SIZE_BYTES, 4);
+    auto stats = pool.getStats();
+
+    EXPECT_EQ(TEST_STACK_SIZE_BYTES, stats.stack_size_bytes);
+    EXPECT_EQ(4, stats.num_stacks);
+    EXPECT_EQ(0, stats.num_stacks_in_use);
+    EXPECT_EQ(0, stats.peak_num_stacks_in_use);
+    EXPECT_EQ(0, stats.high_water_mark_bytes);
+}
+
+TEST(CoroutineStackPoolTest, coroutine_takes_and_returns_stack)
+{
+    CoroutineStackPool pool(TEST_STACK_SIZE_BYTES, 4);
+
+    {
+        IntCoroutine::pull_type coroutine(pool.getAllocator(),
+                                          [](IntCoroutine::push_type& yield) {
+                                              yield(1);
+                                              yield(2);
+                                          });
+        EXPECT_EQ(1, coroutine.get());
+        EXPECT_EQ(1, pool.getStats().num_stacks_in_use);
+
+        coroutine();
+        EXPECT_EQ(2, coroutine.get());
+    }
+
+    auto stats = pool.getStats();
+    EXPECT_EQ(4, stats.num_stacks);
+    EXPECT_EQ(0, stats.num_stacks_in_use);
+    EXPECT_EQ(1, stats.peak_num_stacks_in_use);
+}
+
+TEST(CoroutineStackPoolTest, pool_grows_when_out_of_stacks)
+{
+    CoroutineStackPool pool(TEST_STACK_SIZE_BYTES, 1);
+
+    {
+        auto coroutine_func = [](IntCoroutine::push_type& yield) { yield(0); };
+        IntCoroutine::pull_type coroutine1(pool.getAllocator(), coroutine_func);
+        IntCoroutine::pull_type coroutine2(pool.getAllocator(), coroutine_func);
+        IntCoroutine::pull_type coroutine3(pool.getAllocator(), coroutine_func);
+
+        auto stats = pool.getStats();
+        EXPECT_EQ(3, stats.num_stacks);
+        EXPECT_EQ(3, stats.num_stacks_in_use);
+    }
+
+    // The extra stacks are kept by the pool so they can be re-used
+    auto stats = pool.getStats();
+    EXPECT_EQ(3, stats.num_stacks);
+    EXPECT_EQ(0, stats.num_stacks_in_use);
+    EXPECT_EQ(3, stats.peak_num_stacks_in_use);
+}
+
+TEST(CoroutineStackPoolTest, stacks_are_reused)
+{
+    CoroutineStackPool pool(TEST_STACK_SIZE_BYTES, 1);
+
+    for (int i = 0; i < 10; i++)
+    {
+        IntCoroutine::pull_type coroutine(
+            pool.getAllocator(), [i](IntCoroutine::push_type& yield) { yield(i); });
+        EXPECT_EQ(i, coroutine.get());
+    }
+
+    auto stats = pool.getStats();
+    EXPECT_EQ(1, stats.num_stacks);
+    EXPECT_EQ(1, stats.peak_num_stacks_in_use);
+}
+
+TEST(CoroutineStackPoolTest, high_water_mark_increases_with_deeper_stack_usage)
+{
+    CoroutineStackPool pool(TEST_STACK_SIZE_BYTES, 1);
+
+    {
+        IntCoroutine::pull_type coroutine(
+            pool.getAllocator(), [](IntCoroutine::push_type& yield) { yield(0); });
+    }
+    std::size_t shallow_high_water_mark = pool.getStats().high_water_mark_bytes;
+    EXPECT_GT(shallow_high_water_mark, 0);
+
+    {
+        IntCoroutine::pull_type coroutine(
+            pool.getAllocator(), [](IntCoroutine::push_type& yield) {
+                // Use a large chunk of the stack. The array is volatile so the
+                // compiler can't optimize it away
+                volatile char buffer[16 * 1024];
+                for (std::size_t i = 0; i < sizeof(buffer); i++)
+                {
+                    buffer[i] = 0;
+                }
+                yield(buffer[0]);
+            });
+    }
+    std::size_t deep_high_water_mark = pool.getStats().high_water_mark_bytes;
+
+    EXPECT_GT(deep_high_water_mark, shallow_high_water_mark);
+    EXPECT_GE(deep_high_water_mark, 16 * 1024);
+    EXPECT_LT(deep_high_water_mark, TEST_STACK_SIZE_BYTES);
+}
+
+TEST(CoroutineStackPoolTest, get_instance_returns_same_pool)
+{
+    EXPECT_EQ(&CoroutineStackPool::getInstance(), &CoroutineStackPool::getInstance());
+    EXPECT_GE(CoroutineStackPool::getInstance().getStats().num_stacks,
+              CoroutineStackPool::DEFAULT_INITIAL_NUM_STACKS);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
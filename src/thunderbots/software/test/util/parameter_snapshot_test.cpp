@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "util/parameter/dynamic_parameters.h"
+
+using namespace Util::DynamicParameters;
+
+TEST(ParameterSnapshotTest, snapshot_contains_parameter_values_test)
+{
+    auto snapshot = getParameterSnapshot();
+
+    EXPECT_DOUBLE_EQ(AI::refbox::min_valid_x.value(), snapshot->AI.refbox.min_valid_x);
+    EXPECT_EQ(cameras::ignore_camera_0.value(), snapshot->cameras.ignore_camera_0);
+    EXPECT_EQ(AI::current_ai_play.value(), snapshot->AI.current_ai_play);
+}
+
+TEST(ParameterSnapshotTest, snapshot_is_reused_until_a_parameter_changes_test)
+{
+    auto snapshot = getParameterSnapshot();
+    EXPECT_EQ(snapshot, getParameterSnapshot());
+
+    const double old_min_valid_x = snapshot->AI.refbox.min_valid_x;
+    AI::refbox::min_valid_x.setValue(old_min_valid_x - 1.0);
+
+    auto new_snapshot = getParameterSnapshot();
+    EXPECT_NE(snapshot, new_snapshot);
+    EXPECT_DOUBLE_EQ(old_min_valid_x - 1.0, new_snapshot->AI.refbox.min_valid_x);
+    // Snapshots never change once they have been published
+    EXPECT_DOUBLE_EQ(old_min_valid_x, snapshot->AI.refbox.min_valid_x);
+
+    AI::refbox::min_valid_x.setValue(old_min_valid_x);
+}
+
+TEST(ParameterSnapshotTest, snapshot_includes_thread_local_values_test)
+{
+    const bool shared_value = cameras::ignore_camera_1.value();
+
+    cameras::ignore_camera_1.setThreadLocalValue(!shared_value);
+    EXPECT_EQ(!shared_value, getParameterSnapshot()->cameras.ignore_camera_1);
+
+    bool value_in_other_thread = !shared_value;
+    std::thread other_thread([&value_in_other_thread]() {
+        value_in_other_thread = getParameterSnapshot()->cameras.ignore_camera_1;
+    });
+    other_thread.join();
+    EXPECT_EQ(shared_value, value_in_other_thread);
+
+    cameras::ignore_camera_1.clearThreadLocalValue();
+    EXPECT_EQ(shared_value, getParameterSnapshot()->cameras.ignore_camera_1);
+}
+
+TEST(ParameterSnapshotTest, update_is_published_as_one_snapshot_test)
+{
+    auto snapshot                = getParameterSnapshot();
+    const double old_min_valid_x = snapshot->AI.refbox.min_valid_x;
+    const double old_max_valid_x = snapshot->AI.refbox.max_valid_x;
+
+    std::shared_ptr<const ParameterSnapshot> snapshot_during_update;
+    std::shared_ptr<const ParameterSnapshot> snapshot_in_other_thread;
+    updateParametersAndPublishSnapshot([&]() {
+        AI::refbox::min_valid_x.setValue(old_min_valid_x - 1.0);
+        snapshot_during_update = getParameterSnapshot();
+        std::thread other_thread([&snapshot_in_other_thread]() {
+            snapshot_in_other_thread = getParameterSnapshot();
+        });
+        other_thread.join();
+        AI::refbox::max_valid_x.setValue(old_max_valid_x + 1.0);
+    });
+
+    // Nothing is published until the whole update has been applied
+    EXPECT_EQ(snapshot, snapshot_during_update);
+    EXPECT_DOUBLE_EQ(old_min_valid_x, snapshot_in_other_thread->AI.refbox.min_valid_x);
+    EXPECT_DOUBLE_EQ(old_max_valid_x, snapshot_in_other_thread->AI.refbox.max_valid_x);
+
+    auto new_snapshot = getParameterSnapshot();
+    EXPECT_DOUBLE_EQ(old_min_valid_x - 1.0, new_snapshot->AI.refbox.min_valid_x);
+    EXPECT_DOUBLE_EQ(old_max_valid_x + 1.0, new_snapshot->AI.refbox.max_valid_x);
+
+    updateParametersAndPublishSnapshot([&]() {
+        AI::refbox::min_valid_x.setValue(old_min_valid_x);
+        AI::refbox::max_valid_x.setValue(old_max_valid_x);
+    });
+}
+
+int main(int argc, char **argv)
+{
+    ros::init(argc, argv, "parameter_snapshot_test");
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
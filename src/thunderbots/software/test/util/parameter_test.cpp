@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 TEST(ParameterTest, register_single_callback_test)
 {
     Parameter<bool> test_param = Parameter<bool>("test_param", "parameters", false);
@@ -56,6 +58,75 @@ TEST(ParameterTest, register_duplicate_callbacks_test)
     EXPECT_EQ(test_value, 2);
 }
 
+TEST(ParameterTest, callback_can_read_new_value_test)
+{
+    Parameter<int> test_param = Parameter<int>("test_param", "parameters", 0);
+    int test_value            = 0;
+
+    // The value must not be locked while the callbacks are called
+    auto callback = [&test_param, &test_value](int) { test_value = test_param.value(); };
+    test_param.registerCallbackFunction(callback);
+
+    test_param.setValue(3);
+    EXPECT_EQ(test_value, 3);
+}
+
+TEST(ParameterTest, thread_local_value_overrides_value_in_calling_thread_only_test)
+{
+    Parameter<int> test_param = Parameter<int>("test_param", "parameters", 1);
+
+    test_param.setThreadLocalValue(2);
+    EXPECT_EQ(test_param.value(), 2);
+
+    int value_in_other_thread = 0;
+    std::thread other_thread([&test_param, &value_in_other_thread]() {
+        value_in_other_thread = test_param.value();
+    });
+    other_thread.join();
+    EXPECT_EQ(value_in_other_thread, 1);
+
+    test_param.clearThreadLocalValue();
+    EXPECT_EQ(test_param.value(), 1);
+}
+
+TEST(ParameterTest, shared_value_ignores_thread_local_value_test)
+{
+    Parameter<double> test_param = Parameter<double>("test_param", "parameters", 1.0);
+
+    const uint64_t version = Parameter<double>::getThreadLocalValuesVersion();
+    EXPECT_FALSE(Parameter<double>::hasThreadLocalValues());
+
+    test_param.setThreadLocalValue(2.0);
+    EXPECT_TRUE(Parameter<double>::hasThreadLocalValues());
+    EXPECT_NE(version, Parameter<double>::getThreadLocalValuesVersion());
+    EXPECT_DOUBLE_EQ(test_param.value(), 2.0);
+    EXPECT_DOUBLE_EQ(test_param.sharedValue(), 1.0);
+
+    Parameter<double>::clearAllThreadLocalValues();
+    EXPECT_FALSE(Parameter<double>::hasThreadLocalValues());
+}
+
+TEST(ParameterTest, set_value_does_not_change_thread_local_value_test)
+{
+    Parameter<std::string> test_param =
+        Parameter<std::string>("test_param", "parameters", "shared");
+    std::string test_value = "";
+
+    auto callback = [&test_value](std::string new_value) { test_value = new_value; };
+    test_param.registerCallbackFunction(callback);
+
+    // Overriding the value in this thread does not call the callbacks
+    test_param.setThreadLocalValue("thread local");
+    EXPECT_EQ(test_value, "");
+
+    test_param.setValue("new shared");
+    EXPECT_EQ(test_value, "new shared");
+    EXPECT_EQ(test_param.value(), "thread local");
+
+    Parameter<std::string>::clearAllThreadLocalValues();
+    EXPECT_EQ(test_param.value(), "new shared");
+}
+
 int main(int argc, char **argv)
 {
     ros::init(argc, argv, "dynamic_parameters_ros_test");
@@ -0,0 +1,64 @@
+#include "util/units.h"
+
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+using namespace Units;
+
+// Quantities of different dimensions must not convert to each other, and raw doubles
+// must be given a unit explicitly
+static_assert(!std::is_convertible<Meters, Radians>::value,
+              "lengths must not convert to angles");
+static_assert(!std::is_convertible<Meters, MetersPerSecond>::value,
+              "lengths must not convert to speeds");
+static_assert(!std::is_convertible<double, Meters>::value,
+              "doubles must not implicitly convert to lengths");
+static_assert(std::is_convertible<Millimeters, Meters>::value,
+              "lengths must convert between units");
+
+// Conversions are resolved at compile time
+static_assert(Millimeters(Meters(1.5)).value() == 1500.0,
+              "conversions must be usable in constant expressions");
+
+TEST(UnitsTest, converts_between_units_of_the_same_dimension)
+{
+    EXPECT_DOUBLE_EQ(2500.0, Millimeters(Meters(2.5)).value());
+    EXPECT_DOUBLE_EQ(-0.25, Meters(Millimeters(-250.0)).value());
+    EXPECT_DOUBLE_EQ(314.0, Centiradians(Radians(3.14)).value());
+    EXPECT_DOUBLE_EQ(3140.0, Milliradians(Radians(3.14)).value());
+    EXPECT_DOUBLE_EQ(31.4, Centiradians(Milliradians(314.0)).value());
+    EXPECT_DOUBLE_EQ(1500.0, MillimetersPerSecond(MetersPerSecond(1.5)).value());
+    EXPECT_DOUBLE_EQ(200.0, CentiradiansPerSecond(RadiansPerSecond(2.0)).value());
+}
+
+TEST(UnitsTest, in_returns_value_in_other_unit)
+{
+    EXPECT_DOUBLE_EQ(4.5, Millimeters(4500.0).in<Meters>());
+    EXPECT_DOUBLE_EQ(4500.0, Meters(4.5).in<Millimeters>());
+    EXPECT_DOUBLE_EQ(4.5, Meters(4.5).in<Meters>());
+}
+
+TEST(UnitsTest, arithmetic_keeps_unit)
+{
+    Meters length = Meters(1.0) + Millimeters(500.0);
+    EXPECT_DOUBLE_EQ(1.5, length.value());
+    EXPECT_DOUBLE_EQ(0.5, (Meters(1.0) - Millimeters(500.0)).value());
+    EXPECT_DOUBLE_EQ(-1.0, (-Meters(1.0)).value());
+    EXPECT_DOUBLE_EQ(3.0, (Meters(1.5) * 2.0).value());
+    EXPECT_DOUBLE_EQ(0.75, (Meters(1.5) / 2.0).value());
+}
+
+TEST(UnitsTest, compares_across_units)
+{
+    EXPECT_TRUE(Meters(1.0) == Millimeters(1000.0));
+    EXPECT_TRUE(Meters(1.0) != Millimeters(999.0));
+    EXPECT_TRUE(Meters(1.0) < Millimeters(1001.0));
+    EXPECT_TRUE(Meters(1.0) > Millimeters(999.0));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -6,6 +6,30 @@
 
 using namespace Util;
 
+CanvasMessenger::CanvasMessenger()
+    : layers_map(), publisher(), stop_publisher_thread(false)
+{
+    // Nothing is kept until there is a publisher to send it
+    for (std::atomic<bool>& layer_drawing : layers_drawing)
+    {
+        layer_drawing = false;
+    }
+}
+
+CanvasMessenger::~CanvasMessenger()
+{
+    {
+        std::scoped_lock layers_to_publish_lock(layers_to_publish_mutex);
+        stop_publisher_thread = true;
+    }
+    layers_to_publish_cv.notify_one();
+
+    if (publisher_thread.joinable())
+    {
+        publisher_thread.join();
+    }
+}
+
 std::shared_ptr<CanvasMessenger> CanvasMessenger::getInstance()
 {
     static std::shared_ptr<CanvasMessenger> canvas_messenger(new CanvasMessenger);
@@ -14,51 +38,133 @@ std::shared_ptr<CanvasMessenger> CanvasMessenger::getInstance()
 
 void CanvasMessenger::initializePublisher(ros::NodeHandle node_handle)
 {
+    std::lock_guard<std::mutex> layers_map_lock(layers_map_mutex);
+
     this->publisher = node_handle.advertise<thunderbots_msgs::CanvasLayer>(
         Util::Constants::VISUALIZER_DRAW_LAYER_TOPIC, BUFFER_SIZE);
+
+    if (!publisher_thread.joinable())
+    {
+        publisher_thread = std::thread(&CanvasMessenger::runPublisherThread, this);
+    }
+
+    for (std::atomic<bool>& layer_drawing : layers_drawing)
+    {
+        layer_drawing = true;
+    }
 }
 
-void CanvasMessenger::publishAndClearLayer(Layer layer)
+bool CanvasMessenger::isDrawingLayer(Layer layer) const
 {
-    // Take ownership of the layers for the duration of this function
-    std::lock_guard<std::mutex> layers_map_lock(layers_map_mutex);
+    return layers_drawing[static_cast<std::size_t>(layer)].load(
+        std::memory_order_relaxed);
+}
 
-    // Get the time right now
-    const std::chrono::time_point<std::chrono::system_clock> now =
-        std::chrono::system_clock::now();
+void CanvasMessenger::publishAndClearLayer(Layer layer)
+{
+    std::vector<Sprite> sprites_to_publish;
+    bool publish_layer = false;
 
-    // Make sure the layer exists
-    auto layer_pair = layers_map.find(layer);
-    if (layer_pair != layers_map.end())
     {
-        // First is the layer number
-        const uint8_t layer_number = (uint8_t)layer_pair->first;
+        // Take ownership of the layers while we take the sprites out of the layer
+        std::lock_guard<std::mutex> layers_map_lock(layers_map_mutex);
+
+        // Get the time right now
+        const std::chrono::time_point<std::chrono::system_clock> now =
+            std::chrono::system_clock::now();
 
-        // Second is the vector that contains the sprites
-        const std::vector<Sprite>& sprites = layer_pair->second.sprites;
+        SpritesAndTime& layer_data = layers_map[layer];
 
-        const int64_t elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                                       now - layer_pair->second.time)
-                                       .count();
-        const double elapsed_ms = elapsed_ns / 1.0e6;
+        const double elapsed_ms =
+            std::chrono::duration<double, std::milli>(now - layer_data.time).count();
+        const double frame_ms =
+            std::chrono::duration<double, std::milli>(now - layer_data.time_last_cleared)
+                .count();
 
-        // Publish the layer if enough time has passed since we
-        // last published
-        if (elapsed_ms >= DESIRED_PERIOD_MS)
+        // Publish the layer if enough time has passed since we last published, and
+        // the sprites on it were drawn for the whole frame
+        if (isDrawingLayer(layer) && elapsed_ms >= DESIRED_PERIOD_MS)
         {
-            // Publish the layer
-            this->publishPayload(layer_number, sprites);
+            sprites_to_publish = std::move(layer_data.sprites);
+            publish_layer      = true;
 
             // Update last published time
-            layer_pair->second.time = now;
+            layer_data.time = now;
         }
 
         // Clear the layer
-        layer_pair->second.sprites = {};
+        layer_data.sprites           = {};
+        layer_data.time_last_cleared = now;
+
+        // Only keep what is drawn in the next frame if we expect enough time to have
+        // passed to publish it once the frame is over, assuming it takes as long as
+        // this one did
+        const double elapsed_ms_at_end_of_next_frame =
+            std::chrono::duration<double, std::milli>(now - layer_data.time).count() +
+            frame_ms;
+        layers_drawing[static_cast<std::size_t>(layer)] =
+            publisher && elapsed_ms_at_end_of_next_frame >= DESIRED_PERIOD_MS;
+    }
+
+    if (publish_layer)
+    {
+        {
+            std::scoped_lock layers_to_publish_lock(layers_to_publish_mutex);
+            layers_to_publish[layer] = std::move(sprites_to_publish);
+        }
+        layers_to_publish_cv.notify_one();
+    }
+}
+
+void CanvasMessenger::runPublisherThread()
+{
+    while (true)
+    {
+        std::map<Layer, std::vector<Sprite>> layers;
+        {
+            std::unique_lock<std::mutex> layers_to_publish_lock(layers_to_publish_mutex);
+            layers_to_publish_cv.wait(layers_to_publish_lock, [this]() {
+                return stop_publisher_thread || !layers_to_publish.empty();
+            });
+            if (stop_publisher_thread)
+            {
+                return;
+            }
+            layers.swap(layers_to_publish);
+        }
+
+        const std::chrono::time_point<std::chrono::system_clock> now =
+            std::chrono::system_clock::now();
+        for (auto& [layer, sprites] : layers)
+        {
+            std::vector<uint8_t> payload =
+                serializeLayer(static_cast<uint8_t>(layer), sprites);
+
+            // The visualizer keeps showing the last payload it received for a layer,
+            // so we don't need to send it again unless it has changed
+            PayloadAndTime& last_published = last_published_payloads[layer];
+            const double elapsed_ms =
+                std::chrono::duration<double, std::milli>(now - last_published.time)
+                    .count();
+            if (payload == last_published.payload &&
+                elapsed_ms < UNCHANGED_LAYER_PERIOD_MS)
+            {
+                continue;
+            }
+
+            // Create a new layer message, add the binary data
+            thunderbots_msgs::CanvasLayer new_layer;
+            new_layer.data = payload;
+            publisher->publish(new_layer);
+
+            last_published.payload = std::move(payload);
+            last_published.time    = now;
+        }
     }
 }
 
-void CanvasMessenger::publishPayload(uint8_t layer, std::vector<Sprite> sprites)
+std::vector<uint8_t> CanvasMessenger::serializeLayer(uint8_t layer,
+                                                     std::vector<Sprite>& sprites)
 {
     std::vector<uint8_t> payload;
 
@@ -72,17 +178,7 @@ void CanvasMessenger::publishPayload(uint8_t layer, std::vector<Sprite> sprites)
         payload.insert(payload.end(), sprite_payload.begin(), sprite_payload.end());
     }
 
-    // Create a new layer message, add the binary data
-    thunderbots_msgs::CanvasLayer new_layer;
-    new_layer.data = payload;
-
-    // and publish if we have a valid ROS publisher.
-    // This check is important for cases where we're running this without running ROS,
-    // such as in unit tests.
-    if (publisher)
-    {
-        publisher->publish(new_layer);
-    }
+    return payload;
 }
 
 void CanvasMessenger::clearAllLayers()
@@ -107,24 +203,23 @@ void CanvasMessenger::clearLayer(Layer layer)
 
 void CanvasMessenger::drawSprite(Layer layer, Sprite sprite)
 {
-    // We simply add the sprite to the specified layer
-    this->addSpriteToLayer(layer, sprite);
+    drawSprites(layer, {sprite});
 }
 
-void CanvasMessenger::addSpriteToLayer(Layer layer, Sprite& sprite)
+void CanvasMessenger::drawSprites(Layer layer, std::vector<Sprite> sprites)
 {
-    // Take ownership of the layers for the duration of this function
-    std::lock_guard<std::mutex> layers_map_lock(layers_map_mutex);
-
-    // We look if the layer exists
-    if (this->layers_map.find(layer) == this->layers_map.end())
+    // Don't bother locking the layers if the sprites won't be published
+    if (!isDrawingLayer(layer))
     {
-        // If not, we initialize new key to empty vector pair
-        this->layers_map[layer];
+        return;
     }
 
-    // and add the sprite to the layer vector
-    this->layers_map[layer].sprites.emplace_back(sprite);
+    // Take ownership of the layers for the duration of this function
+    std::lock_guard<std::mutex> layers_map_lock(layers_map_mutex);
+
+    // and add the sprites to the layer vector, creating the layer if it doesn't exist
+    std::vector<Sprite>& layer_sprites = this->layers_map[layer].sprites;
+    layer_sprites.insert(layer_sprites.end(), sprites.begin(), sprites.end());
 }
 
 void CanvasMessenger::drawRectangle(Layer layer, Rectangle rectangle, Angle orientation,
@@ -141,6 +236,14 @@ void CanvasMessenger::drawGradient(Layer layer, std::function<double(Point)> val
                                    const Rectangle& area, double min_val, double max_val,
                                    Color min_color, Color max_color, int points_per_meter)
 {
+    // The function may be expensive, so don't evaluate it if the gradient won't be
+    // published
+    if (!isDrawingLayer(layer))
+    {
+        return;
+    }
+
+    std::vector<Sprite> gradient_sprites;
     for (int i = 0; i < area.width() * points_per_meter; i++)
     {
         for (int j = 0; j < area.height() * points_per_meter; j++)
@@ -171,9 +274,13 @@ void CanvasMessenger::drawGradient(Layer layer, std::function<double(Point)> val
                 static_cast<uint8_t>((max_color.a - min_color.a) / (max_val - min_val) *
                                          (val_at_p - min_val) +
                                      min_color.a)};
-            drawRectangle(layer, block, Angle::zero(), color);
+            gradient_sprites.emplace_back(0, block.centre(), Angle::zero(),
+                                          block.width(), block.height(), color);
         }
     }
+
+    // Draw the whole gradient at once, rather than locking the layers for every block
+    drawSprites(layer, std::move(gradient_sprites));
 }
 
 void CanvasMessenger::drawLine(Layer layer, Point p1, Point p2, double thickness,
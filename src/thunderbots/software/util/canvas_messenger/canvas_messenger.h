@@ -4,18 +4,23 @@
  *
  * The singleton constructs a binary representation of all the sprites
  * to be drawn for a particular layer and sends it to the visualizer via
- * ROS messages.
+ * ROS messages. The binary representation is built and sent on a separate
+ * publisher thread, so the threads drawing on the canvas only collect sprites.
  */
 
 #pragma once
 
 #include <ros/ros.h>
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "ai/world/ball.h"
@@ -46,6 +51,9 @@ namespace Util
             STATIC_FEATURES
         };
 
+        // The number of values in the Layer enum
+        static const std::size_t NUM_LAYERS = 5;
+
         struct Color
         {
             // Red value of the color
@@ -125,6 +133,24 @@ namespace Util
             Color _color;
         };
 
+        /**
+         * Creates a new CanvasMessenger with no layers and no publisher. Sprites drawn
+         * on it are discarded when their layer is published, until a publisher is
+         * initialized
+         *
+         * Most code should draw on the shared instance returned by getInstance(). A
+         * separate CanvasMessenger is useful to keep an AI that isn't connected to the
+         * visualizer, such as one of several running in the same process, from
+         * contending for the shared instance
+         */
+        explicit CanvasMessenger();
+
+        /**
+         * Stops the publisher thread, if it was started. Layers that have not been sent
+         * yet are discarded
+         */
+        ~CanvasMessenger();
+
         /**
          * Getter of the singleton object.
          *
@@ -132,14 +158,42 @@ namespace Util
          */
         static std::shared_ptr<CanvasMessenger> getInstance();
 
+        /**
+         * Creates the ROS publisher for the layers and starts the thread that sends
+         * them. Until this is called, nothing drawn on this CanvasMessenger is kept
+         *
+         * @param node_handle The node handle to create the publisher with
+         */
         void initializePublisher(ros::NodeHandle node_handle);
 
         /**
-         * Uses ROS publishers to publish sprite data for each layer and
-         * then clears all layer data.
+         * Hands the sprites drawn on the given layer since it was last cleared to the
+         * publisher thread, then clears the layer.
+         *
+         * Layers are published at most DESIRED_CANVAS_MESSAGE_FREQ times a second. When
+         * a layer will not be published at the end of the next frame (the sprites drawn
+         * until the next call to this function), draw calls for it are skipped
+         * entirely, so only complete frames are ever published. The publisher thread
+         * does not send a layer that is identical to the last one it sent, except once
+         * a second so newly started visualizers still receive it
+         *
+         * @param layer The layer to publish
          */
         void publishAndClearLayer(Layer layer);
 
+        /**
+         * Returns true if sprites drawn on the given layer will be published at the end
+         * of this frame. Draw calls for layers that aren't being drawn are skipped, so
+         * callers can check this to avoid the work of figuring out what to draw.
+         *
+         * This does not take any locks
+         *
+         * @param layer The layer to check
+         *
+         * @return true if sprites drawn on the given layer will be published
+         */
+        bool isDrawingLayer(Layer layer) const;
+
         /**
          * Clear the given layer
          * @param layer The layer to clear
@@ -254,30 +308,46 @@ namespace Util
         };
 
         /**
-         * Struct that holds some sprites and a time
+         * Struct that holds some sprites, the time they were last published, and the
+         * time the layer was last cleared
          */
         struct SpritesAndTime
         {
             std::vector<Sprite> sprites;
             std::chrono::time_point<std::chrono::system_clock> time;
+            std::chrono::time_point<std::chrono::system_clock> time_last_cleared;
+        };
+
+        /**
+         * Struct that holds the last payload the publisher thread sent for a layer and
+         * the time it was sent
+         */
+        struct PayloadAndTime
+        {
+            std::vector<uint8_t> payload;
+            std::chrono::time_point<std::chrono::system_clock> time;
         };
 
         // The number of pixels per meter
         static const int PIXELS_PER_METER = 2000;
 
         /**
-         * Constructor; initializes an empty layers map then populates it
+         * Converts the sprites for a layer into the binary message sent to the
+         * visualizer
+         *
+         * @param layer The layer number
+         * @param sprites The sprites on the layer
+         *
+         * @return the binary message for the layer
          */
-        explicit CanvasMessenger() : layers_map(), publisher() {}
-
-        void publishPayload(uint8_t layer, std::vector<Sprite> shapes);
+        static std::vector<uint8_t> serializeLayer(uint8_t layer,
+                                                   std::vector<Sprite> &sprites);
 
         /**
-         * Add sprite to layer
-         * @param layer: The layer which the sprite is to be added to
-         * @param sprite: The sprite data
+         * Serializes and publishes the layers handed over by publishAndClearLayer until
+         * this CanvasMessenger is destroyed
          */
-        void addSpriteToLayer(Layer layer, Sprite &sprite);
+        void runPublisherThread();
 
         /**
          * Draw a sprite onto a specific layer.
@@ -287,6 +357,14 @@ namespace Util
          */
         void drawSprite(Layer layer, Sprite sprite);
 
+        /**
+         * Draw many sprites onto a specific layer, locking the layers only once
+         *
+         * @param layer: The layer number these shapes are being drawn to
+         * @param sprites: the sprite data to draw
+         */
+        void drawSprites(Layer layer, std::vector<Sprite> sprites);
+
         /**
          * Clears all sprite data for all layers
          */
@@ -294,10 +372,13 @@ namespace Util
 
         std::optional<ros::Publisher> publisher;
 
-        // Period in nanoseconds
+        // Period in milliseconds
         const double DESIRED_PERIOD_MS =
             1.0e3 / Util::Constants::DESIRED_CANVAS_MESSAGE_FREQ;
 
+        // How often a layer is sent even if it has not changed, in milliseconds
+        const double UNCHANGED_LAYER_PERIOD_MS = 1.0e3;
+
         // Number of messages we want our ROS publisher to buffer
         const int BUFFER_SIZE = 8;
 
@@ -309,5 +390,21 @@ namespace Util
 
         // layer to sprites/time last published map
         std::map<Layer, SpritesAndTime> layers_map;
+
+        // Whether the sprites drawn on each layer are being kept, indexed by layer.
+        // These are read by every draw call without locking the layers
+        std::array<std::atomic<bool>, NUM_LAYERS> layers_drawing;
+
+        // The layers waiting for the publisher thread. If a layer is published again
+        // before the thread gets to it, only the newest sprites are kept
+        std::map<Layer, std::vector<Sprite>> layers_to_publish;
+        bool stop_publisher_thread;
+        std::mutex layers_to_publish_mutex;
+        std::condition_variable layers_to_publish_cv;
+
+        // The last payload sent for each layer. Only used by the publisher thread
+        std::map<Layer, PayloadAndTime> last_published_payloads;
+
+        std::thread publisher_thread;
     };
 }  // namespace Util
@@ -0,0 +1,111 @@
+#include "util/coroutine_stack_pool.h"
+
+#include <algorithm>
+#include <boost/context/stack_traits.hpp>
+#include <cstring>
+
+namespace Util
+{
+    CoroutineStackPool::Allocator::Allocator(CoroutineStackPool &pool) : pool(&pool) {}
+
+    boost::context::stack_context CoroutineStackPool::Allocator::allocate()
+    {
+        return pool->allocate();
+    }
+
+    void CoroutineStackPool::Allocator::deallocate(boost::context::stack_context &sctx)
+    {
+        pool->deallocate(sctx);
+    }
+
+    CoroutineStackPool::CoroutineStackPool(std::size_t stack_size_bytes,
+                                           std::size_t initial_num_stacks)
+        : stack_size_bytes(stack_size_bytes),
+          peak_num_stacks_in_use(0),
+          high_water_mark_bytes(0)
+    {
+        std::scoped_lock lock(pool_mutex);
+        stacks.reserve(initial_num_stacks);
+        free_stacks.reserve(initial_num_stacks);
+        for (std::size_t i = 0; i < initial_num_stacks; i++)
+        {
+            addNewStack();
+        }
+    }
+
+    CoroutineStackPool &CoroutineStackPool::getInstance()
+    {
+        static CoroutineStackPool instance(boost::context::stack_traits::default_size(),
+                                           DEFAULT_INITIAL_NUM_STACKS);
+        return instance;
+    }
+
+    CoroutineStackPool::Allocator CoroutineStackPool::getAllocator()
+    {
+        return Allocator(*this);
+    }
+
+    CoroutineStackPool::Stats CoroutineStackPool::getStats() const
+    {
+        std::scoped_lock lock(pool_mutex);
+        return Stats{stack_size_bytes, stacks.size(), stacks.size() - free_stacks.size(),
+                     peak_num_stacks_in_use, high_water_mark_bytes};
+    }
+
+    boost::context::stack_context CoroutineStackPool::allocate()
+    {
+        std::scoped_lock lock(pool_mutex);
+        if (free_stacks.empty())
+        {
+            addNewStack();
+        }
+
+        std::byte *stack_bottom = free_stacks.back();
+        free_stacks.pop_back();
+
+        peak_num_stacks_in_use =
+            std::max(peak_num_stacks_in_use, stacks.size() - free_stacks.size());
+
+        // Stacks grow downwards, so the stack pointer starts at the highest address
+        boost::context::stack_context sctx;
+        sctx.size = stack_size_bytes;
+        sctx.sp   = stack_bottom + stack_size_bytes;
+        return sctx;
+    }
+
+    void CoroutineStackPool::deallocate(boost::context::stack_context &sctx)
+    {
+        std::byte *stack_bottom = static_cast<std::byte *>(sctx.sp) - sctx.size;
+
+        // Measuring the stack is done outside the lock since it only touches memory
+        // that is owned by the caller until it is pushed back onto the free list
+        std::size_t used_bytes = measureAndRepaintStack(stack_bottom);
+
+        std::scoped_lock lock(pool_mutex);
+        high_water_mark_bytes = std::max(high_water_mark_bytes, used_bytes);
+        free_stacks.emplace_back(stack_bottom);
+    }
+
+    void CoroutineStackPool::addNewStack()
+    {
+        auto stack = std::make_unique<std::byte[]>(stack_size_bytes);
+        // Writing to every byte forces the OS to map every page of the stack now, rather
+        // than the first time a coroutine happens to touch it
+        std::memset(stack.get(), std::to_integer<int>(STACK_FILL_PATTERN),
+                    stack_size_bytes);
+        free_stacks.emplace_back(stack.get());
+        stacks.emplace_back(std::move(stack));
+    }
+
+    std::size_t CoroutineStackPool::measureAndRepaintStack(std::byte *stack_bottom) const
+    {
+        std::byte *stack_top  = stack_bottom + stack_size_bytes;
+        std::byte *first_used = std::find_if(
+            stack_bottom, stack_top, [](std::byte b) { return b != STACK_FILL_PATTERN; });
+
+        std::size_t used_bytes = static_cast<std::size_t>(stack_top - first_used);
+        std::memset(first_used, std::to_integer<int>(STACK_FILL_PATTERN), used_bytes);
+
+        return used_bytes;
+    }
+}  // namespace Util
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <boost/context/stack_context.hpp>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Util
+{
+    /**
+     * A thread-safe pool of fixed-size coroutine stacks.
+     *
+     * Every Tactic, Action and Play owns a boost coroutine, and these objects are
+     * re-created very frequently during gameplay (Plays re-create Tactics, Tactics
+     * create Actions, looping Tactics restart their coroutine, etc). With the default
+     * boost stack allocator, every one of these creations results in a fresh large
+     * allocation (which is serviced by mmap/munmap), making coroutine creation slow and
+     * unpredictable.
+     *
+     * The pool allocates all of its stacks up-front and pre-faults them by writing a
+     * known pattern over every byte. Stacks are handed out to coroutines and returned to
+     * the pool when the coroutine is destroyed, so no memory is allocated or released
+     * from the OS while the pool has free stacks. If the pool runs out of stacks, it will
+     * grow by allocating a new stack, which will be kept for the lifetime of the pool.
+     *
+     * Because every stack is painted with a known pattern, the pool can also measure how
+     * much of each stack was actually used when the stack is returned. The largest
+     * measured usage is reported as the high-water-mark, which can be used to check that
+     * the stack size is large enough for the coroutines we run.
+     */
+    class CoroutineStackPool
+    {
+       public:
+        /**
+         * Statistics describing the usage of a CoroutineStackPool
+         */
+        struct Stats
+        {
+            // The size of each stack in the pool, in bytes
+            std::size_t stack_size_bytes;
+            // The total number of stacks owned by the pool
+            std::size_t num_stacks;
+            // The number of stacks currently being used by a coroutine
+            std::size_t num_stacks_in_use;
+            // The largest number of stacks that have been in use at the same time
+            std::size_t peak_num_stacks_in_use;
+            // The largest amount of stack space (in bytes) used by any coroutine that has
+            // returned its stack to the pool
+            std::size_t high_water_mark_bytes;
+        };
+
+        /**
+         * A lightweight handle to a CoroutineStackPool that satisfies the boost
+         * StackAllocator concept, so it can be passed to the constructor of a
+         * boost::coroutines2 coroutine. The handle is copied into every coroutine it is
+         * given to, but all copies allocate from the same pool.
+         *
+         * See
+         * https://www.boost.org/doc/libs/release/libs/coroutine2/doc/html/coroutine2/stack.html
+         */
+        class Allocator
+        {
+           public:
+            /**
+             * Creates a new Allocator that allocates stacks from the given pool
+             *
+             * @param pool The pool to allocate stacks from. The pool must outlive the
+             * Allocator and every coroutine that uses it
+             */
+            explicit Allocator(CoroutineStackPool &pool);
+
+            /**
+             * Takes a stack from the pool
+             *
+             * @return the stack context for the stack taken from the pool
+             */
+            boost::context::stack_context allocate();
+
+            /**
+             * Returns a stack to the pool
+             *
+             * @param sctx The stack context of a stack that was previously allocated by
+             * this Allocator
+             */
+            void deallocate(boost::context::stack_context &sctx);
+
+           private:
+            CoroutineStackPool *pool;
+        };
+
+        /**
+         * Creates a new CoroutineStackPool and pre-allocates the given number of stacks
+         *
+         * @param stack_size_bytes The size of every stack in the pool, in bytes
+         * @param initial_num_stacks The number of stacks to allocate and pre-fault
+         * immediately
+         */
+        explicit CoroutineStackPool(std::size_t stack_size_bytes,
+                                    std::size_t initial_num_stacks);
+
+        /**
+         * Returns the CoroutineStackPool shared by all STP coroutines (Tactics, Actions,
+         * and Plays). The stacks in this pool are the same size as the default boost
+         * coroutine stacks
+         *
+         * @return the CoroutineStackPool shared by all STP coroutines
+         */
+        static CoroutineStackPool &getInstance();
+
+        /**
+         * Returns an Allocator that can be given to a boost coroutine so it takes its
+         * stack from this pool
+         *
+         * @return an Allocator that allocates stacks from this pool
+         */
+        Allocator getAllocator();
+
+        /**
+         * Returns statistics describing the usage of this pool
+         *
+         * @return statistics describing the usage of this pool
+         */
+        Stats getStats() const;
+
+        // The number of stacks pre-allocated by the pool returned by getInstance()
+        static constexpr std::size_t DEFAULT_INITIAL_NUM_STACKS = 32;
+
+       private:
+        /**
+         * Takes a free stack from the pool, growing the pool if there are no free stacks
+         *
+         * @return the stack context for the stack taken from the pool
+         */
+        boost::context::stack_context allocate();
+
+        /**
+         * Returns the given stack to the pool, and updates the high-water-mark with the
+         * amount of the stack that was used
+         *
+         * @param sctx The stack context of a stack allocated from this pool
+         */
+        void deallocate(boost::context::stack_context &sctx);
+
+        /**
+         * Allocates a new stack, paints it with the fill pattern (which also pre-faults
+         * every page of the stack), and adds it to the list of free stacks. The
+         * caller must hold the pool mutex.
+         */
+        void addNewStack();
+
+        /**
+         * Measures how many bytes of the given stack have been written to by looking for
+         * the first byte (starting from the bottom of the stack) that no longer contains
+         * the fill pattern, then re-paints the used portion of the stack so it can be
+         * measured again the next time it is used.
+         *
+         * @param stack_bottom A pointer to the lowest address of the stack
+         *
+         * @return the number of bytes of the stack that were used
+         */
+        std::size_t measureAndRepaintStack(std::byte *stack_bottom) const;
+
+        // The byte value every unused byte of a stack is set to
+        static constexpr std::byte STACK_FILL_PATTERN{0xA5};
+
+        const std::size_t stack_size_bytes;
+
+        mutable std::mutex pool_mutex;
+        // All the stacks owned by this pool
+        std::vector<std::unique_ptr<std::byte[]>> stacks;
+        // Pointers to the lowest address of each stack that is not currently in use
+        std::vector<std::byte *> free_stacks;
+        std::size_t peak_num_stacks_in_use;
+        std::size_t high_water_mark_bytes;
+    };
+}  // namespace Util
@@ -43,6 +43,7 @@ AUTOGEN_WARNING = \
 H_HEADER = \
 """{}
 #pragma once
+#include <functional>
 #include \"util/parameter/parameter.h\"
 namespace Util::DynamicParameters{{
 """.format(AUTOGEN_WARNING)
@@ -50,11 +51,190 @@ namespace Util::DynamicParameters{{
 CPP_HEADER = \
 """{}
 # include \"util/parameter/dynamic_parameters.h\"
+# include <atomic>
+# include <mutex>
 namespace Util::DynamicParameters{{
 """.format(AUTOGEN_WARNING)
 
 FOOTER = "}\n"
 
+#####################
+# Snapshot Contants #
+#####################
+
+H_SNAPSHOT_OPEN = \
+"""
+/**
+ * A copy of the value of every parameter, laid out like the namespaces above. Code
+ * that reads many parameters, or reads them in a hot loop, should read them all from
+ * one snapshot so it sees a consistent set of values without locking each parameter
+ */
+struct ParameterSnapshot
+{
+"""
+H_SNAPSHOT_MEMBER = '{type} {name};\n'
+H_SNAPSHOT_STRUCT_OPEN = 'struct {\n'
+H_SNAPSHOT_STRUCT_CLOSE = '}} {name};\n'
+H_SNAPSHOT_CLOSE = '};\n'
+
+H_SNAPSHOT_FUNCTIONS = \
+"""
+/**
+ * Returns the latest published snapshot of the parameters. If the calling thread has
+ * overridden any parameters with setThreadLocalValue, the snapshot includes them.
+ *
+ * Unless a new snapshot has been published since the calling thread last called this,
+ * the snapshot is returned from a per-thread cache after reading a single atomic
+ * counter, so this can be called in hot loops. Snapshots never change once published,
+ * so a snapshot can be held for a whole frame to read consistent values throughout
+ *
+ * @return the latest snapshot of the parameters
+ */
+std::shared_ptr<const ParameterSnapshot> getParameterSnapshot();
+
+/**
+ * Copies the shared value of every parameter into a new snapshot and publishes it to
+ * all threads. This is called whenever a parameter is changed with setValue outside of
+ * updateParametersAndPublishSnapshot, and must be called after parameters are updated
+ * in any other way
+ */
+void publishParameterSnapshot();
+
+/**
+ * Applies an update to any number of parameters, then publishes one snapshot with all
+ * of it. No snapshot is built while the update is applied, including by the callbacks
+ * of parameters changed with setValue, so no thread ever sees part of the update
+ *
+ * @param apply_update the function that sets the new values of the parameters
+ */
+void updateParametersAndPublishSnapshot(const std::function<void()>& apply_update);
+"""
+
+CPP_SNAPSHOT_ASSIGNMENT = '    snapshot.{member} = get_value({parameter});\n'
+CPP_SNAPSHOT_CALLBACK = \
+'    {parameter}.registerCallbackFunction([](auto) {{ publishParameterSnapshot(); }});\n'
+
+CPP_SNAPSHOT_FUNCTIONS = \
+"""
+namespace {{
+/**
+ * Creates a snapshot of every parameter, reading each one with the given function
+ */
+template <typename GetValue>
+ParameterSnapshot createParameterSnapshot(GetValue get_value)
+{{
+    ParameterSnapshot snapshot;
+{assignments}
+    return snapshot;
+}}
+
+ParameterSnapshot createSharedParameterSnapshot()
+{{
+    return createParameterSnapshot(
+        [](auto& parameter) {{ return parameter.sharedValue(); }});
+}}
+
+// The snapshot most recently published to all threads. It is only accessed through
+// std::atomic_load and std::atomic_store, so a published snapshot is replaced rather
+// than modified, and stays alive for as long as any thread is reading it
+std::shared_ptr<const ParameterSnapshot> shared_snapshot =
+    std::make_shared<const ParameterSnapshot>(createSharedParameterSnapshot());
+
+// Incremented every time a new shared snapshot is published
+std::atomic<uint64_t> shared_snapshot_version(0);
+
+// Held while a snapshot is built from the shared values, and while an update is applied
+// to them, so a snapshot never contains part of an update. It is recursive so the
+// callbacks of parameters changed during an update can still try to publish
+std::recursive_mutex update_mutex;
+
+// Whether the calling thread is applying an update in updateParametersAndPublishSnapshot
+thread_local bool applying_update = false;
+
+bool hasThreadLocalValues()
+{{
+    return Parameter<bool>::hasThreadLocalValues() ||
+           Parameter<int32_t>::hasThreadLocalValues() ||
+           Parameter<double>::hasThreadLocalValues() ||
+           Parameter<std::string>::hasThreadLocalValues();
+}}
+
+uint64_t getThreadLocalValuesVersion()
+{{
+    return Parameter<bool>::getThreadLocalValuesVersion() +
+           Parameter<int32_t>::getThreadLocalValuesVersion() +
+           Parameter<double>::getThreadLocalValuesVersion() +
+           Parameter<std::string>::getThreadLocalValuesVersion();
+}}
+
+bool registerSnapshotCallbacks()
+{{
+{callbacks}
+    return true;
+}}
+
+const bool snapshot_callbacks_registered = registerSnapshotCallbacks();
+}}
+
+std::shared_ptr<const ParameterSnapshot> getParameterSnapshot()
+{{
+    // The snapshot the calling thread last returned, and the versions it was made from
+    thread_local std::shared_ptr<const ParameterSnapshot> cached_snapshot;
+    thread_local uint64_t cached_shared_snapshot_version    = 0;
+    thread_local uint64_t cached_thread_local_values_version = 0;
+
+    const uint64_t current_shared_snapshot_version    = shared_snapshot_version.load();
+    const uint64_t current_thread_local_values_version = getThreadLocalValuesVersion();
+    if (!cached_snapshot ||
+        cached_shared_snapshot_version != current_shared_snapshot_version ||
+        cached_thread_local_values_version != current_thread_local_values_version)
+    {{
+        if (hasThreadLocalValues())
+        {{
+            std::scoped_lock lock(update_mutex);
+            cached_snapshot = std::make_shared<const ParameterSnapshot>(
+                createParameterSnapshot(
+                    [](auto& parameter) {{ return parameter.value(); }}));
+        }}
+        else
+        {{
+            cached_snapshot = std::atomic_load(&shared_snapshot);
+        }}
+        cached_shared_snapshot_version     = current_shared_snapshot_version;
+        cached_thread_local_values_version = current_thread_local_values_version;
+    }}
+    return cached_snapshot;
+}}
+
+void publishParameterSnapshot()
+{{
+    // An update is published once, after all of it has been applied
+    if (applying_update)
+    {{
+        return;
+    }}
+
+    // Publishers take turns so the last snapshot published is always the newest
+    std::scoped_lock lock(update_mutex);
+    std::atomic_store(&shared_snapshot, std::make_shared<const ParameterSnapshot>(
+                                            createSharedParameterSnapshot()));
+    shared_snapshot_version++;
+}}
+
+void updateParametersAndPublishSnapshot(const std::function<void()>& apply_update)
+{{
+    std::scoped_lock lock(update_mutex);
+
+    // Updates applied within this one are published with it
+    const bool applying_outer_update = applying_update;
+    applying_update                  = true;
+    apply_update();
+    applying_update = applying_outer_update;
+
+    publishParameterSnapshot();
+}}
+"""
+
 CFG_STR_VECTOR = "std::vector<std::string> cfg_strs{{{}}};\n"
 
 RECONFIGURE_SERVER = \
@@ -18,18 +18,22 @@ namespace Util::DynamicParameters
 
     void parameterUpdateCallback(const dynamic_reconfigure::Config::ConstPtr& updates)
     {
-        Parameter<bool>::updateAllParametersFromConfigMsg(updates);
-        Parameter<int32_t>::updateAllParametersFromConfigMsg(updates);
-        Parameter<double>::updateAllParametersFromConfigMsg(updates);
-        Parameter<std::string>::updateAllParametersFromConfigMsg(updates);
+        updateParametersAndPublishSnapshot([&updates]() {
+            Parameter<bool>::updateAllParametersFromConfigMsg(updates);
+            Parameter<int32_t>::updateAllParametersFromConfigMsg(updates);
+            Parameter<double>::updateAllParametersFromConfigMsg(updates);
+            Parameter<std::string>::updateAllParametersFromConfigMsg(updates);
+        });
     }
 
     void updateAllParametersFromROSParameterServer()
     {
-        Parameter<bool>::updateAllParametersFromROSParameterServer();
-        Parameter<int32_t>::updateAllParametersFromROSParameterServer();
-        Parameter<double>::updateAllParametersFromROSParameterServer();
-        Parameter<std::string>::updateAllParametersFromROSParameterServer();
+        updateParametersAndPublishSnapshot([]() {
+            Parameter<bool>::updateAllParametersFromROSParameterServer();
+            Parameter<int32_t>::updateAllParametersFromROSParameterServer();
+            Parameter<double>::updateAllParametersFromROSParameterServer();
+            Parameter<std::string>::updateAllParametersFromROSParameterServer();
+        });
     }
 
 }  // namespace Util::DynamicParameters
@@ -21,13 +21,14 @@ namespace Util::DynamicParameters
     /**
      * This callback is attatched to the /parameter/parameter_updates topic
      * The new values arrive on this topic and the parameter objects are updated
-     * from the Config msg
+     * from the Config msg, then a single new ParameterSnapshot is published with all
+     * of the new values
      */
     void parameterUpdateCallback(const dynamic_reconfigure::Config::ConstPtr& updates);
 
     /**
      * Updates all known parameters with the latest values from the ROS Parameter
-     * Server
+     * Server, then publishes a single new ParameterSnapshot with all of the new values
      */
     void updateAllParametersFromROSParameterServer();
 
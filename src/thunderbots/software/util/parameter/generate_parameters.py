@@ -263,6 +263,9 @@ def generate_header_and_cpp(param_info: dict, output_path: str):
         __header_and_cpp_gen(
             value, key, dynamic_parameters_h, dynamic_parameters_cpp)
 
+    # generate the snapshot of all the parameters
+    __snapshot_gen(param_info, dynamic_parameters_h, dynamic_parameters_cpp)
+
     # append the footer
     dynamic_parameters_h.write(constants.FOOTER)
     dynamic_parameters_cpp.write(constants.FOOTER)
@@ -341,6 +344,83 @@ def __header_and_cpp_gen(param_info: dict, cfg_name: str, header_file_pointer, c
             cpp_file_pointer.write(constants.NAMESPACE_CLOSE)
 
 
+def __snapshot_gen(param_info: dict, header_file_pointer, cpp_file_pointer):
+    """Takes the information about the parameters and namespaces and generates
+    the ParameterSnapshot struct in the header file, and the functions that
+    create and publish it in the cpp file
+
+    :param param_info: Return value of load_configuration, dict containing params
+    :param header_file_pointer: The file pointer to the dynamic_parameters.h file
+    :param cpp_file_pointer: The file pointer to the dynamic_parameters.cpp file
+    :type param_info: dict
+    :type header_file_pointer: file
+    :type cpp_file_pointer: file
+
+    """
+    header_file_pointer.write(constants.H_SNAPSHOT_OPEN)
+    assignments = []
+    callbacks = []
+
+    # the first key is the file name, so that is skipped
+    for key, value in param_info.items():
+        __snapshot_members_gen(value, [], header_file_pointer,
+                               assignments, callbacks)
+
+    header_file_pointer.write(constants.H_SNAPSHOT_CLOSE)
+    header_file_pointer.write(constants.H_SNAPSHOT_FUNCTIONS)
+
+    cpp_file_pointer.write(constants.CPP_SNAPSHOT_FUNCTIONS.format(
+        assignments="".join(assignments),
+        callbacks="".join(callbacks)
+    ))
+
+
+def __snapshot_members_gen(param_info: dict, namespaces: list, header_file_pointer,
+                           assignments: list, callbacks: list):
+    """Recursively generates the members of the ParameterSnapshot struct, with a
+    nested struct for each namespace, and collects the statements that copy each
+    parameter into the snapshot and register the callbacks that republish it
+
+    :param param_info: Contains namespace and parameter information
+        organized by namespaces until the parameter
+    :param namespaces: The namespaces the current parameters are in
+    :param header_file_pointer: The file pointer to the dynamic_parameters.h file
+    :param assignments: The list to add the snapshot assignments to
+    :param callbacks: The list to add the callback registrations to
+    :type param_info: dict
+    :type namespaces: list
+    :type header_file_pointer: file
+    :type assignments: list
+    :type callbacks: list
+
+    """
+    for key in param_info.keys():
+
+        # if type key is found, add the parameter to the snapshot
+        if "type" in param_info[key]:
+            header_file_pointer.write(
+                constants.H_SNAPSHOT_MEMBER.format(
+                    name=key,
+                    type=constants.CPP_TYPE_MAP[param_info[key]["type"]]
+                )
+            )
+            assignments.append(constants.CPP_SNAPSHOT_ASSIGNMENT.format(
+                member=".".join(namespaces + [key]),
+                parameter="::".join(namespaces + [key])
+            ))
+            callbacks.append(constants.CPP_SNAPSHOT_CALLBACK.format(
+                parameter="::".join(namespaces + [key])
+            ))
+
+        # else create a struct for the namespace
+        else:
+            header_file_pointer.write(constants.H_SNAPSHOT_STRUCT_OPEN)
+            __snapshot_members_gen(param_info[key], namespaces + [key],
+                                   header_file_pointer, assignments, callbacks)
+            header_file_pointer.write(
+                constants.H_SNAPSHOT_STRUCT_CLOSE.format(name=key))
+
+
 def generate_server_node(param_info: dict, output_path: str):
     """This function must be called after the cfg, h and cpp files
     have been generated. Those generated cfg files will be setup
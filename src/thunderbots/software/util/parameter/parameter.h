@@ -2,9 +2,11 @@
 
 #include <ros/ros.h>
 
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 // messages for dynamic_reconfigure
 #include <dynamic_reconfigure/BoolParameter.h>
@@ -62,26 +64,110 @@ class Parameter
     }
 
     /**
-     * Returns the value of this parameter
+     * Returns the value of this parameter. If the calling thread has overridden this
+     * parameter with setThreadLocalValue, the overriding value is returned instead
      *
      * @return the value of this parameter
      */
     T value()
+    {
+        const auto& thread_local_values = Parameter<T>::getThreadLocalValues();
+        if (!thread_local_values.empty())
+        {
+            auto thread_local_value = thread_local_values.find(this);
+            if (thread_local_value != thread_local_values.end())
+            {
+                return thread_local_value->second;
+            }
+        }
+
+        return sharedValue();
+    }
+
+    /**
+     * Returns the value of this parameter shared by all threads, ignoring any value
+     * the calling thread has set with setThreadLocalValue
+     *
+     * @return the value of this parameter shared by all threads
+     */
+    T sharedValue()
     {
         std::scoped_lock lock(this->value_mutex_);
         return this->value_;
     }
 
+    /**
+     * Overrides the value of this parameter for the calling thread only. Other threads
+     * keep seeing the shared value, and callback functions are not called.
+     *
+     * This lets several AIs run in the same process with different parameters, by
+     * giving each one its own thread
+     *
+     * @param thread_local_value The value this parameter should have in the calling
+     * thread
+     */
+    void setThreadLocalValue(const T thread_local_value)
+    {
+        Parameter<T>::getThreadLocalValues()[this] = thread_local_value;
+        Parameter<T>::getMutableThreadLocalValuesVersion()++;
+    }
+
+    /**
+     * Removes the override set by setThreadLocalValue for the calling thread, so it
+     * sees the shared value again
+     */
+    void clearThreadLocalValue()
+    {
+        Parameter<T>::getThreadLocalValues().erase(this);
+        Parameter<T>::getMutableThreadLocalValuesVersion()++;
+    }
+
+    /**
+     * Removes all the overrides set by setThreadLocalValue for Parameters of type T for
+     * the calling thread
+     */
+    static void clearAllThreadLocalValues()
+    {
+        Parameter<T>::getThreadLocalValues().clear();
+        Parameter<T>::getMutableThreadLocalValuesVersion()++;
+    }
+
+    /**
+     * Returns true if the calling thread has overridden any Parameter of type T with
+     * setThreadLocalValue
+     *
+     * @return true if the calling thread has overridden any Parameter of type T
+     */
+    static bool hasThreadLocalValues()
+    {
+        return !Parameter<T>::getThreadLocalValues().empty();
+    }
+
+    /**
+     * Returns a number that changes every time the calling thread sets or clears an
+     * override for a Parameter of type T, so callers can tell when values they have
+     * cached for the calling thread are out of date
+     *
+     * @return the version of the calling thread's overrides for Parameters of type T
+     */
+    static uint64_t getThreadLocalValuesVersion()
+    {
+        return Parameter<T>::getMutableThreadLocalValuesVersion();
+    }
+
     /**
      * Given the value, sets the value of this parameter and calls all registered
-     * callback functions with the new value
+     * callback functions with the new value. The value is no longer locked when the
+     * callback functions are called, so they may read this parameter
      *
      * @param new_value The new value to set
      */
     void setValue(const T new_value)
     {
-        std::scoped_lock value_lock(this->value_mutex_);
-        this->value_ = new_value;
+        {
+            std::scoped_lock value_lock(this->value_mutex_);
+            this->value_ = new_value;
+        }
         std::scoped_lock callback_lock(this->callback_mutex_);
         for (auto callback_func : callback_functions)
         {
@@ -240,6 +326,29 @@ class Parameter
         return instance;
     }
 
+    /**
+     * Returns the values of the Parameters of type T that have been overridden by the
+     * calling thread
+     *
+     * @return A mutable reference to the calling thread's overriding values
+     */
+    static std::unordered_map<const Parameter<T>*, T>& getThreadLocalValues()
+    {
+        static thread_local std::unordered_map<const Parameter<T>*, T> values;
+        return values;
+    }
+
+    /**
+     * Returns the version of the calling thread's overrides for Parameters of type T
+     *
+     * @return A mutable reference to the version of the calling thread's overrides
+     */
+    static uint64_t& getMutableThreadLocalValuesVersion()
+    {
+        static thread_local uint64_t version = 0;
+        return version;
+    }
+
     std::mutex value_mutex_;
     std::mutex callback_mutex_;
 
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <ratio>
+
+/**
+ * Strongly typed physical quantities, which stop values in one unit being used as if
+ * they were in another, such as passing millimetres where metres are expected.
+ *
+ * A Quantity is a double tagged with a dimension and a scale relative to the SI unit of
+ * that dimension, in the same way as std::chrono::duration. Quantities of the same
+ * dimension convert implicitly to each other, and the conversion factor is computed
+ * from the scales at compile time, so a conversion costs a single multiply. Quantities
+ * of different dimensions do not convert, and raw doubles must be wrapped explicitly
+ * with the unit they are in.
+ */
+namespace Units
+{
+    /**
+     * The dimensions of the quantities we use. They are in their own namespace so they
+     * don't clash with the geometry types of the same names
+     */
+    namespace Dimensions
+    {
+        struct Length;
+        struct Speed;
+        struct Angle;
+        struct AngularVelocity;
+        struct RotationalSpeed;
+    }  // namespace Dimensions
+
+    /**
+     * A physical quantity in a particular unit
+     *
+     * @tparam Dimension the dimension of the quantity, from Units::Dimensions
+     * @tparam Scale the size of the unit, as a std::ratio of the SI unit
+     */
+    template <typename Dimension, typename Scale = std::ratio<1>>
+    class Quantity
+    {
+       public:
+        /**
+         * Creates a zero Quantity
+         */
+        constexpr Quantity() : value_(0.0) {}
+
+        /**
+         * Creates a Quantity from a raw value in this Quantity's unit
+         *
+         * @param value the value, in this Quantity's unit
+         */
+        constexpr explicit Quantity(double value) : value_(value) {}
+
+        /**
+         * Converts a Quantity of the same dimension in another unit to this unit
+         *
+         * @param other the Quantity to convert
+         */
+        template <typename OtherScale>
+        constexpr Quantity(const Quantity<Dimension, OtherScale> &other)
+            : value_(other.value() *
+                     (static_cast<double>(std::ratio_divide<OtherScale, Scale>::num) /
+                      static_cast<double>(std::ratio_divide<OtherScale, Scale>::den)))
+        {
+        }
+
+        /**
+         * Returns the value of this Quantity in its own unit
+         *
+         * @return the value of this Quantity in its own unit
+         */
+        constexpr double value() const
+        {
+            return value_;
+        }
+
+        /**
+         * Returns the value of this Quantity in another unit of the same dimension
+         *
+         * @tparam To the Quantity type whose unit to return the value in
+         *
+         * @return the value of this Quantity in the unit of To
+         */
+        template <typename To>
+        constexpr double in() const
+        {
+            return To(*this).value();
+        }
+
+        constexpr Quantity operator-() const
+        {
+            return Quantity(-value_);
+        }
+
+        constexpr Quantity operator+(const Quantity &other) const
+        {
+            return Quantity(value_ + other.value_);
+        }
+
+        constexpr Quantity operator-(const Quantity &other) const
+        {
+            return Quantity(value_ - other.value_);
+        }
+
+        constexpr Quantity operator*(double scale) const
+        {
+            return Quantity(value_ * scale);
+        }
+
+        constexpr Quantity operator/(double scale) const
+        {
+            return Quantity(value_ / scale);
+        }
+
+        constexpr bool operator==(const Quantity &other) const
+        {
+            return value_ == other.value_;
+        }
+
+        constexpr bool operator!=(const Quantity &other) const
+        {
+            return value_ != other.value_;
+        }
+
+        constexpr bool operator<(const Quantity &other) const
+        {
+            return value_ < other.value_;
+        }
+
+        constexpr bool operator>(const Quantity &other) const
+        {
+            return value_ > other.value_;
+        }
+
+       private:
+        double value_;
+    };
+
+    typedef Quantity<Dimensions::Length> Meters;
+    typedef Quantity<Dimensions::Length, std::milli> Millimeters;
+
+    typedef Quantity<Dimensions::Speed> MetersPerSecond;
+    typedef Quantity<Dimensions::Speed, std::milli> MillimetersPerSecond;
+
+    typedef Quantity<Dimensions::Angle> Radians;
+    typedef Quantity<Dimensions::Angle, std::centi> Centiradians;
+    typedef Quantity<Dimensions::Angle, std::milli> Milliradians;
+
+    typedef Quantity<Dimensions::AngularVelocity> RadiansPerSecond;
+    typedef Quantity<Dimensions::AngularVelocity, std::centi> CentiradiansPerSecond;
+
+    typedef Quantity<Dimensions::RotationalSpeed> RevolutionsPerMinute;
+}  // namespace Units